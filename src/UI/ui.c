@@ -9,7 +9,9 @@
 #include "UI/ui.h"
 #include "platform_internal.h"
 #include "raygui.h"
+#include "renderer/backend.h"
 #include <stdio.h>
+#include <string.h>
 
 void SetThemeColor(SimColor *themeColor)
 {
@@ -48,51 +50,79 @@ void SetThemeColor(SimColor *themeColor)
     GuiSetStyle(DEFAULT, TEXT_COLOR_DISABLED, ColorToInt(colorDisabled));
 }
 
+// Slider bound to a SimReal parameter (raygui sliders only work on float)
+static bool ParamSlider(Rectangle bounds, const char *text, SimReal *value, float minValue, float maxValue)
+{
+    float sliderValue = (float)*value;
+    GuiSlider(bounds, text, NULL, &sliderValue, minValue, maxValue);
+    if (sliderValue == (float)*value)
+        return false;
+    *value = sliderValue;
+    return true;
+}
+
 // TODO:
 // only move sliders if click happeded inside bouding box
 // if user is dragging mass and hovers over sliders, sliders will also move
-void MakeVariableSliders(SpringMassSystemState *systemState)
+bool MakeVariableSliders(SpringMassSystemState *systemState)
+{
+    return MakeVariableSlidersAt(systemState, UI_SLIDER_X, UI_SLIDER_Y);
+}
+
+bool MakeVariableSlidersAt(SpringMassSystemState *systemState, float x, float y)
 {
     // Slider ranges
-    const float k_min = 0.0f;
-    const float k_max = 500.0f;
+    const float k_min = PARAM_K_MIN;
+    const float k_max = PARAM_K_MAX;
 
-    const float m_min = 0.1f;
-    const float m_max = 500.0f;
+    const float m_min = PARAM_M_MIN;
+    const float m_max = PARAM_M_MAX;
 
-    const float c_min = 0.0f;
-    const float c_max = 50.0f;
+    const float c_min = PARAM_C_MIN;
+    const float c_max = PARAM_C_MAX;
 
-    const float e_min = 0.0f;
-    const float e_max = 1.0f;
+    const float e_min = PARAM_E_MIN;
+    const float e_max = PARAM_E_MAX;
+
+    // Tracks whether any parameter moved, so the caller only re-selects the physics kernel on change
+    bool changed = false;
 
     // Slider and label bounds
-    Rectangle sliderBounds = (Rectangle){ UI_SLIDER_X, UI_SLIDER_Y, UI_SLIDER_WIDTH, UI_SLIDER_HEIGHT };
-    Rectangle labelBounds = (Rectangle){ UI_SLIDER_X, UI_SLIDER_Y - 20, UI_SLIDER_WIDTH, UI_SLIDER_HEIGHT };
+    Rectangle sliderBounds = (Rectangle){ x, y, UI_SLIDER_WIDTH, UI_SLIDER_HEIGHT };
+    Rectangle labelBounds = (Rectangle){ x, y - 20, UI_SLIDER_WIDTH, UI_SLIDER_HEIGHT };
 
     // Draw sliders and labels
     GuiLabel(labelBounds, "Spring Constant (k)");
-    GuiSlider(sliderBounds, TextFormat("k=%.1f", systemState->springConst), NULL, &systemState->springConst, k_min,
-              k_max);
+    changed |= ParamSlider(sliderBounds, TextFormat("k=%.1f", (float)systemState->springConst),
+                           &systemState->springConst, k_min, k_max);
     labelBounds.y += 2 * UI_SLIDER_HEIGHT;
     sliderBounds.y += 2 * UI_SLIDER_HEIGHT;
 
     GuiLabel(labelBounds, "Mass (m)");
-    GuiSlider(sliderBounds, TextFormat("m=%.1f", systemState->mass), NULL, &systemState->mass, m_min, m_max);
+    changed |=
+        ParamSlider(sliderBounds, TextFormat("m=%.1f", (float)systemState->mass), &systemState->mass, m_min, m_max);
     labelBounds.y += 2 * UI_SLIDER_HEIGHT;
     sliderBounds.y += 2 * UI_SLIDER_HEIGHT;
 
     GuiLabel(labelBounds, "Damping Coeficient (c)");
-    GuiSlider(sliderBounds, TextFormat("c=%.1f", systemState->damping), NULL, &systemState->damping, c_min, c_max);
+    changed |= ParamSlider(sliderBounds, TextFormat("c=%.1f", (float)systemState->damping), &systemState->damping,
+                           c_min, c_max);
     labelBounds.y += 2 * UI_SLIDER_HEIGHT;
     sliderBounds.y += 2 * UI_SLIDER_HEIGHT;
 
     GuiLabel(labelBounds, "Restitution (e)");
-    GuiSlider(sliderBounds, TextFormat("e=%.1f", systemState->restitution), NULL, &systemState->restitution, e_min,
-              e_max);
+    changed |= ParamSlider(sliderBounds, TextFormat("e=%.1f", (float)systemState->restitution),
+                           &systemState->restitution, e_min, e_max);
+
+    return changed;
 }
 
 void ShowDamping(float c, float k, float m, SimColor *themeColor)
+{
+    ShowDampingAt(c, k, m, themeColor, UI_SLIDER_X, UI_SLIDER_Y);
+}
+
+void ShowDampingAt(float c, float k, float m, SimColor *themeColor, float x, float y)
 {
     // For a mass-spring-damper system, the critical damping coefficient is:
     //   c_crit = 2 * sqrt(k * m)
@@ -114,11 +144,19 @@ void ShowDamping(float c, float k, float m, SimColor *themeColor)
 
     const int fontSize = 20;
     // UPDATE if I change this to label i wont have to pass themeColor
-    DrawText(dampingType, UI_SLIDER_X, UI_SLIDER_Y + 7 * UI_SLIDER_HEIGHT + 5, fontSize,
-             SimColorToRayColor(*themeColor));
+    Render_DrawText(dampingType, x, y + 7 * UI_SLIDER_HEIGHT + 5, fontSize, *themeColor);
 }
 
-int ShowPauseDialog(void)
+void ShowNoiseStats(double mean, double deviation, long samples, SimColor *themeColor)
+{
+    const int fontSize = 20;
+    Render_DrawText(TextFormat("Noise: mean %.1f, std %.1f", mean, deviation), UI_SLIDER_X,
+                    UI_SLIDER_Y + 8 * UI_SLIDER_HEIGHT + 10, fontSize, *themeColor);
+    Render_DrawText(TextFormat("over %ld frames", samples), UI_SLIDER_X, UI_SLIDER_Y + 9 * UI_SLIDER_HEIGHT + 15,
+                    fontSize, *themeColor);
+}
+
+int ShowPauseDialog(bool rewound)
 {
     float screenWidth = GetScreenWidth();
     float screenHeight = GetScreenHeight();
@@ -131,14 +169,14 @@ int ShowPauseDialog(void)
 
     Rectangle dialogBounds = { x, y, dialogWidth, dialogHeight };
 
-    DrawRectangleRec(dialogBounds, BLACK);
+    renderBackend->rect(x, y, dialogWidth, dialogHeight, SIM_BLACK);
     GuiGroupBox(dialogBounds, NULL);
 
     const char *text = "Paused";
     int fontSize = 20;
-    int textWidth = MeasureText(text, fontSize);
+    int textWidth = renderBackend->measureText(text, fontSize);
 
-    DrawText(text, x + (dialogWidth / 2) - (textWidth / 2), y + 10, fontSize, GRAY);
+    Render_DrawText(text, x + (dialogWidth / 2) - (textWidth / 2), y + 10, fontSize, SIM_GRAY);
 
     // Add buttons inside the group box
     int numButtons = 3; // UPDATE if button is added, need a fix for this
@@ -148,7 +186,7 @@ int ShowPauseDialog(void)
     int i = 1;
 
     Rectangle resumeButtonBounds = { buttonX, y + dialogHeight * i / (numButtons + 1), buttonWidth, buttonHeight };
-    if (GuiButton(resumeButtonBounds, "Resume"))
+    if (GuiButton(resumeButtonBounds, rewound ? "Resume from here" : "Resume"))
     {
         return 1;
     }
@@ -169,6 +207,29 @@ int ShowPauseDialog(void)
     return -1;
 }
 
+bool ShowTimelineSlider(float *time, float start, float end)
+{
+    // Under the pause dialog, as wide as it
+    float screenWidth = GetScreenWidth();
+    float screenHeight = GetScreenHeight();
+    float dialogWidth = screenWidth / 2;
+    float x = (screenWidth / 2) - (dialogWidth / 2);
+    float y = (screenHeight / 2) + (screenHeight / 4) + 30;
+
+    char label[64], startText[16], endText[16];
+    snprintf(label, sizeof(label), "Rewind: %d:%02d", (int)*time / 60, (int)*time % 60);
+    snprintf(startText, sizeof(startText), "%d:%02d", (int)start / 60, (int)start % 60);
+    snprintf(endText, sizeof(endText), "%d:%02d", (int)end / 60, (int)end % 60);
+    Render_DrawText(label, x, y - 20, 15, SIM_GRAY);
+
+    float value = *time;
+    GuiSlider((Rectangle){ x + 50, y, dialogWidth - 100, UI_SLIDER_HEIGHT }, startText, endText, &value, start, end);
+    if (value == *time)
+        return false;
+    *time = value;
+    return true;
+}
+
 int ShowSettings(void)
 {
     float screenWidth = GetScreenWidth();
@@ -182,17 +243,17 @@ int ShowSettings(void)
 
     Rectangle dialogBounds = { x, y, dialogWidth, dialogHeight };
 
-    DrawRectangleRec(dialogBounds, BLACK);
+    renderBackend->rect(x, y, dialogWidth, dialogHeight, SIM_BLACK);
     GuiGroupBox(dialogBounds, NULL);
 
     const char *text = "Settings";
     int fontSize = 20;
-    int textWidth = MeasureText(text, fontSize);
+    int textWidth = renderBackend->measureText(text, fontSize);
 
-    DrawText(text, x + (dialogWidth / 2) - (textWidth / 2), y + 10, fontSize, GRAY);
+    Render_DrawText(text, x + (dialogWidth / 2) - (textWidth / 2), y + 10, fontSize, SIM_GRAY);
 
     // Add buttons inside the group box
-    int numButtons = 2; // UPDATE if button is added, need a fix for this
+    int numButtons = 3; // UPDATE if button is added, need a fix for this
     float buttonWidth = 150;
     float buttonHeight = 40;
     float buttonX = x + (dialogWidth - buttonWidth) / 2;
@@ -210,13 +271,35 @@ int ShowSettings(void)
     {
         return 2;
     }
+    i++;
+
+    Rectangle designButtonBounds = { buttonX, y + dialogHeight * i / (numButtons + 1), buttonWidth, buttonHeight };
+    if (GuiButton(designButtonBounds, "Design From Targets"))
+    {
+        return 3;
+    }
     return -1;
 }
 
-// FIXME: I dont like these globals..
-bool showColorPanel = false;
-bool showColorScroll = true;
-void ShowThemeChange(SpringMassRenderState *state)
+void InitThemeDialog(ThemeDialogState *dialog)
+{
+    memset(dialog, 0, sizeof(*dialog)); // Padding included: the state is written to snapshots byte for byte
+    dialog->focus = -1;
+    dialog->showColorScroll = true;
+    dialog->customColor = SIM_BLUE;
+}
+
+void InitDesignDialog(DesignDialogState *dialog)
+{
+    dialog->useOvershoot = true;
+    dialog->useSettle = true;
+    dialog->useImpacts = false;
+    dialog->overshoot = 0.1f;
+    dialog->settleTime = 2.0f;
+    dialog->impacts = 0.0f;
+}
+
+void ShowThemeChange(SpringMassRenderState *state, ThemeDialogState *dialog)
 {
     float screenWidth = GetScreenWidth();
     float screenHeight = GetScreenHeight();
@@ -229,14 +312,14 @@ void ShowThemeChange(SpringMassRenderState *state)
 
     Rectangle dialogBounds = { x, y, dialogWidth, dialogHeight };
 
-    DrawRectangleRec(dialogBounds, BLACK);
+    renderBackend->rect(x, y, dialogWidth, dialogHeight, SIM_BLACK);
     GuiGroupBox(dialogBounds, NULL);
 
     const char *text = "Change Theme";
     int fontSize = 20;
-    int textWidth = MeasureText(text, fontSize);
+    int textWidth = renderBackend->measureText(text, fontSize);
 
-    DrawText(text, x + (dialogWidth / 2) - (textWidth / 2), y + 10, fontSize, GRAY);
+    Render_DrawText(text, x + (dialogWidth / 2) - (textWidth / 2), y + 10, fontSize, SIM_GRAY);
 
     // Add buttons inside the group box
     int numButtons = 2; // UPDATE if button is added, need a fix for this
@@ -245,10 +328,6 @@ void ShowThemeChange(SpringMassRenderState *state)
     float buttonX = x + (dialogWidth - buttonWidth) / 2;
     int i = 1;
 
-    static int listViewScroll = 0;
-    static int active = 0;
-    static int focus = -1;
-
     // Array of sim colors matching the list
     static SimColor themeColors[] = { SIM_DARKGRAY,   SIM_MAROON,    SIM_ORANGE, SIM_DARKGREEN, SIM_DARKBLUE,
                                       SIM_DARKPURPLE, SIM_DARKBROWN, SIM_GRAY,   SIM_RED,       SIM_GOLD,
@@ -262,42 +341,41 @@ void ShowThemeChange(SpringMassRenderState *state)
                                         "SKYBLUE",   "PURPLE", "BEIGE" };
 
     Rectangle colorsListBounds = { buttonX, y + dialogHeight * i / (numButtons + 1), buttonWidth, buttonHeight * 3 };
-    if (showColorScroll)
+    if (dialog->showColorScroll)
     {
-        int result = GuiListViewEx(colorsListBounds, colorNames, 21, &listViewScroll, &active, &focus);
+        int result = GuiListViewEx(colorsListBounds, colorNames, 21, &dialog->listViewScroll, &dialog->active,
+                                   &dialog->focus);
 
         // Apply the theme color based on the selected item (active)
-        if (active >= 0 && active < 21)
+        if (dialog->active >= 0 && dialog->active < 21)
         {
-            SetThemeColor(&themeColors[active]);
-            state->themeColor = themeColors[active];
+            SetThemeColor(&themeColors[dialog->active]);
+            state->themeColor = themeColors[dialog->active];
         }
     }
     i++;
 
-    static bool showColorPanel = false;
-    static Color customColor = BLUE;
-
     Rectangle customColorButtonBounds = { buttonX, y + dialogHeight * i / (numButtons + 1) + 20, buttonWidth,
                                           buttonHeight };
     if (GuiButton(customColorButtonBounds, "Custom"))
     {
-        showColorPanel = !showColorPanel; // Toggle the panel
+        dialog->showColorPanel = !dialog->showColorPanel; // Toggle the panel
     }
 
-    if (showColorPanel)
+    if (dialog->showColorPanel)
     {
         Rectangle colorPickerBounds = { x + (dialogWidth / 2) - 100, y + (dialogHeight / 2) - 100, 200, 200 };
+        Color customColor = SimColorToRayColor(dialog->customColor);
         GuiColorPicker(colorPickerBounds, NULL, &customColor);
 
         // Apply the custom color
-        SimColor customSimColor = RayColorToSimColor(customColor);
-        SetThemeColor(&customSimColor);
-        state->themeColor = RayColorToSimColor(customColor);
+        dialog->customColor = RayColorToSimColor(customColor);
+        SetThemeColor(&dialog->customColor);
+        state->themeColor = dialog->customColor;
     }
 }
 
-void ShowParamEdit()
+bool ShowParamEdit(SpringMassSystemState *state)
 {
     float screenWidth = GetScreenWidth();
     float screenHeight = GetScreenHeight();
@@ -310,14 +388,151 @@ void ShowParamEdit()
 
     Rectangle dialogBounds = { x, y, dialogWidth, dialogHeight };
 
-    DrawRectangleRec(dialogBounds, BLACK);
+    renderBackend->rect(x, y, dialogWidth, dialogHeight, SIM_BLACK);
     GuiGroupBox(dialogBounds, NULL);
 
     const char *text = "Edit Parameters";
     int fontSize = 20;
-    int textWidth = MeasureText(text, fontSize);
+    int textWidth = renderBackend->measureText(text, fontSize);
+
+    Render_DrawText(text, x + (dialogWidth / 2) - (textWidth / 2), y + 10, fontSize, SIM_GRAY);
+
+    // Force law selector, one toggle per law in ForceLaw order
+    const float margin = 20.0f;
+    int law = state->law;
+    GuiLabel((Rectangle){ x + margin, y + 40, dialogWidth - 2 * margin, 20 }, "Force Law");
+    GuiToggleGroup((Rectangle){ x + margin, y + 60, (dialogWidth - 2 * margin) / FORCE_LAWS, 24 },
+                   "Linear;Duffing;Stops;Coulomb;Drag;Measured", &law);
+    bool changed = law != (int)state->law;
+    state->law = (ForceLaw)law;
+
+    // Parameters of the selected law (the linear spring, mass and damping stay on the main sliders)
+    Rectangle labelBounds = { x + margin, y + 100, dialogWidth - 2 * margin - 60, UI_SLIDER_HEIGHT };
+    Rectangle sliderBounds = { x + margin, y + 120, dialogWidth - 2 * margin - 60, UI_SLIDER_HEIGHT };
+    switch (state->law)
+    {
+        case FORCE_DUFFING:
+            GuiLabel(labelBounds, "Cubic Stiffness (beta)");
+            changed |= ParamSlider(sliderBounds, TextFormat("%.4f", (float)state->cubicConst), &state->cubicConst,
+                                   0.0f, 0.01f);
+            break;
+        case FORCE_STOPS:
+            GuiLabel(labelBounds, "Free Travel (gap)");
+            changed |= ParamSlider(sliderBounds, TextFormat("%.0f", (float)state->stopGap), &state->stopGap, 0.0f,
+                                   200.0f);
+            labelBounds.y += 2 * UI_SLIDER_HEIGHT;
+            sliderBounds.y += 2 * UI_SLIDER_HEIGHT;
+            GuiLabel(labelBounds, "Stop Stiffness");
+            changed |= ParamSlider(sliderBounds, TextFormat("%.0f", (float)state->stopConst), &state->stopConst,
+                                   0.0f, 5000.0f);
+            break;
+        case FORCE_COULOMB:
+            GuiLabel(labelBounds, "Static Friction");
+            changed |= ParamSlider(sliderBounds, TextFormat("%.0f", (float)state->staticFriction),
+                                   &state->staticFriction, 0.0f, 10000.0f);
+            labelBounds.y += 2 * UI_SLIDER_HEIGHT;
+            sliderBounds.y += 2 * UI_SLIDER_HEIGHT;
+            GuiLabel(labelBounds, "Kinetic Friction");
+            changed |= ParamSlider(sliderBounds, TextFormat("%.0f", (float)state->kineticFriction),
+                                   &state->kineticFriction, 0.0f, 10000.0f);
+            break;
+        case FORCE_DRAG:
+            GuiLabel(labelBounds, "Drag Coefficient");
+            changed |= ParamSlider(sliderBounds, TextFormat("%.4f", (float)state->dragCoeff), &state->dragCoeff, 0.0f,
+                                   0.02f);
+            break;
+        case FORCE_TABLE:
+            GuiLabel(labelBounds, "Measured curve (load one with --spring-table)");
+            break;
+        default:
+            GuiLabel(labelBounds, "Hooke's law: F = -k x");
+            break;
+    }
+
+    // Stochastic forcing acts under every law
+    labelBounds.y = y + 180;
+    sliderBounds.y = y + 200;
+    GuiLabel(labelBounds, "Noise Intensity (0: off)");
+    changed |= ParamSlider(sliderBounds, TextFormat("%.0f", (float)state->noiseIntensity), &state->noiseIntensity, 0.0f,
+                           PARAM_NOISE_MAX);
+    labelBounds.y += 2 * UI_SLIDER_HEIGHT;
+    sliderBounds.y += 2 * UI_SLIDER_HEIGHT;
+    GuiLabel(labelBounds, "Noise Correlation Time (0: white)");
+    changed |= ParamSlider(sliderBounds, TextFormat("%.2f s", (float)state->noiseTau), &state->noiseTau, 0.0f,
+                           PARAM_TAU_MAX);
+    return changed;
+}
+
+bool ShowDesignDialog(DesignDialogState *dialog, DesignTarget *target, const DesignResult *last, bool solving)
+{
+    float screenWidth = GetScreenWidth();
+    float screenHeight = GetScreenHeight();
+
+    float dialogWidth = screenWidth / 2;
+    float dialogHeight = screenHeight / 2;
+
+    float x = (screenWidth / 2) - (dialogWidth / 2);
+    float y = (screenHeight / 2) - (dialogHeight / 2);
+
+    Rectangle dialogBounds = { x, y, dialogWidth, dialogHeight };
+
+    renderBackend->rect(x, y, dialogWidth, dialogHeight, SIM_BLACK);
+    GuiGroupBox(dialogBounds, NULL);
+
+    const char *text = "Design From Targets";
+    int fontSize = 20;
+    int textWidth = renderBackend->measureText(text, fontSize);
+
+    Render_DrawText(text, x + (dialogWidth / 2) - (textWidth / 2), y + 10, fontSize, SIM_GRAY);
+
+    // One checkbox and slider per target; unchecked targets are left free
+    const float margin = 20.0f;
+    float sliderX = x + margin + 150;
+    float sliderWidth = dialogWidth - 2 * margin - 210;
+    Rectangle checkBounds = { x + margin, y + 50, 20, 20 };
+    GuiCheckBox(checkBounds, "Overshoot", &dialog->useOvershoot);
+    GuiSlider((Rectangle){ sliderX, checkBounds.y, sliderWidth, UI_SLIDER_HEIGHT }, NULL,
+              TextFormat("%.0f%%", dialog->overshoot * 100), &dialog->overshoot, 0.0f, 1.0f);
+    checkBounds.y += 2 * UI_SLIDER_HEIGHT;
+    GuiCheckBox(checkBounds, "Settling time", &dialog->useSettle);
+    GuiSlider((Rectangle){ sliderX, checkBounds.y, sliderWidth, UI_SLIDER_HEIGHT }, NULL,
+              TextFormat("%.1f s", dialog->settleTime), &dialog->settleTime, 0.1f, 10.0f);
+    checkBounds.y += 2 * UI_SLIDER_HEIGHT;
+    GuiCheckBox(checkBounds, "Wall impacts", &dialog->useImpacts);
+    GuiSlider((Rectangle){ sliderX, checkBounds.y, sliderWidth, UI_SLIDER_HEIGHT }, NULL,
+              TextFormat("<= %d", (int)(dialog->impacts + 0.5f)), &dialog->impacts, 0.0f, 20.0f);
+
+    // Outcome of the last solve
+    if (last != NULL)
+    {
+        GuiLabel((Rectangle){ x + margin, checkBounds.y + 50, dialogWidth - 2 * margin, 20 },
+                 TextFormat("%s: k=%.1f c=%.2f m=%.2f e=%.2f", last->met ? "Met" : "Closest (not met)",
+                            (float)last->springConst, (float)last->damping, (float)last->mass,
+                            (float)last->restitution));
+        GuiLabel((Rectangle){ x + margin, checkBounds.y + 70, dialogWidth - 2 * margin, 20 },
+                 TextFormat("overshoot %.0f%%, settles in %.2f s, %d impacts (%.0f ms)", last->overshoot * 100,
+                            last->settleTime, last->impacts, last->seconds * 1e3));
+    }
 
-    DrawText(text, x + (dialogWidth / 2) - (textWidth / 2), y + 10, fontSize, GRAY);
+    // A solve in progress replaces the button until its result is applied
+    Rectangle solveBounds = { x + (dialogWidth - 150) / 2, y + dialogHeight - 60, 150, 40 };
+    if (solving)
+    {
+        textWidth = renderBackend->measureText("Solving...", fontSize);
+        Render_DrawText("Solving...", x + (dialogWidth / 2) - (textWidth / 2), solveBounds.y + 10, fontSize,
+                        SIM_GRAY);
+        return false;
+    }
+    if (!GuiButton(solveBounds, "Solve"))
+        return false;
+    DesignTargetInit(target);
+    if (dialog->useOvershoot)
+        target->overshoot = dialog->overshoot;
+    if (dialog->useSettle)
+        target->settleTime = dialog->settleTime;
+    if (dialog->useImpacts)
+        target->maxImpacts = (int)(dialog->impacts + 0.5f);
+    return true;
 }
 
 bool EscKeyPressed(void)
@@ -329,6 +544,33 @@ bool EscKeyPressed(void)
     return false;
 }
 
+bool LatchKeyPressed(void)
+{
+    if (IsKeyPressed(KEY_L))
+    {
+        return true;
+    }
+    return false;
+}
+
+bool SensitivityKeyPressed(void)
+{
+    if (IsKeyPressed(KEY_S))
+    {
+        return true;
+    }
+    return false;
+}
+
+bool PhaseKeyPressed(void)
+{
+    if (IsKeyPressed(KEY_P))
+    {
+        return true;
+    }
+    return false;
+}
+
 bool ExitButtonClicked(void)
 {
     return !WindowShouldClose();
@@ -9,19 +9,58 @@
 #define UI_H
 
 #include "consts.h"
+#include "core/design.h"
 #include "core/physics.h"
 #include "renderer/renderer.h"
 #include <stdbool.h>
 
+// Persistent state of the theme change dialog
+typedef struct ThemeDialogState
+{
+    int listViewScroll;   // Scroll offset of the preset color list
+    int active;           // Selected preset color
+    int focus;            // Focused preset color (-1 for none)
+    bool showColorPanel;  // Custom color picker is open
+    bool showColorScroll; // Preset color list is shown
+    SimColor customColor; // Last color chosen in the custom picker
+} ThemeDialogState;
+
+// Persistent state of the design targets dialog; targets keep their values while unchecked
+typedef struct DesignDialogState
+{
+    bool useOvershoot; // Overshoot target is applied
+    bool useSettle;    // Settling time target is applied
+    bool useImpacts;   // Wall impact limit is applied
+    float overshoot;   // Overshoot target (fraction of the start displacement)
+    float settleTime;  // Settling time target (s)
+    float impacts;     // Most wall impacts (slider value, rounded)
+} DesignDialogState;
+
 // UI Function declarations
 void SetThemeColor(SimColor *themeColor);                          // Set theme color for UI elements
-void MakeVariableSliders(SpringMassSystemState *systemState);      // Draw parameter adjustment sliders
+bool MakeVariableSliders(SpringMassSystemState *systemState);      // Draw parameter sliders (returns true if changed)
+bool MakeVariableSlidersAt(SpringMassSystemState *systemState, float x,
+                           float y);                               // Same, with the first slider at (x, y)
 void ShowDamping(float c, float k, float m, SimColor *themeColor); // Display damping type based on parameters
-int ShowPauseDialog(void); // Show pause dialog (returns: 1=Resume, 2=Settings, 3=Exit, -1=None)
-int ShowSettings(void);    // Show settings dialog (returns: 1=Edit Params, 2=Change Theme, -1=None)
-void ShowThemeChange(SpringMassRenderState *state); // Show theme change dialog with color options
-void ShowParamEdit();
+void ShowDampingAt(float c, float k, float m, SimColor *themeColor, float x,
+                   float y); // Same, below sliders placed at (x, y)
+void ShowNoiseStats(double mean, double deviation, long samples,
+                    SimColor *themeColor); // Running displacement statistics while noise drives the mass
+int ShowPauseDialog(bool rewound); // Show pause dialog (returns: 1=Resume, 2=Settings, 3=Exit, -1=None)
+bool ShowTimelineSlider(float *time, float start,
+                        float end); // Session timeline under the pause dialog (returns true if moved)
+int ShowSettings(void);    // Show settings dialog (returns: 1=Edit Params, 2=Change Theme, 3=Design, -1=None)
+void InitThemeDialog(ThemeDialogState *dialog);   // Theme dialog defaults (preset list shown, nothing selected)
+void InitDesignDialog(DesignDialogState *dialog); // Design dialog defaults (overshoot and settling time on)
+void ShowThemeChange(SpringMassRenderState *state,
+                     ThemeDialogState *dialog); // Show theme change dialog with color options
+bool ShowParamEdit(SpringMassSystemState *state); // Force law dialog (returns true if a parameter changed)
+bool ShowDesignDialog(DesignDialogState *dialog, DesignTarget *target, const DesignResult *last,
+                      bool solving); // Design targets dialog (returns true with `target` set on Solve)
 bool EscKeyPressed(void);                      // Check if Escape key pressed
+bool LatchKeyPressed(void);                    // Check if L (cycle drag latch mode) pressed
+bool SensitivityKeyPressed(void);              // Check if S (cycle sensitivity channel) pressed
+bool PhaseKeyPressed(void);                    // Check if P (show/hide the phase plot) pressed
 bool ExitButtonClicked(void);                  // Check if exit button clicked
 void DestroyRenderer(void);                    // Destroy renderer and close window
 Vec2D GetMousePOS(void);                       // Get current mouse position
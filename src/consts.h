@@ -51,6 +51,18 @@ typedef struct SimColor
 #define UI_SLIDER_X (SCREEN_WIDTH - UI_SLIDER_WIDTH - 10) // X position of UI sliders
 #define UI_SLIDER_Y 20                                    // Y position of first UI slider
 
+// Parameter slider ranges (also the search box of the design solver)
+#define PARAM_K_MIN 0.0f   // Spring constant
+#define PARAM_K_MAX 500.0f
+#define PARAM_M_MIN 0.1f   // Mass
+#define PARAM_M_MAX 500.0f
+#define PARAM_C_MIN 0.0f   // Damping coefficient
+#define PARAM_C_MAX 50.0f
+#define PARAM_E_MIN 0.0f   // Coefficient of restitution
+#define PARAM_E_MAX 1.0f
+#define PARAM_NOISE_MAX 2000.0f // Noise intensity (force density)
+#define PARAM_TAU_MAX 1.0f      // Noise correlation time (seconds)
+
 #define SIM_LIGHTGRAY (SimColor){ 200, 200, 200, 255 } // Light Gray
 #define SIM_GRAY (SimColor){ 130, 130, 130, 255 }      // Gray
 #define SIM_DARKGRAY (SimColor){ 80, 80, 80, 255 }     // Dark Gray
@@ -73,6 +85,7 @@ typedef struct SimColor
 #define SIM_BROWN (SimColor){ 127, 106, 79, 255 }      // Brown
 #define SIM_DARKBROWN (SimColor){ 76, 63, 47, 255 }    // Dark Brown
 #define SIM_WHITE (SimColor){ 255, 255, 255, 255 }     // White
+#define SIM_RAYWHITE (SimColor){ 245, 245, 245, 255 }  // Ray White (raylib background white)
 #define SIM_BLACK (SimColor){ 0, 0, 0, 255 }           // Black
 #define SIM_BLANK (SimColor){ 0, 0, 0, 0 }             // Blank (Transparent)
 #define SIM_MAGENTA (SimColor){ 255, 0, 255, 255 }     // Magenta
@@ -0,0 +1,222 @@
+/********************************************************
+ * @file chain.c                                        *
+ * @brief Implementation of the multirate spring chain. *
+ * @author Gabe G.                                      *
+ * @date 10-19-2026                                     *
+ ********************************************************/
+
+#include "core/chain.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**********************************
+ *      Forward Declarations      *
+ **********************************/
+
+static SimReal MassLimit(const SpringChain *chain, int i); // Largest stable step of one mass
+static void GroupByClass(const unsigned char *classOf, int count, int *order,
+                         int *start); // Counting sort of indices by class
+
+/***********************************
+ *      External API Functions     *
+ ***********************************/
+
+bool ChainInit(SpringChain *chain, int count)
+{
+    memset(chain, 0, sizeof(*chain));
+    if (count <= 0)
+        return false;
+    chain->count = count;
+    SimReal **arrays[] = { &chain->x, &chain->v,       &chain->mass, &chain->time,
+                           &chain->impulse, &chain->k, &chain->c,    &chain->rest };
+    bool ok = true;
+    for (size_t a = 0; a < sizeof(arrays) / sizeof(arrays[0]); a++)
+        ok &= (*arrays[a] = calloc(count, sizeof(SimReal))) != NULL;
+    ok &= (chain->massClass = calloc(count, 1)) != NULL;
+    ok &= (chain->linkClass = calloc(count, 1)) != NULL;
+    ok &= (chain->massOrder = calloc(count, sizeof(int))) != NULL;
+    ok &= (chain->linkOrder = calloc(count, sizeof(int))) != NULL;
+    if (!ok)
+    {
+        ChainFree(chain);
+        return false;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        chain->mass[i] = 1;
+        chain->k[i] = 1;
+        chain->rest[i] = 1;
+        chain->x[i] = i + 1; // Every link at its rest length
+    }
+    chain->dirty = true;
+    return true;
+}
+
+void ChainFree(SpringChain *chain)
+{
+    free(chain->x);
+    free(chain->v);
+    free(chain->mass);
+    free(chain->time);
+    free(chain->impulse);
+    free(chain->k);
+    free(chain->c);
+    free(chain->rest);
+    free(chain->massClass);
+    free(chain->linkClass);
+    free(chain->massOrder);
+    free(chain->linkOrder);
+    memset(chain, 0, sizeof(*chain));
+}
+
+void ChainSetMass(SpringChain *chain, int i, SimReal mass)
+{
+    chain->mass[i] = mass;
+    chain->dirty = true;
+    chain->revision++;
+}
+
+void ChainSetLink(SpringChain *chain, int i, SimReal k, SimReal c, SimReal rest)
+{
+    chain->k[i] = k;
+    chain->c[i] = c;
+    chain->rest[i] = rest;
+    chain->dirty = true;
+    chain->revision++;
+}
+
+void ChainAssignClasses(SpringChain *chain, SimReal dt)
+{
+    int finest = 0;
+    for (int i = 0; i < chain->count; i++)
+    {
+        // Halve the step until it fits the mass's limit
+        SimReal limit = MassLimit(chain, i);
+        int r = 0;
+        while (r < CHAIN_MAX_CLASSES - 1 && dt / (SimReal)(1 << r) > limit)
+            r++;
+        chain->massClass[i] = (unsigned char)r;
+        finest = r > finest ? r : finest;
+    }
+    for (int i = 0; i < chain->count; i++)
+    {
+        if (chain->singleRate)
+            chain->massClass[i] = (unsigned char)finest;
+        int slower = i > 0 ? chain->massClass[i - 1] : 0;
+        chain->linkClass[i] = chain->massClass[i] > slower ? chain->massClass[i] : (unsigned char)slower;
+    }
+    GroupByClass(chain->massClass, chain->count, chain->massOrder, chain->massStart);
+    GroupByClass(chain->linkClass, chain->count, chain->linkOrder, chain->linkStart);
+    chain->classes = finest + 1;
+    chain->classDt = dt;
+    chain->dirty = false;
+}
+
+void ChainAdvance(SpringChain *chain, SimReal dt, int steps)
+{
+    if (chain->dirty || dt != chain->classDt)
+        ChainAssignClasses(chain, dt);
+
+    // Substep s of the finest class runs every class r whose step divides it: r >= finest - (trailing zeros of s).
+    // Only the active classes' index ranges are visited, so the work per step is sum(2^r) over masses and links.
+    const int finest = chain->classes - 1;
+    const int substeps = 1 << finest;
+    const SimReal h = dt / substeps;
+    SimReal *x = chain->x, *v = chain->v, *time = chain->time, *impulse = chain->impulse;
+    for (int step = 0; step < steps; step++)
+    {
+        for (int s = 0; s < substeps; s++)
+        {
+            int zeros = 0;
+            while (s != 0 && !((s >> zeros) & 1))
+                zeros++;
+            int coarsest = s == 0 ? 0 : finest - zeros;
+            SimReal t = s * h;
+
+            // Link impulses at time t, from both ends' positions along their drifts
+            for (int n = chain->linkStart[coarsest]; n < chain->linkStart[chain->classes]; n++)
+            {
+                int l = chain->linkOrder[n];
+                SimReal hl = dt / (SimReal)(1 << chain->linkClass[l]);
+                SimReal xb = x[l] + v[l] * (t - time[l]);
+                SimReal xa = l > 0 ? x[l - 1] + v[l - 1] * (t - time[l - 1]) : 0;
+                SimReal va = l > 0 ? v[l - 1] : 0;
+                SimReal force = chain->k[l] * (xb - xa - chain->rest[l]) + chain->c[l] * (v[l] - va); // Tension
+                impulse[l] -= force * hl;
+                if (l > 0)
+                    impulse[l - 1] += force * hl;
+            }
+            chain->linkUpdates += chain->linkStart[chain->classes] - chain->linkStart[coarsest];
+
+            // Masses due at t finish their drift and kick with everything collected since their last kick
+            for (int n = chain->massStart[coarsest]; n < chain->massStart[chain->classes]; n++)
+            {
+                int i = chain->massOrder[n];
+                x[i] += v[i] * (t - time[i]);
+                time[i] = t;
+                v[i] += impulse[i] / chain->mass[i];
+                impulse[i] = 0;
+            }
+            chain->massUpdates += chain->massStart[chain->classes] - chain->massStart[coarsest];
+        }
+
+        // Every mass drifts to the end of the step, which starts the next one
+        for (int i = 0; i < chain->count; i++)
+        {
+            x[i] += v[i] * (dt - time[i]);
+            time[i] = 0;
+        }
+    }
+}
+
+double ChainEnergy(const SpringChain *chain)
+{
+    double energy = 0;
+    for (int i = 0; i < chain->count; i++)
+    {
+        double stretch = chain->x[i] - (i > 0 ? chain->x[i - 1] : 0) - chain->rest[i];
+        energy += 0.5 * chain->mass[i] * chain->v[i] * chain->v[i] + 0.5 * chain->k[i] * stretch * stretch;
+    }
+    return energy;
+}
+
+/***************************************
+ *      Internal helper functions      *
+ ***************************************/
+
+// Semi-implicit Euler is stable for h < 2 / (omega + gamma): omega^2 bounds the mass-weighted stiffness matrix and
+// gamma the mass-weighted damping matrix, both by this mass's Gershgorin row
+static SimReal MassLimit(const SpringChain *chain, int i)
+{
+    double m = chain->mass[i];
+    double stiffness = chain->k[i] / m, damping = chain->c[i] / m;
+    if (i > 0)
+    {
+        double coupling = 1 / sqrt(m * chain->mass[i - 1]);
+        stiffness += chain->k[i] * coupling;
+        damping += chain->c[i] * coupling;
+    }
+    if (i + 1 < chain->count)
+    {
+        double coupling = 1 / sqrt(m * chain->mass[i + 1]);
+        stiffness += chain->k[i + 1] / m + chain->k[i + 1] * coupling;
+        damping += chain->c[i + 1] / m + chain->c[i + 1] * coupling;
+    }
+    double rate = sqrt(stiffness) + damping;
+    return rate > 0 ? (SimReal)(CHAIN_SAFETY * 2 / rate) : INFINITY;
+}
+
+static void GroupByClass(const unsigned char *classOf, int count, int *order, int *start)
+{
+    memset(start, 0, (CHAIN_MAX_CLASSES + 1) * sizeof(int));
+    for (int i = 0; i < count; i++)
+        start[classOf[i] + 1]++;
+    for (int r = 0; r < CHAIN_MAX_CLASSES; r++)
+        start[r + 1] += start[r];
+    int next[CHAIN_MAX_CLASSES];
+    memcpy(next, start, sizeof(next));
+    for (int i = 0; i < count; i++)
+        order[next[classOf[i]]++] = i;
+}
@@ -0,0 +1,62 @@
+/****************************************************************************************************************
+ * @file chain.h                                                                                                *
+ * @brief Spring chains stepped multirate: each mass at a power-of-two fraction of dt set by its own stiffness. *
+ * @author Gabe G.                                                                                              *
+ * @date 10-19-2026                                                                                             *
+ ****************************************************************************************************************/
+
+#ifndef CHAIN_H
+#define CHAIN_H
+
+#include "core/precision.h"
+#include <stdbool.h>
+
+#define CHAIN_MAX_CLASSES 16 // Rate classes; class r steps at dt / 2^r
+#define CHAIN_SAFETY 0.8     // Fraction of a mass's stability limit its class step may use
+
+// Masses in a line: link i joins mass i - 1 to mass i, and link 0 joins mass 0 to a wall at x = 0.
+//
+// A mass's stability limit comes from its row of the mass-weighted stiffness and damping matrices (Gershgorin), so
+// a stiff link makes the masses at both of its ends fast and leaves the rest alone. A link is evaluated at the rate
+// of its faster end; its impulse is applied to the fast end at once and collected by the slow end until its next
+// kick, so momentum crosses class boundaries exactly. Between kicks a mass drifts at its last velocity, and links
+// read a slow neighbour's position along that drift.
+typedef struct SpringChain
+{
+    int count;        // Masses (and links)
+    SimReal *x;       // Position of each mass at `time`
+    SimReal *v;       // Velocity of each mass
+    SimReal *mass;    // Mass of each mass
+    SimReal *time;    // When each mass last took its kick, from the start of the current step
+    SimReal *impulse; // Link impulse collected since the last kick
+    SimReal *k;       // Stiffness of each link
+    SimReal *c;       // Damping of each link (on the relative velocity)
+    SimReal *rest;    // Rest length of each link
+
+    unsigned char *massClass;                 // Rate class of each mass
+    unsigned char *linkClass;                 // Rate class of each link (its faster end)
+    int *massOrder;                           // Masses grouped by class, coarsest first
+    int *linkOrder;                           // Links grouped the same way
+    int massStart[CHAIN_MAX_CLASSES + 1];     // First entry of each class in massOrder
+    int linkStart[CHAIN_MAX_CLASSES + 1];     // First entry of each class in linkOrder
+    int classes;                              // Classes in use (the finest is classes - 1)
+    SimReal classDt;                          // Step the classes were assigned for
+    bool dirty;                               // A parameter changed since the classes were assigned
+    unsigned long revision;                   // Bumped on every parameter change (for derived data like modes)
+    bool singleRate;                          // Step everything at the finest class (reference runs)
+
+    long massUpdates; // Kicks taken so far (cost counter)
+    long linkUpdates; // Link forces evaluated so far
+} SpringChain;
+
+// Chain Function declarations
+bool ChainInit(SpringChain *chain, int count); // Allocate `count` unit masses on unit links at rest (false: no memory)
+void ChainFree(SpringChain *chain);            // Release the arrays
+void ChainSetMass(SpringChain *chain, int i, SimReal mass); // Change a mass (reassigns classes on the next step)
+void ChainSetLink(SpringChain *chain, int i, SimReal k, SimReal c,
+                  SimReal rest);                            // Change a link (reassigns classes on the next step)
+void ChainAssignClasses(SpringChain *chain, SimReal dt);    // Sort masses and links into rate classes for `dt`
+void ChainAdvance(SpringChain *chain, SimReal dt, int steps); // Advance `steps` steps of `dt`
+double ChainEnergy(const SpringChain *chain);               // Kinetic plus spring energy
+
+#endif
@@ -0,0 +1,251 @@
+/********************************************************************************************************
+ * @file contact.c                                                                                      *
+ * @brief Implementation of the body line: springs, sweep-and-prune broadphase and sequential impulses. *
+ * @author Gabe G.                                                                                      *
+ * @date 10-19-2026                                                                                     *
+ ********************************************************************************************************/
+
+#include "core/contact.h"
+#include "consts.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CONTACT_DEFAULT_GAP 10 // Gap between neighbouring default bodies at rest
+
+/**********************************
+ *      Forward Declarations      *
+ **********************************/
+
+static void Integrate(ContactLine *line, SimReal dt); // Springs and damping, semi-implicit Euler
+static void SortEdges(ContactLine *line);             // Restore the left-edge order by insertion sort
+static bool FindPairs(ContactLine *line);             // Sweep the order for touching or overlapping bodies
+static void SolveImpulses(ContactLine *line);         // Sequential restitution impulses until nothing approaches
+static void Separate(ContactLine *line);              // Push overlapping pairs apart by inverse mass
+static void ResolveWalls(ContactLine *line);          // Clamp and bounce bodies at the walls
+
+/***********************************
+ *      External API Functions     *
+ ***********************************/
+
+bool ContactInit(ContactLine *line, int count)
+{
+    memset(line, 0, sizeof(*line));
+    if (count <= 0)
+        return false;
+    line->count = count;
+    SimReal **arrays[] = { &line->x, &line->v, &line->invMass, &line->kOverM, &line->cOverM,
+                           &line->anchor, &line->half, &line->edge };
+    bool ok = true;
+    for (size_t a = 0; a < sizeof(arrays) / sizeof(arrays[0]); a++)
+        ok &= (*arrays[a] = calloc(count, sizeof(SimReal))) != NULL;
+    ok &= (line->order = calloc(count, sizeof(int))) != NULL;
+    if (!ok)
+    {
+        ContactFree(line);
+        return false;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        line->invMass[i] = 1;
+        line->half[i] = RECT_SIZE / 2;
+        line->anchor[i] = line->x[i] = (SimReal)i * (RECT_SIZE + CONTACT_DEFAULT_GAP);
+        line->order[i] = i;
+    }
+    line->restitution = 1;
+    line->xMin = -INFINITY;
+    line->xMax = INFINITY;
+    return true;
+}
+
+void ContactFree(ContactLine *line)
+{
+    free(line->x);
+    free(line->v);
+    free(line->invMass);
+    free(line->kOverM);
+    free(line->cOverM);
+    free(line->anchor);
+    free(line->half);
+    free(line->edge);
+    free(line->order);
+    free(line->pairs);
+    memset(line, 0, sizeof(*line));
+}
+
+void ContactSetBody(ContactLine *line, int i, SimReal mass, SimReal k, SimReal c, SimReal anchor, SimReal width)
+{
+    line->invMass[i] = mass > 0 ? 1 / mass : 0; // Non-positive mass: immovable
+    line->kOverM[i] = k * line->invMass[i];
+    line->cOverM[i] = c * line->invMass[i];
+    line->anchor[i] = anchor;
+    line->half[i] = width / 2;
+}
+
+bool ContactAdvance(ContactLine *line, SimReal dt, int steps)
+{
+    for (int step = 0; step < steps; step++)
+    {
+        Integrate(line, dt);
+        SortEdges(line);
+        if (!FindPairs(line))
+            return false;
+        SolveImpulses(line);
+        Separate(line);
+        ResolveWalls(line);
+    }
+    return true;
+}
+
+double ContactMomentum(const ContactLine *line)
+{
+    double momentum = 0;
+    for (int i = 0; i < line->count; i++)
+        if (line->invMass[i] > 0)
+            momentum += line->v[i] / line->invMass[i];
+    return momentum;
+}
+
+double ContactKineticEnergy(const ContactLine *line)
+{
+    double energy = 0;
+    for (int i = 0; i < line->count; i++)
+        if (line->invMass[i] > 0)
+            energy += 0.5 * line->v[i] * line->v[i] / line->invMass[i];
+    return energy;
+}
+
+/***************************************
+ *      Internal helper functions      *
+ ***************************************/
+
+static void Integrate(ContactLine *line, SimReal dt)
+{
+    SimReal *restrict x = line->x, *restrict v = line->v;
+    const SimReal *restrict k = line->kOverM, *restrict c = line->cOverM, *restrict anchor = line->anchor;
+    for (int i = 0; i < line->count; i++) // Independent bodies: the compiler vectorizes this
+    {
+        v[i] += (-k[i] * (x[i] - anchor[i]) - c[i] * v[i]) * dt;
+        x[i] += v[i] * dt;
+    }
+}
+
+static void SortEdges(ContactLine *line)
+{
+    int *order = line->order;
+    SimReal *edge = line->edge;
+    for (int n = 0; n < line->count; n++)
+        edge[n] = line->x[order[n]] - line->half[order[n]];
+
+    // The order from the last step is nearly right, so each body moves only a place or two
+    long swaps = 0;
+    for (int n = 1; n < line->count; n++)
+    {
+        SimReal key = edge[n];
+        if (edge[n - 1] <= key)
+            continue;
+        int body = order[n], m = n;
+        for (; m > 0 && edge[m - 1] > key; m--)
+        {
+            edge[m] = edge[m - 1];
+            order[m] = order[m - 1];
+        }
+        edge[m] = key;
+        order[m] = body;
+        swaps += n - m;
+    }
+    line->swaps += swaps;
+}
+
+static bool FindPairs(ContactLine *line)
+{
+    const int *order = line->order;
+    const SimReal *edge = line->edge;
+    line->pairCount = 0;
+    for (int n = 0; n < line->count; n++)
+    {
+        int a = order[n];
+        SimReal right = edge[n] + 2 * line->half[a] + (SimReal)CONTACT_SLOP; // Touching counts as contact
+        for (int m = n + 1; m < line->count && edge[m] < right; m++)
+        {
+            if (line->pairCount == line->pairCapacity)
+            {
+                int capacity = line->pairCapacity ? line->pairCapacity * 2 : line->count;
+                ContactPair *pairs = realloc(line->pairs, capacity * sizeof(ContactPair));
+                if (pairs == NULL)
+                    return false;
+                line->pairs = pairs;
+                line->pairCapacity = capacity;
+            }
+            int b = order[m];
+            bool aLeft = line->x[a] <= line->x[b];
+            line->pairs[line->pairCount++] = (ContactPair){ aLeft ? a : b, aLeft ? b : a };
+        }
+    }
+    line->contacts += line->pairCount;
+    return true;
+}
+
+static void SolveImpulses(ContactLine *line)
+{
+    SimReal *v = line->v;
+    const SimReal *invMass = line->invMass;
+    const SimReal bounce = 1 + line->restitution;
+    for (int iteration = 0; iteration < CONTACT_ITERATIONS; iteration++)
+    {
+        // Forward sweeps carry a chain pushed from the left along it in one pass, backward sweeps one from the right
+        bool forward = (iteration & 1) == 0, approaching = false;
+        for (int p = 0; p < line->pairCount; p++)
+        {
+            const ContactPair *pair = &line->pairs[forward ? p : line->pairCount - 1 - p];
+            int a = pair->left, b = pair->right;
+            SimReal approach = v[a] - v[b], weight = invMass[a] + invMass[b];
+            if (approach <= 0 || weight <= 0)
+                continue;
+            SimReal impulse = bounce * approach / weight;
+            v[a] -= impulse * invMass[a];
+            v[b] += impulse * invMass[b];
+            approaching = true;
+            line->impulses++;
+        }
+        if (!approaching)
+            break;
+    }
+}
+
+static void Separate(ContactLine *line)
+{
+    SimReal *x = line->x;
+    const SimReal *invMass = line->invMass, *half = line->half;
+    for (int p = 0; p < line->pairCount; p++)
+    {
+        int a = line->pairs[p].left, b = line->pairs[p].right;
+        SimReal overlap = (x[a] + half[a]) - (x[b] - half[b]) - (SimReal)CONTACT_SLOP;
+        SimReal weight = invMass[a] + invMass[b];
+        if (overlap <= 0 || weight <= 0)
+            continue;
+        x[a] -= overlap * invMass[a] / weight;
+        x[b] += overlap * invMass[b] / weight;
+    }
+}
+
+static void ResolveWalls(ContactLine *line)
+{
+    SimReal *x = line->x, *v = line->v;
+    for (int i = 0; i < line->count; i++)
+    {
+        if (x[i] - line->half[i] < line->xMin)
+        {
+            x[i] = line->xMin + line->half[i];
+            if (v[i] < 0)
+                v[i] = -line->restitution * v[i];
+        }
+        if (x[i] + line->half[i] > line->xMax)
+        {
+            x[i] = line->xMax - line->half[i];
+            if (v[i] > 0)
+                v[i] = -line->restitution * v[i];
+        }
+    }
+}
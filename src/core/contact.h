@@ -0,0 +1,65 @@
+/**********************************************************************************************
+ * @file contact.h                                                                            *
+ * @brief Many spring-mass bodies on the floor line, colliding with each other and the walls. *
+ * @author Gabe G.                                                                            *
+ * @date 10-19-2026                                                                           *
+ **********************************************************************************************/
+
+#ifndef CONTACT_H
+#define CONTACT_H
+
+#include "core/precision.h"
+#include <stdbool.h>
+
+#define CONTACT_ITERATIONS 8 // Sequential-impulse sweeps per step (alternating direction)
+#define CONTACT_SLOP 0.01    // Gap (px) still counted as touching, and overlap left in place (no jitter at rest)
+
+// One overlapping pair from the broadphase: `left` has the smaller center
+typedef struct ContactPair
+{
+    int left;
+    int right;
+} ContactPair;
+
+// Bodies, each on its own spring to an anchor, with a width like the mass rectangle. Positions are centers.
+//
+// Broadphase: `order` keeps the bodies sorted by left edge between steps. Bodies move little per step, so an
+// insertion sort restores it in O(N + swaps), and one sweep down the order finds every overlap in O(N + pairs).
+// Contacts are solved with sequential impulses: each approaching pair gets a restitution impulse from its current
+// approach speed, sweeping the pairs alternately left to right and right to left until nothing approaches. A
+// collision chain (Newton's cradle) hands its momentum along the chain within one sweep.
+typedef struct ContactLine
+{
+    int count;           // Bodies
+    SimReal *x;          // Center of each body
+    SimReal *v;          // Velocity
+    SimReal *invMass;    // 1/m (0: immovable)
+    SimReal *kOverM;     // Spring k/m (0: free body)
+    SimReal *cOverM;     // Damping c/m
+    SimReal *anchor;     // Spring rest position of each center
+    SimReal *half;       // Half the width
+    SimReal restitution; // Shared by body-body and body-wall impacts
+    SimReal xMin;        // Walls on the bodies' edges (-INFINITY / INFINITY: none)
+    SimReal xMax;
+
+    int *order;         // Bodies by left edge (kept from step to step)
+    SimReal *edge;      // Left edge of order[n], sorted with it
+    ContactPair *pairs; // Touching or overlapping pairs found this step
+    int pairCount;      // Pairs in use
+    int pairCapacity;   // Pairs allocated
+
+    long swaps;    // Insertion-sort moves so far (how unsorted the order got)
+    long contacts; // Pairs found so far
+    long impulses; // Impulses applied so far
+} ContactLine;
+
+// Contact Function declarations
+bool ContactInit(ContactLine *line, int count); // Allocate `count` free unit bodies, RECT_SIZE wide, spaced at rest
+void ContactFree(ContactLine *line);            // Release the arrays
+void ContactSetBody(ContactLine *line, int i, SimReal mass, SimReal k, SimReal c, SimReal anchor,
+                    SimReal width); // Set one body's mass, spring and width
+bool ContactAdvance(ContactLine *line, SimReal dt, int steps); // Step springs, then resolve contacts (false: no memory)
+double ContactMomentum(const ContactLine *line);              // Total momentum
+double ContactKineticEnergy(const ContactLine *line);         // Total kinetic energy
+
+#endif
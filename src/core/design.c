@@ -0,0 +1,562 @@
+/*******************************************************
+ * @file design.c                                      *
+ * @brief Implementation of the inverse design search. *
+ * @author Gabe G.                                     *
+ * @date 10-19-2026                                    *
+ *******************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "core/design.h"
+#include "consts.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DESIGN_PARAMS 4      // k, c, m, e
+#define DESIGN_UNMET 10.0f   // Score offset of a candidate missing a target (met candidates score below 4)
+#define DESIGN_NEIGHBOURS 81 // 3^DESIGN_PARAMS points around a refined candidate
+#define DESIGN_SOLVE_MEMO 8  // Whole solves remembered
+
+// One search coordinate. Mass is searched on a log scale: the response depends on k/m and c/sqrt(km), so a
+// linear grid would spend nearly every sample on heavy masses.
+typedef struct DesignAxis
+{
+    float lo;
+    float hi;
+    bool logScale;
+} DesignAxis;
+
+// A solve: the fixed part of the system, the targets and the derived evaluation settings
+typedef struct DesignProblem
+{
+    SpringMassSystemState base; // Law, its parameters and the walls (k, c, m and e are set per candidate)
+    DesignTarget target;
+    SimReal release;            // Release displacement from equilibrium
+    float horizon;              // Seconds simulated per candidate
+    float band;                 // Settling band (absolute displacement)
+    uint64_t fingerprint;       // Hash of everything but the targets that shapes a response
+} DesignProblem;
+
+// A candidate and its response
+typedef struct DesignEval
+{
+    float u[DESIGN_PARAMS]; // Search coordinates
+    float overshoot;
+    float settleTime;
+    int impacts;
+    bool pruned;            // Stopped early: the metrics are lower bounds
+    float score;            // Lower is better
+} DesignEval;
+
+// Complete (unpruned) evaluations are valid for any targets that share the fingerprint
+typedef struct DesignCacheEntry
+{
+    uint64_t fingerprint; // 0: empty
+    float u[DESIGN_PARAMS];
+    float overshoot;
+    float settleTime;
+    int impacts;
+} DesignCacheEntry;
+
+// A search thread's share of the candidates
+typedef struct DesignJob
+{
+    const DesignProblem *problem;
+    DesignEval **evals;
+    int count;
+} DesignJob;
+
+static const DesignAxis axes[DESIGN_PARAMS] = {
+    { PARAM_K_MIN, PARAM_K_MAX, false },
+    { PARAM_C_MIN, PARAM_C_MAX, false },
+    { PARAM_M_MIN, PARAM_M_MAX, true },
+    { PARAM_E_MIN, PARAM_E_MAX, false },
+};
+
+static DesignCacheEntry cache[DESIGN_CACHE_SIZE];
+static struct
+{
+    uint64_t key;
+    DesignResult result;
+} solveMemo[DESIGN_SOLVE_MEMO];
+static int solveMemoNext = 0;
+static pthread_mutex_t cacheLock = PTHREAD_MUTEX_INITIALIZER; // Guards `cache` and `solveMemo` across callers
+
+/**********************************
+ *      Forward Declarations      *
+ **********************************/
+
+static float AxisLo(int p);                                              // Lower bound of a search coordinate
+static float AxisHi(int p);                                              // Upper bound of a search coordinate
+static SimReal AxisValue(int p, float u);                                // Parameter value at a search coordinate
+static uint64_t HashBytes(uint64_t hash, const void *data, size_t size); // FNV-1a
+static void EvaluateAll(const DesignProblem *problem, DesignEval *evals, int count, const float *start,
+                        DesignResult *result); // Cache lookups, threaded simulation, scoring
+static void *EvaluateJob(void *job);           // Simulate a thread's share in batches
+static void EvaluateBatch(const DesignProblem *problem, DesignEval **evals,
+                          int count); // Step up to DESIGN_BATCH candidates together
+static float Score(const DesignProblem *problem, const DesignEval *eval,
+                   const float *start);                 // Rank a response (lower is better)
+static int CompareScores(const void *a, const void *b); // qsort order of DesignEval by score
+static DesignCacheEntry *CacheSlot(uint64_t fingerprint, const float *u,
+                                   bool insert); // Find a cached evaluation (or a slot for one)
+static int KeepBest(DesignEval *best, int bestCount, DesignEval *evals,
+                    int count); // Merge a round's evaluations into the top list
+static double DesignNow(void);  // Monotonic clock in seconds
+static bool SolveLocked(SpringMassSystemState *state, const DesignTarget *target,
+                        DesignResult *result); // DesignSolve with `cacheLock` held
+
+/***********************************
+ *      External API Functions     *
+ ***********************************/
+
+void DesignTargetInit(DesignTarget *target)
+{
+    target->overshoot = -1.0f;
+    target->settleTime = -1.0f;
+    target->maxImpacts = -1;
+    target->release = 0.0f;
+}
+
+bool DesignSolve(SpringMassSystemState *state, const DesignTarget *target, DesignResult *result)
+{
+    // The caches are process-wide, so concurrent solves take turns; each one already spreads over the cores
+    pthread_mutex_lock(&cacheLock);
+    bool met = SolveLocked(state, target, result);
+    pthread_mutex_unlock(&cacheLock);
+    return met;
+}
+
+bool DesignParseTarget(DesignTarget *target, const char *spec)
+{
+    DesignTargetInit(target);
+    char copy[256];
+    if (strlen(spec) >= sizeof(copy))
+        return false;
+    strcpy(copy, spec);
+
+    char *save = NULL;
+    for (char *item = strtok_r(copy, ",", &save); item != NULL; item = strtok_r(NULL, ",", &save))
+    {
+        char *equals = strchr(item, '=');
+        if (equals == NULL)
+            return false;
+        *equals = '\0';
+        char *end;
+        double value = strtod(equals + 1, &end);
+        if (end == equals + 1 || *end != '\0')
+            return false;
+        if (strcmp(item, "overshoot") == 0)
+            target->overshoot = (float)value;
+        else if (strcmp(item, "settle") == 0)
+            target->settleTime = (float)value;
+        else if (strcmp(item, "impacts") == 0)
+            target->maxImpacts = (int)value;
+        else if (strcmp(item, "release") == 0)
+            target->release = (float)value;
+        else
+            return false;
+    }
+    return true;
+}
+
+void DesignClearCache(void)
+{
+    pthread_mutex_lock(&cacheLock);
+    memset(cache, 0, sizeof(cache));
+    memset(solveMemo, 0, sizeof(solveMemo));
+    pthread_mutex_unlock(&cacheLock);
+}
+
+/***************************************
+ *      Internal helper functions      *
+ ***************************************/
+
+static float AxisLo(int p)
+{
+    return axes[p].logScale ? logf(axes[p].lo) : axes[p].lo;
+}
+
+static float AxisHi(int p)
+{
+    return axes[p].logScale ? logf(axes[p].hi) : axes[p].hi;
+}
+
+static SimReal AxisValue(int p, float u)
+{
+    return axes[p].logScale ? expf(u) : u;
+}
+
+static uint64_t HashBytes(uint64_t hash, const void *data, size_t size)
+{
+    const unsigned char *bytes = data;
+    for (size_t i = 0; i < size; i++)
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    return hash;
+}
+
+static void EvaluateAll(const DesignProblem *problem, DesignEval *evals, int count, const float *start,
+                        DesignResult *result)
+{
+    // Answer what earlier solves already simulated; only the rest is stepped
+    DesignEval **pending = malloc(count * sizeof(DesignEval *));
+    int pendingCount = 0;
+    for (int i = 0; i < count; i++)
+    {
+        const DesignCacheEntry *hit = CacheSlot(problem->fingerprint, evals[i].u, false);
+        if (hit != NULL)
+        {
+            evals[i].overshoot = hit->overshoot;
+            evals[i].settleTime = hit->settleTime;
+            evals[i].impacts = hit->impacts;
+            evals[i].pruned = false;
+            result->cached++;
+        }
+        else if (pending != NULL)
+            pending[pendingCount++] = &evals[i];
+        else
+            EvaluateBatch(problem, (DesignEval *[]){ &evals[i] }, 1); // No memory for the list: one at a time
+    }
+
+    // Split the rest across threads, each stepping its share DESIGN_BATCH candidates at a time
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN) > 0 ? sysconf(_SC_NPROCESSORS_ONLN) : 1;
+    int threads = cpus < DESIGN_THREADS ? (int)cpus : DESIGN_THREADS;
+    if (threads > (pendingCount + DESIGN_BATCH - 1) / DESIGN_BATCH)
+        threads = (pendingCount + DESIGN_BATCH - 1) / DESIGN_BATCH;
+    pthread_t workers[DESIGN_THREADS];
+    DesignJob jobs[DESIGN_THREADS];
+    bool started[DESIGN_THREADS] = { false };
+    for (int i = 0; i < threads; i++)
+    {
+        int from = pendingCount * i / threads;
+        int to = pendingCount * (i + 1) / threads;
+        jobs[i] = (DesignJob){ problem, pending + from, to - from };
+        if (i > 0)
+            started[i] = pthread_create(&workers[i], NULL, EvaluateJob, &jobs[i]) == 0;
+    }
+    if (threads > 0)
+        EvaluateJob(&jobs[0]);
+    for (int i = 1; i < threads; i++)
+    {
+        if (started[i])
+            pthread_join(workers[i], NULL);
+        else
+            EvaluateJob(&jobs[i]); // Thread creation failed: run the share here
+    }
+
+    for (int i = 0; i < pendingCount; i++)
+    {
+        result->evaluated++;
+        if (pending[i]->pruned)
+        {
+            result->pruned++;
+            continue;
+        }
+        DesignCacheEntry *slot = CacheSlot(problem->fingerprint, pending[i]->u, true);
+        *slot = (DesignCacheEntry){ problem->fingerprint,
+                                    { pending[i]->u[0], pending[i]->u[1], pending[i]->u[2], pending[i]->u[3] },
+                                    pending[i]->overshoot,
+                                    pending[i]->settleTime,
+                                    pending[i]->impacts };
+    }
+    free(pending);
+
+    for (int i = 0; i < count; i++)
+        evals[i].score = Score(problem, &evals[i], start);
+}
+
+static void *EvaluateJob(void *arg)
+{
+    DesignJob *job = arg;
+    for (int first = 0; first < job->count; first += DESIGN_BATCH)
+    {
+        int count = job->count - first < DESIGN_BATCH ? job->count - first : DESIGN_BATCH;
+        EvaluateBatch(job->problem, job->evals + first, count);
+    }
+    return NULL;
+}
+
+static void EvaluateBatch(const DesignProblem *problem, DesignEval **evals, int count)
+{
+    // Release every candidate from rest and step them together; each leaves the batch as soon as it breaks a
+    // target, so a hopeless candidate costs a few steps rather than the whole horizon
+    SpringMassSystemState states[DESIGN_BATCH];
+    SpringMassSystemState *active[DESIGN_BATCH];
+    int slot[DESIGN_BATCH];
+    float peak[DESIGN_BATCH], lastOutside[DESIGN_BATCH];
+    SimReal previousX[DESIGN_BATCH];
+    int impacts[DESIGN_BATCH];
+    const DesignTarget *target = &problem->target;
+    const SimReal release = problem->release;
+    const float scale = 1.0f / fabsf((float)release);
+    const float sign = release < 0 ? -1.0f : 1.0f;
+
+    for (int i = 0; i < count; i++)
+    {
+        SpringMassSystemState *state = &states[i];
+        *state = problem->base;
+        state->springConst = AxisValue(0, evals[i]->u[0]);
+        state->damping = AxisValue(1, evals[i]->u[1]);
+        state->mass = AxisValue(2, evals[i]->u[2]);
+        state->restitution = AxisValue(3, evals[i]->u[3]);
+        state->x = state->equilibrium + release;
+        state->velocity = 0;
+        SpringmassSelectKernel(state);
+        active[i] = state;
+        slot[i] = i;
+        peak[i] = 0.0f;
+        lastOutside[i] = 0.0f;
+        previousX[i] = state->x;
+        impacts[i] = 0;
+    }
+
+    int activeCount = count;
+    int steps = (int)(problem->horizon / DESIGN_DT + 0.5f);
+    for (int step = 1; step <= steps && activeCount > 0; step++)
+    {
+        SpringmassAdvanceBatch(active, activeCount, DESIGN_DT, 1);
+        float time = step * DESIGN_DT;
+        for (int j = activeCount - 1; j >= 0; j--)
+        {
+            int i = slot[j];
+            const SpringMassSystemState *state = active[j];
+            float displacement = (float)(state->x - state->equilibrium);
+
+            // Overshoot is the swing to the far side of equilibrium; an impact is arriving at a wall
+            float swing = -sign * displacement * scale;
+            if (swing > peak[i])
+                peak[i] = swing;
+            if ((state->x <= state->xMin && previousX[i] > state->xMin) ||
+                (state->x >= state->xMax && previousX[i] < state->xMax))
+                impacts[i]++;
+            previousX[i] = state->x;
+            bool outside = fabsf(displacement) > problem->band;
+            if (outside)
+                lastOutside[i] = time;
+
+            bool pruned = (target->overshoot >= 0 && peak[i] > target->overshoot) ||
+                          (target->maxImpacts >= 0 && impacts[i] > target->maxImpacts) ||
+                          (target->settleTime > 0 && time > target->settleTime && outside);
+            if (!pruned && step < steps)
+                continue;
+
+            DesignEval *eval = evals[i];
+            eval->overshoot = peak[i];
+            eval->settleTime = lastOutside[i] + DESIGN_DT;
+            eval->impacts = impacts[i];
+            eval->pruned = pruned;
+            active[j] = active[activeCount - 1];
+            slot[j] = slot[activeCount - 1];
+            activeCount--;
+        }
+    }
+}
+
+static float Score(const DesignProblem *problem, const DesignEval *eval, const float *start)
+{
+    // Candidates that miss a target rank by how far they miss; the rest by how little they change the sliders
+    const DesignTarget *target = &problem->target;
+    float violation = 0.0f;
+    if (target->overshoot >= 0)
+        violation += fmaxf(eval->overshoot - target->overshoot, 0.0f) / fmaxf(target->overshoot, 0.05f);
+    if (target->settleTime > 0)
+        violation += fmaxf(eval->settleTime - target->settleTime, 0.0f) / target->settleTime;
+    if (target->maxImpacts >= 0 && eval->impacts > target->maxImpacts)
+        violation += (float)(eval->impacts - target->maxImpacts);
+    if (violation > 0.0f)
+        return DESIGN_UNMET + violation;
+
+    float distance = 0.0f;
+    for (int p = 0; p < DESIGN_PARAMS; p++)
+    {
+        float d = (eval->u[p] - start[p]) / (AxisHi(p) - AxisLo(p));
+        distance += d * d;
+    }
+    return distance;
+}
+
+static int CompareScores(const void *a, const void *b)
+{
+    float sa = ((const DesignEval *)a)->score;
+    float sb = ((const DesignEval *)b)->score;
+    return (sa > sb) - (sa < sb);
+}
+
+static DesignCacheEntry *CacheSlot(uint64_t fingerprint, const float *u, bool insert)
+{
+    // Open addressing over a short probe run; when the run is full, inserts replace its first entry
+    uint64_t hash = HashBytes(fingerprint, u, DESIGN_PARAMS * sizeof(float));
+    for (int probe = 0; probe < 8; probe++)
+    {
+        DesignCacheEntry *entry = &cache[(hash + probe) % DESIGN_CACHE_SIZE];
+        if (entry->fingerprint == fingerprint && memcmp(entry->u, u, sizeof(entry->u)) == 0)
+            return entry;
+        if (entry->fingerprint == 0)
+            return insert ? entry : NULL;
+    }
+    return insert ? &cache[hash % DESIGN_CACHE_SIZE] : NULL;
+}
+
+static int KeepBest(DesignEval *best, int bestCount, DesignEval *evals, int count)
+{
+    qsort(evals, count, sizeof(DesignEval), CompareScores);
+    DesignEval merged[2 * DESIGN_KEEP];
+    int mergedCount = 0;
+    for (int i = 0; i < bestCount; i++)
+        merged[mergedCount++] = best[i];
+
+    // The new top entries, skipping repeats (neighbourhoods overlap and clamping folds points together)
+    for (int i = 0, taken = 0; i < count && taken < DESIGN_KEEP; i++)
+    {
+        bool repeat = false;
+        for (int j = 0; j < mergedCount && !repeat; j++)
+            repeat = memcmp(merged[j].u, evals[i].u, sizeof(evals[i].u)) == 0;
+        if (repeat)
+            continue;
+        merged[mergedCount++] = evals[i];
+        taken++;
+    }
+    qsort(merged, mergedCount, sizeof(DesignEval), CompareScores);
+    int kept = mergedCount < DESIGN_KEEP ? mergedCount : DESIGN_KEEP;
+    memcpy(best, merged, kept * sizeof(DesignEval));
+    return kept;
+}
+
+static double DesignNow(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static bool SolveLocked(SpringMassSystemState *state, const DesignTarget *target, DesignResult *result)
+{
+    double start = DesignNow();
+    memset(result, 0, sizeof(*result));
+    if (target->overshoot < 0 && target->settleTime <= 0 && target->maxImpacts < 0)
+        return false; // Nothing to design for
+
+    DesignProblem problem;
+    problem.base = *state;
+    problem.base.noiseIntensity = 0;       // Targets describe the deterministic response
+    SpringmassSelectKernel(&problem.base); // Resolves the default force table before threads copy the state
+    problem.target = *target;
+    SimReal far = state->xMax - state->equilibrium;
+    if (state->equilibrium - state->xMin > far)
+        far = -(state->equilibrium - state->xMin);
+    problem.release = target->release != 0.0f ? target->release
+                      : isinf(far)            ? 150.0f
+                                              : DESIGN_RELEASE_FRACTION * far;
+    problem.band = DESIGN_SETTLE_BAND * fabsf((float)problem.release);
+    problem.horizon = DESIGN_HORIZON;
+    if (target->settleTime > 0)
+        problem.horizon = fminf(fmaxf(2 * target->settleTime, target->settleTime + 1.0f), DESIGN_MAX_SECONDS);
+
+    // Everything that shapes a response except k, c, m and e
+    const SpringMassSystemState *b = &problem.base;
+    uint64_t hash = 14695981039346656037ull;
+    SimReal shape[] = { b->cubicConst, b->stopGap,  b->stopConst, b->staticFriction, b->kineticFriction,
+                        b->dragCoeff,  b->xMin - b->equilibrium, b->xMax - b->equilibrium, problem.release };
+    hash = HashBytes(hash, &b->law, sizeof(b->law));
+    hash = HashBytes(hash, &b->table, sizeof(b->table));
+    hash = HashBytes(hash, shape, sizeof(shape));
+    hash = HashBytes(hash, &problem.horizon, sizeof(problem.horizon));
+    problem.fingerprint = hash ? hash : 1;
+
+    // The same question from the same starting parameters has the same answer
+    float startU[DESIGN_PARAMS];
+    SimReal current[DESIGN_PARAMS] = { state->springConst, state->damping, state->mass, state->restitution };
+    for (int p = 0; p < DESIGN_PARAMS; p++)
+    {
+        float value = axes[p].logScale ? logf(fmaxf((float)current[p], axes[p].lo)) : (float)current[p];
+        startU[p] = fminf(fmaxf(value, AxisLo(p)), AxisHi(p));
+    }
+    uint64_t key = HashBytes(problem.fingerprint, target, sizeof(*target));
+    key = HashBytes(key, startU, sizeof(startU));
+    for (int i = 0; i < DESIGN_SOLVE_MEMO; i++)
+    {
+        if (solveMemo[i].key != key)
+            continue;
+        *result = solveMemo[i].result;
+        result->evaluated = 0;
+        result->pruned = 0;
+        result->cached = 1;
+        result->seconds = DesignNow() - start;
+        state->springConst = result->springConst;
+        state->damping = result->damping;
+        state->mass = result->mass;
+        state->restitution = result->restitution;
+        SpringmassSelectKernel(state);
+        return result->met;
+    }
+
+    // Coarse grid over the whole slider box
+    int coarse = 1;
+    for (int p = 0; p < DESIGN_PARAMS; p++)
+        coarse *= DESIGN_GRID;
+    int capacity = coarse > DESIGN_KEEP * DESIGN_NEIGHBOURS ? coarse : DESIGN_KEEP * DESIGN_NEIGHBOURS;
+    DesignEval *evals = malloc(capacity * sizeof(DesignEval));
+    if (evals == NULL)
+        return false;
+    for (int i = 0; i < coarse; i++)
+    {
+        for (int p = 0, rest = i; p < DESIGN_PARAMS; p++, rest /= DESIGN_GRID)
+            evals[i].u[p] = AxisLo(p) + (AxisHi(p) - AxisLo(p)) * (rest % DESIGN_GRID) / (DESIGN_GRID - 1);
+    }
+    EvaluateAll(&problem, evals, coarse, startU, result);
+    DesignEval best[DESIGN_KEEP];
+    int bestCount = KeepBest(best, 0, evals, coarse);
+
+    // Refine: a 3^4 neighbourhood around each of the best candidates, halving the spacing every round
+    float spacing[DESIGN_PARAMS];
+    for (int p = 0; p < DESIGN_PARAMS; p++)
+        spacing[p] = (AxisHi(p) - AxisLo(p)) / (DESIGN_GRID - 1);
+    for (int round = 0; round < DESIGN_ROUNDS; round++)
+    {
+        for (int p = 0; p < DESIGN_PARAMS; p++)
+            spacing[p] *= 0.5f;
+        int count = 0;
+        for (int c = 0; c < bestCount; c++)
+        {
+            for (int n = 0; n < DESIGN_NEIGHBOURS; n++)
+            {
+                DesignEval *eval = &evals[count++];
+                for (int p = 0, rest = n; p < DESIGN_PARAMS; p++, rest /= 3)
+                {
+                    float u = best[c].u[p] + (rest % 3 - 1) * spacing[p];
+                    eval->u[p] = fminf(fmaxf(u, AxisLo(p)), AxisHi(p));
+                }
+            }
+        }
+        EvaluateAll(&problem, evals, count, startU, result);
+        bestCount = KeepBest(best, bestCount, evals, count);
+    }
+    free(evals);
+
+    // Apply the winner
+    const DesignEval *winner = &best[0];
+    result->springConst = AxisValue(0, winner->u[0]);
+    result->damping = AxisValue(1, winner->u[1]);
+    result->mass = AxisValue(2, winner->u[2]);
+    result->restitution = AxisValue(3, winner->u[3]);
+    result->overshoot = winner->overshoot;
+    result->settleTime = winner->settleTime;
+    result->impacts = winner->impacts;
+    result->met = winner->score < DESIGN_UNMET;
+    state->springConst = result->springConst;
+    state->damping = result->damping;
+    state->mass = result->mass;
+    state->restitution = result->restitution;
+    SpringmassSelectKernel(state);
+    result->seconds = DesignNow() - start;
+
+    solveMemo[solveMemoNext].key = key;
+    solveMemo[solveMemoNext].result = *result;
+    solveMemoNext = (solveMemoNext + 1) % DESIGN_SOLVE_MEMO;
+    return result->met;
+}
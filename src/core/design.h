@@ -0,0 +1,60 @@
+/************************************************************************************************************
+ * @file design.h                                                                                           *
+ * @brief Inverse design: search k, c, m and e for a response that meets overshoot/settling/impact targets. *
+ * @author Gabe G.                                                                                          *
+ * @date 10-19-2026                                                                                         *
+ ************************************************************************************************************/
+
+#ifndef DESIGN_H
+#define DESIGN_H
+
+#include "core/physics.h"
+#include <stdbool.h>
+
+#define DESIGN_GRID 6                // Coarse samples per parameter
+#define DESIGN_ROUNDS 4              // Refinement rounds, each halving the spacing
+#define DESIGN_KEEP 4                // Best candidates refined in each round
+#define DESIGN_BATCH 32              // Candidates stepped together through the batch kernels
+#define DESIGN_THREADS 4             // Upper bound on search threads
+#define DESIGN_DT 0.001f             // Step of the evaluated response (seconds)
+#define DESIGN_HORIZON 5.0f          // Response length when no settling target sets one (seconds)
+#define DESIGN_MAX_SECONDS 20.0f     // Longest response evaluated
+#define DESIGN_SETTLE_BAND 0.02f     // Settled: within this fraction of the release displacement
+#define DESIGN_CACHE_SIZE 8192       // Evaluated candidates remembered between solves
+#define DESIGN_RELEASE_FRACTION 0.8f // Default release: this fraction of the way to the far wall
+
+// What the response to a release from rest must satisfy. A negative target is not constrained.
+typedef struct DesignTarget
+{
+    float overshoot;  // Largest swing past equilibrium, as a fraction of the release displacement
+    float settleTime; // Time after which the mass stays inside the settling band (seconds)
+    int maxImpacts;   // Most wall impacts allowed within the evaluated response
+    float release;    // Release displacement from equilibrium (0: toward the far wall, see above)
+} DesignTarget;
+
+// Outcome of a solve; the parameters are also written into the solved system
+typedef struct DesignResult
+{
+    SimReal springConst; // Chosen k
+    SimReal damping;     // Chosen c
+    SimReal mass;        // Chosen m
+    SimReal restitution; // Chosen e
+    float overshoot;     // Response of the chosen parameters
+    float settleTime;
+    int impacts;
+    bool met;            // Every target is met
+    int evaluated;       // Candidates simulated by this solve
+    int pruned;          // Of those, stopped early once out of spec
+    int cached;          // Candidates answered from the cache
+    double seconds;      // Wall time of the solve
+} DesignResult;
+
+// Design Function declarations (thread-safe: solves share the cache and take turns on `cacheLock`)
+void DesignTargetInit(DesignTarget *target); // All targets unconstrained, default release
+bool DesignSolve(SpringMassSystemState *state, const DesignTarget *target,
+                 DesignResult *result);      // Search and apply the best parameters (false: none met every target)
+bool DesignParseTarget(DesignTarget *target,
+                       const char *spec);    // "overshoot=0.1,settle=2,impacts=3[,release=150]"
+void DesignClearCache(void);                 // Forget every cached evaluation
+
+#endif
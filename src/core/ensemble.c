@@ -0,0 +1,240 @@
+/***************************************************************************************
+ * @file ensemble.c                                                                    *
+ * @brief Implementation of the noise-driven ensembles and their streaming statistics. *
+ * @author Gabe G.                                                                     *
+ * @date 10-19-2026                                                                    *
+ ***************************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "core/ensemble.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Reduction of one block of members. A block always holds the same members and folds their samples in the
+// same order, so it comes out identical whichever thread ran it.
+typedef struct EnsembleBlock
+{
+    Welford position;
+    Welford velocity;
+    WelfordCov lagged[ENSEMBLE_MAX_LAGS + 1]; // Pairs (d[t - k], d[t]) for each lag k
+} EnsembleBlock;
+
+// A thread's share of the blocks
+typedef struct EnsembleJob
+{
+    const SpringMassSystemState *proto;
+    const EnsembleConfig *config;
+    EnsembleBlock *blocks;
+    int first; // First block
+    int count; // Blocks in the share
+    bool ok;   // The share's scratch memory was available
+} EnsembleJob;
+
+/**********************************
+ *      Forward Declarations      *
+ **********************************/
+
+static void *EnsembleJobRun(void *job); // Run a thread's share of the blocks
+static void RunBlock(const SpringMassSystemState *proto, const EnsembleConfig *config, int b, EnsembleBlock *block,
+                     double *history); // Simulate and reduce one block of members
+static double EnsembleNow(void);       // Monotonic clock in seconds
+
+/***********************************
+ *      External API Functions     *
+ ***********************************/
+
+void WelfordInit(Welford *w)
+{
+    memset(w, 0, sizeof(*w));
+}
+
+void WelfordAdd(Welford *w, double x)
+{
+    w->count += 1;
+    double delta = x - w->mean;
+    w->mean += delta / w->count;
+    w->m2 += delta * (x - w->mean);
+}
+
+void WelfordMerge(Welford *into, const Welford *from)
+{
+    if (from->count == 0)
+        return;
+    double count = into->count + from->count;
+    double delta = from->mean - into->mean;
+    into->mean += delta * (from->count / count);
+    into->m2 += from->m2 + delta * delta * (into->count * from->count / count);
+    into->count = count;
+}
+
+double WelfordVariance(const Welford *w)
+{
+    return w->count > 1 ? w->m2 / (w->count - 1) : 0.0;
+}
+
+void WelfordCovAdd(WelfordCov *w, double a, double b)
+{
+    w->count += 1;
+    double deltaA = a - w->meanA;
+    w->meanA += deltaA / w->count;
+    w->meanB += (b - w->meanB) / w->count;
+    w->comoment += deltaA * (b - w->meanB);
+}
+
+void WelfordCovMerge(WelfordCov *into, const WelfordCov *from)
+{
+    if (from->count == 0)
+        return;
+    double count = into->count + from->count;
+    double deltaA = from->meanA - into->meanA;
+    double deltaB = from->meanB - into->meanB;
+    double weight = into->count * from->count / count;
+    into->meanA += deltaA * (from->count / count);
+    into->meanB += deltaB * (from->count / count);
+    into->comoment += from->comoment + deltaA * deltaB * weight;
+    into->count = count;
+}
+
+void EnsembleConfigInit(EnsembleConfig *config)
+{
+    config->members = 256;
+    config->burnIn = 5000;
+    config->samples = 2000;
+    config->sampleEvery = 10;
+    config->lags = 64;
+    config->threads = 0;
+    config->dt = 0.001f;
+}
+
+bool EnsembleRun(const SpringMassSystemState *proto, const EnsembleConfig *config, EnsembleStats *stats)
+{
+    double start = EnsembleNow();
+    memset(stats, 0, sizeof(*stats));
+    if (config->members <= 0 || config->samples <= 0 || config->sampleEvery <= 0 || config->burnIn < 0 ||
+        config->lags < 0 || config->lags > ENSEMBLE_MAX_LAGS || !(config->dt > 0))
+        return false;
+
+    SpringMassSystemState base = *proto;
+    SpringmassSelectKernel(&base); // Resolves the default force table before threads copy the state
+    int blockCount = (config->members + ENSEMBLE_BLOCK - 1) / ENSEMBLE_BLOCK;
+    EnsembleBlock *blocks = malloc(blockCount * sizeof(EnsembleBlock));
+    if (blocks == NULL)
+        return false;
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN) > 0 ? sysconf(_SC_NPROCESSORS_ONLN) : 1;
+    int threads = config->threads > 0 ? config->threads : (int)cpus;
+    if (threads > ENSEMBLE_THREADS)
+        threads = ENSEMBLE_THREADS;
+    if (threads > blockCount)
+        threads = blockCount;
+
+    pthread_t workers[ENSEMBLE_THREADS];
+    EnsembleJob jobs[ENSEMBLE_THREADS];
+    bool started[ENSEMBLE_THREADS] = { false };
+    for (int i = 0; i < threads; i++)
+    {
+        int from = blockCount * i / threads;
+        int to = blockCount * (i + 1) / threads;
+        jobs[i] = (EnsembleJob){ &base, config, blocks, from, to - from, false };
+        if (i > 0)
+            started[i] = pthread_create(&workers[i], NULL, EnsembleJobRun, &jobs[i]) == 0;
+    }
+    EnsembleJobRun(&jobs[0]);
+    bool ok = jobs[0].ok;
+    for (int i = 1; i < threads; i++)
+    {
+        if (started[i])
+            pthread_join(workers[i], NULL);
+        else
+            EnsembleJobRun(&jobs[i]); // Thread creation failed: run the share here
+        ok &= jobs[i].ok;
+    }
+
+    // Blocks merge in member order, so the result is the same for any number of threads
+    WelfordCov lagged[ENSEMBLE_MAX_LAGS + 1];
+    memset(lagged, 0, sizeof(lagged));
+    for (int b = 0; ok && b < blockCount; b++)
+    {
+        WelfordMerge(&stats->position, &blocks[b].position);
+        WelfordMerge(&stats->velocity, &blocks[b].velocity);
+        for (int k = 0; k <= config->lags; k++)
+            WelfordCovMerge(&lagged[k], &blocks[b].lagged[k]);
+    }
+    free(blocks);
+    if (!ok)
+        return false;
+
+    double variance = lagged[0].count > 0 ? lagged[0].comoment / lagged[0].count : 0.0;
+    for (int k = 0; k <= config->lags; k++)
+        stats->autocorrelation[k] =
+            (variance > 0 && lagged[k].count > 0) ? lagged[k].comoment / lagged[k].count / variance : 0.0;
+    stats->lags = config->lags;
+    stats->threads = threads;
+    stats->seconds = EnsembleNow() - start;
+    return true;
+}
+
+/***************************************
+ *      Internal helper functions      *
+ ***************************************/
+
+static void *EnsembleJobRun(void *arg)
+{
+    EnsembleJob *job = arg;
+    double *history = malloc(ENSEMBLE_BLOCK * (job->config->lags + 1) * sizeof(double));
+    job->ok = history != NULL;
+    for (int b = job->first; job->ok && b < job->first + job->count; b++)
+        RunBlock(job->proto, job->config, b, &job->blocks[b], history);
+    free(history);
+    return NULL;
+}
+
+static void RunBlock(const SpringMassSystemState *proto, const EnsembleConfig *config, int b, EnsembleBlock *block,
+                     double *history)
+{
+    SpringMassSystemState states[ENSEMBLE_BLOCK];
+    SpringMassSystemState *stepping[ENSEMBLE_BLOCK];
+    int first = b * ENSEMBLE_BLOCK;
+    int count = config->members - first < ENSEMBLE_BLOCK ? config->members - first : ENSEMBLE_BLOCK;
+    for (int i = 0; i < count; i++)
+    {
+        states[i] = *proto;
+        states[i].noiseStream = (uint64_t)(first + i); // Each member its own noise, whatever block size or thread
+        states[i].noiseStep = 0;
+        states[i].noiseForce = 0;
+        stepping[i] = &states[i];
+    }
+    memset(block, 0, sizeof(*block));
+
+    // Each member keeps its last `lags` displacements in a ring for the lagged pairs
+    const int lags = config->lags;
+    const int ring = lags + 1;
+    if (config->burnIn > 0)
+        SpringmassAdvanceBatch(stepping, count, config->dt, config->burnIn);
+    for (int t = 0; t < config->samples; t++)
+    {
+        SpringmassAdvanceBatch(stepping, count, config->dt, config->sampleEvery);
+        int maxLag = t < lags ? t : lags;
+        for (int i = 0; i < count; i++)
+        {
+            double d = states[i].x - states[i].equilibrium;
+            double *past = history + i * ring;
+            WelfordAdd(&block->position, d);
+            WelfordAdd(&block->velocity, states[i].velocity);
+            past[t % ring] = d;
+            for (int k = 0; k <= maxLag; k++)
+                WelfordCovAdd(&block->lagged[k], past[(t - k) % ring], d);
+        }
+    }
+}
+
+static double EnsembleNow(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
@@ -0,0 +1,67 @@
+/*******************************************************************************************
+ * @file ensemble.h                                                                        *
+ * @brief Noise-driven ensembles reduced on the fly to mean, variance and autocorrelation. *
+ * @author Gabe G.                                                                         *
+ * @date 10-19-2026                                                                        *
+ *******************************************************************************************/
+
+#ifndef ENSEMBLE_H
+#define ENSEMBLE_H
+
+#include "core/physics.h"
+#include <stdbool.h>
+
+#define ENSEMBLE_MAX_LAGS 256 // Longest autocorrelation lag (in samples)
+#define ENSEMBLE_BLOCK 64     // Members per work unit; blocks are reduced in member order
+#define ENSEMBLE_THREADS 8    // Upper bound on worker threads
+
+// Running mean and variance (Welford); two accumulators merge exactly as if one had seen both streams (Chan)
+typedef struct Welford
+{
+    double count;
+    double mean;
+    double m2; // Sum of squared deviations from the mean
+} Welford;
+
+// Running co-moment of paired samples
+typedef struct WelfordCov
+{
+    double count;
+    double meanA;
+    double meanB;
+    double comoment; // Sum of (a - meanA)(b - meanB)
+} WelfordCov;
+
+typedef struct EnsembleConfig
+{
+    int members;     // Independent realisations; member i draws noise stream i of the prototype's seed
+    int burnIn;      // Steps discarded before sampling (lets the start-up transient decay)
+    int samples;     // Samples taken per member after the burn-in
+    int sampleEvery; // Steps between samples
+    int lags;        // Autocorrelation lags (at most ENSEMBLE_MAX_LAGS)
+    int threads;     // Worker threads (0: one per CPU); results do not depend on it
+    SimReal dt;      // Step (seconds)
+} EnsembleConfig;
+
+typedef struct EnsembleStats
+{
+    Welford position; // Displacement from equilibrium over every sample of every member
+    Welford velocity;
+    double autocorrelation[ENSEMBLE_MAX_LAGS + 1]; // Displacement autocovariance at each lag over the variance
+    int lags;                                      // Lags filled in
+    int threads;                                   // Threads used
+    double seconds;                                // Wall time of the run
+} EnsembleStats;
+
+// Ensemble Function declarations
+void WelfordInit(Welford *w);                                   // Empty accumulator
+void WelfordAdd(Welford *w, double x);                          // Add one sample
+void WelfordMerge(Welford *into, const Welford *from);          // Combine two accumulators
+double WelfordVariance(const Welford *w);                       // Sample variance (0 below two samples)
+void WelfordCovAdd(WelfordCov *w, double a, double b);          // Add one pair
+void WelfordCovMerge(WelfordCov *into, const WelfordCov *from); // Combine two co-moment accumulators
+void EnsembleConfigInit(EnsembleConfig *config);                // Defaults: 256 members, 20 s sampled after 5 s
+bool EnsembleRun(const SpringMassSystemState *proto, const EnsembleConfig *config,
+                 EnsembleStats *stats);                         // Simulate and reduce (false: bad config or no memory)
+
+#endif
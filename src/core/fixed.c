@@ -0,0 +1,294 @@
+/****************************************************************
+ * @file fixed.c                                                *
+ * @brief Implementation of the Q32.32 fixed-point step kernel. *
+ * @author Gabe G.                                              *
+ * @date 10-19-2026                                             *
+ ****************************************************************/
+
+#include "core/fixed.h"
+#include <math.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#define FIXED_LOW_MASK 0xFFFFFFFFull // Fraction half of a Q32.32 value
+#define FIXED_HALF (1ull << 31)      // Rounding term of a product
+
+// GCC/Clang vector extensions: one 64-bit integer lane per system. Only AVX2 has the width to pay for the 32-bit
+// partial products; two SSE2 lanes are no faster than the scalar 128-bit multiply, so those builds step one by one.
+#if defined(__GNUC__) && defined(__AVX2__)
+#define FIXED_VECTOR 1
+#define FIXED_VECTOR_BYTES 32
+#define FIXED_LANES (FIXED_VECTOR_BYTES / (int)sizeof(SimFixed))
+typedef int64_t FixedVec __attribute__((vector_size(FIXED_VECTOR_BYTES)));
+typedef uint64_t FixedUVec __attribute__((vector_size(FIXED_VECTOR_BYTES)));
+#else
+#define FIXED_LANES 1
+#endif
+
+/**********************************
+ *      Forward Declarations      *
+ **********************************/
+
+static inline void FixedStep(FixedSystem *s);                    // One step and wall check
+#if defined(FIXED_VECTOR)
+static inline FixedUVec Mul32(FixedUVec a, FixedUVec b);         // Low 32 bits times low 32 bits, per lane
+static inline FixedVec FixedMulVec(FixedVec a, FixedVec b);      // FixedMul lane by lane
+static inline bool AnyLane(FixedVec mask);                       // Some lane of a comparison mask is set
+static void FixedAdvanceLanes(FixedSystem **systems, int steps); // FIXED_LANES systems through the vector step
+#endif
+static uint64_t DigestValue(uint64_t hash, SimFixed value);      // FNV-1a over the little-endian bytes
+
+/***********************************
+ *      External API Functions     *
+ ***********************************/
+
+SimFixed FixedFromReal(double value)
+{
+    if (isnan(value))
+        return 0;
+    double scaled = ldexp(value, FIXED_FRAC_BITS); // Exact: a power-of-two scale
+    if (scaled >= 0x1.0p63)
+        return INT64_MAX;
+    if (scaled <= -0x1.0p63)
+        return INT64_MIN;
+    return (SimFixed)llround(scaled);
+}
+
+double FixedToReal(SimFixed value)
+{
+    return ldexp((double)value, -FIXED_FRAC_BITS);
+}
+
+// (a * b + 2^31) >> 32, wrapped to 64 bits. Every path below computes exactly this integer: a 128-bit product where
+// the compiler has one, otherwise four 32 x 32 -> 64 bit partial products in wrapping uint64 arithmetic.
+SimFixed FixedMul(SimFixed a, SimFixed b)
+{
+#if defined(__SIZEOF_INT128__)
+    return (SimFixed)(uint64_t)(((__int128)a * b + FIXED_HALF) >> FIXED_FRAC_BITS);
+#else
+    int64_t aHigh = a >> FIXED_FRAC_BITS;
+    int64_t bHigh = b >> FIXED_FRAC_BITS;
+    uint64_t aLow = (uint64_t)a & FIXED_LOW_MASK;
+    uint64_t bLow = (uint64_t)b & FIXED_LOW_MASK;
+    uint64_t result = ((uint64_t)(aHigh * bHigh) << FIXED_FRAC_BITS) + (uint64_t)(aHigh * (int64_t)bLow) +
+                      (uint64_t)((int64_t)aLow * bHigh) + ((aLow * bLow + FIXED_HALF) >> FIXED_FRAC_BITS);
+    return (SimFixed)result;
+#endif
+}
+
+SimFixed FixedDiv(SimFixed a, SimFixed b)
+{
+    if (b == 0)
+        return 0;
+    bool negative = (a < 0) != (b < 0);
+    uint64_t numerator = a < 0 ? 0 - (uint64_t)a : (uint64_t)a;
+    uint64_t divisor = b < 0 ? 0 - (uint64_t)b : (uint64_t)b;
+
+    // Long division of the 96-bit numerator |a| << 32, one quotient bit at a time (only run when converting)
+    uint64_t quotient = 0, remainder = 0;
+    for (int bit = 63 + FIXED_FRAC_BITS; bit >= 0; bit--)
+    {
+        uint64_t next = bit >= FIXED_FRAC_BITS ? (numerator >> (bit - FIXED_FRAC_BITS)) & 1 : 0;
+        bool carry = remainder >> 63;
+        remainder = (remainder << 1) | next;
+        if (carry || remainder >= divisor)
+        {
+            remainder -= divisor;
+            if (bit >= 63)
+                return negative ? INT64_MIN : INT64_MAX; // Quotient too large
+            quotient |= 1ull << bit;
+        }
+    }
+    return negative ? -(SimFixed)quotient : (SimFixed)quotient;
+}
+
+bool FixedFromState(FixedSystem *fixed, const SpringMassSystemState *state, SimReal dt)
+{
+    if (state->law != FORCE_LINEAR || state->noiseIntensity > 0)
+        return false;
+
+    // The inputs are converted exactly as stored; k/m, c/m and the products with dt are then formed in integers,
+    // not taken from the float caches
+    SimFixed mass = FixedFromReal(state->mass);
+    fixed->x = FixedFromReal(state->x);
+    fixed->velocity = FixedFromReal(state->velocity);
+    fixed->equilibrium = FixedFromReal(state->equilibrium);
+    fixed->xMin = FixedFromReal(state->xMin);
+    fixed->xMax = FixedFromReal(state->xMax);
+    fixed->restitution = FixedFromReal(state->restitution);
+    fixed->dt = FixedFromReal(dt);
+    fixed->kDt = FixedMul(FixedDiv(FixedFromReal(state->springConst), mass), fixed->dt);
+    fixed->cDt = FixedMul(FixedDiv(FixedFromReal(state->damping), mass), fixed->dt);
+    return mass > 0;
+}
+
+void FixedToState(const FixedSystem *fixed, SpringMassSystemState *state)
+{
+    state->x = (SimReal)FixedToReal(fixed->x);
+    state->velocity = (SimReal)FixedToReal(fixed->velocity);
+}
+
+void FixedAdvance(FixedSystem *fixed, int steps)
+{
+    FixedSystem s = *fixed; // Held in locals for the loop
+    for (int i = 0; i < steps; i++)
+        FixedStep(&s);
+    *fixed = s;
+}
+
+void FixedAdvanceBatch(FixedSystem **systems, int count, int steps)
+{
+    int i = 0;
+#if defined(FIXED_VECTOR)
+    for (; i + FIXED_LANES <= count; i += FIXED_LANES)
+        FixedAdvanceLanes(systems + i, steps);
+#endif
+    for (; i < count; i++)
+        FixedAdvance(systems[i], steps);
+}
+
+int FixedBatchLanes(void)
+{
+    return FIXED_LANES;
+}
+
+uint64_t FixedDigest(FixedSystem *const *systems, int count)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (int i = 0; i < count; i++)
+    {
+        hash = DigestValue(hash, systems[i]->x);
+        hash = DigestValue(hash, systems[i]->velocity);
+    }
+    return hash;
+}
+
+bool FixedCrossCheck(const SpringMassSystemState *state, SimReal dt, int steps, int every, FixedDrift *drift)
+{
+    SpringMassSystemState real = *state;
+    FixedSystem fixed;
+    drift->maxPosition = drift->maxVelocity = drift->rmsPosition = 0;
+    drift->samples = 0;
+    if (every <= 0 || !FixedFromState(&fixed, state, dt))
+        return false;
+    SpringmassSelectKernel(&real);
+
+    double sumSquares = 0;
+    for (int done = 0; done < steps; done += every)
+    {
+        int chunk = steps - done < every ? steps - done : every;
+        SpringmassAdvance(&real, dt, chunk);
+        FixedAdvance(&fixed, chunk);
+        double dx = fabs(FixedToReal(fixed.x) - real.x);
+        double dv = fabs(FixedToReal(fixed.velocity) - real.velocity);
+        drift->maxPosition = fmax(drift->maxPosition, dx);
+        drift->maxVelocity = fmax(drift->maxVelocity, dv);
+        sumSquares += dx * dx;
+        drift->samples++;
+    }
+    drift->rmsPosition = drift->samples > 0 ? sqrt(sumSquares / drift->samples) : 0;
+    return true;
+}
+
+/***************************************
+ *      Internal helper functions      *
+ ***************************************/
+
+// Semi-implicit Euler as in the float kernels: v += (-k/m d - c/m v) dt, then x += v dt, then the walls
+static inline void FixedStep(FixedSystem *s)
+{
+    s->velocity -= FixedMul(s->kDt, s->x - s->equilibrium) + FixedMul(s->cDt, s->velocity);
+    s->x += FixedMul(s->velocity, s->dt);
+    if (s->x < s->xMin)
+    {
+        s->x = s->xMin;
+        if (s->velocity < 0)
+            s->velocity = -FixedMul(s->restitution, s->velocity);
+    }
+    if (s->x > s->xMax)
+    {
+        s->x = s->xMax;
+        if (s->velocity > 0)
+            s->velocity = -FixedMul(s->restitution, s->velocity);
+    }
+}
+
+#if defined(FIXED_VECTOR)
+static inline FixedUVec Mul32(FixedUVec a, FixedUVec b)
+{
+    return (FixedUVec)_mm256_mul_epu32((__m256i)a, (__m256i)b);
+}
+
+// The product of the operands read as unsigned, from 32-bit multiplies the vector units have, then corrected for
+// the signs: a negative a is a + 2^64, adding b << 64 to the product, i.e. b << 32 after the shift (and likewise
+// for b). Same integer as FixedMul.
+static inline FixedVec FixedMulVec(FixedVec a, FixedVec b)
+{
+    FixedUVec ua = (FixedUVec)a, ub = (FixedUVec)b;
+    FixedUVec aHigh = ua >> FIXED_FRAC_BITS;
+    FixedUVec bHigh = ub >> FIXED_FRAC_BITS;
+    FixedUVec result = (Mul32(aHigh, bHigh) << FIXED_FRAC_BITS) + Mul32(aHigh, ub) + Mul32(ua, bHigh) +
+                       ((Mul32(ua, ub) + FIXED_HALF) >> FIXED_FRAC_BITS);
+    FixedUVec signs = ((FixedUVec)(a >> 63) & ub) + ((FixedUVec)(b >> 63) & ua);
+    return (FixedVec)(result - (signs << FIXED_FRAC_BITS));
+}
+
+static inline bool AnyLane(FixedVec mask)
+{
+    int64_t any = 0;
+    for (int l = 0; l < FIXED_LANES; l++)
+        any |= mask[l];
+    return any != 0;
+}
+
+static void FixedAdvanceLanes(FixedSystem **systems, int steps)
+{
+    FixedVec x, v, equilibrium, xMin, xMax, e, dt, kDt, cDt;
+    for (int l = 0; l < FIXED_LANES; l++)
+    {
+        x[l] = systems[l]->x;
+        v[l] = systems[l]->velocity;
+        equilibrium[l] = systems[l]->equilibrium;
+        xMin[l] = systems[l]->xMin;
+        xMax[l] = systems[l]->xMax;
+        e[l] = systems[l]->restitution;
+        dt[l] = systems[l]->dt;
+        kDt[l] = systems[l]->kDt;
+        cDt[l] = systems[l]->cDt;
+    }
+    const FixedVec zero = x - x;
+    for (int i = 0; i < steps; i++)
+    {
+        v -= FixedMulVec(kDt, x - equilibrium) + FixedMulVec(cDt, v);
+        x += FixedMulVec(v, dt);
+        FixedVec below = x < xMin; // All ones where the comparison holds
+        FixedVec above = x > xMax;
+        if (!AnyLane(below | above))
+            continue; // Clear of both walls: the usual case, and the bounce multiply is the costly part
+        x = (below & xMin) | (~below & x);
+        FixedVec bounce = below & (v < zero);
+        v = (bounce & -FixedMulVec(e, v)) | (~bounce & v);
+        above = x > xMax;
+        x = (above & xMax) | (~above & x);
+        bounce = above & (v > zero);
+        v = (bounce & -FixedMulVec(e, v)) | (~bounce & v);
+    }
+    for (int l = 0; l < FIXED_LANES; l++)
+    {
+        systems[l]->x = x[l];
+        systems[l]->velocity = v[l];
+    }
+}
+#endif
+
+static uint64_t DigestValue(uint64_t hash, SimFixed value)
+{
+    for (int byte = 0; byte < 8; byte++)
+    {
+        hash ^= ((uint64_t)value >> (8 * byte)) & 0xFF;
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
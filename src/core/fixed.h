@@ -0,0 +1,60 @@
+/***********************************************************************************************
+ * @file fixed.h                                                                               *
+ * @brief Q32.32 fixed-point step kernel that replays bit-for-bit on any compiler and machine. *
+ * @author Gabe G.                                                                             *
+ * @date 10-19-2026                                                                            *
+ ***********************************************************************************************/
+
+#ifndef FIXED_H
+#define FIXED_H
+
+#include "core/physics.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define FIXED_FRAC_BITS 32                         // Fraction bits: 2^-32 px resolution, +-2^31 px range
+#define FIXED_ONE ((SimFixed)1 << FIXED_FRAC_BITS) // 1.0
+
+typedef int64_t SimFixed; // Q32.32
+
+// A linear system in fixed point. Everything after FixedFromState is integer arithmetic (products rounded half
+// up), so a run depends only on its starting values: no FMA contraction, x87 excess precision or vector width
+// can change it.
+typedef struct FixedSystem
+{
+    SimFixed x;           // Position
+    SimFixed velocity;    // Velocity
+    SimFixed equilibrium; // Rest position
+    SimFixed xMin;        // Walls (INT64_MIN / INT64_MAX: none)
+    SimFixed xMax;
+    SimFixed restitution; // e
+    SimFixed dt;          // Step the coefficients were derived for
+    SimFixed kDt;         // k/m * dt
+    SimFixed cDt;         // c/m * dt
+} FixedSystem;
+
+// How far the float kernel and the fixed-point kernel drift apart from the same start
+typedef struct FixedDrift
+{
+    double maxPosition; // Largest |x difference|
+    double maxVelocity; // Largest |velocity difference|
+    double rmsPosition; // Root mean square of the x difference over the samples
+    long samples;       // Comparisons made
+} FixedDrift;
+
+// Fixed Function declarations
+SimFixed FixedFromReal(double value); // Round to the nearest Q32.32 (saturates; NaN is 0)
+double FixedToReal(SimFixed value);   // Exact for |value| < 2^21
+SimFixed FixedMul(SimFixed a, SimFixed b); // Product rounded half up
+SimFixed FixedDiv(SimFixed a, SimFixed b); // Quotient truncated toward zero (saturates; b == 0 gives 0)
+bool FixedFromState(FixedSystem *fixed, const SpringMassSystemState *state,
+                    SimReal dt);      // Convert (false: only the linear, noise-free law is supported)
+void FixedToState(const FixedSystem *fixed, SpringMassSystemState *state); // Write position and velocity back
+void FixedAdvance(FixedSystem *fixed, int steps);                           // Step + walls `steps` times
+void FixedAdvanceBatch(FixedSystem **systems, int count, int steps); // Same, integer AVX2 lanes if built (same results)
+int FixedBatchLanes(void);                                           // Systems per SIMD group (1: scalar only)
+uint64_t FixedDigest(FixedSystem *const *systems, int count);        // Hash of positions and velocities
+bool FixedCrossCheck(const SpringMassSystemState *state, SimReal dt, int steps, int every,
+                     FixedDrift *drift); // Run the float and fixed kernels side by side, comparing every `every` steps
+
+#endif
@@ -0,0 +1,329 @@
+/****************************************************
+ * @file modal.c                                    *
+ * @brief Implementation of the modal chain solver. *
+ * @author Gabe G.                                  *
+ * @date 10-19-2026                                 *
+ ****************************************************/
+
+#include "core/modal.h"
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MODAL_QL_ITERATIONS 60 // Per eigenvalue; implicit QL needs two or three on average
+#define MODAL_RIGID 1e-9       // Angular frequency below which a mode is free motion (a chain cut loose)
+#define MODAL_TIME_TILE 4      // Output times reconstructed per pass over the mode shapes
+#define MODAL_ROW_VECTORS 2    // Vectors of masses per reconstruction tile
+
+// GCC/Clang vector extensions: a tile of masses per vector, compiled to SSE/AVX/NEON as available
+#if defined(__GNUC__)
+#define MODAL_VECTOR 1
+#if defined(__AVX__)
+#define MODAL_VECTOR_BYTES 32
+#else
+#define MODAL_VECTOR_BYTES 16
+#endif
+#define MODAL_LANES (MODAL_VECTOR_BYTES / (int)sizeof(SimReal))
+typedef SimReal ModalVec __attribute__((vector_size(MODAL_VECTOR_BYTES)));
+#else
+#define MODAL_LANES 1
+#endif
+#define MODAL_ROW_TILE (MODAL_ROW_VECTORS * MODAL_LANES) // Masses per reconstruction tile
+
+/**********************************
+ *      Forward Declarations      *
+ **********************************/
+
+static bool Decompose(ModalChain *modal, const SpringChain *chain,
+                      double beta); // Modes of the chain's current parameters
+static bool TridiagonalQL(double *diagonal, double *offDiagonal, double *vectors,
+                          int n); // Eigenvalues and eigenvectors of a symmetric tridiagonal matrix
+static double ModeAt(const ModalChain *modal, int j, double t); // Modal displacement of mode j at time t
+static void Reconstruct(const ModalChain *modal, int samples,
+                        SimReal *positions); // Shapes times the amplitudes of up to MODAL_TIME_TILE samples
+
+/***********************************
+ *      External API Functions     *
+ ***********************************/
+
+bool ModalInit(ModalChain *modal, const SpringChain *chain, int modes)
+{
+    memset(modal, 0, sizeof(*modal));
+    modal->requested = modes;
+    return ModalSync(modal, chain);
+}
+
+bool ModalSync(ModalChain *modal, const SpringChain *chain)
+{
+    double beta;
+    if (!ModalProportional(chain, &beta))
+        return false;
+    if (!modal->decomposed || modal->revision != chain->revision || modal->count != chain->count)
+    {
+        if (!Decompose(modal, chain, beta))
+            return false;
+    }
+
+    // Project the displacement and velocity onto the modes: q = Phi^T M u, since Phi^T M Phi = I
+    for (int j = 0; j < modal->modes; j++)
+    {
+        const SimReal *shape = modal->shape + (size_t)j * modal->stride;
+        double q = 0, qd = 0;
+        for (int i = 0; i < modal->count; i++)
+        {
+            double weight = (double)shape[i] * chain->mass[i];
+            q += weight * (chain->x[i] - modal->equilibrium[i]);
+            qd += weight * chain->v[i];
+        }
+        modal->q0[j] = q;
+        modal->qd0[j] = qd;
+    }
+    return true;
+}
+
+void ModalFree(ModalChain *modal)
+{
+    free(modal->shape);
+    free(modal->equilibrium);
+    free(modal->omega);
+    free(modal->zeta);
+    free(modal->q0);
+    free(modal->qd0);
+    free(modal->amplitude);
+    memset(modal, 0, sizeof(*modal));
+}
+
+void ModalSample(ModalChain *modal, const double *times, int samples, SimReal *positions)
+{
+    // A few output times share each pass over the shapes, so the shapes stream from memory once per tile of times
+    for (int first = 0; first < samples; first += MODAL_TIME_TILE)
+    {
+        int tile = samples - first < MODAL_TIME_TILE ? samples - first : MODAL_TIME_TILE;
+        for (int j = 0; j < modal->modes; j++)
+            for (int s = 0; s < MODAL_TIME_TILE; s++)
+                modal->amplitude[j * MODAL_TIME_TILE + s] = s < tile ? (SimReal)ModeAt(modal, j, times[first + s]) : 0;
+        Reconstruct(modal, tile, positions + (size_t)first * modal->count);
+    }
+}
+
+bool ModalProportional(const SpringChain *chain, double *beta)
+{
+    double ratio = 0;
+    for (int i = 0; i < chain->count; i++)
+    {
+        if (chain->k[i] > 0)
+        {
+            ratio = (double)chain->c[i] / chain->k[i];
+            break;
+        }
+    }
+    for (int i = 0; i < chain->count; i++)
+    {
+        double expected = ratio * chain->k[i];
+        if (fabs(chain->c[i] - expected) > MODAL_PROPORTIONAL_TOLERANCE * fmax(fabs(chain->c[i]), fabs(expected)))
+            return false;
+    }
+    *beta = ratio;
+    return true;
+}
+
+/***************************************
+ *      Internal helper functions      *
+ ***************************************/
+
+static bool Decompose(ModalChain *modal, const SpringChain *chain, double beta)
+{
+    const int n = chain->count;
+    int kept = (modal->requested <= 0 || modal->requested > n) ? n : modal->requested;
+    if (modal->shape == NULL || modal->count != n)
+    {
+        int requested = modal->requested;
+        ModalFree(modal);
+        modal->requested = requested;
+        modal->count = n;
+        modal->modes = kept;
+        modal->stride = (n + MODAL_ROW_TILE - 1) / MODAL_ROW_TILE * MODAL_ROW_TILE;
+        modal->shape = calloc((size_t)kept * modal->stride, sizeof(SimReal));
+        modal->equilibrium = calloc(modal->stride, sizeof(SimReal));
+        modal->omega = calloc(kept, sizeof(double));
+        modal->zeta = calloc(kept, sizeof(double));
+        modal->q0 = calloc(kept, sizeof(double));
+        modal->qd0 = calloc(kept, sizeof(double));
+        modal->amplitude = calloc((size_t)kept * MODAL_TIME_TILE, sizeof(SimReal));
+        if (!modal->shape || !modal->equilibrium || !modal->omega || !modal->zeta || !modal->q0 || !modal->qd0 ||
+            !modal->amplitude)
+        {
+            ModalFree(modal);
+            return false;
+        }
+    }
+    modal->decomposed = false;
+    modal->beta = beta;
+
+    // M^-1/2 K M^-1/2: link i adds k_i to the diagonal of both its masses and -k_i between them
+    double *diagonal = malloc(n * sizeof(double));
+    double *offDiagonal = malloc(n * sizeof(double));
+    double *vectors = calloc((size_t)n * n, sizeof(double));
+    int *order = malloc(n * sizeof(int));
+    bool ok = diagonal && offDiagonal && vectors && order;
+    if (ok)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            diagonal[i] = (chain->k[i] + (i + 1 < n ? chain->k[i + 1] : 0)) / (double)chain->mass[i];
+            offDiagonal[i] = i + 1 < n ? -chain->k[i + 1] / sqrt((double)chain->mass[i] * chain->mass[i + 1]) : 0;
+            vectors[(size_t)i * n + i] = 1;
+            order[i] = i;
+        }
+        ok = TridiagonalQL(diagonal, offDiagonal, vectors, n);
+    }
+    if (ok)
+    {
+        // Lowest frequencies first (insertion sort: QL leaves them nearly ordered)
+        for (int i = 1; i < n; i++)
+        {
+            int index = order[i], j = i;
+            for (; j > 0 && diagonal[order[j - 1]] > diagonal[index]; j--)
+                order[j] = order[j - 1];
+            order[j] = index;
+        }
+        for (int j = 0; j < kept; j++)
+        {
+            const double *vector = vectors + (size_t)order[j] * n;
+            modal->omega[j] = sqrt(fmax(diagonal[order[j]], 0));
+            modal->zeta[j] = modal->beta * modal->omega[j] / 2; // C = beta K
+            for (int i = 0; i < n; i++)
+                modal->shape[(size_t)j * modal->stride + i] = (SimReal)(vector[i] / sqrt((double)chain->mass[i]));
+        }
+        double position = 0;
+        for (int i = 0; i < n; i++)
+        {
+            position += chain->rest[i];
+            modal->equilibrium[i] = (SimReal)position;
+        }
+        modal->revision = chain->revision;
+        modal->decomposed = true;
+    }
+    free(diagonal);
+    free(offDiagonal);
+    free(vectors);
+    free(order);
+    return ok;
+}
+
+// Implicit QL with Wilkinson shifts. offDiagonal[i] couples i and i + 1; vectors starts as the identity and ends
+// with eigenvector i in row i (rows are rotated in pairs, so they stay contiguous).
+static bool TridiagonalQL(double *diagonal, double *offDiagonal, double *vectors, int n)
+{
+    for (int l = 0; l < n; l++)
+    {
+        int iterations = 0, m;
+        do
+        {
+            for (m = l; m < n - 1; m++)
+            {
+                double scale = fabs(diagonal[m]) + fabs(diagonal[m + 1]);
+                if (fabs(offDiagonal[m]) <= DBL_EPSILON * scale)
+                    break;
+            }
+            if (m == l)
+                break;
+            if (iterations++ == MODAL_QL_ITERATIONS)
+                return false;
+
+            double g = (diagonal[l + 1] - diagonal[l]) / (2 * offDiagonal[l]);
+            double r = hypot(g, 1);
+            g = diagonal[m] - diagonal[l] + offDiagonal[l] / (g + copysign(r, g));
+            double s = 1, c = 1, p = 0;
+            bool deflated = false;
+            for (int i = m - 1; i >= l; i--)
+            {
+                double f = s * offDiagonal[i], b = c * offDiagonal[i];
+                r = hypot(f, g);
+                offDiagonal[i + 1] = r;
+                if (r == 0)
+                {
+                    diagonal[i + 1] -= p;
+                    offDiagonal[m] = 0;
+                    deflated = true;
+                    break;
+                }
+                s = f / r;
+                c = g / r;
+                g = diagonal[i + 1] - p;
+                r = (diagonal[i] - g) * s + 2 * c * b;
+                p = s * r;
+                diagonal[i + 1] = g + p;
+                g = c * r - b;
+
+                double *lower = vectors + (size_t)i * n, *upper = lower + n;
+                for (int k = 0; k < n; k++)
+                {
+                    double u = upper[k];
+                    upper[k] = s * lower[k] + c * u;
+                    lower[k] = c * lower[k] - s * u;
+                }
+            }
+            if (deflated)
+                continue;
+            diagonal[l] -= p;
+            offDiagonal[l] = g;
+            offDiagonal[m] = 0;
+        } while (true);
+    }
+    return true;
+}
+
+static double ModeAt(const ModalChain *modal, int j, double t)
+{
+    double omega = modal->omega[j], zeta = modal->zeta[j], q = modal->q0[j], qd = modal->qd0[j];
+    if (omega < MODAL_RIGID)
+        return q + qd * t; // No restoring force, and C = beta K means no damping either
+    if (zeta < 1 - 1e-9)
+    {
+        double decay = zeta * omega, wd = omega * sqrt(1 - zeta * zeta);
+        return exp(-decay * t) * (q * cos(wd * t) + (qd + decay * q) / wd * sin(wd * t));
+    }
+    if (zeta <= 1 + 1e-9)
+        return exp(-omega * t) * (q + (qd + omega * q) * t);
+    double root = omega * sqrt(zeta * zeta - 1);
+    double fast = -zeta * omega - root, slow = -zeta * omega + root;
+    double a = (qd - fast * q) / (slow - fast);
+    return a * exp(slow * t) + (q - a) * exp(fast * t);
+}
+
+static void Reconstruct(const ModalChain *modal, int samples, SimReal *positions)
+{
+    const int n = modal->count;
+    for (int row = 0; row < n; row += MODAL_ROW_TILE)
+    {
+        int rows = n - row < MODAL_ROW_TILE ? n - row : MODAL_ROW_TILE;
+        SimReal tile[MODAL_TIME_TILE][MODAL_ROW_TILE];
+#if MODAL_VECTOR
+        // Accumulators for a tile of masses at every time of the tile stay in registers across all the modes
+        ModalVec sum[MODAL_TIME_TILE][MODAL_ROW_VECTORS];
+        memset(sum, 0, sizeof(sum));
+        for (int j = 0; j < modal->modes; j++)
+        {
+            ModalVec shape[MODAL_ROW_VECTORS];
+            memcpy(shape, modal->shape + (size_t)j * modal->stride + row, sizeof(shape));
+            const SimReal *amplitude = modal->amplitude + j * MODAL_TIME_TILE;
+            for (int s = 0; s < MODAL_TIME_TILE; s++)
+                for (int v = 0; v < MODAL_ROW_VECTORS; v++)
+                    sum[s][v] += shape[v] * amplitude[s];
+        }
+        memcpy(tile, sum, sizeof(tile));
+#else
+        memset(tile, 0, sizeof(tile));
+        for (int j = 0; j < modal->modes; j++)
+            for (int s = 0; s < MODAL_TIME_TILE; s++)
+                for (int r = 0; r < MODAL_ROW_TILE; r++)
+                    tile[s][r] += modal->shape[(size_t)j * modal->stride + row + r] *
+                                  modal->amplitude[j * MODAL_TIME_TILE + s];
+#endif
+        for (int s = 0; s < samples; s++)
+            for (int r = 0; r < rows; r++)
+                positions[(size_t)s * n + row + r] = modal->equilibrium[row + r] + tile[s][r];
+    }
+}
@@ -0,0 +1,49 @@
+/********************************************************************************
+ * @file modal.h                                                                *
+ * @brief Closed-form evolution of linear spring chains by modal decomposition. *
+ * @author Gabe G.                                                              *
+ * @date 10-19-2026                                                             *
+ ********************************************************************************/
+
+#ifndef MODAL_H
+#define MODAL_H
+
+#include "core/chain.h"
+#include <stdbool.h>
+
+#define MODAL_PROPORTIONAL_TOLERANCE 1e-6 // Relative spread of c/k across links still treated as proportional
+
+// A SpringChain solved exactly instead of stepped. K and M are diagonalized once per parameter change
+// (M^-1/2 K M^-1/2 is tridiagonal for a chain, so implicit QL does it in place), which splits the chain into
+// independent damped oscillators. Stiffness-proportional damping (the same c/k on every link) keeps them
+// independent. Each mode then has a closed form in t, and a sample is the mode shapes times the modal amplitudes:
+// no step size, no integration error, O(count * modes) per output time.
+typedef struct ModalChain
+{
+    int count;              // Masses
+    int modes;              // Modes kept, lowest frequency first
+    int requested;          // Modes asked for (<= 0: all)
+    int stride;             // Padded length of a mode shape (whole row tiles of the reconstruction)
+    SimReal *shape;         // Mass-normalized mode shapes, mode j at shape + j * stride (zero padded)
+    SimReal *equilibrium;   // Position of each mass with every link at rest
+    double *omega;          // Undamped angular frequency of each mode
+    double *zeta;           // Damping ratio of each mode
+    double *q0;             // Modal displacement at t = 0
+    double *qd0;            // Modal velocity at t = 0
+    SimReal *amplitude;     // Scratch: modal displacements at the sample times being reconstructed
+    double beta;            // Shared c/k of the links
+    unsigned long revision; // Chain revision the modes belong to
+    bool decomposed;        // Modes valid for `revision`
+} ModalChain;
+
+// Modal Function declarations
+bool ModalInit(ModalChain *modal, const SpringChain *chain,
+               int modes); // Decompose and take the chain's state as t = 0 (modes <= 0: all; false: unsupported)
+bool ModalSync(ModalChain *modal,
+               const SpringChain *chain); // Take a new t = 0 state, decomposing again only if parameters changed
+void ModalFree(ModalChain *modal);        // Release the arrays
+void ModalSample(ModalChain *modal, const double *times, int samples,
+                 SimReal *positions); // Positions at each time, `count` per sample, row by row
+bool ModalProportional(const SpringChain *chain, double *beta); // Whether every link has the same c/k (and its value)
+
+#endif
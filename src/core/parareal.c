@@ -0,0 +1,302 @@
+/*****************************************************************
+ * @file parareal.c                                              *
+ * @brief Implementation of the Parareal parallel-in-time solve. *
+ * @author Gabe G.                                               *
+ * @date 10-19-2026                                              *
+ *****************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "core/parareal.h"
+#include <limits.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#define PARAREAL_FLUSH 0x8040 // MXCSR flush-to-zero and denormals-are-zero
+#endif
+
+// The part of the state that changes along a trajectory; everything else is the same in every slice
+typedef struct PararealPoint
+{
+    SimReal x;
+    SimReal velocity;
+    SimReal noiseForce; // Coloured-noise force (0 without noise)
+} PararealPoint;
+
+// One solve: the propagators and the per-slice values of the current iteration
+typedef struct PararealSolve
+{
+    SpringMassSystemState fine;   // Start state, fine kernel selected
+    SpringMassSystemState coarse; // Start state without noise, kernel selected for the coarse step
+    SimReal dt;                   // Fine step
+    int ratio;                    // Fine steps per coarse step
+    int slices;
+    long *first;              // First fine step of each slice, then the total (slices + 1)
+    PararealPoint *boundary;  // State at the start of each slice, then the end state (slices + 1)
+    PararealPoint *fineEnd;   // Fine propagation of each slice from its boundary
+    PararealPoint *coarseEnd; // Coarse propagation of each slice from its boundary
+} PararealSolve;
+
+// A thread's share of the slices in one fine pass
+typedef struct PararealJob
+{
+    PararealSolve *solve;
+    int from;       // First slice
+    int to;         // One past the last slice
+    double seconds; // CPU time the share took
+} PararealJob;
+
+/**********************************
+ *      Forward Declarations      *
+ **********************************/
+
+static void *PararealJobRun(void *job); // Fine-propagate a thread's share of the slices
+static void FinePass(PararealSolve *solve, int from, int threads, double *critical); // Fine-propagate every slice
+static void Fine(const PararealSolve *solve, int n, PararealPoint *out);   // Slice n with the fine step
+static void Coarse(const PararealSolve *solve, int n, PararealPoint *out); // Slice n with the coarse step
+static double StiffestRate(const SpringMassSystemState *state);            // Fastest rate of the dynamics (1/s)
+static double Distance(const PararealPoint *a, const PararealPoint *b, double scale,
+                       SimReal invMass); // Largest difference in px
+static double PararealNow(clockid_t clock);  // Clock reading in seconds
+
+/***********************************
+ *      External API Functions     *
+ ***********************************/
+
+void PararealConfigInit(PararealConfig *config)
+{
+    config->steps = 0;
+    config->dt = 0.001f;
+    config->slices = 0;
+    config->coarseRatio = 50;
+    config->maxIterations = 0;
+    config->tolerance = 1e-2;
+    config->threads = 0;
+}
+
+bool PararealRun(const SpringMassSystemState *start, const PararealConfig *config, SpringMassSystemState *end,
+                 PararealStats *stats)
+{
+    double begin = PararealNow(CLOCK_MONOTONIC);
+    *stats = (PararealStats){ 0 };
+    if (config->steps <= 0 || !(config->dt > 0) || config->coarseRatio < 1 || config->slices < 0 ||
+        config->slices > PARAREAL_MAX_SLICES || config->maxIterations < 0 || !(config->tolerance >= 0))
+        return false;
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN) > 0 ? sysconf(_SC_NPROCESSORS_ONLN) : 1;
+    int threads = config->threads > 0 ? config->threads : (int)cpus;
+    if (threads > PARAREAL_THREADS)
+        threads = PARAREAL_THREADS;
+    int slices = config->slices > 0 ? config->slices : threads;
+    if (slices > config->steps)
+        slices = (int)config->steps;
+    if (threads > slices)
+        threads = slices;
+
+    PararealSolve solve;
+    solve.fine = *start;
+    SpringmassSelectKernel(&solve.fine); // Resolves the default force table before threads copy the state
+    solve.coarse = solve.fine;
+    solve.coarse.noiseIntensity = 0; // The prediction follows the mean path; corrections bring the noise back
+    SpringmassSelectKernel(&solve.coarse);
+    solve.dt = config->dt;
+    solve.slices = slices;
+
+    // Semi-implicit Euler is stable below dt * rate = 2; keep the coarse step well inside that
+    double rate = StiffestRate(&solve.fine);
+    double stable = rate > 0 ? 0.5 / (rate * config->dt) : config->coarseRatio;
+    solve.ratio = stable < config->coarseRatio ? (int)stable : config->coarseRatio;
+    if (solve.ratio < 1)
+        solve.ratio = 1;
+
+    solve.first = malloc((slices + 1) * sizeof(long));
+    solve.boundary = malloc((slices + 1) * sizeof(PararealPoint));
+    solve.fineEnd = malloc(slices * sizeof(PararealPoint));
+    solve.coarseEnd = malloc(slices * sizeof(PararealPoint));
+    bool ok = solve.first != NULL && solve.boundary != NULL && solve.fineEnd != NULL && solve.coarseEnd != NULL;
+    if (ok)
+    {
+        for (int n = 0; n <= slices; n++)
+            solve.first[n] = (long)(config->steps * (double)n / slices);
+        solve.first[slices] = config->steps;
+
+        // Velocity differences count as the distance they would carry the mass in 1/rate (or one slice)
+        double scale = rate > 0 ? 1.0 / rate : config->steps * config->dt / slices;
+        int iterations = config->maxIterations > 0 && config->maxIterations < slices ? config->maxIterations : slices;
+
+        // Iteration 0: the coarse propagator alone predicts every slice boundary
+        double sweep = PararealNow(CLOCK_MONOTONIC);
+        solve.boundary[0] = (PararealPoint){ start->x, start->velocity, start->noiseForce };
+        for (int n = 0; n < slices; n++)
+        {
+            Coarse(&solve, n, &solve.coarseEnd[n]);
+            solve.boundary[n + 1] = solve.coarseEnd[n];
+        }
+        stats->criticalSeconds += PararealNow(CLOCK_MONOTONIC) - sweep;
+
+        // Iteration k: fine passes run in parallel from the predicted boundaries, then a serial sweep corrects the
+        // prediction U[n+1] = F(U[n]) + G(new U[n]) - G(old U[n]). Slice k - 1 starts from an exact boundary, so its
+        // correction is exactly zero and the first k boundaries match the serial solve bit for bit; only the slices
+        // from there on are refined again
+        for (int k = 1; k <= iterations; k++)
+        {
+            FinePass(&solve, k - 1, threads, &stats->criticalSeconds);
+            sweep = PararealNow(CLOCK_MONOTONIC);
+            double change = 0;
+            for (int n = k - 1; n < slices; n++)
+            {
+                PararealPoint predicted;
+                Coarse(&solve, n, &predicted);
+                const PararealPoint *f = &solve.fineEnd[n], *g = &solve.coarseEnd[n];
+                PararealPoint next = { f->x + (predicted.x - g->x), f->velocity + (predicted.velocity - g->velocity),
+                                       f->noiseForce + (predicted.noiseForce - g->noiseForce) };
+                change = fmax(change, Distance(&next, &solve.boundary[n + 1], scale, solve.fine.invMass));
+                solve.coarseEnd[n] = predicted;
+                solve.boundary[n + 1] = next;
+            }
+            stats->criticalSeconds += PararealNow(CLOCK_MONOTONIC) - sweep;
+            stats->iterations = k;
+            stats->change = change;
+            if (change <= config->tolerance || k == slices)
+            {
+                stats->converged = true;
+                break;
+            }
+        }
+
+        *end = solve.fine;
+        end->x = solve.boundary[slices].x;
+        end->velocity = solve.boundary[slices].velocity;
+        end->noiseForce = solve.boundary[slices].noiseForce;
+        end->noiseStep = solve.fine.noiseStep + (uint64_t)config->steps;
+        stats->slices = slices;
+        stats->threads = threads;
+        stats->coarseDt = config->dt * solve.ratio;
+    }
+    free(solve.first);
+    free(solve.boundary);
+    free(solve.fineEnd);
+    free(solve.coarseEnd);
+    stats->seconds = PararealNow(CLOCK_MONOTONIC) - begin;
+    return ok;
+}
+
+/***************************************
+ *      Internal helper functions      *
+ ***************************************/
+
+static void *PararealJobRun(void *arg)
+{
+    // CPU time of the thread, so the critical path holds even when threads outnumber the cores
+    PararealJob *job = arg;
+    double start = PararealNow(CLOCK_THREAD_CPUTIME_ID);
+    for (int n = job->from; n < job->to; n++)
+        Fine(job->solve, n, &job->solve->fineEnd[n]);
+    job->seconds = PararealNow(CLOCK_THREAD_CPUTIME_ID) - start;
+    return NULL;
+}
+
+static void FinePass(PararealSolve *solve, int from, int threads, double *critical)
+{
+    int active = solve->slices - from;
+    if (threads > active)
+        threads = active;
+    pthread_t workers[PARAREAL_THREADS];
+    PararealJob jobs[PARAREAL_THREADS];
+    bool started[PARAREAL_THREADS] = { false };
+    for (int i = 0; i < threads; i++)
+    {
+        jobs[i] = (PararealJob){ solve, from + active * i / threads, from + active * (i + 1) / threads, 0 };
+        if (i > 0)
+            started[i] = pthread_create(&workers[i], NULL, PararealJobRun, &jobs[i]) == 0;
+    }
+    PararealJobRun(&jobs[0]);
+    double slowest = jobs[0].seconds;
+    for (int i = 1; i < threads; i++)
+    {
+        if (started[i])
+            pthread_join(workers[i], NULL);
+        else
+            PararealJobRun(&jobs[i]); // Thread creation failed: run the share here
+        slowest = fmax(slowest, jobs[i].seconds);
+    }
+    *critical += slowest;
+}
+
+static void Fine(const PararealSolve *solve, int n, PararealPoint *out)
+{
+    // The serial solve's kernel and step from the slice's first step, noise draws included
+    SpringMassSystemState state = solve->fine;
+    state.x = solve->boundary[n].x;
+    state.velocity = solve->boundary[n].velocity;
+    state.noiseForce = solve->boundary[n].noiseForce;
+    state.noiseStep = solve->fine.noiseStep + (uint64_t)solve->first[n];
+    for (long left = solve->first[n + 1] - solve->first[n]; left > 0; left -= INT_MAX)
+        SpringmassAdvance(&state, solve->dt, left > INT_MAX ? INT_MAX : (int)left);
+    *out = (PararealPoint){ state.x, state.velocity, state.noiseForce };
+}
+
+static void Coarse(const PararealSolve *solve, int n, PararealPoint *out)
+{
+    // Whole coarse steps spanning the slice exactly
+    long fine = solve->first[n + 1] - solve->first[n];
+    long steps = (fine + solve->ratio - 1) / solve->ratio;
+    SimReal dt = (SimReal)(fine * (double)solve->dt / steps);
+    SpringMassSystemState state = solve->coarse;
+    state.x = solve->boundary[n].x;
+    state.velocity = solve->boundary[n].velocity;
+    state.noiseForce = solve->boundary[n].noiseForce;
+
+    // A noise-free prediction settles onto a denormal velocity that never rounds away, and denormal arithmetic is
+    // dozens of times slower. The prediction only has to be repeatable, not match the serial solve, so flush them
+#if defined(PARAREAL_FLUSH)
+    unsigned int csr = _mm_getcsr();
+    _mm_setcsr(csr | PARAREAL_FLUSH);
+#endif
+    for (long left = steps; left > 0; left -= INT_MAX)
+        SpringmassAdvance(&state, dt, left > INT_MAX ? INT_MAX : (int)left);
+#if defined(PARAREAL_FLUSH)
+    _mm_setcsr(csr);
+#endif
+    *out = (PararealPoint){ state.x, state.velocity, state.noiseForce };
+}
+
+static double StiffestRate(const SpringMassSystemState *state)
+{
+    // Largest d(accel)/dx of the active law near the start, plus the damping and drag rates
+    double d = state->x - state->equilibrium, v = state->velocity;
+    double energy = d * d + (state->kOverM > 0 ? v * v / state->kOverM : 0); // Amplitude squared, undamped
+    double stiffness = fabs((double)state->kOverM);
+    if (state->law == FORCE_STOPS)
+        stiffness += fabs((double)state->stopOverM);
+    else if (state->law == FORCE_DUFFING)
+        stiffness += 3 * fabs((double)state->cubicOverM) * energy;
+    else if (state->law == FORCE_TABLE)
+    {
+        const ForceTable *table = state->table != NULL ? state->table : SpringmassDefaultForceTable();
+        for (int i = 0; i < table->count; i++)
+            stiffness = fmax(stiffness, fabs((double)table->slope[i]) * table->invStep * state->invMass);
+    }
+    double speed = sqrt(v * v + fabs((double)state->kOverM) * energy);
+    return sqrt(stiffness) + fabs((double)state->cOverM) + 2 * fabs((double)state->dragOverM) * speed;
+}
+
+static double Distance(const PararealPoint *a, const PararealPoint *b, double scale, SimReal invMass)
+{
+    double position = fabs((double)a->x - b->x);
+    double velocity = fabs((double)a->velocity - b->velocity) * scale;
+    double force = fabs((double)a->noiseForce - b->noiseForce) * invMass * scale * scale;
+    return fmax(position, fmax(velocity, force));
+}
+
+static double PararealNow(clockid_t clock)
+{
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
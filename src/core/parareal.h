@@ -0,0 +1,45 @@
+/**********************************************************************************************************************
+ * @file parareal.h                                                                                                   *
+ * @brief Parallel-in-time (Parareal) solve of one long trajectory: coarse prediction, fine correction on every core. *
+ * @author Gabe G.                                                                                                    *
+ * @date 10-19-2026                                                                                                   *
+ **********************************************************************************************************************/
+
+#ifndef PARAREAL_H
+#define PARAREAL_H
+
+#include "core/physics.h"
+#include <stdbool.h>
+
+#define PARAREAL_THREADS 16     // Upper bound on worker threads
+#define PARAREAL_MAX_SLICES 1024 // Upper bound on time slices
+
+typedef struct PararealConfig
+{
+    long steps;        // Fine steps in the whole run
+    SimReal dt;        // Fine step (the serial solve this reproduces)
+    int slices;        // Time slices (0: one per thread)
+    int coarseRatio;   // Fine steps per coarse step (lowered where the coarse step would go unstable)
+    int maxIterations; // Correction sweeps at most (0: one per slice, after which the result is exact)
+    double tolerance;  // Converged once no slice boundary moves more than this (px; velocity scaled to px)
+    int threads;       // Worker threads (0: one per CPU)
+} PararealConfig;
+
+typedef struct PararealStats
+{
+    int iterations;         // Correction sweeps run
+    bool converged;         // Stopped on the tolerance rather than maxIterations
+    double change;          // Largest boundary move in the last sweep
+    int slices;             // Slices used
+    int threads;            // Threads used
+    SimReal coarseDt;       // Coarse step used
+    double seconds;         // Wall time of the solve
+    double criticalSeconds; // Coarse sweeps plus the slowest thread of each fine pass: the time with a core per thread
+} PararealStats;
+
+// Parareal Function declarations
+void PararealConfigInit(PararealConfig *config); // Defaults: 1 ms fine step, coarse 50x, tolerance 0.01 px
+bool PararealRun(const SpringMassSystemState *start, const PararealConfig *config, SpringMassSystemState *end,
+                 PararealStats *stats); // Advance `start` by config->steps (false: bad config or no memory)
+
+#endif
@@ -6,6 +6,10 @@
  ************************************************************/
 
 #include "core/physics.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
 
 void InitSystem(SpringMassSystemState *state)
 {
@@ -16,24 +20,31 @@ void InitSystem(SpringMassSystemState *state)
     state->damping = 4.0f;         // Damping coefficient        (c)
     state->equilibrium = state->x; // Equilibrium/rest point     (x_eq)
     state->restitution = 0.1f;     // Coefficient of restitution (e)
+    state->xMin = -INFINITY;       // No walls until the caller sets them
+    state->xMax = INFINITY;
+    state->law = FORCE_LINEAR;        // Linear until another force law is chosen
+    state->cubicConst = 0.001f;       // Duffing: doubles the linear force 316 px out
+    state->stopGap = 60.0f;           // Stops: free travel each way
+    state->stopConst = 1000.0f;       // Stops: 10x the spring past the gap
+    state->staticFriction = 1500.0f;  // Coulomb: sticks within 15 px of equilibrium
+    state->kineticFriction = 1000.0f; // Coulomb: sliding friction
+    state->dragCoeff = 0.002f;        // Quadratic air drag
+    state->table = NULL;              // Measured curve (NULL: built-in table)
+    state->noiseIntensity = 0.0f;     // Deterministic until noise is switched on
+    state->noiseTau = 0.0f;           // White noise when switched on
+    state->noiseSeed = 1;
+    state->noiseStream = 0;
+    state->noiseStep = 0;
+    state->noiseForce = 0.0f;
+    SpringmassSelectKernel(state);
 }
 
-float SpringmassAccel(float x, float v, float k, float m, float c)
+SimReal SpringmassAccel(SimReal x, SimReal v, SimReal k, SimReal m, SimReal c)
 {
     return -(k / m) * x - (c / m) * v; // acceleration = -(k/m)x - (c/m)v
 }
 
-void SpringmassStep(SpringMassSystemState *state, float dt)
-{
-    float displacement = state->x - state->equilibrium; // x - x_eq, displacement from equilibrium
-    float acceleration =
-        SpringmassAccel(displacement, state->velocity, state->springConst, state->mass, state->damping);
-
-    state->velocity += acceleration * dt; // semi-implicit Euler velocity update
-    state->x += state->velocity * dt;     // position update
-}
-
-void SpringmassResolveBounds(SpringMassSystemState *state, float x_min, float x_max)
+void SpringmassResolveBounds(SpringMassSystemState *state, SimReal x_min, SimReal x_max)
 {
     // Check minimum boundary
     if (state->x < x_min)
@@ -49,4 +60,903 @@ void SpringmassResolveBounds(SpringMassSystemState *state, float x_min, float x_
         if (state->velocity > 0)
             state->velocity = -(state->restitution) * state->velocity; // Bounce if moving into wall
     }
-}
\ No newline at end of file
+}
+
+/*******************************************
+ *      Stochastic forcing                 *
+ *******************************************/
+
+#define NOISE_GOLDEN 0x9E3779B97F4A7C15ull // Weyl increment of SplitMix64
+#define NOISE_TWO_PI 6.283185307179586
+
+// SplitMix64 finalizer: a bijective 64-bit mix with full avalanche
+static inline uint64_t NoiseMix(uint64_t z)
+{
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t NoiseKey(uint64_t seed, uint64_t stream)
+{
+    return NoiseMix(seed ^ NoiseMix(stream + NOISE_GOLDEN));
+}
+
+// Draw `counter` of a stream is a pure function of (key, counter). No generator state is carried, so systems,
+// SIMD lanes and threads draw independently and any draw can be recomputed. Box-Muller on two uniforms.
+static inline double NoiseNormal(uint64_t key, uint64_t counter)
+{
+    uint64_t a = NoiseMix(key + (2 * counter + 1) * NOISE_GOLDEN);
+    uint64_t b = NoiseMix(key + (2 * counter + 2) * NOISE_GOLDEN);
+    double u1 = (double)((a >> 11) + 1) * 0x1.0p-53; // (0, 1]: the log stays finite
+    double u2 = (double)(b >> 11) * 0x1.0p-53;
+    return sqrt(-2 * log(u1)) * cos(NOISE_TWO_PI * u2);
+}
+
+// Noise coefficients for one kernel call. White noise adds sigma dW / m to the velocity each step (Euler-Maruyama);
+// coloured noise advances an Ornstein-Uhlenbeck force with its exact update, so its variance sigma^2 / (2 tau)
+// does not depend on dt.
+typedef struct NoiseCoeffs
+{
+    uint64_t key;
+    bool coloured;
+    SimReal white; // sigma / (m sqrt(dt))
+    SimReal decay; // exp(-dt / tau)
+    SimReal kick;  // sigma sqrt((1 - decay^2) / (2 tau))
+    SimReal invMass;
+} NoiseCoeffs;
+
+static inline NoiseCoeffs LoadNoise(const SpringMassSystemState *state, SimReal dt)
+{
+    NoiseCoeffs n;
+    n.key = NoiseKey(state->noiseSeed, state->noiseStream);
+    n.coloured = state->noiseTau > 0;
+    n.white = (SimReal)(state->noiseIntensity * state->invMass / sqrt(dt));
+    n.decay = n.coloured ? (SimReal)exp(-dt / state->noiseTau) : 0;
+    n.kick = n.coloured ? (SimReal)(state->noiseIntensity * sqrt((1 - n.decay * n.decay) / (2 * state->noiseTau))) : 0;
+    n.invMass = state->invMass;
+    return n;
+}
+
+// Acceleration from the noise over the next step; consumes one draw (and advances the coloured force)
+static inline SimReal NoiseDrive(const NoiseCoeffs *n, SimReal *force, uint64_t *step)
+{
+    SimReal xi = (SimReal)NoiseNormal(n->key, (*step)++);
+    if (!n->coloured)
+        return n->white * xi;
+    *force = *force * n->decay + n->kick * xi;
+    return *force * n->invMass;
+}
+
+/*******************************************
+ *      Specialized step kernels           *
+ *******************************************/
+
+// Wall behaviour a kernel is specialized for
+#define WALLS_NONE 0      // No walls (xMin/xMax are infinite)
+#define WALLS_INELASTIC 1 // e == 0, mass sticks to the wall
+#define WALLS_ELASTIC 2   // e == 1, velocity is mirrored
+#define WALLS_GENERAL 3   // 0 < e < 1
+
+// Velocity after hitting a wall; WALLS is a compile-time constant so the branch folds away
+#define WALL_BOUNCE(WALLS, v, e)                                                                                       \
+    ((WALLS) == WALLS_INELASTIC ? (SimReal)0 : (WALLS) == WALLS_ELASTIC ? -(v) : -(e) * (v))
+
+// Coefficients of every law, copied into locals by each kernel
+typedef struct LawCoeffs
+{
+    SimReal kOverM;
+    SimReal cOverM;
+    SimReal equilibrium;
+    SimReal cubicOverM;
+    SimReal stopGap;
+    SimReal stopOverM;
+    SimReal staticOverM;
+    SimReal kineticOverM;
+    SimReal dragOverM;
+    SimReal invMass;
+    const ForceTable *table;
+} LawCoeffs;
+
+static inline LawCoeffs LoadCoeffs(const SpringMassSystemState *state)
+{
+    return (LawCoeffs){ state->kOverM,     state->cOverM,       state->equilibrium,  state->cubicOverM,
+                        state->stopGap,    state->stopOverM,    state->staticOverM,  state->kineticOverM,
+                        state->dragOverM,  state->invMass,      state->table };
+}
+
+// Segment of a table lookup. The clamp is a floating-point min/max (no compare-and-jump), so displacements outside
+// the table extend the end segments at the same cost as those inside it.
+static inline int TableSegment(const ForceTable *table, SimReal u)
+{
+    SimReal segment = u > 0 ? u : 0;
+    segment = segment < table->lastSegment ? segment : table->lastSegment;
+    return (int)segment;
+}
+
+// The segment's line through the origin of the grid, so the index only selects loads and never feeds back into
+// the arithmetic (no int-to-float conversion on the step's critical path)
+static inline SimReal TableForce(const ForceTable *table, SimReal displacement)
+{
+    SimReal u = (displacement - table->x0) * table->invStep;
+    int i = TableSegment(table, u);
+    return table->intercept[i] + table->slope[i] * u;
+}
+
+// The segment a kernel is stepping through. A mass crosses a fraction of a segment per step, so the kernels keep
+// the segment's bounds and line in locals and only look it up again on leaving it; the force stays bit-identical
+// to TableForce. A zeroed cursor is an empty segment, so the first call seeks.
+typedef struct TableCursor
+{
+    SimReal lo;        // The segment covers lo <= u < hi; the end segments extend to infinity
+    SimReal hi;
+    SimReal intercept;
+    SimReal slope;
+} TableCursor;
+
+static inline void TableSeek(const ForceTable *table, TableCursor *cursor, SimReal u)
+{
+    int i = TableSegment(table, u);
+    cursor->lo = (i == 0) ? -INFINITY : (SimReal)i;
+    cursor->hi = ((SimReal)i >= table->lastSegment) ? INFINITY : (SimReal)(i + 1);
+    cursor->intercept = table->intercept[i];
+    cursor->slope = table->slope[i];
+}
+
+static inline SimReal TableCursorForce(const ForceTable *table, TableCursor *cursor, SimReal displacement)
+{
+    SimReal u = (displacement - table->x0) * table->invStep;
+    if (u < cursor->lo || u >= cursor->hi)
+        TableSeek(table, cursor, u);
+    return cursor->intercept + cursor->slope * u;
+}
+
+// Acceleration from the spring, the law's extra terms and viscous damping (dry friction is applied by StepLaw).
+// `cursor` carries the table segment between steps (NULL looks it up each call).
+static inline SimReal LawAccel(ForceLaw law, int damped, const LawCoeffs *c, TableCursor *cursor, SimReal d,
+                               SimReal v)
+{
+    SimReal a = -c->kOverM * d;
+    if (law == FORCE_TABLE)
+        a = (cursor != NULL ? TableCursorForce(c->table, cursor, d) : TableForce(c->table, d)) * c->invMass;
+    if (law == FORCE_DUFFING)
+        a -= c->cubicOverM * d * d * d;
+    if (law == FORCE_STOPS)
+    {
+        SimReal over = (d < 0 ? -d : d) - c->stopGap; // Penetration past the stop
+        if (over > 0)
+            a -= c->stopOverM * (d < 0 ? -over : over);
+    }
+    if (law == FORCE_DRAG)
+        a -= c->dragOverM * v * (v < 0 ? -v : v);
+    if (damped)
+        a -= c->cOverM * v;
+    return a;
+}
+
+// One semi-implicit Euler step. The kernels pass LAW and DAMPED as constants, so only the active law's terms
+// are compiled into each loop. The SIMD kernels below repeat these operations in the same order, lane by lane,
+// so both paths produce the same trajectories. `drive` is the noise acceleration (NULL when deterministic).
+static inline void StepLaw(ForceLaw law, int damped, const LawCoeffs *c, TableCursor *cursor, SimReal *px,
+                           SimReal *pv, SimReal dt, const SimReal *drive)
+{
+    SimReal x = *px;
+    SimReal v = *pv;
+    SimReal a = LawAccel(law, damped, c, cursor, x - c->equilibrium, v);
+    if (drive != NULL)
+        a += *drive;
+
+    if (law == FORCE_COULOMB)
+    {
+        // A stuck mass (v == 0) breaks away only once the net force beats static friction; a sliding mass that
+        // would reverse within the step stops instead and sticks
+        if (v == 0)
+            a = ((a < 0 ? -a : a) > c->staticOverM) ? a - (a < 0 ? -c->kineticOverM : c->kineticOverM) : 0;
+        else
+            a -= (v < 0 ? -c->kineticOverM : c->kineticOverM);
+        SimReal next = v + a * dt;
+        v = (v != 0 && next * v < 0) ? 0 : next;
+    }
+    else
+    {
+        v += a * dt;
+    }
+    x += v * dt;
+    *px = x;
+    *pv = v;
+}
+
+// Generates a kernel with the force law, damping term, wall handling and noise fixed at compile time.
+// Coefficients and state are held in locals so the loop body touches no memory (beyond a force table).
+#define DEFINE_SPRINGMASS_KERNEL(NAME, LAW, DAMPED, WALLS, NOISY)                                                      \
+    static void NAME(SpringMassSystemState *state, SimReal dt, int steps)                                              \
+    {                                                                                                                  \
+        const LawCoeffs c = LoadCoeffs(state);                                                                         \
+        const SimReal xMin = state->xMin;                                                                              \
+        const SimReal xMax = state->xMax;                                                                              \
+        const SimReal e = state->restitution;                                                                          \
+        SimReal x = state->x;                                                                                          \
+        SimReal v = state->velocity;                                                                                   \
+        const NoiseCoeffs noise = (NOISY) ? LoadNoise(state, dt) : (NoiseCoeffs){ 0 };                                 \
+        SimReal noiseForce = state->noiseForce;                                                                        \
+        uint64_t noiseStep = state->noiseStep;                                                                         \
+        TableCursor cursor = { 0 };                                                                                    \
+        (void)xMin;                                                                                                    \
+        (void)xMax;                                                                                                    \
+        (void)e;                                                                                                       \
+        for (int i = 0; i < steps; i++)                                                                                \
+        {                                                                                                              \
+            SimReal drive = (NOISY) ? NoiseDrive(&noise, &noiseForce, &noiseStep) : 0;                                 \
+            StepLaw(LAW, DAMPED, &c, &cursor, &x, &v, dt, (NOISY) ? &drive : NULL);                                    \
+            if ((WALLS) != WALLS_NONE)                                                                                 \
+            {                                                                                                          \
+                if (x < xMin)                                                                                          \
+                {                                                                                                      \
+                    x = xMin;                                                                                          \
+                    if (v < 0)                                                                                         \
+                        v = WALL_BOUNCE(WALLS, v, e);                                                                  \
+                }                                                                                                      \
+                if (x > xMax)                                                                                          \
+                {                                                                                                      \
+                    x = xMax;                                                                                          \
+                    if (v > 0)                                                                                         \
+                        v = WALL_BOUNCE(WALLS, v, e);                                                                  \
+                }                                                                                                      \
+            }                                                                                                          \
+        }                                                                                                              \
+        state->x = x;                                                                                                  \
+        state->velocity = v;                                                                                           \
+        if (NOISY)                                                                                                     \
+        {                                                                                                              \
+            state->noiseForce = noiseForce;                                                                            \
+            state->noiseStep = noiseStep;                                                                              \
+        }                                                                                                              \
+    }
+
+// The eight damping/wall variants of one law
+#define DEFINE_LAW_KERNELS(LAW, PREFIX)                                                                                \
+    DEFINE_SPRINGMASS_KERNEL(Kernel##PREFIX##UndampedFree, LAW, 0, WALLS_NONE, 0)                                      \
+    DEFINE_SPRINGMASS_KERNEL(Kernel##PREFIX##UndampedInelastic, LAW, 0, WALLS_INELASTIC, 0)                            \
+    DEFINE_SPRINGMASS_KERNEL(Kernel##PREFIX##UndampedElastic, LAW, 0, WALLS_ELASTIC, 0)                                \
+    DEFINE_SPRINGMASS_KERNEL(Kernel##PREFIX##UndampedWalls, LAW, 0, WALLS_GENERAL, 0)                                  \
+    DEFINE_SPRINGMASS_KERNEL(Kernel##PREFIX##DampedFree, LAW, 1, WALLS_NONE, 0)                                        \
+    DEFINE_SPRINGMASS_KERNEL(Kernel##PREFIX##DampedInelastic, LAW, 1, WALLS_INELASTIC, 0)                              \
+    DEFINE_SPRINGMASS_KERNEL(Kernel##PREFIX##DampedElastic, LAW, 1, WALLS_ELASTIC, 0)                                  \
+    DEFINE_SPRINGMASS_KERNEL(Kernel##PREFIX##DampedWalls, LAW, 1, WALLS_GENERAL, 0)
+
+DEFINE_LAW_KERNELS(FORCE_LINEAR, Linear)
+DEFINE_LAW_KERNELS(FORCE_DUFFING, Duffing)
+DEFINE_LAW_KERNELS(FORCE_STOPS, Stops)
+DEFINE_LAW_KERNELS(FORCE_COULOMB, Coulomb)
+DEFINE_LAW_KERNELS(FORCE_DRAG, Drag)
+DEFINE_LAW_KERNELS(FORCE_TABLE, Table)
+
+// Noisy kernels add the noise drive each step; damping and walls are handled generally
+DEFINE_SPRINGMASS_KERNEL(KernelLinearNoisy, FORCE_LINEAR, 1, WALLS_GENERAL, 1)
+DEFINE_SPRINGMASS_KERNEL(KernelDuffingNoisy, FORCE_DUFFING, 1, WALLS_GENERAL, 1)
+DEFINE_SPRINGMASS_KERNEL(KernelStopsNoisy, FORCE_STOPS, 1, WALLS_GENERAL, 1)
+DEFINE_SPRINGMASS_KERNEL(KernelCoulombNoisy, FORCE_COULOMB, 1, WALLS_GENERAL, 1)
+DEFINE_SPRINGMASS_KERNEL(KernelDragNoisy, FORCE_DRAG, 1, WALLS_GENERAL, 1)
+DEFINE_SPRINGMASS_KERNEL(KernelTableNoisy, FORCE_TABLE, 1, WALLS_GENERAL, 1)
+
+#define LAW_KERNEL_ROW(PREFIX)                                                                                         \
+    {                                                                                                                  \
+        { Kernel##PREFIX##UndampedFree, Kernel##PREFIX##UndampedInelastic, Kernel##PREFIX##UndampedElastic,            \
+          Kernel##PREFIX##UndampedWalls },                                                                             \
+        {                                                                                                              \
+            Kernel##PREFIX##DampedFree, Kernel##PREFIX##DampedInelastic, Kernel##PREFIX##DampedElastic,                \
+                Kernel##PREFIX##DampedWalls                                                                            \
+        }                                                                                                              \
+    }
+
+#define LAW_KERNEL_NAMES(LAW)                                                                                          \
+    {                                                                                                                  \
+        { LAW "undamped/no-bounds", LAW "undamped/inelastic", LAW "undamped/elastic", LAW "undamped/restitution" },    \
+        {                                                                                                              \
+            LAW "damped/no-bounds", LAW "damped/inelastic", LAW "damped/elastic", LAW "damped/restitution"             \
+        }                                                                                                              \
+    }
+
+// Kernel table indexed by [law][damped][walls]
+static const SpringMassKernel kernelTable[FORCE_LAWS][2][4] = {
+    LAW_KERNEL_ROW(Linear),  LAW_KERNEL_ROW(Duffing), LAW_KERNEL_ROW(Stops),
+    LAW_KERNEL_ROW(Coulomb), LAW_KERNEL_ROW(Drag),    LAW_KERNEL_ROW(Table),
+};
+
+static const char *kernelNames[FORCE_LAWS][2][4] = {
+    LAW_KERNEL_NAMES(""),         LAW_KERNEL_NAMES("duffing/"), LAW_KERNEL_NAMES("stops/"),
+    LAW_KERNEL_NAMES("coulomb/"), LAW_KERNEL_NAMES("drag/"),    LAW_KERNEL_NAMES("table/"),
+};
+
+static const SpringMassKernel noisyKernelTable[FORCE_LAWS] = {
+    KernelLinearNoisy,  KernelDuffingNoisy, KernelStopsNoisy,
+    KernelCoulombNoisy, KernelDragNoisy,    KernelTableNoisy,
+};
+
+static const char *noisyKernelNames[FORCE_LAWS] = {
+    "noisy", "duffing/noisy", "stops/noisy", "coulomb/noisy", "drag/noisy", "table/noisy",
+};
+
+static const char *lawNames[FORCE_LAWS] = { "Linear", "Duffing", "Stops", "Coulomb", "Air drag", "Measured" };
+
+/*******************************************
+ *      SIMD batch kernels                 *
+ *******************************************/
+
+// GCC/Clang vector extensions: one lane per system, compiled to SSE/AVX/NEON as available. Two-lane groups
+// (doubles without AVX) lose to the scalar kernels on most laws, so those builds batch through the scalar kernels.
+#if defined(__GNUC__) && (SIM_PRECISION != SIM_PRECISION_DOUBLE || defined(__AVX__))
+#define SIM_VECTOR 1
+#if defined(__AVX__)
+#define SIM_VECTOR_BYTES 32
+#else
+#define SIM_VECTOR_BYTES 16
+#endif
+#define SIM_LANES (SIM_VECTOR_BYTES / (int)sizeof(SimReal))
+
+#if SIM_PRECISION == SIM_PRECISION_DOUBLE
+typedef long long SimLaneBits; // Integer the size of a lane, for comparison masks
+#else
+typedef int SimLaneBits;
+#endif
+typedef SimReal SimVec __attribute__((vector_size(SIM_VECTOR_BYTES)));
+typedef SimLaneBits SimMask __attribute__((vector_size(SIM_VECTOR_BYTES))); // All ones where a comparison holds
+
+// Vector kernel: advances exactly SIM_LANES systems that share a law (walls and damping handled generally)
+typedef void (*SpringMassVectorKernel)(SpringMassSystemState **states, SimReal dt, int steps);
+
+static inline SimVec Select(SimMask mask, SimVec a, SimVec b)
+{
+    return (SimVec)((mask & (SimMask)a) | (~mask & (SimMask)b));
+}
+
+static inline SimVec Splat(SimReal value)
+{
+    SimVec v;
+    for (int l = 0; l < SIM_LANES; l++)
+        v[l] = value;
+    return v;
+}
+
+static inline bool AnyLane(SimMask mask)
+{
+    SimLaneBits any = 0;
+    for (int l = 0; l < SIM_LANES; l++)
+        any |= mask[l];
+    return any != 0;
+}
+
+// Per-lane copy of the scalar step; DAMPED is always on (c == 0 contributes nothing). Noise is drawn per lane
+// from the counter-based generator, so a lane reproduces the noisy scalar kernel exactly. There is no Coulomb
+// kernel: its stick/slip selects cost more across lanes than the scalar kernel's predicted branches.
+#define DEFINE_SPRINGMASS_VECTOR_KERNEL(NAME, LAW, NOISY)                                                              \
+    static void NAME(SpringMassSystemState **states, SimReal dt, int steps)                                            \
+    {                                                                                                                  \
+        SimVec x, v, equilibrium, kOverM, cOverM, cubicOverM, stopGap, stopOverM, dragOverM, invMass, xMin, xMax, e;   \
+        SimVec tableX0, tableInvStep;                                                                                  \
+        SimVec segLo = { 0 }, segHi = { 0 }, segIntercept = { 0 }, segSlope = { 0 }; /* TableCursor per lane */        \
+        const ForceTable *tables[SIM_LANES];                                                                           \
+        NoiseCoeffs noise[SIM_LANES];                                                                                  \
+        SimReal noiseForce[SIM_LANES];                                                                                 \
+        uint64_t noiseStep[SIM_LANES];                                                                                 \
+        for (int l = 0; l < SIM_LANES; l++)                                                                            \
+        {                                                                                                              \
+            const SpringMassSystemState *s = states[l];                                                                \
+            x[l] = s->x;                                                                                               \
+            v[l] = s->velocity;                                                                                        \
+            equilibrium[l] = s->equilibrium;                                                                           \
+            kOverM[l] = s->kOverM;                                                                                     \
+            cOverM[l] = s->cOverM;                                                                                     \
+            cubicOverM[l] = s->cubicOverM;                                                                             \
+            stopGap[l] = s->stopGap;                                                                                   \
+            stopOverM[l] = s->stopOverM;                                                                               \
+            dragOverM[l] = s->dragOverM;                                                                               \
+            invMass[l] = s->invMass;                                                                                   \
+            xMin[l] = s->xMin;                                                                                         \
+            xMax[l] = s->xMax;                                                                                         \
+            e[l] = s->restitution;                                                                                     \
+            tables[l] = s->table;                                                                                      \
+            tableX0[l] = s->table->x0;                                                                                 \
+            tableInvStep[l] = s->table->invStep;                                                                       \
+            if (NOISY)                                                                                                 \
+            {                                                                                                          \
+                noise[l] = LoadNoise(s, dt);                                                                           \
+                noiseForce[l] = s->noiseForce;                                                                         \
+                noiseStep[l] = s->noiseStep;                                                                           \
+            }                                                                                                          \
+        }                                                                                                              \
+        const SimVec zero = Splat(0);                                                                                  \
+        const SimVec dtv = Splat(dt);                                                                                  \
+        (void)cubicOverM;                                                                                              \
+        (void)stopGap;                                                                                                 \
+        (void)stopOverM;                                                                                               \
+        (void)dragOverM;                                                                                               \
+        (void)invMass;                                                                                                 \
+        (void)tables;                                                                                                  \
+        (void)tableX0;                                                                                                 \
+        (void)tableInvStep;                                                                                            \
+        (void)segLo;                                                                                                   \
+        (void)segHi;                                                                                                   \
+        (void)segIntercept;                                                                                            \
+        (void)segSlope;                                                                                                \
+        (void)noise;                                                                                                   \
+        (void)noiseForce;                                                                                              \
+        (void)noiseStep;                                                                                               \
+        for (int i = 0; i < steps; i++)                                                                                \
+        {                                                                                                              \
+            SimVec d = x - equilibrium;                                                                                \
+            SimVec a;                                                                                                  \
+            if ((LAW) == FORCE_TABLE)                                                                                  \
+            {                                                                                                          \
+                /* TableCursorForce lane by lane: one vector bounds test per step, lanes seek only when they leave */  \
+                SimVec u = (d - tableX0) * tableInvStep;                                                               \
+                SimMask moved = (u < segLo) | (u >= segHi);                                                            \
+                if (AnyLane(moved))                                                                                    \
+                {                                                                                                      \
+                    for (int l = 0; l < SIM_LANES; l++)                                                                \
+                    {                                                                                                  \
+                        if (!moved[l])                                                                                 \
+                            continue;                                                                                  \
+                        TableCursor cursor;                                                                            \
+                        TableSeek(tables[l], &cursor, u[l]);                                                           \
+                        segLo[l] = cursor.lo;                                                                          \
+                        segHi[l] = cursor.hi;                                                                          \
+                        segIntercept[l] = cursor.intercept;                                                            \
+                        segSlope[l] = cursor.slope;                                                                    \
+                    }                                                                                                  \
+                }                                                                                                      \
+                a = (segIntercept + segSlope * u) * invMass;                                                           \
+            }                                                                                                          \
+            else                                                                                                       \
+                a = -kOverM * d;                                                                                       \
+            if ((LAW) == FORCE_DUFFING)                                                                                \
+                a -= cubicOverM * d * d * d;                                                                           \
+            if ((LAW) == FORCE_STOPS)                                                                                  \
+            {                                                                                                          \
+                SimVec over = Select(d < zero, -d, d) - stopGap;                                                       \
+                a -= Select(over > zero, stopOverM * Select(d < zero, -over, over), zero);                             \
+            }                                                                                                          \
+            if ((LAW) == FORCE_DRAG)                                                                                   \
+                a -= dragOverM * v * Select(v < zero, -v, v);                                                          \
+            a -= cOverM * v;                                                                                           \
+            if (NOISY)                                                                                                 \
+            {                                                                                                          \
+                SimVec drive;                                                                                          \
+                for (int l = 0; l < SIM_LANES; l++)                                                                    \
+                    drive[l] = NoiseDrive(&noise[l], &noiseForce[l], &noiseStep[l]);                                   \
+                a += drive;                                                                                            \
+            }                                                                                                          \
+            v += a * dtv;                                                                                              \
+            x += v * dtv;                                                                                              \
+            SimMask below = x < xMin;                                                                                  \
+            x = Select(below, xMin, x);                                                                                \
+            v = Select(below & (v < zero), -e * v, v);                                                                 \
+            SimMask above = x > xMax;                                                                                  \
+            x = Select(above, xMax, x);                                                                                \
+            v = Select(above & (v > zero), -e * v, v);                                                                 \
+        }                                                                                                              \
+        for (int l = 0; l < SIM_LANES; l++)                                                                            \
+        {                                                                                                              \
+            states[l]->x = x[l];                                                                                       \
+            states[l]->velocity = v[l];                                                                                \
+            if (NOISY)                                                                                                 \
+            {                                                                                                          \
+                states[l]->noiseForce = noiseForce[l];                                                                 \
+                states[l]->noiseStep = noiseStep[l];                                                                   \
+            }                                                                                                          \
+        }                                                                                                              \
+    }
+
+DEFINE_SPRINGMASS_VECTOR_KERNEL(VectorKernelLinear, FORCE_LINEAR, 0)
+DEFINE_SPRINGMASS_VECTOR_KERNEL(VectorKernelDuffing, FORCE_DUFFING, 0)
+DEFINE_SPRINGMASS_VECTOR_KERNEL(VectorKernelStops, FORCE_STOPS, 0)
+DEFINE_SPRINGMASS_VECTOR_KERNEL(VectorKernelDrag, FORCE_DRAG, 0)
+DEFINE_SPRINGMASS_VECTOR_KERNEL(VectorKernelTable, FORCE_TABLE, 0)
+DEFINE_SPRINGMASS_VECTOR_KERNEL(VectorKernelLinearNoisy, FORCE_LINEAR, 1)
+DEFINE_SPRINGMASS_VECTOR_KERNEL(VectorKernelDuffingNoisy, FORCE_DUFFING, 1)
+DEFINE_SPRINGMASS_VECTOR_KERNEL(VectorKernelStopsNoisy, FORCE_STOPS, 1)
+DEFINE_SPRINGMASS_VECTOR_KERNEL(VectorKernelDragNoisy, FORCE_DRAG, 1)
+DEFINE_SPRINGMASS_VECTOR_KERNEL(VectorKernelTableNoisy, FORCE_TABLE, 1)
+
+// Indexed by [noisy][law]; NULL where the scalar kernel is faster
+static const SpringMassVectorKernel vectorKernelTable[2][FORCE_LAWS] = {
+    { VectorKernelLinear, VectorKernelDuffing, VectorKernelStops, NULL, VectorKernelDrag, VectorKernelTable },
+    { VectorKernelLinearNoisy, VectorKernelDuffingNoisy, VectorKernelStopsNoisy, NULL, VectorKernelDragNoisy,
+      VectorKernelTableNoisy },
+};
+#else
+#define SIM_LANES 1
+#endif
+
+void SpringmassSelectKernel(SpringMassSystemState *state)
+{
+    if (state->law < 0 || state->law >= FORCE_LAWS)
+        state->law = FORCE_LINEAR;
+    if (state->table == NULL)
+        state->table = SpringmassDefaultForceTable();
+
+    state->kOverM = state->springConst / state->mass;
+    state->cOverM = state->damping / state->mass;
+    state->invMass = 1 / state->mass;
+    state->cubicOverM = state->cubicConst / state->mass;
+    state->stopOverM = state->stopConst / state->mass;
+    state->staticOverM = state->staticFriction / state->mass;
+    state->kineticOverM = fmax(fmin(state->kineticFriction, state->staticFriction) / state->mass, 0);
+    state->dragOverM = state->dragCoeff / state->mass;
+
+    int damped = state->damping != 0.0f;
+    int walls;
+    if (isinf(state->xMin) && isinf(state->xMax))
+        walls = WALLS_NONE;
+    else if (state->restitution == 0.0f)
+        walls = WALLS_INELASTIC;
+    else if (state->restitution == 1.0f)
+        walls = WALLS_ELASTIC;
+    else
+        walls = WALLS_GENERAL;
+
+    state->kernel = (state->noiseIntensity > 0) ? noisyKernelTable[state->law] : kernelTable[state->law][damped][walls];
+}
+
+void SpringmassAdvance(SpringMassSystemState *state, SimReal dt, int steps)
+{
+    state->kernel(state, dt, steps);
+}
+
+void SpringmassAdvanceBatch(SpringMassSystemState **states, int count, SimReal dt, int steps)
+{
+#if defined(SIM_VECTOR)
+    // Systems sharing a law (and noise on/off) run SIM_LANES at a time through its vector kernel; leftovers, and
+    // laws without one, use their scalar kernels
+    SpringMassSystemState *group[SIM_LANES];
+    for (int noisy = 0; noisy < 2; noisy++)
+    {
+        for (int law = 0; law < FORCE_LAWS; law++)
+        {
+            SpringMassVectorKernel kernel = vectorKernelTable[noisy][law];
+            int grouped = 0;
+            for (int i = 0; i < count; i++)
+            {
+                if (states[i]->law != (ForceLaw)law || (states[i]->noiseIntensity > 0) != noisy)
+                    continue;
+                if (kernel == NULL)
+                {
+                    states[i]->kernel(states[i], dt, steps);
+                    continue;
+                }
+                group[grouped++] = states[i];
+                if (grouped == SIM_LANES)
+                {
+                    kernel(group, dt, steps);
+                    grouped = 0;
+                }
+            }
+            for (int i = 0; i < grouped; i++)
+                group[i]->kernel(group[i], dt, steps);
+        }
+    }
+#else
+    for (int i = 0; i < count; i++)
+        states[i]->kernel(states[i], dt, steps);
+#endif
+}
+
+int SpringmassBatchLanes(void)
+{
+    return SIM_LANES;
+}
+
+void SpringmassSetNoise(SpringMassSystemState *state, SimReal intensity, SimReal tau, uint64_t seed, uint64_t stream)
+{
+    state->noiseIntensity = intensity > 0 ? intensity : 0;
+    state->noiseTau = tau > 0 ? tau : 0;
+    state->noiseSeed = seed;
+    state->noiseStream = stream;
+    state->noiseStep = 0;
+    state->noiseForce = 0;
+    SpringmassSelectKernel(state);
+}
+
+double SpringmassNoiseNormal(uint64_t seed, uint64_t stream, uint64_t counter)
+{
+    return NoiseNormal(NoiseKey(seed, stream), counter);
+}
+
+void SpringmassStep(SpringMassSystemState *state, SimReal dt)
+{
+    // Same step as the kernels, with the law chosen at run time
+    LawCoeffs c = LoadCoeffs(state);
+    SimReal noise = 0;
+    const SimReal *drive = NULL;
+    if (state->noiseIntensity > 0)
+    {
+        NoiseCoeffs n = LoadNoise(state, dt);
+        noise = NoiseDrive(&n, &state->noiseForce, &state->noiseStep);
+        drive = &noise;
+    }
+    switch (state->law)
+    {
+        case FORCE_DUFFING:
+            StepLaw(FORCE_DUFFING, 1, &c, NULL, &state->x, &state->velocity, dt, drive);
+            break;
+        case FORCE_STOPS:
+            StepLaw(FORCE_STOPS, 1, &c, NULL, &state->x, &state->velocity, dt, drive);
+            break;
+        case FORCE_COULOMB:
+            StepLaw(FORCE_COULOMB, 1, &c, NULL, &state->x, &state->velocity, dt, drive);
+            break;
+        case FORCE_DRAG:
+            StepLaw(FORCE_DRAG, 1, &c, NULL, &state->x, &state->velocity, dt, drive);
+            break;
+        case FORCE_TABLE:
+            StepLaw(FORCE_TABLE, 1, &c, NULL, &state->x, &state->velocity, dt, drive);
+            break;
+        default:
+            StepLaw(FORCE_LINEAR, 1, &c, NULL, &state->x, &state->velocity, dt, drive);
+            break;
+    }
+}
+
+const char *SpringmassKernelName(const SpringMassSystemState *state)
+{
+    for (int law = 0; law < FORCE_LAWS; law++)
+        for (int d = 0; d < 2; d++)
+            for (int w = 0; w < 4; w++)
+                if (kernelTable[law][d][w] == state->kernel)
+                    return kernelNames[law][d][w];
+    for (int law = 0; law < FORCE_LAWS; law++)
+        if (noisyKernelTable[law] == state->kernel)
+            return noisyKernelNames[law];
+    return "unknown";
+}
+
+const char *SpringmassForceLawName(ForceLaw law)
+{
+    return (law >= 0 && law < FORCE_LAWS) ? lawNames[law] : "unknown";
+}
+
+/*******************************************
+ *      Measured force tables              *
+ *******************************************/
+
+bool ForceTableBuild(ForceTable *table, const SimReal *displacement, const SimReal *force, int count)
+{
+    if (count < 2 || !(displacement[count - 1] > displacement[0]))
+        return false;
+    for (int i = 1; i < count; i++)
+        if (!(displacement[i] >= displacement[i - 1]))
+            return false;
+
+    // Resample onto the uniform grid with linear interpolation between the measured points
+    SimReal x0 = displacement[0];
+    SimReal step = (displacement[count - 1] - x0) / (FORCE_TABLE_SIZE - 1);
+    int segment = 0;
+    for (int i = 0; i < FORCE_TABLE_SIZE; i++)
+    {
+        SimReal x = x0 + step * i;
+        while (segment < count - 2 && displacement[segment + 1] < x)
+            segment++;
+        SimReal span = displacement[segment + 1] - displacement[segment];
+        SimReal t = span > 0 ? (x - displacement[segment]) / span : 0;
+        table->force[i] = force[segment] + t * (force[segment + 1] - force[segment]);
+    }
+    for (int i = 0; i < FORCE_TABLE_SIZE - 1; i++)
+        table->slope[i] = table->force[i + 1] - table->force[i];
+    table->slope[FORCE_TABLE_SIZE - 1] = table->slope[FORCE_TABLE_SIZE - 2];
+    for (int i = 0; i < FORCE_TABLE_SIZE; i++)
+        table->intercept[i] = table->force[i] - table->slope[i] * i;
+    table->x0 = x0;
+    table->invStep = 1 / step;
+    table->lastSegment = FORCE_TABLE_SIZE - 2;
+    table->count = FORCE_TABLE_SIZE;
+    return true;
+}
+
+bool ForceTableLoad(ForceTable *table, const char *path)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+        return false;
+
+    // Lines that don't parse as two numbers (headers, comments) are skipped
+    SimReal *displacement = malloc(4096 * sizeof(SimReal));
+    SimReal *force = malloc(4096 * sizeof(SimReal));
+    if (displacement == NULL || force == NULL)
+    {
+        free(displacement);
+        free(force);
+        fclose(file);
+        return false;
+    }
+    int count = 0;
+    char line[256];
+    while (count < 4096 && fgets(line, sizeof(line), file) != NULL)
+    {
+        double x, f;
+        if (sscanf(line, " %lf , %lf", &x, &f) == 2 || sscanf(line, " %lf %lf", &x, &f) == 2)
+        {
+            displacement[count] = (SimReal)x;
+            force[count] = (SimReal)f;
+            count++;
+        }
+    }
+    fclose(file);
+    bool built = ForceTableBuild(table, displacement, force, count);
+    free(displacement);
+    free(force);
+    return built;
+}
+
+SimReal ForceTableLookup(const ForceTable *table, SimReal displacement)
+{
+    return TableForce(table, displacement); // Outside the table the end segments extend
+}
+
+SimReal ForceTableSlope(const ForceTable *table, SimReal displacement)
+{
+    int i = TableSegment(table, (displacement - table->x0) * table->invStep);
+    return table->slope[i] * table->invStep;
+}
+
+static ForceTable defaultTable;
+static pthread_once_t defaultTableOnce = PTHREAD_ONCE_INIT;
+
+static void BuildDefaultForceTable(void)
+{
+    // A progressive spring measured on a bench rig: softer in compression than in tension, stiffening with
+    // travel (displacement in pixels, force on the mass)
+    static const SimReal measuredX[] = { -250, -200, -150, -100, -60, -30, 0, 30, 60, 100, 150, 200, 250 };
+    static const SimReal measuredF[] = { 42000, 29500, 19000, 10800, 6100, 2900, 0,
+                                         -3100, -6400, -11500, -20500, -32000, -46000 };
+    ForceTableBuild(&defaultTable, measuredX, measuredF, sizeof(measuredX) / sizeof(measuredX[0]));
+}
+
+const ForceTable *SpringmassDefaultForceTable(void)
+{
+    // Shared by every system; built once, on whichever thread selects a kernel first
+    pthread_once(&defaultTableOnce, BuildDefaultForceTable);
+    return &defaultTable;
+}
+
+SimReal SpringmassForceAccel(const SpringMassSystemState *state, SimReal displacement, SimReal velocity)
+{
+    // General (non-specialized) evaluation for tools and tests; friction acts against the given velocity
+    LawCoeffs c = LoadCoeffs(state);
+    SimReal a = LawAccel(state->law, 1, &c, NULL, displacement, velocity);
+    if (state->law == FORCE_COULOMB && velocity != 0)
+        a -= velocity < 0 ? -c.kineticOverM : c.kineticOverM;
+    return a;
+}
+
+/*******************************************
+ *      Parameter sensitivities            *
+ *******************************************/
+
+// Partial derivatives of LawAccel with respect to displacement and velocity (dry friction is piecewise constant)
+static inline void LawSlopes(ForceLaw law, const LawCoeffs *c, SimReal d, SimReal v, SimReal *aD, SimReal *aV)
+{
+    SimReal slopeD = (law == FORCE_TABLE) ? ForceTableSlope(c->table, d) * c->invMass : -c->kOverM;
+    SimReal slopeV = -c->cOverM;
+    if (law == FORCE_DUFFING)
+        slopeD -= 3 * c->cubicOverM * d * d;
+    if (law == FORCE_STOPS && (d < 0 ? -d : d) > c->stopGap)
+        slopeD -= c->stopOverM;
+    if (law == FORCE_DRAG)
+        slopeV -= 2 * c->dragOverM * (v < 0 ? -v : v);
+    *aD = slopeD;
+    *aV = slopeV;
+}
+
+static const char *sensitivityNames[SENS_PARAMS] = { "dx/dk", "dx/dc", "dx/dm", "dx/dx0" };
+
+// Tangents of all parameters side by side, one lane each (a single SSE/AVX register with vector extensions)
+#if defined(SIM_VECTOR)
+typedef SimReal TangentVec __attribute__((vector_size(SENS_PARAMS * sizeof(SimReal))));
+
+static inline void TangentStep(TangentVec *dx, TangentVec *dv, const TangentVec *aP, SimReal aD, SimReal aV,
+                               bool pinned, SimReal dt)
+{
+    *dv = pinned ? *dv * 0 : *dv + (aD * *dx + aV * *dv + *aP) * dt;
+    *dx = *dx + *dv * dt;
+}
+
+static inline void TangentScale(TangentVec *t, SimReal s)
+{
+    *t = *t * s;
+}
+#else
+typedef struct TangentVec
+{
+    SimReal lane[SENS_PARAMS];
+} TangentVec;
+
+static inline void TangentStep(TangentVec *dx, TangentVec *dv, const TangentVec *aP, SimReal aD, SimReal aV,
+                               bool pinned, SimReal dt)
+{
+    for (int p = 0; p < SENS_PARAMS; p++)
+    {
+        dv->lane[p] = pinned ? 0 : dv->lane[p] + (aD * dx->lane[p] + aV * dv->lane[p] + aP->lane[p]) * dt;
+        dx->lane[p] = dx->lane[p] + dv->lane[p] * dt;
+    }
+}
+
+static inline void TangentScale(TangentVec *t, SimReal s)
+{
+    for (int p = 0; p < SENS_PARAMS; p++)
+        t->lane[p] *= s;
+}
+#endif
+
+void SpringmassTangentInit(SpringMassTangent *tangent)
+{
+    memset(tangent, 0, sizeof(*tangent));
+    tangent->dx[SENS_X0] = 1; // The trajectory starts from the current position
+}
+
+void SpringmassAdvanceTangent(SpringMassSystemState *state, SpringMassTangent *tangent, SimReal dt, int steps)
+{
+    // Forward-mode differentiation of the discrete step: the state advances exactly as in the kernels while
+    // the tangent of every parameter rides alongside, so all sensitivities come out of this one pass
+    const LawCoeffs c = LoadCoeffs(state);
+    const ForceLaw law = state->law;
+    const SimReal e = state->restitution;
+    const bool noisy = state->noiseIntensity > 0;
+    const NoiseCoeffs noise = noisy ? LoadNoise(state, dt) : (NoiseCoeffs){ 0 };
+    SimReal x = state->x;
+    SimReal v = state->velocity;
+    SimReal noiseForce = state->noiseForce;
+    uint64_t noiseStep = state->noiseStep;
+    TableCursor cursor = { 0 };
+    TangentVec dx, dv;
+    memcpy(&dx, tangent->dx, sizeof(dx));
+    memcpy(&dv, tangent->dv, sizeof(dv));
+
+    for (int i = 0; i < steps; i++)
+    {
+        SimReal d = x - c.equilibrium;
+        SimReal v0 = v;
+        SimReal drive = noisy ? NoiseDrive(&noise, &noiseForce, &noiseStep) : 0;
+        SimReal a = LawAccel(law, 1, &c, &cursor, d, v) + drive;
+        SimReal aD, aV;
+        LawSlopes(law, &c, d, v, &aD, &aV);
+        StepLaw(law, 1, &c, &cursor, &x, &v, dt, noisy ? &drive : NULL);
+
+        // Dry friction subtracts a constant, or holds the mass: then v stays pinned at zero
+        bool pinned = (law == FORCE_COULOMB && v == 0);
+        if (law == FORCE_COULOMB)
+            a -= ((v0 != 0 ? v0 : a) < 0) ? -c.kineticOverM : c.kineticOverM;
+
+        // Explicit parameter terms; every force (the noise included, for the fixed draws) is divided by m,
+        // so da/dm = -a/m
+        SimReal dadk = (law == FORCE_TABLE) ? 0 : -d * c.invMass; // A measured table has no k
+        SimReal terms[SENS_PARAMS] = { dadk, -v0 * c.invMass, -a * c.invMass, 0 };
+        TangentVec aP;
+        memcpy(&aP, terms, sizeof(aP));
+        TangentStep(&dx, &dv, &aP, aD, aV, pinned, dt);
+
+        // A wall fixes the position (its derivative vanishes) and scales an incoming velocity by -e
+        if (x < state->xMin || x > state->xMax)
+        {
+            bool below = x < state->xMin;
+            x = below ? state->xMin : state->xMax;
+            TangentScale(&dx, 0);
+            if (below ? v < 0 : v > 0)
+            {
+                v = -e * v;
+                TangentScale(&dv, -e);
+            }
+        }
+    }
+
+    state->x = x;
+    state->velocity = v;
+    state->noiseForce = noiseForce;
+    state->noiseStep = noiseStep;
+    memcpy(tangent->dx, &dx, sizeof(dx));
+    memcpy(tangent->dv, &dv, sizeof(dv));
+}
+
+const char *SpringmassSensitivityName(SensParam param)
+{
+    return (param >= 0 && param < SENS_PARAMS) ? sensitivityNames[param] : "none";
+}
@@ -8,28 +8,133 @@
 #ifndef PHYSICS_H
 #define PHYSICS_H
 
+#include "core/precision.h"
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 
+#define FORCE_TABLE_SIZE 256 // Uniform samples a measured force curve is resampled to
+
+typedef struct SpringMassSystemState SpringMassSystemState;
+
+// Force model acting on the mass (viscous damping c*v applies to every law)
+typedef enum ForceLaw
+{
+    FORCE_LINEAR,  // Hookean spring: -k x
+    FORCE_DUFFING, // Cubic stiffening: -k x - beta x^3
+    FORCE_STOPS,   // Piecewise linear: extra stiffness past +-gap from equilibrium
+    FORCE_COULOMB, // Hookean spring with dry friction (stick-slip)
+    FORCE_DRAG,    // Hookean spring with quadratic air drag: -cd v |v|
+    FORCE_TABLE,   // Measured force-displacement curve, linearly interpolated
+    FORCE_LAWS
+} ForceLaw;
+
+// Force-displacement curve resampled onto a uniform grid, so a lookup is one multiply and one interpolation
+typedef struct ForceTable
+{
+    SimReal x0;                      // Displacement of sample 0
+    SimReal invStep;                 // Samples per unit of displacement
+    SimReal lastSegment;             // count - 2: lookups clamp their segment index to [0, lastSegment]
+    int count;                       // Samples in use (at least 2)
+    SimReal force[FORCE_TABLE_SIZE]; // Force on the mass at each sample
+    SimReal slope[FORCE_TABLE_SIZE]; // force[i + 1] - force[i]; the end slopes extrapolate past the table
+    SimReal intercept[FORCE_TABLE_SIZE]; // force[i] - slope[i] * i, so segment i is intercept[i] + slope[i] * u
+} ForceTable;
+
+// Parameters whose sensitivities SpringmassAdvanceTangent propagates
+typedef enum SensParam
+{
+    SENS_K,  // Spring constant
+    SENS_C,  // Damping coefficient
+    SENS_M,  // Mass
+    SENS_X0, // Initial position
+    SENS_PARAMS
+} SensParam;
+
+// Tangent of the state: derivatives of position and velocity with respect to each parameter
+typedef struct SpringMassTangent
+{
+    SimReal dx[SENS_PARAMS]; // d(x)/d(parameter)
+    SimReal dv[SENS_PARAMS]; // d(velocity)/d(parameter)
+} SpringMassTangent;
+
+// Step kernel: advances the system `steps` times by `dt`, resolving wall collisions after each step
+typedef void (*SpringMassKernel)(SpringMassSystemState *state, SimReal dt, int steps);
+
 // State of a 1D spring-mass system
-typedef struct SpringMassSystemState
+struct SpringMassSystemState
 {
-    float x;           // Position (only horizontal)
-    float xMin;        // Minimum position boundary
-    float xMax;        // Maximum position boundary
-    float velocity;    // Velocity
-    float springConst; // Spring constant
-    float mass;        // Mass
-    float damping;     // Damping coefficient
-    float equilibrium; // Equilibrium (rest) position
-    float restitution; // Coefficient of restitution (bounciness)
-} SpringMassSystemState;
+    SimReal x;           // Position (only horizontal)
+    SimReal xMin;        // Minimum position boundary (-INFINITY for no wall)
+    SimReal xMax;        // Maximum position boundary (+INFINITY for no wall)
+    SimReal velocity;    // Velocity
+    SimReal springConst; // Spring constant
+    SimReal mass;        // Mass
+    SimReal damping;     // Damping coefficient
+    SimReal equilibrium; // Equilibrium (rest) position
+    SimReal restitution; // Coefficient of restitution (bounciness)
+
+    // Force law and its parameters (only those of the active law are used)
+    ForceLaw law;            // Active force model
+    SimReal cubicConst;      // Duffing: beta
+    SimReal stopGap;         // Stops: free travel either side of equilibrium
+    SimReal stopConst;       // Stops: added stiffness past the gap
+    SimReal staticFriction;  // Coulomb: largest net force a stuck mass resists
+    SimReal kineticFriction; // Coulomb: friction force while sliding
+    SimReal dragCoeff;       // Drag: force per velocity squared
+    const ForceTable *table; // Table: measured curve (NULL uses SpringmassDefaultForceTable())
+
+    // Stochastic forcing (Euler-Maruyama); draws come from a counter-based generator keyed by seed and stream
+    SimReal noiseIntensity; // sigma: white-noise force density (0: deterministic)
+    SimReal noiseTau;       // Correlation time of coloured (Ornstein-Uhlenbeck) noise (0: white)
+    uint64_t noiseSeed;     // Seed shared by an ensemble
+    uint64_t noiseStream;   // Independent stream per system (e.g. ensemble member index)
+    uint64_t noiseStep;     // Draws consumed so far (the generator's counter)
+    SimReal noiseForce;     // Current coloured-noise force
+
+    // Derived values, refreshed by SpringmassSelectKernel() whenever a parameter changes
+    SimReal kOverM;          // Cached k/m
+    SimReal cOverM;          // Cached c/m
+    SimReal invMass;         // Cached 1/m
+    SimReal cubicOverM;      // Cached beta/m
+    SimReal stopOverM;       // Cached stop stiffness/m
+    SimReal staticOverM;     // Cached static friction/m
+    SimReal kineticOverM;    // Cached kinetic friction/m (never above static)
+    SimReal dragOverM;       // Cached cd/m
+    SpringMassKernel kernel; // Kernel specialized for the current law/damping/wall regime
+};
 
 // Physics Function Declarations
 void InitSystem(SpringMassSystemState *state); // Initialize system to default values
-float SpringmassAccel(float x, float v, float k, float m,
-                      float c);                              // Compute acceleration using Hooke's law and damping
-void SpringmassStep(SpringMassSystemState *state, float dt); // Advance system by one time step (semi-implicit Euler)
-void SpringmassResolveBounds(SpringMassSystemState *state, float x_min,
-                             float x_max); // Resolve boundary collisions with restitution
+SimReal SpringmassAccel(SimReal x, SimReal v, SimReal k, SimReal m,
+                        SimReal c);                            // Compute acceleration using Hooke's law and damping
+void SpringmassStep(SpringMassSystemState *state, SimReal dt); // Advance system by one time step (semi-implicit Euler)
+void SpringmassResolveBounds(SpringMassSystemState *state, SimReal x_min,
+                             SimReal x_max); // Resolve boundary collisions with restitution
+void SpringmassSelectKernel(
+    SpringMassSystemState *state); // Recompute cached coefficients and pick the matching kernel
+void SpringmassAdvance(SpringMassSystemState *state, SimReal dt,
+                       int steps); // Step + resolve bounds `steps` times with the selected kernel
+void SpringmassAdvanceBatch(SpringMassSystemState **states, int count, SimReal dt,
+                            int steps); // Advance several systems, grouped by kernel
+const char *SpringmassKernelName(const SpringMassSystemState *state); // Name of the selected kernel
+int SpringmassBatchLanes(void); // Systems per SIMD group in SpringmassAdvanceBatch (1: scalar only)
+SimReal SpringmassForceAccel(const SpringMassSystemState *state, SimReal displacement,
+                             SimReal velocity);                  // Acceleration under the active law (moving mass)
+const char *SpringmassForceLawName(ForceLaw law);                // Display name of a force law
+bool ForceTableBuild(ForceTable *table, const SimReal *displacement, const SimReal *force,
+                     int count);                                 // Resample measured points (ascending displacement)
+bool ForceTableLoad(ForceTable *table, const char *path);        // Load "displacement,force" lines from a CSV file
+SimReal ForceTableLookup(const ForceTable *table, SimReal displacement); // Interpolated force at a displacement
+SimReal ForceTableSlope(const ForceTable *table, SimReal displacement);  // Force gradient at a displacement
+const ForceTable *SpringmassDefaultForceTable(void);             // Built-in measured progressive spring
+void SpringmassTangentInit(SpringMassTangent *tangent);          // Start a tangent (only dx/dx0 = 1)
+void SpringmassAdvanceTangent(SpringMassSystemState *state, SpringMassTangent *tangent, SimReal dt,
+                              int steps);                        // Advance state and sensitivities in one pass
+const char *SpringmassSensitivityName(SensParam param);          // Channel label such as "dx/dk"
+void SpringmassSetNoise(SpringMassSystemState *state, SimReal intensity, SimReal tau, uint64_t seed,
+                        uint64_t stream);                        // Configure noise and restart its draws
+double SpringmassNoiseNormal(uint64_t seed, uint64_t stream,
+                             uint64_t counter);                  // Standard normal draw `counter` of a stream
 
 #endif
@@ -0,0 +1,58 @@
+/*****************************************************************************
+ * @file precision.h                                                         *
+ * @brief Build-time floating point precision for state and simulation time. *
+ * @author Gabe G.                                                           *
+ * @date 10-19-2026                                                          *
+ *****************************************************************************/
+
+#ifndef PRECISION_H
+#define PRECISION_H
+
+// Precision modes (select with `make PRECISION=FLOAT|DOUBLE|MIXED`)
+#define SIM_PRECISION_FLOAT 0  // float state, float time
+#define SIM_PRECISION_DOUBLE 1 // double state, double time
+#define SIM_PRECISION_MIXED 2  // float state, double time
+
+#ifndef SIM_PRECISION
+#define SIM_PRECISION SIM_PRECISION_FLOAT
+#endif
+
+#if SIM_PRECISION == SIM_PRECISION_FLOAT
+typedef float SimReal; // Scalar type for physical state and parameters
+typedef float SimTime; // Scalar type for accumulated simulation time
+#define SIM_PRECISION_NAME "float"
+#elif SIM_PRECISION == SIM_PRECISION_DOUBLE
+typedef double SimReal;
+typedef double SimTime;
+#define SIM_PRECISION_NAME "double"
+#elif SIM_PRECISION == SIM_PRECISION_MIXED
+typedef float SimReal;
+typedef double SimTime;
+#define SIM_PRECISION_NAME "mixed"
+#else
+#error "SIM_PRECISION must be SIM_PRECISION_FLOAT, SIM_PRECISION_DOUBLE or SIM_PRECISION_MIXED"
+#endif
+
+// Elapsed time with Kahan-compensated accumulation, so summing millions of
+// small frame times does not lose the low bits of each dt.
+typedef struct SimClock
+{
+    SimTime time;         // Accumulated time
+    SimTime compensation; // Running error term (low-order bits lost from `time`)
+} SimClock;
+
+static inline void SimClockReset(SimClock *clock)
+{
+    clock->time = 0;
+    clock->compensation = 0;
+}
+
+static inline void SimClockAdvance(SimClock *clock, SimTime dt)
+{
+    SimTime y = dt - clock->compensation; // Re-apply what was lost last time
+    SimTime t = clock->time + y;          // Low bits of y are lost here...
+    clock->compensation = (t - clock->time) - y; // ...and recovered here
+    clock->time = t;
+}
+
+#endif
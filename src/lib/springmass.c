@@ -0,0 +1,241 @@
+/****************************************************************************************************
+ * @file springmass.c                                                                               *
+ * @brief Implementation of the libspringmass API over the physics kernels and the history pyramid. *
+ * @author Gabe G.                                                                                  *
+ * @date 10-19-2026                                                                                 *
+ ****************************************************************************************************/
+
+#include "lib/springmass.h"
+#include "core/physics.h"
+#include "renderer/history.h"
+#include <math.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#define SM_BATCH_CHUNK 256 // Systems handed to SpringmassAdvanceBatch at once (pointer array on the stack)
+
+_Static_assert((int)SM_LAW_LINEAR == (int)FORCE_LINEAR && (int)SM_LAW_DUFFING == (int)FORCE_DUFFING &&
+                   (int)SM_LAW_STOPS == (int)FORCE_STOPS && (int)SM_LAW_COULOMB == (int)FORCE_COULOMB &&
+                   (int)SM_LAW_DRAG == (int)FORCE_DRAG && (int)SM_LAW_TABLE == (int)FORCE_TABLE,
+               "SmLaw must match ForceLaw");
+
+struct SmSystem
+{
+    SpringMassSystemState state; // Parameters, position and velocity
+    double time;                 // Seconds stepped
+    History history;             // Recorded displacement
+    int recordEvery;             // Steps between samples (0: not recording)
+    int untilRecord;             // Steps left before the next sample
+};
+
+// Where each real-valued parameter lives in the physics state (SM_PARAM_LAW is the enum `law`)
+static const size_t paramFields[SM_PARAMS] = {
+    [SM_PARAM_SPRING] = offsetof(SpringMassSystemState, springConst),
+    [SM_PARAM_DAMPING] = offsetof(SpringMassSystemState, damping),
+    [SM_PARAM_MASS] = offsetof(SpringMassSystemState, mass),
+    [SM_PARAM_EQUILIBRIUM] = offsetof(SpringMassSystemState, equilibrium),
+    [SM_PARAM_RESTITUTION] = offsetof(SpringMassSystemState, restitution),
+    [SM_PARAM_WALL_MIN] = offsetof(SpringMassSystemState, xMin),
+    [SM_PARAM_WALL_MAX] = offsetof(SpringMassSystemState, xMax),
+    [SM_PARAM_CUBIC] = offsetof(SpringMassSystemState, cubicConst),
+    [SM_PARAM_STOP_GAP] = offsetof(SpringMassSystemState, stopGap),
+    [SM_PARAM_STOP_SPRING] = offsetof(SpringMassSystemState, stopConst),
+    [SM_PARAM_STATIC_FRICTION] = offsetof(SpringMassSystemState, staticFriction),
+    [SM_PARAM_KINETIC_FRICTION] = offsetof(SpringMassSystemState, kineticFriction),
+    [SM_PARAM_DRAG] = offsetof(SpringMassSystemState, dragCoeff),
+    [SM_PARAM_NOISE] = offsetof(SpringMassSystemState, noiseIntensity),
+    [SM_PARAM_NOISE_TAU] = offsetof(SpringMassSystemState, noiseTau),
+};
+
+/**********************************
+ *      Forward Declarations      *
+ **********************************/
+
+static void AdvanceChunk(SmSystem *const *systems, int count, double dt, int steps); // Step and record a chunk
+static void Record(SmSystem *system); // Append the current displacement to the history
+
+/***********************************
+ *      External API Functions     *
+ ***********************************/
+
+int SmVersion(void)
+{
+    return SM_VERSION_MAJOR * 100 + SM_VERSION_MINOR;
+}
+
+SmSystem *SmCreate(void)
+{
+    SmSystem *system = calloc(1, sizeof(SmSystem));
+    if (system == NULL)
+        return NULL;
+    InitSystem(&system->state);
+    SpringmassSelectKernel(&system->state);
+    HistoryInit(&system->history);
+    return system;
+}
+
+void SmDestroy(SmSystem *system)
+{
+    if (system == NULL)
+        return;
+    HistoryFree(&system->history);
+    free(system);
+}
+
+bool SmSetParam(SmSystem *system, SmParam param, double value)
+{
+    SpringMassSystemState *state = &system->state;
+    if (param < 0 || param >= SM_PARAMS || isnan(value))
+        return false;
+    if (param == SM_PARAM_LAW)
+    {
+        if (value != floor(value) || value < 0 || value >= FORCE_LAWS)
+            return false;
+        state->law = (ForceLaw)value;
+    }
+    else
+    {
+        bool badMass = param == SM_PARAM_MASS && (value <= 0 || isinf(value));
+        bool badNoise = (param == SM_PARAM_NOISE || param == SM_PARAM_NOISE_TAU) && value < 0;
+        bool badBounce = param == SM_PARAM_RESTITUTION && (value < 0 || value > 1);
+        if (badMass || badNoise || badBounce)
+            return false;
+        *(SimReal *)((char *)state + paramFields[param]) = (SimReal)value;
+    }
+    SpringmassSelectKernel(state); // Every parameter feeds the cached coefficients or the kernel choice
+    return true;
+}
+
+double SmGetParam(const SmSystem *system, SmParam param)
+{
+    const SpringMassSystemState *state = &system->state;
+    if (param < 0 || param >= SM_PARAMS)
+        return NAN;
+    if (param == SM_PARAM_LAW)
+        return state->law;
+    return *(const SimReal *)((const char *)state + paramFields[param]);
+}
+
+void SmSetNoiseSeed(SmSystem *system, unsigned long long seed, unsigned long long stream)
+{
+    SpringMassSystemState *state = &system->state;
+    SpringmassSetNoise(state, state->noiseIntensity, state->noiseTau, seed, stream);
+}
+
+void SmSetState(SmSystem *system, double position, double velocity)
+{
+    system->state.x = (SimReal)position;
+    system->state.velocity = (SimReal)velocity;
+    system->state.noiseForce = 0;
+    system->time = 0;
+    system->untilRecord = system->recordEvery;
+}
+
+void SmGetState(const SmSystem *system, SmState *state)
+{
+    state->time = system->time;
+    state->position = system->state.x;
+    state->velocity = system->state.velocity;
+}
+
+void SmStep(SmSystem *system, double dt, int steps)
+{
+    AdvanceChunk(&system, 1, dt, steps);
+}
+
+void SmStepBatch(SmSystem *const *systems, int count, double dt, int steps)
+{
+    for (int first = 0; first < count; first += SM_BATCH_CHUNK)
+        AdvanceChunk(systems + first, count - first < SM_BATCH_CHUNK ? count - first : SM_BATCH_CHUNK, dt, steps);
+}
+
+bool SmRecord(SmSystem *system, int every)
+{
+    if (every < 0)
+        return false;
+    system->recordEvery = every;
+    system->untilRecord = every;
+    return true;
+}
+
+long SmHistoryCount(const SmSystem *system)
+{
+    return HistoryCount(&system->history);
+}
+
+long SmHistoryRecent(SmSystem *system, SmSample *out, long max)
+{
+    if (max <= 0)
+        return 0;
+    HistoryNode *nodes = malloc(max * sizeof(HistoryNode));
+    if (nodes == NULL)
+        return -1;
+    long count = HistoryRecent(&system->history, nodes, max);
+    for (long i = 0; i < count; i++)
+        out[i] = (SmSample){ nodes[i].t0, nodes[i].min };
+    free(nodes);
+    return count;
+}
+
+int SmHistoryQuery(SmSystem *system, double t0, double t1, int columns, SmColumn *out)
+{
+    if (columns <= 0)
+        return 0;
+    HistoryColumn *scratch = malloc(columns * sizeof(HistoryColumn));
+    if (scratch == NULL)
+        return -1;
+    HistoryQuery(&system->history, t0, t1, columns, scratch);
+    int valid = 0;
+    for (int c = 0; c < columns; c++)
+    {
+        out[c] = (SmColumn){ scratch[c].min, scratch[c].max, scratch[c].valid };
+        valid += scratch[c].valid;
+    }
+    free(scratch);
+    return valid;
+}
+
+void SmHistoryClear(SmSystem *system)
+{
+    HistoryClear(&system->history);
+}
+
+/***************************************
+ *      Internal helper functions      *
+ ***************************************/
+
+static void AdvanceChunk(SmSystem *const *systems, int count, double dt, int steps)
+{
+    SpringMassSystemState *states[SM_BATCH_CHUNK];
+    for (int i = 0; i < count; i++)
+        states[i] = &systems[i]->state;
+
+    // Run the kernels uninterrupted up to the next step any recording system wants a sample at
+    while (steps > 0)
+    {
+        int run = steps;
+        for (int i = 0; i < count; i++)
+            if (systems[i]->recordEvery > 0 && systems[i]->untilRecord < run)
+                run = systems[i]->untilRecord;
+        if (count == 1)
+            SpringmassAdvance(states[0], (SimReal)dt, run);
+        else
+            SpringmassAdvanceBatch(states, count, (SimReal)dt, run);
+        for (int i = 0; i < count; i++)
+        {
+            SmSystem *system = systems[i];
+            system->time += run * dt;
+            if (system->recordEvery > 0 && (system->untilRecord -= run) == 0)
+            {
+                Record(system);
+                system->untilRecord = system->recordEvery;
+            }
+        }
+        steps -= run;
+    }
+}
+
+static void Record(SmSystem *system)
+{
+    HistoryAppend(&system->history, system->time, (float)(system->state.x - system->state.equilibrium));
+}
@@ -0,0 +1,111 @@
+/************************************************************************************************************
+ * @file springmass.h                                                                                       *
+ * @brief libspringmass: reentrant C API to create, step, batch and record spring-mass systems (no raylib). *
+ * @author Gabe G.                                                                                          *
+ * @date 10-19-2026                                                                                         *
+ ************************************************************************************************************/
+
+#ifndef SPRINGMASS_H
+#define SPRINGMASS_H
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__GNUC__)
+#define SM_API __attribute__((visibility("default"))) // Exported from libspringmass.so; everything else is hidden
+#else
+#define SM_API
+#endif
+
+#define SM_VERSION_MAJOR 1 // Bumped when the API or ABI changes incompatibly
+#define SM_VERSION_MINOR 0 // Bumped when something is added
+
+// A system is a context: it owns the physics state, the clock and the recorded history, and nothing else in the
+// library is mutable. Different systems may be used from different threads at the same time; one system must not
+// be used by two threads at once.
+typedef struct SmSystem SmSystem;
+
+// Force model acting on the mass (values are part of the ABI)
+typedef enum SmLaw
+{
+    SM_LAW_LINEAR = 0,  // Hookean spring: -k x
+    SM_LAW_DUFFING = 1, // Cubic stiffening: -k x - beta x^3
+    SM_LAW_STOPS = 2,   // Piecewise linear: extra stiffness past +-gap from equilibrium
+    SM_LAW_COULOMB = 3, // Hookean spring with dry friction
+    SM_LAW_DRAG = 4,    // Hookean spring with quadratic air drag
+    SM_LAW_TABLE = 5    // Built-in measured force curve
+} SmLaw;
+
+// Parameters read and written with SmGetParam/SmSetParam (values are part of the ABI)
+typedef enum SmParam
+{
+    SM_PARAM_SPRING = 0,            // Spring constant k
+    SM_PARAM_DAMPING = 1,           // Viscous damping c
+    SM_PARAM_MASS = 2,              // Mass m (must be positive)
+    SM_PARAM_EQUILIBRIUM = 3,       // Rest position
+    SM_PARAM_RESTITUTION = 4,       // Wall bounciness, 0 to 1
+    SM_PARAM_WALL_MIN = 5,          // Left wall (-INFINITY: none)
+    SM_PARAM_WALL_MAX = 6,          // Right wall (INFINITY: none)
+    SM_PARAM_LAW = 7,               // An SmLaw
+    SM_PARAM_CUBIC = 8,             // Duffing beta
+    SM_PARAM_STOP_GAP = 9,          // Stops: free travel either side of equilibrium
+    SM_PARAM_STOP_SPRING = 10,      // Stops: added stiffness past the gap
+    SM_PARAM_STATIC_FRICTION = 11,  // Coulomb: largest net force a stuck mass resists
+    SM_PARAM_KINETIC_FRICTION = 12, // Coulomb: friction while sliding
+    SM_PARAM_DRAG = 13,             // Drag: force per velocity squared
+    SM_PARAM_NOISE = 14,            // White-noise force density (0: deterministic)
+    SM_PARAM_NOISE_TAU = 15,        // Correlation time of the noise (0: white)
+    SM_PARAMS
+} SmParam;
+
+// Where a system is
+typedef struct SmState
+{
+    double time;     // Seconds stepped since creation (or the last SmSetState)
+    double position; // Position of the mass
+    double velocity; // Velocity of the mass
+} SmState;
+
+// One recorded sample: displacement from equilibrium at a time
+typedef struct SmSample
+{
+    double time;
+    double displacement;
+} SmSample;
+
+// Range of the recorded displacement over one column of an SmHistoryQuery
+typedef struct SmColumn
+{
+    double min;
+    double max;
+    int valid; // 0 if no sample falls in the column
+} SmColumn;
+
+// Springmass Function declarations
+SM_API int SmVersion(void);                 // SM_VERSION_MAJOR * 100 + SM_VERSION_MINOR of the loaded library
+SM_API SmSystem *SmCreate(void);            // A system with the default parameters at rest (NULL: no memory)
+SM_API void SmDestroy(SmSystem *system);    // Release a system and its history (NULL is ignored)
+SM_API bool SmSetParam(SmSystem *system, SmParam param, double value); // false: unknown parameter or bad value
+SM_API double SmGetParam(const SmSystem *system, SmParam param);       // Current value (NaN: unknown parameter)
+SM_API void SmSetNoiseSeed(SmSystem *system, unsigned long long seed,
+                           unsigned long long stream); // Key the noise generator and restart its draws
+SM_API void SmSetState(SmSystem *system, double position, double velocity); // Place the mass and restart the clock
+SM_API void SmGetState(const SmSystem *system, SmState *state);            // Time, position and velocity
+SM_API void SmStep(SmSystem *system, double dt, int steps);                // Advance `steps` steps of `dt`
+SM_API void SmStepBatch(SmSystem *const *systems, int count, double dt,
+                        int steps); // Advance several systems together (SIMD across systems that share a law)
+SM_API bool SmRecord(SmSystem *system, int every); // Record the displacement every `every` steps (0: stop)
+SM_API long SmHistoryCount(const SmSystem *system); // Samples recorded
+SM_API long SmHistoryRecent(SmSystem *system, SmSample *out, long max); // Newest samples, oldest first
+SM_API int SmHistoryQuery(SmSystem *system, double t0, double t1, int columns,
+                          SmColumn *out); // Min/max per column over [t0, t1] (returns filled columns, -1: no memory)
+SM_API void SmHistoryClear(SmSystem *system); // Drop the recorded samples
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
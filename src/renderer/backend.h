@@ -0,0 +1,76 @@
+/**********************************************************************************************************
+ * @file backend.h                                                                                        *
+ * @brief Drawing backend interface between the renderer and the platform (raylib or the CPU rasterizer). *
+ * @author Gabe G.                                                                                        *
+ * @date 10-19-2026                                                                                       *
+ **********************************************************************************************************/
+
+#ifndef BACKEND_H
+#define BACKEND_H
+
+#include "consts.h"
+#include <stdbool.h>
+
+// Backend-neutral keys and buttons used by the drawing code
+typedef enum RenderKey
+{
+    RENDER_KEY_HOME,
+    RENDER_KEY_END
+} RenderKey;
+
+typedef enum RenderButton
+{
+    RENDER_BUTTON_LEFT
+} RenderButton;
+
+// Backend-owned single-channel float image (a texture on the GPU backend, a pixel copy on the CPU one)
+typedef struct RenderImage RenderImage;
+
+// A drawing backend. raylib owns input along with the window, so backends also answer the few
+// input queries the drawing code makes; headless backends report no input.
+typedef struct RenderBackend
+{
+    const char *name;
+
+    // Window and frame
+    void (*openWindow)(int width, int height, const char *title, int fps);
+    void (*closeWindow)(void);
+    bool (*windowShouldClose)(void);
+    void (*beginFrame)(void);
+    void (*endFrame)(void);
+    float (*frameTime)(void);
+    void (*setWindowPosition)(int x, int y);
+
+    // Primitives (thickness <= 1 draws a thin line)
+    void (*clear)(SimColor color);
+    void (*line)(Vec2D from, Vec2D to, float thickness, SimColor color);
+    void (*rect)(float x, float y, float width, float height, SimColor color);
+    void (*rectLines)(float x, float y, float width, float height, SimColor color);
+    void (*circle)(Vec2D center, float radius, SimColor color);
+    void (*text)(const char *text, int x, int y, int fontSize, SimColor color);
+    int (*measureText)(const char *text, int fontSize);
+
+    // Density images: drawn stretched over `bounds` with brightness log(1 + value * scale) * invLogPeak (clamped to
+    // 1), as the tint fading to white and from transparent
+    RenderImage *(*createImage)(int width, int height, const float *pixels);
+    void (*updateImageRows)(RenderImage *image, int firstRow, int rows, const float *pixels);
+    void (*drawImage)(RenderImage *image, SimRect bounds, float scale, float invLogPeak, SimColor tint);
+    void (*destroyImage)(RenderImage *image);
+
+    // Input
+    Vec2D (*mousePosition)(void);
+    float (*mouseWheel)(void);
+    bool (*buttonPressed)(RenderButton button);
+    bool (*buttonDown)(RenderButton button);
+    bool (*keyPressed)(RenderKey key);
+    bool (*latchMousePosition)(Vec2D *position); // Query the cursor now (false: only the last poll is known)
+    int (*refreshRate)(void);                    // Display refresh rate in Hz (0 if unknown)
+} RenderBackend;
+
+extern const RenderBackend *renderBackend; // Backend used by every drawing call (set before opening the window)
+extern const RenderBackend RAYLIB_BACKEND; // GPU backend (backend_raylib.c)
+
+// Backend Function declarations
+void SetRenderBackend(const RenderBackend *backend); // Select the backend for all subsequent drawing
+
+#endif
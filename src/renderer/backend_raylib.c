@@ -0,0 +1,239 @@
+/********************************************************
+ * @file backend_raylib.c                               *
+ * @brief raylib implementation of the drawing backend. *
+ * @author Gabe G.                                      *
+ * @date 10-19-2026                                     *
+ ********************************************************/
+
+#include "renderer/backend.h"
+#include "platform_internal.h"
+#include <stdlib.h>
+
+// A density image is an R32 float texture; the tone map runs in a shader shared by every image
+struct RenderImage
+{
+    Texture2D texture;
+};
+
+static const char *DENSITY_FRAGMENT_SHADER =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform float invScale;\n"
+    "uniform float invLogPeak;\n"
+    "out vec4 finalColor;\n"
+    "void main()\n"
+    "{\n"
+    "    float density = texture(texture0, fragTexCoord).r * invScale;\n"
+    "    float level = clamp(log(1.0 + density) * invLogPeak, 0.0, 1.0);\n"
+    "    finalColor = vec4(mix(fragColor.rgb, vec3(1.0), level * level), level);\n"
+    "}\n";
+
+// Loaded with the first image and released with the last
+static Shader densityShader;
+static int densityUsers = 0;
+static int invScaleLoc;
+static int invLogPeakLoc;
+
+#if defined(RENDER_GLFW_LATCH)
+#include <math.h>
+
+// raylib's desktop platform links GLFW in; it can query the cursor directly instead of returning the last poll
+void glfwGetCursorPos(void *window, double *x, double *y);
+
+#define CURSOR_SCALE_MOVE 8.0 // Raw cursor travel between polls (screen units) needed to measure the scale
+
+// GLFW reports the cursor in screen units; raylib's GetMousePosition adds its mouse offset and applies its mouse
+// scale (which on HiDPI also folds in the content scale), none of which raylib exposes. The latched position is
+// therefore the last polled one moved by the raw travel since that poll, with the scale starting from the window's
+// DPI scale and then measured from polls where the cursor moved.
+typedef struct CursorMap
+{
+    bool valid;     // A poll has been recorded
+    double rawX;    // GLFW cursor right after the last poll
+    double rawY;
+    Vector2 polled; // raylib's mouse position from that poll
+    Vector2 scale;  // raylib units per screen unit
+} CursorMap;
+
+static CursorMap cursorMap;
+#endif
+
+static void RaylibOpenWindow(int width, int height, const char *title, int fps)
+{
+    InitWindow(width, height, title);
+    SetTargetFPS(fps);
+    SetExitKey(KEY_NULL);
+}
+
+static void RaylibLine(Vec2D from, Vec2D to, float thickness, SimColor color)
+{
+    if (thickness <= 1.0f)
+        DrawLineV(SimVectoRayVec(from), SimVectoRayVec(to), SimColorToRayColor(color));
+    else
+        DrawLineEx(SimVectoRayVec(from), SimVectoRayVec(to), thickness, SimColorToRayColor(color));
+}
+
+static void RaylibRect(float x, float y, float width, float height, SimColor color)
+{
+    DrawRectangleRec((Rectangle){ x, y, width, height }, SimColorToRayColor(color));
+}
+
+static void RaylibRectLines(float x, float y, float width, float height, SimColor color)
+{
+    DrawRectangleLines(x, y, width, height, SimColorToRayColor(color));
+}
+
+static void RaylibCircle(Vec2D center, float radius, SimColor color)
+{
+    DrawCircleV(SimVectoRayVec(center), radius, SimColorToRayColor(color));
+}
+
+static void RaylibText(const char *text, int x, int y, int fontSize, SimColor color)
+{
+    DrawText(text, x, y, fontSize, SimColorToRayColor(color));
+}
+
+static void RaylibClear(SimColor color)
+{
+    ClearBackground(SimColorToRayColor(color));
+}
+
+static void RaylibEndFrame(void)
+{
+    EndDrawing(); // Polls input last
+#if defined(RENDER_GLFW_LATCH)
+    double x, y;
+    glfwGetCursorPos(GetWindowHandle(), &x, &y);
+    Vector2 polled = GetMousePosition();
+    if (!cursorMap.valid)
+        cursorMap.scale = IsWindowState(FLAG_WINDOW_HIGHDPI) ? GetWindowScaleDPI() : (Vector2){ 1.0f, 1.0f };
+    else
+    {
+        double dx = x - cursorMap.rawX, dy = y - cursorMap.rawY;
+        if (fabs(dx) >= CURSOR_SCALE_MOVE)
+            cursorMap.scale.x = (float)((polled.x - cursorMap.polled.x) / dx);
+        if (fabs(dy) >= CURSOR_SCALE_MOVE)
+            cursorMap.scale.y = (float)((polled.y - cursorMap.polled.y) / dy);
+    }
+    cursorMap = (CursorMap){ true, x, y, polled, cursorMap.scale };
+#endif
+}
+
+static Vec2D RaylibMousePosition(void)
+{
+    Vector2 point = GetMousePosition();
+    return (Vec2D){ point.x, point.y };
+}
+
+static bool RaylibButtonPressed(RenderButton button)
+{
+    (void)button; // Only the left button is used
+    return IsMouseButtonPressed(MOUSE_BUTTON_LEFT);
+}
+
+static bool RaylibButtonDown(RenderButton button)
+{
+    (void)button;
+    return IsMouseButtonDown(MOUSE_BUTTON_LEFT);
+}
+
+static bool RaylibKeyPressed(RenderKey key)
+{
+    return IsKeyPressed(key == RENDER_KEY_HOME ? KEY_HOME : KEY_END);
+}
+
+static bool RaylibLatchMousePosition(Vec2D *position)
+{
+#if defined(RENDER_GLFW_LATCH)
+    if (!cursorMap.valid)
+    {
+        *position = RaylibMousePosition();
+        return false;
+    }
+    double x, y;
+    glfwGetCursorPos(GetWindowHandle(), &x, &y);
+    *position = (Vec2D){ cursorMap.polled.x + (float)((x - cursorMap.rawX) * cursorMap.scale.x),
+                         cursorMap.polled.y + (float)((y - cursorMap.rawY) * cursorMap.scale.y) };
+    return true;
+#else
+    *position = RaylibMousePosition(); // Input is only polled in EndDrawing
+    return false;
+#endif
+}
+
+static int RaylibRefreshRate(void)
+{
+    return GetMonitorRefreshRate(GetCurrentMonitor());
+}
+
+static RenderImage *RaylibCreateImage(int width, int height, const float *pixels)
+{
+    RenderImage *image = malloc(sizeof(RenderImage));
+    if (image == NULL)
+        return NULL;
+    Image source = { (void *)pixels, width, height, 1, PIXELFORMAT_UNCOMPRESSED_R32 };
+    image->texture = LoadTextureFromImage(source);
+    if (densityUsers++ == 0)
+    {
+        densityShader = LoadShaderFromMemory(NULL, DENSITY_FRAGMENT_SHADER);
+        invScaleLoc = GetShaderLocation(densityShader, "invScale");
+        invLogPeakLoc = GetShaderLocation(densityShader, "invLogPeak");
+    }
+    return image;
+}
+
+static void RaylibUpdateImageRows(RenderImage *image, int firstRow, int rows, const float *pixels)
+{
+    UpdateTextureRec(image->texture, (Rectangle){ 0, firstRow, image->texture.width, rows }, pixels);
+}
+
+static void RaylibDrawImage(RenderImage *image, SimRect bounds, float scale, float invLogPeak, SimColor tint)
+{
+    SetShaderValue(densityShader, invScaleLoc, &scale, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(densityShader, invLogPeakLoc, &invLogPeak, SHADER_UNIFORM_FLOAT);
+    BeginShaderMode(densityShader);
+    DrawTexturePro(image->texture, (Rectangle){ 0, 0, image->texture.width, image->texture.height },
+                   SimRectToRayRect(bounds), (Vector2){ 0, 0 }, 0.0f, SimColorToRayColor(tint));
+    EndShaderMode();
+}
+
+static void RaylibDestroyImage(RenderImage *image)
+{
+    if (image == NULL)
+        return;
+    UnloadTexture(image->texture);
+    if (--densityUsers == 0)
+        UnloadShader(densityShader);
+    free(image);
+}
+
+const RenderBackend RAYLIB_BACKEND = {
+    .name = "raylib",
+    .openWindow = RaylibOpenWindow,
+    .closeWindow = CloseWindow,
+    .windowShouldClose = WindowShouldClose,
+    .beginFrame = BeginDrawing,
+    .endFrame = RaylibEndFrame,
+    .frameTime = GetFrameTime,
+    .setWindowPosition = SetWindowPosition,
+    .clear = RaylibClear,
+    .line = RaylibLine,
+    .rect = RaylibRect,
+    .rectLines = RaylibRectLines,
+    .circle = RaylibCircle,
+    .text = RaylibText,
+    .measureText = MeasureText,
+    .createImage = RaylibCreateImage,
+    .updateImageRows = RaylibUpdateImageRows,
+    .drawImage = RaylibDrawImage,
+    .destroyImage = RaylibDestroyImage,
+    .mousePosition = RaylibMousePosition,
+    .mouseWheel = GetMouseWheelMove,
+    .buttonPressed = RaylibButtonPressed,
+    .buttonDown = RaylibButtonDown,
+    .keyPressed = RaylibKeyPressed,
+    .latchMousePosition = RaylibLatchMousePosition,
+    .refreshRate = RaylibRefreshRate,
+};
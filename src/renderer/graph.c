@@ -6,23 +6,18 @@
  ***************************************************************************************************/
 
 #include "graph.h"
-#include "platform_internal.h"
 #include "renderer.h"
+#include "renderer/backend.h"
+#include <math.h>
+#include <stdarg.h>
 #include <stdio.h>
 #include <string.h>
 
-// Maximum number of data points to store
-#define MAX_POINTS 2000
-
-// Time window to display (in seconds)
+// Time window to display when following the live edge (in seconds)
 #define TIME_WINDOW 15.0f
 
-// Graph data storage
-static Vector2 dataPoints[MAX_POINTS];
-static int pointCount = 0;
-static float minDisplacement = 0.0f;
-static float maxDisplacement = 0.0f;
-static float maxTime = 0.0f;
+// Narrowest zoom (in seconds); about ten samples at 60 Hz
+#define MIN_TIME_SPAN 0.15f
 
 // Graph window dimensions and position
 static const int GRAPH_WIDTH = SCREEN_WIDTH;
@@ -30,165 +25,501 @@ static const int GRAPH_HEIGHT = SCREEN_HEIGHT;
 static const int GRAPH_X = SCREEN_WIDTH + 100;
 static const int GRAPH_Y = 0;
 
-// Margin for graph drawing
+// Margin for graph drawing (shrunk for small graphs)
 static const int MARGIN = 50;
 
-void InitGraph(void)
+static int GraphMargin(SimRect bounds);                 // Margin around the plot area for `bounds`
+static const char *GraphFormat(GraphState *graph, const char *format, ...); // printf into the graph's label buffer
+static void HandleGraphInput(GraphState *graph, SimRect bounds,
+                             double time); // Zoom/pan the view with the mouse and keyboard
+static void DrawGraphChannel(GraphState *graph, SimRect bounds, double timeWindowStart, double timeWindowEnd,
+                             int graphWidth, int columnCount); // Overlay the second channel on its own scale
+static double ForecastEnd(const GraphState *graph, double time);    // End of a forecast still ahead of `time` (or 0)
+static void DrawGraphForecast(const GraphState *graph, SimRect bounds, double timeWindowStart, double timeRange,
+                              float low, float displacementRange, SimColor color); // Ghost curve of the forecast
+
+void InitGraph(GraphState *graph)
 {
-    // Set the window position for the graph window
-    SetWindowPosition(GRAPH_X, GRAPH_Y);
-
     // Initialize data
-    pointCount = 0;
-    minDisplacement = 0.0f;
-    maxDisplacement = 0.0f;
-    maxTime = 0.0f;
+    HistoryInit(&graph->history);
+    graph->minDisplacement = 0.0f;
+    graph->maxDisplacement = 0.0f;
+    graph->maxTime = 0.0;
+
+    // View: the window [viewEnd - viewSpan, viewEnd], pinned to the newest sample while following
+    graph->viewSpan = TIME_WINDOW;
+    graph->viewEnd = 0.0;
+    graph->followLive = true;
+    graph->isPanning = false;
+    graph->panLastMouseX = 0.0f;
+    graph->channelReady = false;
+    graph->channelLabel = NULL;
+    graph->columnStride = 1;
+    graph->forecast = (GraphForecast){ 0 };
+}
+
+void InitGraphWindow(void)
+{
+    // Set the window position for the graph window
+    renderBackend->setWindowPosition(GRAPH_X, GRAPH_Y);
+}
 
-    memset(dataPoints, 0, sizeof(dataPoints));
+SimRect GraphWindowBounds(void)
+{
+    return (SimRect){ GRAPH_X, GRAPH_Y, GRAPH_WIDTH, GRAPH_HEIGHT };
 }
 
-void UpdateGraph(float displacement, float time)
+void UpdateGraph(GraphState *graph, float displacement, double time)
 {
     // Add new data point
-    if (pointCount < MAX_POINTS)
-    {
-        dataPoints[pointCount].x = time;
-        dataPoints[pointCount].y = displacement;
-        pointCount++;
-    }
-    else
-    {
-        // Shift all points left and add new point at the end
-        for (int i = 0; i < MAX_POINTS - 1; i++)
-        {
-            dataPoints[i] = dataPoints[i + 1];
-        }
-        dataPoints[MAX_POINTS - 1].x = time;
-        dataPoints[MAX_POINTS - 1].y = displacement;
-    }
+    HistoryAppend(&graph->history, time, displacement);
 
     // Update min/max values for scaling
-    if (displacement < minDisplacement)
-        minDisplacement = displacement;
-    if (displacement > maxDisplacement)
-        maxDisplacement = displacement;
-    if (time > maxTime)
-        maxTime = time;
+    if (displacement < graph->minDisplacement)
+        graph->minDisplacement = displacement;
+    if (displacement > graph->maxDisplacement)
+        graph->maxDisplacement = displacement;
+    if (time > graph->maxTime)
+        graph->maxTime = time;
 }
 
-void DrawGraph(float displacement, float time, SimColor *themeColor)
+void DrawGraph(GraphState *graph, SimRect bounds, float displacement, double time, SimColor *themeColor)
 {
-    // All drawing is offset to start at (WIDTH+1, 0)
-    int offsetX = GRAPH_X;
-    int offsetY = GRAPH_Y;
+    // All drawing is offset to start at the top-left of `bounds`
+    int offsetX = bounds.x;
+    int offsetY = bounds.y;
+    int width = bounds.width;
+    int height = bounds.height;
+    int margin = GraphMargin(bounds);
+
+    HandleGraphInput(graph, bounds, time);
 
     // Draw background
-    DrawRectangle(offsetX, offsetY, GRAPH_WIDTH, GRAPH_HEIGHT, BLACK);
+    renderBackend->rect(offsetX, offsetY, width, height, SIM_BLACK);
 
     // Draw axes
-    int graphWidth = GRAPH_WIDTH - 2 * MARGIN;
-    int graphHeight = GRAPH_HEIGHT - 2 * MARGIN;
+    int graphWidth = width - 2 * margin;
+    int graphHeight = height - 2 * margin;
+    if (graphWidth > SCREEN_WIDTH)
+        graphWidth = SCREEN_WIDTH; // One query column per pixel, up to the column buffer size
 
     // X-axis (time)
-    DrawLine(offsetX + MARGIN, offsetY + GRAPH_HEIGHT - MARGIN, offsetX + GRAPH_WIDTH - MARGIN,
-             offsetY + GRAPH_HEIGHT - MARGIN, BLACK);
-    DrawText("Time (s)", offsetX + GRAPH_WIDTH / 2 - 30, offsetY + GRAPH_HEIGHT - MARGIN + 25, 15, LIGHTGRAY);
+    renderBackend->line((Vec2D){ offsetX + margin, offsetY + height - margin },
+                        (Vec2D){ offsetX + width - margin, offsetY + height - margin }, 1.0f, SIM_BLACK);
+    renderBackend->text("Time (s)", offsetX + width / 2 - 30, offsetY + height - margin + margin / 2, 15,
+                        SIM_LIGHTGRAY);
 
     // Y-axis (displacement)
-    DrawLine(offsetX + MARGIN, offsetY + MARGIN, offsetX + MARGIN, offsetY + GRAPH_HEIGHT - MARGIN, BLACK);
-    DrawText("Displacement", offsetX + 5, offsetY + 30, 15, LIGHTGRAY);
+    renderBackend->line((Vec2D){ offsetX + margin, offsetY + margin },
+                        (Vec2D){ offsetX + margin, offsetY + height - margin }, 1.0f, SIM_BLACK);
+    renderBackend->text("Displacement", offsetX + 5, offsetY + margin * 3 / 5, 15, SIM_LIGHTGRAY);
 
     // Draw grid lines
     for (int i = 0; i <= 10; i++)
     {
-        int x = offsetX + MARGIN + (graphWidth * i) / 10;
-        int y = offsetY + MARGIN + (graphHeight * i) / 10;
-        DrawLine(x, offsetY + MARGIN, x, offsetY + GRAPH_HEIGHT - MARGIN, LIGHTGRAY);
-        DrawLine(offsetX + MARGIN, y, offsetX + GRAPH_WIDTH - MARGIN, y, LIGHTGRAY);
+        int x = offsetX + margin + (graphWidth * i) / 10;
+        int y = offsetY + margin + (graphHeight * i) / 10;
+        renderBackend->line((Vec2D){ x, offsetY + margin }, (Vec2D){ x, offsetY + height - margin }, 1.0f,
+                            SIM_LIGHTGRAY);
+        renderBackend->line((Vec2D){ offsetX + margin, y }, (Vec2D){ offsetX + width - margin, y }, 1.0f,
+                            SIM_LIGHTGRAY);
+    }
+
+    // Visible time window; the live view runs to the end of a forecast that is still ahead
+    double forecastEnd = ForecastEnd(graph, time);
+    double timeWindowEnd = graph->followLive ? fmax(time, forecastEnd) : graph->viewEnd;
+    double timeWindowStart = timeWindowEnd - graph->viewSpan;
+    if (graph->followLive && timeWindowStart < 0.0)
+    {
+        timeWindowStart = 0.0;
+        timeWindowEnd = graph->viewSpan;
+    }
+    double timeRange = timeWindowEnd - timeWindowStart;
+
+    // One min/max column per pixel (or per `columnStride` pixels when the frame budget is tight): the pyramid
+    // level is chosen so that only O(columns) nodes are read
+    HistoryColumn *columns = graph->columns;
+    int columnCount = (graphWidth + graph->columnStride - 1) / graph->columnStride;
+    HistoryQuery(&graph->history, timeWindowStart, timeWindowEnd, columnCount, columns);
+
+    // Live view scales to the whole session (as before); a zoomed view scales to what is visible
+    float low = graph->minDisplacement;
+    float high = graph->maxDisplacement;
+    if (!graph->followLive)
+    {
+        low = 0.0f;
+        high = 0.0f;
+        for (int c = 0; c < columnCount; c++)
+        {
+            if (!columns[c].valid)
+                continue;
+            if (columns[c].min < low)
+                low = columns[c].min;
+            if (columns[c].max > high)
+                high = columns[c].max;
+        }
+    }
+
+    if (forecastEnd > 0.0)
+    {
+        low = fminf(low, graph->forecast.min);
+        high = fmaxf(high, graph->forecast.max);
     }
 
     // Draw equilibrium line (displacement = 0) if we have data
-    if (pointCount > 0)
+    if (HistoryCount(&graph->history) > 0)
     {
-        float displacementRange = maxDisplacement - minDisplacement;
+        float displacementRange = high - low;
         if (displacementRange >= 0.1f)
         {
             // Calculate y position for displacement = 0
-            float equilibriumY =
-                offsetY + GRAPH_HEIGHT - MARGIN - ((0.0f - minDisplacement) / displacementRange) * graphHeight;
+            float equilibriumY = offsetY + height - margin - ((0.0f - low) / displacementRange) * graphHeight;
 
             // Create a lighter version of theme color by blending with white
-            Color lighterTheme = { themeColor->r + (255 - themeColor->r) * 0.5f,
-                                   themeColor->g + (255 - themeColor->g) * 0.5f,
-                                   themeColor->b + (255 - themeColor->b) * 0.5f, themeColor->a };
+            SimColor lighterTheme = { themeColor->r + (255 - themeColor->r) * 0.5f,
+                                      themeColor->g + (255 - themeColor->g) * 0.5f,
+                                      themeColor->b + (255 - themeColor->b) * 0.5f, themeColor->a };
 
-            DrawLineEx((Vector2){ offsetX + MARGIN, equilibriumY },
-                       (Vector2){ offsetX + GRAPH_WIDTH - MARGIN, equilibriumY }, 2.0f, lighterTheme);
+            renderBackend->line((Vec2D){ offsetX + margin, equilibriumY },
+                                (Vec2D){ offsetX + width - margin, equilibriumY }, 2.0f, lighterTheme);
         }
     }
 
-    // Draw data points if we have any
-    if (pointCount > 1)
+    // Draw data if we have any
+    if (HistoryCount(&graph->history) > 1)
     {
-        // Use a sliding time window
-        float timeWindowStart = (time > TIME_WINDOW) ? (time - TIME_WINDOW) : 0.0f;
-        float timeWindowEnd = time;
-        float timeRange = timeWindowEnd - timeWindowStart;
-
-        float displacementRange = maxDisplacement - minDisplacement;
+        float displacementRange = high - low;
         if (displacementRange < 0.1f)
             displacementRange = 0.1f; // Avoid division by zero
 
-        for (int i = 0; i < pointCount - 1; i++)
+        SimColor lineColor = *themeColor;
+        bool havePrevious = false;
+        Vec2D previous = { 0 };
+        for (int c = 0; c < columnCount; c++)
         {
-            // Only draw points within the time window
-            if (dataPoints[i].x < timeWindowStart && dataPoints[i + 1].x < timeWindowStart)
+            if (!columns[c].valid)
                 continue;
-            if (dataPoints[i].x > timeWindowEnd)
-                break;
-
-            // Map time to x coordinate (relative to time window)
-            float x1 = offsetX + MARGIN + ((dataPoints[i].x - timeWindowStart) / timeRange) * graphWidth;
-            float x2 = offsetX + MARGIN + ((dataPoints[i + 1].x - timeWindowStart) / timeRange) * graphWidth;
 
             // Map displacement to y coordinate (inverted because screen y is top-down)
-            float y1 = offsetY + GRAPH_HEIGHT - MARGIN -
-                       ((dataPoints[i].y - minDisplacement) / displacementRange) * graphHeight;
-            float y2 = offsetY + GRAPH_HEIGHT - MARGIN -
-                       ((dataPoints[i + 1].y - minDisplacement) / displacementRange) * graphHeight;
-
-            DrawLineEx((Vector2){ x1, y1 }, (Vector2){ x2, y2 }, 2.0f, SimColorToRayColor(*themeColor));
+            float x = offsetX + margin + (float)c * graphWidth / columnCount;
+            float yMin = offsetY + height - margin - ((columns[c].min - low) / displacementRange) * graphHeight;
+            float yMax = offsetY + height - margin - ((columns[c].max - low) / displacementRange) * graphHeight;
+            Vec2D mid = { x, 0.5f * (yMin + yMax) };
+
+            // Envelope of everything in this pixel column, joined to its neighbour
+            if (yMin - yMax >= 1.0f)
+                renderBackend->line((Vec2D){ x, yMax }, (Vec2D){ x, yMin }, 2.0f, lineColor);
+            if (havePrevious)
+                renderBackend->line(previous, mid, 2.0f, lineColor);
+            previous = mid;
+            havePrevious = true;
         }
 
         // Draw current point
-        float x = offsetX + MARGIN + ((dataPoints[pointCount - 1].x - timeWindowStart) / timeRange) * graphWidth;
-        float y = offsetY + GRAPH_HEIGHT - MARGIN -
-                  ((dataPoints[pointCount - 1].y - minDisplacement) / displacementRange) * graphHeight;
-        DrawCircle(x, y, 4, RED);
+        double first, last;
+        if (HistoryTimeRange(&graph->history, &first, &last) && last >= timeWindowStart && last <= timeWindowEnd)
+        {
+            HistoryNode newest;
+            HistoryRecent(&graph->history, &newest, 1);
+            float x = offsetX + margin + (float)((newest.t1 - timeWindowStart) / timeRange) * graphWidth;
+            float y = offsetY + height - margin - ((newest.max - low) / displacementRange) * graphHeight;
+            renderBackend->circle((Vec2D){ x, y }, 4, SIM_RED);
+        }
+    }
+
+    if (forecastEnd > 0.0)
+    {
+        SimColor ghost = { themeColor->r, themeColor->g, themeColor->b, 96 };
+        DrawGraphForecast(graph, bounds, timeWindowStart, timeRange, low, high - low > 0.1f ? high - low : 0.1f,
+                          ghost);
     }
 
+    if (graph->channelLabel != NULL)
+        DrawGraphChannel(graph, bounds, timeWindowStart, timeWindowEnd, graphWidth, columnCount);
+
     // Draw current values
-    DrawText(TextFormat("Current Displacement: %.2f", displacement), offsetX + GRAPH_WIDTH - 545, offsetY + MARGIN - 25,
-             15, SimColorToRayColor(*themeColor));
+    int valueX = width - 545 > margin ? width - 545 : margin;
+    renderBackend->text(GraphFormat(graph, "Current Displacement: %.2f", displacement), offsetX + valueX,
+                        offsetY + margin / 2, 15, *themeColor);
+    if (!graph->followLive)
+        renderBackend->text("Wheel: zoom  Drag: pan  Home: session  End: live", offsetX + margin, offsetY + 10, 12,
+                            SIM_GRAY);
 
     // Draw min/max labels
-    DrawText(TextFormat("%.2f", maxDisplacement), offsetX + 5, offsetY + MARGIN, 12, GRAY);
-    DrawText(TextFormat("%.2f", minDisplacement), offsetX + 5, offsetY + GRAPH_HEIGHT - MARGIN - 5, 12, GRAY);
+    renderBackend->text(GraphFormat(graph, "%.2f", high), offsetX + 5, offsetY + margin, 12, SIM_GRAY);
+    renderBackend->text(GraphFormat(graph, "%.2f", low), offsetX + 5, offsetY + height - margin - 5, 12, SIM_GRAY);
+
+    // Draw time labels for the visible window
+    renderBackend->text(GraphFormat(graph, "%.1f", timeWindowStart), offsetX + margin - 10,
+                        offsetY + height - margin + 5, 12, SIM_GRAY);
+    renderBackend->text(GraphFormat(graph, "%.1f", timeWindowEnd), offsetX + width - margin - 20,
+                        offsetY + height - margin + 5, 12, SIM_GRAY);
+}
 
-    // Draw time labels for the sliding window
-    float timeWindowStart = (time > TIME_WINDOW) ? (time - TIME_WINDOW) : 0.0f;
-    DrawText(TextFormat("%.1f", timeWindowStart), offsetX + MARGIN - 10, offsetY + GRAPH_HEIGHT - MARGIN + 5, 12, GRAY);
-    DrawText(TextFormat("%.1f", time), offsetX + GRAPH_WIDTH - MARGIN - 20, offsetY + GRAPH_HEIGHT - MARGIN + 5, 12,
-             GRAY);
+void GraphSetChannel(GraphState *graph, const char *label)
+{
+    if (label != NULL && !graph->channelReady)
+    {
+        HistoryInit(&graph->channel);
+        graph->channelReady = true;
+    }
+    if (label != NULL && label != graph->channelLabel)
+        HistoryClear(&graph->channel); // A different quantity: its old samples don't belong on the new scale
+    graph->channelLabel = label;
 }
 
-void CloseGraph(void)
+void GraphSetColumnStride(GraphState *graph, int stride)
 {
-    // Clean up if needed
-    pointCount = 0;
+    graph->columnStride = stride > 0 ? stride : 1;
+}
+
+void GraphSetForecast(GraphState *graph, const GraphForecast *forecast)
+{
+    graph->forecast = forecast != NULL ? *forecast : (GraphForecast){ 0 };
+}
+
+void UpdateGraphChannel(GraphState *graph, float value, double time)
+{
+    if (graph->channelLabel != NULL)
+        HistoryAppend(&graph->channel, time, value);
+}
+
+void CloseGraph(GraphState *graph)
+{
+    // Release history pages and the spill file
+    HistoryFree(&graph->history);
+    if (graph->channelReady)
+        HistoryFree(&graph->channel);
+    graph->channelReady = false;
+    graph->channelLabel = NULL;
 }
 
 bool GraphWindowShouldClose(void)
 {
-    return WindowShouldClose();
+    return renderBackend->windowShouldClose();
+}
+
+void GraphGetHistory(GraphState *graph, GraphHistory *out)
+{
+    // The samples themselves are saved whole from GraphFreezeHistory
+    out->points = NULL;
+    out->count = 0;
+    out->minDisplacement = graph->minDisplacement;
+    out->maxDisplacement = graph->maxDisplacement;
+    out->maxTime = graph->maxTime;
+}
+
+void GraphRestoreHistory(GraphState *graph, const GraphHistory *in)
+{
+    HistoryClear(&graph->history);
+    for (int i = 0; i < in->count; i++)
+        HistoryAppend(&graph->history, in->points[i].x, in->points[i].y);
+    graph->minDisplacement = in->minDisplacement;
+    graph->maxDisplacement = in->maxDisplacement;
+    graph->maxTime = in->maxTime;
+    graph->followLive = true;
+}
+
+bool GraphFreezeHistory(GraphState *graph, History *frozen)
+{
+    // The graph only clears its history on restore and frees it on close, after the snapshot writer has stopped
+    return HistoryFreeze(&graph->history, frozen);
+}
+
+bool GraphLoadHistoryImage(GraphState *graph, const unsigned char *data, size_t size)
+{
+    if (!HistoryLoadImage(&graph->history, data, size))
+        return false;
+    double first, last;
+    if (HistoryTimeRange(&graph->history, &first, &last))
+        graph->maxTime = last; // Exact, unlike the float kept with the scale
+    graph->followLive = true;
+    return true;
+}
+
+/***************************************
+ *      Internal helper functions      *
+ ***************************************/
+
+static int GraphMargin(SimRect bounds)
+{
+    int smaller = bounds.width < bounds.height ? bounds.width : bounds.height;
+    return smaller < 8 * MARGIN ? smaller / 8 : MARGIN;
+}
+
+static const char *GraphFormat(GraphState *graph, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    vsnprintf(graph->label, sizeof(graph->label), format, args);
+    va_end(args);
+    return graph->label;
+}
+
+static void DrawGraphChannel(GraphState *graph, SimRect bounds, double timeWindowStart, double timeWindowEnd,
+                             int graphWidth, int columnCount)
+{
+    int margin = GraphMargin(bounds);
+    float bottom = bounds.y + bounds.height - margin;
+    float graphHeight = bounds.height - 2 * margin;
+    HistoryColumn *columns = graph->channelColumns;
+    HistoryQuery(&graph->channel, timeWindowStart, timeWindowEnd, columnCount, columns);
+
+    // Scaled to what is visible, symmetric about zero so the sign of the channel reads at a glance
+    float extent = 0.0f;
+    for (int c = 0; c < columnCount; c++)
+    {
+        if (!columns[c].valid)
+            continue;
+        if (-columns[c].min > extent)
+            extent = -columns[c].min;
+        if (columns[c].max > extent)
+            extent = columns[c].max;
+    }
+    if (extent <= 0.0f)
+        extent = 1.0f;
+
+    bool havePrevious = false;
+    Vec2D previous = { 0 };
+    for (int c = 0; c < columnCount; c++)
+    {
+        if (!columns[c].valid)
+            continue;
+        float x = bounds.x + margin + (float)c * graphWidth / columnCount;
+        float yMin = bottom - (columns[c].min + extent) / (2 * extent) * graphHeight;
+        float yMax = bottom - (columns[c].max + extent) / (2 * extent) * graphHeight;
+        Vec2D mid = { x, 0.5f * (yMin + yMax) };
+        if (yMin - yMax >= 1.0f)
+            renderBackend->line((Vec2D){ x, yMax }, (Vec2D){ x, yMin }, 1.0f, SIM_ORANGE);
+        if (havePrevious)
+            renderBackend->line(previous, mid, 1.0f, SIM_ORANGE);
+        previous = mid;
+        havePrevious = true;
+    }
+
+    // Label and scale on the right-hand side
+    SeriesSample last;
+    float value = SeriesLast(&graph->channel.samples, &last) ? last.value : 0.0f;
+    int right = bounds.x + bounds.width - margin + 5;
+    renderBackend->text(GraphFormat(graph, "%s: %.4g", graph->channelLabel, value), bounds.x + margin + 5,
+                        bounds.y + margin + 5, 15, SIM_ORANGE);
+    renderBackend->text(GraphFormat(graph, "%.3g", extent), right, bounds.y + margin, 12, SIM_ORANGE);
+    renderBackend->text(GraphFormat(graph, "%.3g", -extent), right, bottom - 5, 12, SIM_ORANGE);
+}
+
+static void HandleGraphInput(GraphState *graph, SimRect bounds, double time)
+{
+    int margin = GraphMargin(bounds);
+    float graphWidth = bounds.width - 2 * margin;
+    Vec2D mouse = renderBackend->mousePosition();
+    bool overGraph = mouse.x >= bounds.x + margin && mouse.x <= bounds.x + bounds.width - margin &&
+                     mouse.y >= bounds.y + margin && mouse.y <= bounds.y + bounds.height - margin;
+
+    // Current window, unpinned from the live edge if the user is about to move it
+    float span = graph->viewSpan;
+    double end = graph->followLive ? (time > span ? time : span) : graph->viewEnd;
+    double sessionSpan = time > TIME_WINDOW ? time : TIME_WINDOW;
+
+    // Zoom around the time under the cursor
+    float wheel = renderBackend->mouseWheel();
+    if (overGraph && wheel != 0.0f)
+    {
+        float fraction = (mouse.x - (bounds.x + margin)) / graphWidth;
+        double anchor = end - span + fraction * span;
+        span *= (wheel > 0.0f ? 0.8f : 1.25f);
+        if (span < MIN_TIME_SPAN)
+            span = MIN_TIME_SPAN;
+        if (span > sessionSpan)
+            span = (float)sessionSpan;
+        end = anchor + (1.0f - fraction) * span;
+        graph->viewSpan = span;
+        graph->followLive = false;
+    }
+
+    // Drag to pan
+    if (overGraph && renderBackend->buttonPressed(RENDER_BUTTON_LEFT))
+    {
+        graph->isPanning = true;
+        graph->panLastMouseX = mouse.x;
+    }
+    if (graph->isPanning)
+    {
+        if (!renderBackend->buttonDown(RENDER_BUTTON_LEFT))
+            graph->isPanning = false;
+        else if (mouse.x != graph->panLastMouseX)
+        {
+            end -= (mouse.x - graph->panLastMouseX) / graphWidth * span;
+            graph->panLastMouseX = mouse.x;
+            graph->followLive = false;
+        }
+    }
+
+    // Home shows the whole session, End returns to the live window
+    if (renderBackend->keyPressed(RENDER_KEY_HOME))
+    {
+        graph->viewSpan = (float)sessionSpan;
+        end = sessionSpan;
+        graph->followLive = false;
+    }
+    if (renderBackend->keyPressed(RENDER_KEY_END))
+    {
+        graph->viewSpan = TIME_WINDOW;
+        graph->followLive = true;
+        return;
+    }
+
+    if (graph->followLive)
+        return;
+
+    // Keep the window inside the session; reaching the newest sample resumes following it
+    if (end - graph->viewSpan < 0.0)
+        end = graph->viewSpan;
+    if (end >= time)
+    {
+        end = time;
+        graph->followLive = true;
+    }
+    graph->viewEnd = end;
+}
+
+static double ForecastEnd(const GraphState *graph, double time)
+{
+    const GraphForecast *forecast = &graph->forecast;
+    if (forecast->count < 2)
+        return 0.0;
+    double end = forecast->t0 + (forecast->count - 1) * (double)forecast->interval;
+    return end > time ? end : 0.0;
+}
+
+static void DrawGraphForecast(const GraphState *graph, SimRect bounds, double timeWindowStart, double timeRange,
+                              float low, float displacementRange, SimColor color)
+{
+    int margin = GraphMargin(bounds);
+    int graphWidth = bounds.width - 2 * margin;
+    if (graphWidth > SCREEN_WIDTH)
+        graphWidth = SCREEN_WIDTH;
+    float graphHeight = bounds.height - 2 * margin;
+    float bottom = bounds.y + bounds.height - margin;
+
+    // About one segment per pixel: the forecast can hold more samples than the plot is wide
+    const GraphForecast *forecast = &graph->forecast;
+    float pixels = (float)(forecast->interval / timeRange * graphWidth);
+    int stride = pixels > 0.0f && pixels < 1.0f ? (int)(1.0f / pixels) : 1;
+    bool havePrevious = false;
+    Vec2D previous = { 0 };
+    for (int i = 0; i < forecast->count; i += stride)
+    {
+        double t = forecast->t0 + i * (double)forecast->interval;
+        if (t < timeWindowStart || t > timeWindowStart + timeRange)
+        {
+            havePrevious = false;
+            continue;
+        }
+        Vec2D point = { bounds.x + margin + (float)((t - timeWindowStart) / timeRange) * graphWidth,
+                        bottom - (forecast->displacement[i] - low) / displacementRange * graphHeight };
+        if (havePrevious)
+            renderBackend->line(previous, point, 2.0f, color);
+        previous = point;
+        havePrevious = true;
+    }
 }
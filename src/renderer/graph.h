@@ -9,13 +9,76 @@
 #define GRAPH_H
 
 #include "consts.h"
-#include "raylib.h"
+#include "renderer/history.h"
+
+// Graph scale plus, for snapshots from before history images, a list of samples to replay
+typedef struct GraphHistory
+{
+    const Vec2D *points;   // (time, displacement) samples, oldest first (NULL from GraphGetHistory)
+    int count;             // Number of samples in `points`
+    float minDisplacement; // Smallest displacement seen
+    float maxDisplacement; // Largest displacement seen
+    float maxTime;         // Latest sample time
+} GraphHistory;
+
+// Predicted displacement drawn as a ghost curve ahead of the live edge
+typedef struct GraphForecast
+{
+    const float *displacement; // Samples from t0, `interval` seconds apart (owned by the caller)
+    int count;                 // Samples (0: no forecast)
+    double t0;                 // Time of sample 0
+    float interval;            // Seconds between samples
+    float min;                 // Range of the samples
+    float max;
+} GraphForecast;
+
+// Per-simulation graph: the session history plus the current view
+typedef struct GraphState
+{
+    History history;       // Every sample of the session
+    float minDisplacement; // Smallest displacement seen
+    float maxDisplacement; // Largest displacement seen
+    double maxTime;        // Latest sample time
+    float viewSpan;        // Seconds shown
+    double viewEnd;        // Right edge of the view when not following live
+    bool followLive;       // View is pinned to the newest sample
+    bool isPanning;        // View is being dragged
+    float panLastMouseX;   // Mouse x at the last pan update
+
+    // Optional second channel drawn on its own scale (e.g. a parameter sensitivity)
+    History channel;          // Channel samples (set up on first use)
+    bool channelReady;        // `channel` has been initialized
+    const char *channelLabel; // Shown channel (NULL: hidden)
+
+    int columnStride; // Pixels per min/max column (1: full detail)
+
+    GraphForecast forecast; // Ghost curve; the live view extends to its end while it is ahead
+
+    // Scratch owned by the graph, so graphs of different simulations never share buffers
+    HistoryColumn columns[SCREEN_WIDTH];        // Displacement columns of the last draw
+    HistoryColumn channelColumns[SCREEN_WIDTH]; // Second-channel columns of the last draw
+    char label[128];                            // Formatted axis label being drawn
+} GraphState;
 
 // Graph Function declarations
-void InitGraph(void);                                                 // Initialize graphing system
-void UpdateGraph(float displacement, float time);                     // Update graph with new data point
-void DrawGraph(float displacement, float time, SimColor *themeColor); // Draw graph to screen
-void CloseGraph(void);                                                // Close graph window
-bool GraphWindowShouldClose(void);                                    // Check if graph window should close
+void InitGraph(GraphState *graph);                            // Initialize graphing system
+void InitGraphWindow(void);                                   // Position the window for the graph
+SimRect GraphWindowBounds(void);                              // Default graph area
+void UpdateGraph(GraphState *graph, float displacement, double time); // Update graph with new data point
+void DrawGraph(GraphState *graph, SimRect bounds, float displacement, double time,
+               SimColor *themeColor);                         // Draw graph into `bounds`
+void GraphSetChannel(GraphState *graph, const char *label);   // Show a second channel (NULL hides it)
+void GraphSetColumnStride(GraphState *graph, int stride);     // Pixels per drawn column (frame-budget detail)
+void GraphSetForecast(GraphState *graph,
+                      const GraphForecast *forecast);         // Show a forecast (NULL hides it); keep its samples alive
+void UpdateGraphChannel(GraphState *graph, float value, double time); // Add a sample to the second channel
+void CloseGraph(GraphState *graph);                           // Close graph window
+bool GraphWindowShouldClose(void);                            // Check if graph window should close
+void GraphGetHistory(GraphState *graph, GraphHistory *history); // Get the graph's scale (samples go in the image)
+void GraphRestoreHistory(GraphState *graph,
+                         const GraphHistory *history);        // Replace stored samples (e.g. from a snapshot)
+bool GraphFreezeHistory(GraphState *graph, History *frozen);  // Copy to save elsewhere (HistoryReleaseFrozen after)
+bool GraphLoadHistoryImage(GraphState *graph, const unsigned char *data,
+                           size_t size);                      // Replace the history with a saved image
 
 #endif
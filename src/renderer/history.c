@@ -0,0 +1,801 @@
+/************************************************************************
+ * @file history.c                                                      *
+ * @brief Implementation of the multi-resolution graph history pyramid. *
+ * @author Gabe G.                                                      *
+ * @date 10-19-2026                                                     *
+ ************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "renderer/history.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Saved image: HistoryImage, the Series image, then the nodes of each level in order
+typedef struct HistoryImage
+{
+    int64_t partialCount;
+    int32_t levelCount;
+    int32_t reserved; // Zero
+    HistoryNode partial;
+    int64_t counts[HISTORY_MAX_LEVELS];       // Nodes per level
+    HistoryNode pending[HISTORY_MAX_LEVELS]; // Unpaired node per level
+} HistoryImage;
+
+// One decode thread's share of a raw query
+typedef struct DecodeJob
+{
+    const Series *samples;
+    long firstBlock;
+    long lastBlock;
+    double t0;
+    double t1;
+    int columns;
+    HistoryColumn *out;
+} DecodeJob;
+
+// Decode threads shared by every history, started by the first wide raw query and kept for the life of the
+// process. Workers wake on a new query serial and pull shares from `nextJob`, like the soft rasterizer's bands.
+typedef struct DecodePool
+{
+    pthread_t workers[HISTORY_DECODE_THREADS - 1];
+    int workerCount;
+    pthread_mutex_t lock;
+    pthread_cond_t queryReady;
+    pthread_cond_t queryDone;
+    unsigned long querySerial;
+    int workersBusy;
+    bool claimed; // A query owns the pool; any other decodes on its own thread
+    const DecodeJob *jobs;
+    int jobCount;
+    atomic_int nextJob;
+} DecodePool;
+
+static DecodePool pool = { .lock = PTHREAD_MUTEX_INITIALIZER,
+                           .queryReady = PTHREAD_COND_INITIALIZER,
+                           .queryDone = PTHREAD_COND_INITIALIZER };
+static pthread_once_t poolOnce = PTHREAD_ONCE_INIT;
+
+/**********************************
+ *      Forward Declarations      *
+ **********************************/
+
+static void LevelPush(History *history, int level, HistoryNode node); // Append to a level, cascading pairs upward
+static bool ReservePages(HistoryLevel *level, long pages);            // Grow the page table to at least `pages`
+static bool GrowFirstPage(HistoryLevel *level, long nodes);           // Make the first page hold at least `nodes`
+static void SpillPage(History *history, int level, long page);        // Move a full fine page to the spill file
+static void FreeRetired(History *history);                            // Free spilled pages no copy shares any more
+static bool ReadNode(History *history, int level, long index,
+                     HistoryNode *node); // Fetch a node from RAM, cache or disk (false: spilled page unreadable)
+static long FirstNodeEndingAfter(History *history, int level, double t); // First node at `level` with t1 >= t
+static HistoryNode MergeNodes(HistoryNode a, HistoryNode b);            // Combine two adjacent nodes
+static void AddToColumns(HistoryNode node, double t0, double t1, int columns,
+                         HistoryColumn *out); // Merge a node into the column(s) it overlaps
+static void QueryRaw(History *history, double t0, double t1, int columns,
+                     HistoryColumn *out);                           // Bin raw samples, threaded for wide views
+static void DecodeBlocks(const DecodeJob *job);                     // Bin the samples of a block range
+static void StartDecodePool(void);                                  // Create the pool's workers (once)
+static bool ClaimDecodePool(void);                                  // Take the pool (false: another query has it)
+static void RunDecodePool(const DecodeJob *jobs, int count);        // Decode the shares with the pool, then release it
+static void DecodeShares(void);                                     // Decode shares until none are left
+static void *DecodeWorker(void *arg);                               // Pool worker
+static void MergeColumns(HistoryColumn *into, const HistoryColumn *from, int columns); // Combine column sets
+
+/***********************************
+ *      External API Functions     *
+ ***********************************/
+
+void HistoryInit(History *history)
+{
+    memset(history, 0, sizeof(*history));
+    SeriesInit(&history->samples);
+    for (int i = 0; i < HISTORY_CACHE_PAGES; i++)
+        history->cache[i].level = -1;
+}
+
+void HistoryFree(History *history)
+{
+    HistoryClear(history);
+    SeriesFree(&history->samples);
+    for (int i = 0; i < HISTORY_CACHE_PAGES; i++)
+        free(history->cache[i].nodes);
+    free(history->retired);
+    if (history->spillFile)
+        fclose(history->spillFile);
+    memset(history, 0, sizeof(*history));
+}
+
+void HistoryClear(History *history)
+{
+    for (int l = 0; l < HISTORY_MAX_LEVELS; l++)
+    {
+        HistoryLevel *level = &history->levels[l];
+        for (long p = 0; p < level->pageCapacity; p++)
+            free(level->pages[p]);
+        free(level->pages);
+        free(level->offsets);
+        memset(level, 0, sizeof(*level));
+    }
+    for (int i = 0; i < HISTORY_CACHE_PAGES; i++)
+        history->cache[i].level = -1;
+    FreeRetired(history);
+    SeriesClear(&history->samples);
+    history->partialCount = 0;
+    history->levelCount = 0;
+    history->spillEnd = 0; // Old spilled pages are simply overwritten
+}
+
+void HistoryAppend(History *history, double time, float value)
+{
+    SeriesAppend(&history->samples, time, value);
+
+    // Accumulate raw samples into the next base-level node
+    HistoryNode sample = { time, time, value, value };
+    history->partial = history->partialCount ? MergeNodes(history->partial, sample) : sample;
+    if (++history->partialCount == (1L << HISTORY_BASE_LEVEL))
+    {
+        LevelPush(history, HISTORY_BASE_LEVEL, history->partial);
+        history->partialCount = 0;
+    }
+}
+
+long HistoryCount(const History *history)
+{
+    return history->samples.count;
+}
+
+bool HistoryTimeRange(History *history, double *first, double *last)
+{
+    SeriesSample newest;
+    if (!SeriesLast(&history->samples, &newest))
+        return false;
+    *first = history->samples.blocks[0].firstTime;
+    *last = newest.time;
+    return true;
+}
+
+int HistoryQuery(History *history, double t0, double t1, int columns, HistoryColumn *out)
+{
+    for (int c = 0; c < columns; c++)
+        out[c] = (HistoryColumn){ 0.0f, 0.0f, false };
+    if (history->samples.count == 0 || columns <= 0 || t1 <= t0)
+        return 0;
+
+    // Pick the coarsest level that still gives about two nodes per column. The sample count is estimated
+    // from whole blocks, which only matters far below the base level where every choice decodes raw samples.
+    long firstBlock = SeriesFindBlock(&history->samples, t0);
+    long lastBlock = SeriesFindBlock(&history->samples, t1);
+    long samples = (lastBlock - firstBlock + 1) * SERIES_BLOCK_SAMPLES;
+    int level = 0;
+    while (level + 1 < history->levelCount && (samples >> (level + 1)) >= 2 * columns)
+        level++;
+    if (level < HISTORY_BASE_LEVEL)
+    {
+        QueryRaw(history, t0, t1, columns, out);
+        return level;
+    }
+
+    // Complete nodes at the chosen level...
+    HistoryLevel *chosen = &history->levels[level];
+    for (long i = FirstNodeEndingAfter(history, level, t0); i < chosen->count; i++)
+    {
+        HistoryNode node;
+        if (!ReadNode(history, level, i, &node))
+            continue; // Its columns stay empty (drawn as a gap) rather than showing made-up values
+        if (node.t0 > t1)
+            return level;
+        AddToColumns(node, t0, t1, columns, out);
+    }
+    // ...then the newest samples not yet paired into it: one unpaired node per finer level at most,
+    // and the samples short of a whole base-level node
+    for (int l = level - 1; l >= HISTORY_BASE_LEVEL; l--)
+    {
+        if (history->levels[l].count & 1)
+        {
+            HistoryNode node = history->levels[l].pending;
+            if (node.t0 <= t1 && node.t1 >= t0)
+                AddToColumns(node, t0, t1, columns, out);
+        }
+    }
+    if (history->partialCount > 0 && history->partial.t0 <= t1 && history->partial.t1 >= t0)
+        AddToColumns(history->partial, t0, t1, columns, out);
+    return level;
+}
+
+long HistoryRecent(History *history, HistoryNode *out, long max)
+{
+    long count = history->samples.count;
+    long n = count < max ? count : max;
+    SeriesSample chunk[SERIES_BLOCK_SAMPLES];
+    for (long i = 0; i < n; i += SERIES_BLOCK_SAMPLES)
+    {
+        long take = n - i < SERIES_BLOCK_SAMPLES ? n - i : SERIES_BLOCK_SAMPLES;
+        SeriesRead(&history->samples, count - n + i, take, chunk);
+        for (long j = 0; j < take; j++)
+            out[i + j] = (HistoryNode){ chunk[j].time, chunk[j].time, chunk[j].value, chunk[j].value };
+    }
+    return n;
+}
+
+size_t HistoryBytes(const History *history)
+{
+    size_t bytes = history->samples.bytes;
+    for (int l = 0; l < history->levelCount; l++)
+    {
+        const HistoryLevel *level = &history->levels[l];
+        for (long p = 0; p < level->pageCapacity; p++)
+            if (level->pages[p])
+                bytes += (p == 0 ? level->firstCapacity : HISTORY_PAGE_NODES) * sizeof(HistoryNode);
+    }
+    return bytes;
+}
+
+bool HistoryFreeze(History *history, History *frozen)
+{
+    // Full pages and sealed blocks are never written again, so the copy shares them and only duplicates what
+    // appends still touch: page tables, each level's partial last page and the open block. A page spilled while
+    // the copy is out is retired instead of freed. The copy stays valid while the history keeps growing, but not
+    // past HistoryClear or HistoryFree. The spill file is shared too (reads of spilled pages don't move its offset).
+    // Fields are copied one by one: `frozenCopies` may be changing under a writer releasing an earlier copy.
+    memset(frozen, 0, sizeof(*frozen));
+    frozen->partial = history->partial;
+    frozen->partialCount = history->partialCount;
+    memcpy(frozen->levels, history->levels, sizeof(frozen->levels));
+    frozen->levelCount = history->levelCount;
+    frozen->spillFile = history->spillFile;
+    frozen->spillFailed = history->spillFailed;
+    frozen->spillEnd = history->spillEnd;
+    for (int i = 0; i < HISTORY_CACHE_PAGES; i++)
+        frozen->cache[i].level = -1;
+    atomic_init(&frozen->frozenCopies, 0);
+    frozen->source = history;
+    atomic_fetch_add(&history->frozenCopies, 1);
+    bool ok = SeriesFreeze(&history->samples, &frozen->samples);
+    for (int l = 0; l < HISTORY_MAX_LEVELS; l++)
+    {
+        const HistoryLevel *level = &history->levels[l];
+        HistoryLevel *copy = &frozen->levels[l];
+        long pages = (level->count + HISTORY_PAGE_NODES - 1) / HISTORY_PAGE_NODES;
+        copy->pages = NULL;
+        copy->offsets = NULL;
+        copy->pageCapacity = 0;
+        if (!ok)
+            copy->count = 0; // Nothing to release for levels after a failed copy
+        if (!ok || pages == 0)
+            continue;
+        copy->pages = malloc(pages * sizeof(HistoryNode *));
+        copy->offsets = malloc(pages * sizeof(long));
+        long tail = level->count % HISTORY_PAGE_NODES;
+        HistoryNode *last = tail ? malloc(tail * sizeof(HistoryNode)) : NULL;
+        if (copy->pages == NULL || copy->offsets == NULL || (tail && last == NULL))
+        {
+            free(copy->pages);
+            free(copy->offsets);
+            free(last);
+            copy->pages = NULL;
+            copy->offsets = NULL;
+            copy->count = 0;
+            ok = false;
+            continue;
+        }
+        memcpy(copy->pages, level->pages, pages * sizeof(HistoryNode *));
+        memcpy(copy->offsets, level->offsets, pages * sizeof(long));
+        if (tail)
+        {
+            memcpy(last, level->pages[pages - 1], tail * sizeof(HistoryNode));
+            copy->pages[pages - 1] = last;
+        }
+        copy->pageCapacity = pages;
+    }
+    if (!ok)
+        HistoryReleaseFrozen(frozen);
+    return ok;
+}
+
+void HistoryReleaseFrozen(History *frozen)
+{
+    for (int l = 0; l < HISTORY_MAX_LEVELS; l++)
+    {
+        HistoryLevel *level = &frozen->levels[l];
+        if (level->pages != NULL && level->count % HISTORY_PAGE_NODES)
+            free(level->pages[level->pageCapacity - 1]); // The copied partial page; full pages are shared
+        free(level->pages);
+        free(level->offsets);
+    }
+    SeriesReleaseFrozen(&frozen->samples);
+    if (frozen->source)
+        atomic_fetch_sub(&frozen->source->frozenCopies, 1); // Its retired pages are freed by the next spill
+    memset(frozen, 0, sizeof(*frozen));
+}
+
+size_t HistoryImageSize(const History *history)
+{
+    size_t size = sizeof(HistoryImage) + SeriesImageSize(&history->samples);
+    for (int l = 0; l < history->levelCount; l++)
+        size += history->levels[l].count * sizeof(HistoryNode);
+    return size;
+}
+
+bool HistorySaveImage(History *history, unsigned char *out)
+{
+    HistoryImage image;
+    memset(&image, 0, sizeof(image));
+    image.partialCount = history->partialCount;
+    image.levelCount = history->levelCount;
+    image.partial = history->partial;
+    for (int l = 0; l < history->levelCount; l++)
+    {
+        image.counts[l] = history->levels[l].count;
+        image.pending[l] = history->levels[l].pending;
+    }
+    memcpy(out, &image, sizeof(image));
+    out += sizeof(image);
+    out += SeriesSaveImage(&history->samples, out);
+
+    // Spilled pages are read straight into the image, bypassing the read cache
+    for (int l = 0; l < history->levelCount; l++)
+    {
+        const HistoryLevel *level = &history->levels[l];
+        for (long first = 0; first < level->count; first += HISTORY_PAGE_NODES)
+        {
+            long page = first / HISTORY_PAGE_NODES;
+            long nodes = level->count - first < HISTORY_PAGE_NODES ? level->count - first : HISTORY_PAGE_NODES;
+            size_t bytes = nodes * sizeof(HistoryNode);
+            if (level->pages[page])
+                memcpy(out, level->pages[page], bytes);
+            else if (pread(fileno(history->spillFile), out, bytes, level->offsets[page]) != (ssize_t)bytes)
+                return false;
+            out += bytes;
+        }
+    }
+    return true;
+}
+
+bool HistoryLoadImage(History *history, const unsigned char *data, size_t size)
+{
+    HistoryClear(history);
+    HistoryImage image;
+    if (size < sizeof(image))
+        return false;
+    memcpy(&image, data, sizeof(image));
+    size_t seriesSize = SeriesLoadImage(&history->samples, data + sizeof(image), size - sizeof(image));
+    if (seriesSize == 0 || image.levelCount < 0 || image.levelCount > HISTORY_MAX_LEVELS || image.partialCount < 0 ||
+        image.partialCount >= (1L << HISTORY_BASE_LEVEL))
+    {
+        HistoryClear(history);
+        return false;
+    }
+    size_t used = sizeof(image) + seriesSize;
+
+    // Each level must hold exactly the pairs of the one below, and the levels must fit the image
+    int64_t expected = (history->samples.count - image.partialCount) >> HISTORY_BASE_LEVEL;
+    bool valid = image.levelCount == 0 ? history->samples.count == image.partialCount
+                                       : image.levelCount > HISTORY_BASE_LEVEL;
+    for (int l = 0; valid && l < image.levelCount; l++)
+    {
+        int64_t count = image.counts[l];
+        valid = l < HISTORY_BASE_LEVEL ? count == 0 : count == expected;
+        if (l >= HISTORY_BASE_LEVEL)
+            expected >>= 1;
+        if (valid && (uint64_t)count > (size - used) / sizeof(HistoryNode))
+            valid = false;
+        else
+            used += count * sizeof(HistoryNode);
+    }
+    if (!valid || (image.levelCount < HISTORY_MAX_LEVELS && expected != 0))
+    {
+        HistoryClear(history);
+        return false;
+    }
+
+    // Copy the pages as they were: full fine pages go straight to the spill file, the rest stay in RAM
+    const unsigned char *nodes = data + sizeof(image) + seriesSize;
+    for (int l = 0; l < image.levelCount; l++)
+    {
+        HistoryLevel *level = &history->levels[l];
+        long pages = (long)((image.counts[l] + HISTORY_PAGE_NODES - 1) / HISTORY_PAGE_NODES);
+        if (pages > 0 && !ReservePages(level, pages))
+        {
+            HistoryClear(history);
+            return false;
+        }
+        for (long page = 0; page < pages; page++)
+        {
+            long first = page * HISTORY_PAGE_NODES;
+            long count = image.counts[l] - first < HISTORY_PAGE_NODES ? image.counts[l] - first : HISTORY_PAGE_NODES;
+            if (page == 0 ? !GrowFirstPage(level, count)
+                          : (level->pages[page] = malloc(HISTORY_PAGE_NODES * sizeof(HistoryNode))) == NULL)
+            {
+                HistoryClear(history);
+                return false;
+            }
+            memcpy(level->pages[page], nodes, count * sizeof(HistoryNode));
+            nodes += count * sizeof(HistoryNode);
+            level->count += count;
+            if (count == HISTORY_PAGE_NODES)
+                SpillPage(history, l, page);
+        }
+        level->pending = image.pending[l];
+    }
+    history->levelCount = image.levelCount;
+    history->partial = image.partial;
+    history->partialCount = image.partialCount;
+    return true;
+}
+
+/***************************************
+ *      Internal helper functions      *
+ ***************************************/
+
+static void LevelPush(History *history, int l, HistoryNode node)
+{
+    if (l >= HISTORY_MAX_LEVELS)
+        return;
+    HistoryLevel *level = &history->levels[l];
+    long page = level->count / HISTORY_PAGE_NODES;
+    long slot = level->count % HISTORY_PAGE_NODES;
+
+    if (!ReservePages(level, page + 1))
+        return;
+    if (page == 0 && slot == level->firstCapacity && !GrowFirstPage(level, slot + 1))
+        return;
+    if (!level->pages[page])
+        level->pages[page] = malloc(HISTORY_PAGE_NODES * sizeof(HistoryNode));
+    level->pages[page][slot] = node;
+    level->count++;
+    if (l + 1 > history->levelCount)
+        history->levelCount = l + 1;
+
+    if (slot == HISTORY_PAGE_NODES - 1)
+        SpillPage(history, l, page); // Spill a full fine page
+
+    // Every second node completes a pair for the level above
+    if (level->count & 1)
+        level->pending = node;
+    else
+        LevelPush(history, l + 1, MergeNodes(level->pending, node));
+}
+
+static bool ReservePages(HistoryLevel *level, long pages)
+{
+    if (pages <= level->pageCapacity)
+        return true;
+    long capacity = level->pageCapacity ? level->pageCapacity : 16;
+    while (capacity < pages)
+        capacity *= 2;
+    HistoryNode **table = realloc(level->pages, capacity * sizeof(HistoryNode *));
+    if (table == NULL)
+        return false;
+    level->pages = table;
+    long *offsets = realloc(level->offsets, capacity * sizeof(long));
+    if (offsets == NULL)
+        return false;
+    level->offsets = offsets;
+    memset(level->pages + level->pageCapacity, 0, (capacity - level->pageCapacity) * sizeof(HistoryNode *));
+    level->pageCapacity = capacity;
+    return true;
+}
+
+static bool GrowFirstPage(HistoryLevel *level, long nodes)
+{
+    // Coarse levels hold only a handful of nodes, so their first page starts small instead of a full page each
+    long capacity = level->firstCapacity ? level->firstCapacity : 16;
+    while (capacity < nodes)
+        capacity *= 2;
+    capacity = capacity < HISTORY_PAGE_NODES ? capacity : HISTORY_PAGE_NODES;
+    HistoryNode *page = realloc(level->pages[0], capacity * sizeof(HistoryNode));
+    if (page == NULL)
+        return false;
+    level->pages[0] = page;
+    level->firstCapacity = capacity;
+    return true;
+}
+
+static void SpillPage(History *history, int l, long page)
+{
+    // Coarse levels are small enough to stay in RAM; a failed write keeps the page resident
+    HistoryLevel *level = &history->levels[l];
+    if (l >= HISTORY_RAM_LEVEL || history->spillFailed)
+        return;
+    if (!history->spillFile)
+    {
+        // Opened on the first spill, so short-lived histories never touch the disk. Unlinked on creation; space
+        // is reclaimed when closed. If it can't be created everything stays in RAM.
+        history->spillFile = tmpfile();
+        history->spillFailed = (history->spillFile == NULL);
+        if (history->spillFailed)
+            return;
+    }
+
+    // A frozen copy may still be reading the page, so it is retired until no copy is out
+    bool pinned = atomic_load(&history->frozenCopies) > 0;
+    if (!pinned)
+        FreeRetired(history);
+    else if (history->retiredCount == history->retiredCapacity)
+    {
+        long capacity = history->retiredCapacity ? history->retiredCapacity * 2 : 64;
+        HistoryNode **retired = realloc(history->retired, capacity * sizeof(HistoryNode *));
+        if (!retired)
+            return;
+        history->retired = retired;
+        history->retiredCapacity = capacity;
+    }
+
+    size_t bytes = HISTORY_PAGE_NODES * sizeof(HistoryNode);
+    if (pwrite(fileno(history->spillFile), level->pages[page], bytes, history->spillEnd) == (ssize_t)bytes)
+    {
+        level->offsets[page] = history->spillEnd;
+        history->spillEnd += bytes;
+        if (pinned)
+            history->retired[history->retiredCount++] = level->pages[page];
+        else
+            free(level->pages[page]);
+        level->pages[page] = NULL;
+    }
+}
+
+static void FreeRetired(History *history)
+{
+    for (long i = 0; i < history->retiredCount; i++)
+        free(history->retired[i]);
+    history->retiredCount = 0;
+}
+
+static bool ReadNode(History *history, int l, long index, HistoryNode *node)
+{
+    HistoryLevel *level = &history->levels[l];
+    long page = index / HISTORY_PAGE_NODES;
+    long slot = index % HISTORY_PAGE_NODES;
+    history->nodeReads++;
+    if (level->pages[page])
+    {
+        *node = level->pages[page][slot];
+        return true;
+    }
+
+    // Spilled: look in the cache, else load into the least recently used entry
+    HistoryCachePage *victim = &history->cache[0];
+    for (int i = 0; i < HISTORY_CACHE_PAGES; i++)
+    {
+        HistoryCachePage *entry = &history->cache[i];
+        if (entry->level == l && entry->page == page)
+        {
+            entry->lastUse = ++history->useCounter;
+            *node = entry->nodes[slot];
+            return true;
+        }
+        if (entry->lastUse < victim->lastUse)
+            victim = entry;
+    }
+    // Untagged while it is overwritten: a short read must not leave a half-loaded page that later hits trust
+    victim->level = -1;
+    if (!victim->nodes)
+        victim->nodes = malloc(HISTORY_PAGE_NODES * sizeof(HistoryNode));
+    size_t bytes = HISTORY_PAGE_NODES * sizeof(HistoryNode);
+    if (!victim->nodes)
+        return false;
+    if (pread(fileno(history->spillFile), victim->nodes, bytes, level->offsets[page]) != (ssize_t)bytes)
+        return false;
+    victim->level = l;
+    victim->page = page;
+    victim->lastUse = ++history->useCounter;
+    *node = victim->nodes[slot];
+    return true;
+}
+
+static long FirstNodeEndingAfter(History *history, int level, double t)
+{
+    // Binary search on the top level (RAM-resident), then descend: the first qualifying
+    // child of parent i is 2i or 2i + 1, so each level below costs one or two node reads.
+    int top = history->levelCount - 1;
+    long lo = 0, hi = history->levels[top].count;
+    while (lo < hi)
+    {
+        long mid = (lo + hi) / 2;
+        HistoryNode node;
+        if (ReadNode(history, top, mid, &node) && node.t1 < t)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    long index = lo;
+    for (int l = top - 1; l >= level; l--)
+    {
+        index *= 2;
+        HistoryNode node;
+        if (index < history->levels[l].count && ReadNode(history, l, index, &node) && node.t1 < t)
+            index++; // An unreadable child is kept: the query then skips it instead of misplacing the view
+    }
+    long count = history->levels[level].count;
+    return index < count ? index : count;
+}
+
+static HistoryNode MergeNodes(HistoryNode a, HistoryNode b)
+{
+    return (HistoryNode){ a.t0, b.t1, a.min < b.min ? a.min : b.min, a.max > b.max ? a.max : b.max };
+}
+
+static void QueryRaw(History *history, double t0, double t1, int columns, HistoryColumn *out)
+{
+    const Series *samples = &history->samples;
+    long firstBlock = SeriesFindBlock(samples, t0);
+    long lastBlock = SeriesFindBlock(samples, t1);
+    if (lastBlock >= samples->blockCount)
+        lastBlock = samples->blockCount - 1;
+    long blocks = lastBlock - firstBlock + 1;
+    if (blocks <= 0)
+        return;
+
+    // Blocks decode independently: wide views split the block range into one share per thread, each binned into
+    // its own columns by the decode pool and this thread. A query that finds the pool in use decodes alone.
+    int shares = 1;
+    if (blocks >= HISTORY_PARALLEL_BLOCKS)
+    {
+        pthread_once(&poolOnce, StartDecodePool);
+        shares = pool.workerCount + 1;
+    }
+    HistoryColumn *scratch = NULL;
+    if (shares > 1)
+        scratch = calloc((size_t)(shares - 1) * columns, sizeof(HistoryColumn)); // All columns start invalid
+    if (scratch == NULL || !ClaimDecodePool())
+    {
+        free(scratch);
+        DecodeJob job = { samples, firstBlock, lastBlock, t0, t1, columns, out };
+        DecodeBlocks(&job);
+        return;
+    }
+
+    DecodeJob jobs[HISTORY_DECODE_THREADS];
+    for (int i = 0; i < shares; i++)
+    {
+        long from = firstBlock + blocks * i / shares;
+        long to = firstBlock + blocks * (i + 1) / shares - 1;
+        jobs[i] = (DecodeJob){ samples, from, to, t0, t1, columns, i ? scratch + (size_t)(i - 1) * columns : out };
+    }
+    RunDecodePool(jobs, shares);
+    for (int i = 1; i < shares; i++)
+        MergeColumns(out, jobs[i].out, columns);
+    free(scratch);
+}
+
+static void DecodeBlocks(const DecodeJob *job)
+{
+    SeriesSample decoded[SERIES_BLOCK_SAMPLES];
+    double scale = job->columns / (job->t1 - job->t0);
+    for (long b = job->firstBlock; b <= job->lastBlock; b++)
+    {
+        int n = SeriesDecodeBlock(job->samples, b, decoded);
+        for (int i = 0; i < n; i++)
+        {
+            // A raw sample lands in exactly one column
+            SeriesSample s = decoded[i];
+            if (s.time < job->t0 || s.time > job->t1)
+                continue;
+            int c = (int)((s.time - job->t0) * scale);
+            HistoryColumn *column = &job->out[c < job->columns ? c : job->columns - 1];
+            if (!column->valid)
+                *column = (HistoryColumn){ s.value, s.value, true };
+            else if (s.value < column->min)
+                column->min = s.value;
+            else if (s.value > column->max)
+                column->max = s.value;
+        }
+    }
+}
+
+static void StartDecodePool(void)
+{
+    // The querying thread decodes a share too, so the pool holds one fewer than the thread count
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN) > 0 ? sysconf(_SC_NPROCESSORS_ONLN) : 1;
+    int threads = cpus < HISTORY_DECODE_THREADS ? (int)cpus : HISTORY_DECODE_THREADS;
+    for (int i = 0; i < threads - 1; i++)
+    {
+        if (pthread_create(&pool.workers[pool.workerCount], NULL, DecodeWorker, NULL) != 0)
+            break;
+        pool.workerCount++;
+    }
+}
+
+static bool ClaimDecodePool(void)
+{
+    pthread_mutex_lock(&pool.lock);
+    bool claimed = !pool.claimed;
+    pool.claimed = true;
+    pthread_mutex_unlock(&pool.lock);
+    return claimed;
+}
+
+static void RunDecodePool(const DecodeJob *jobs, int count)
+{
+    pthread_mutex_lock(&pool.lock);
+    pool.jobs = jobs;
+    pool.jobCount = count;
+    atomic_store(&pool.nextJob, 0);
+    pool.workersBusy = pool.workerCount;
+    pool.querySerial++;
+    pthread_cond_broadcast(&pool.queryReady);
+    pthread_mutex_unlock(&pool.lock);
+
+    DecodeShares();
+
+    // Every worker checks in before the jobs (on the caller's stack) go out of scope
+    pthread_mutex_lock(&pool.lock);
+    while (pool.workersBusy > 0)
+        pthread_cond_wait(&pool.queryDone, &pool.lock);
+    pool.jobs = NULL;
+    pool.jobCount = 0;
+    pool.claimed = false;
+    pthread_mutex_unlock(&pool.lock);
+}
+
+static void DecodeShares(void)
+{
+    for (int i = atomic_fetch_add(&pool.nextJob, 1); i < pool.jobCount; i = atomic_fetch_add(&pool.nextJob, 1))
+        DecodeBlocks(&pool.jobs[i]);
+}
+
+static void *DecodeWorker(void *arg)
+{
+    (void)arg;
+    unsigned long seen = 0;
+    for (;;)
+    {
+        pthread_mutex_lock(&pool.lock);
+        while (pool.querySerial == seen)
+            pthread_cond_wait(&pool.queryReady, &pool.lock);
+        seen = pool.querySerial;
+        pthread_mutex_unlock(&pool.lock);
+
+        DecodeShares();
+
+        pthread_mutex_lock(&pool.lock);
+        if (--pool.workersBusy == 0)
+            pthread_cond_signal(&pool.queryDone);
+        pthread_mutex_unlock(&pool.lock);
+    }
+    return NULL; // Not reached: workers live as long as the process
+}
+
+static void MergeColumns(HistoryColumn *into, const HistoryColumn *from, int columns)
+{
+    for (int c = 0; c < columns; c++)
+    {
+        if (!from[c].valid)
+            continue;
+        if (!into[c].valid)
+        {
+            into[c] = from[c];
+            continue;
+        }
+        if (from[c].min < into[c].min)
+            into[c].min = from[c].min;
+        if (from[c].max > into[c].max)
+            into[c].max = from[c].max;
+    }
+}
+
+static void AddToColumns(HistoryNode node, double t0, double t1, int columns, HistoryColumn *out)
+{
+    double scale = columns / (t1 - t0);
+    int first = (int)((node.t0 - t0) * scale);
+    int last = (int)((node.t1 - t0) * scale);
+    if (first < 0)
+        first = 0;
+    if (last >= columns)
+        last = columns - 1;
+    for (int c = first; c <= last; c++)
+    {
+        HistoryColumn *column = &out[c];
+        if (!column->valid)
+        {
+            *column = (HistoryColumn){ node.min, node.max, true };
+            continue;
+        }
+        if (node.min < column->min)
+            column->min = node.min;
+        if (node.max > column->max)
+            column->max = node.max;
+    }
+}
@@ -0,0 +1,100 @@
+/**********************************************************************************
+ * @file history.h                                                                *
+ * @brief Multi-resolution min/max history pyramid backing the graph (no raylib). *
+ * @author Gabe G.                                                                *
+ * @date 10-19-2026                                                               *
+ **********************************************************************************/
+
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include "renderer/series.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#define HISTORY_PAGE_NODES 4096    // Nodes per page (96 KiB)
+#define HISTORY_MAX_LEVELS 40      // Level L node covers 2^L samples
+#define HISTORY_BASE_LEVEL 4       // Finest stored node level; finer views decode the compressed raw samples
+#define HISTORY_RAM_LEVEL 10       // Full pages of levels below this are spilled to disk
+#define HISTORY_CACHE_PAGES 16     // Spilled pages kept in memory for reads
+#define HISTORY_PARALLEL_BLOCKS 16 // Raw views spanning at least this many blocks are decoded on several threads
+#define HISTORY_DECODE_THREADS 4   // Upper bound on decode threads (the pool holds one fewer; the caller decodes too)
+
+// Level L nodes cover 2^L samples; level L+1 nodes merge two level L nodes. Raw samples (level 0) live in a
+// compressed Series, and node levels start at HISTORY_BASE_LEVEL.
+typedef struct HistoryNode
+{
+    double t0; // Time of the first covered sample
+    double t1; // Time of the last covered sample
+    float min; // Smallest covered value
+    float max; // Largest covered value
+} HistoryNode;
+
+// Min/max of the samples falling in one output column of a query
+typedef struct HistoryColumn
+{
+    float min;
+    float max;
+    bool valid; // False if no sample falls in the column
+} HistoryColumn;
+
+// One pyramid level: an append-only array of pages, RAM-resident or spilled
+typedef struct HistoryLevel
+{
+    HistoryNode **pages; // Page pointers (NULL once spilled)
+    long *offsets;       // File offset of each spilled page
+    long pageCapacity;   // Allocated entries in `pages`/`offsets`
+    long count;          // Nodes in this level
+    long firstCapacity;  // Nodes allocated in the first page (grown until it is a full page)
+    HistoryNode pending; // Left half of an incomplete pair (valid when `count` is odd)
+} HistoryLevel;
+
+// Read cache entry for a spilled page
+typedef struct HistoryCachePage
+{
+    int level;             // Level of the cached page (-1 if empty)
+    long page;             // Page index within the level
+    unsigned long lastUse; // For LRU eviction
+    HistoryNode *nodes;    // HISTORY_PAGE_NODES nodes
+} HistoryCachePage;
+
+typedef struct History
+{
+    Series samples;       // Every raw sample, compressed
+    HistoryNode partial;  // Samples not yet covering a whole base-level node
+    long partialCount;    // Samples in `partial`
+    HistoryLevel levels[HISTORY_MAX_LEVELS];
+    int levelCount;   // One past the highest level holding a node (0 until the first base node)
+    FILE *spillFile;  // Anonymous backing file, opened by the first spill
+    bool spillFailed; // The file could not be created: everything stays in RAM
+    long spillEnd;    // Next free offset in `spillFile`
+    HistoryCachePage cache[HISTORY_CACHE_PAGES];
+    unsigned long useCounter; // LRU clock for `cache`
+    long nodeReads;           // Nodes read so far (for profiling)
+    atomic_int frozenCopies;  // HistoryFreeze copies still sharing pages (spilled pages are retired, not freed)
+    HistoryNode **retired;    // Spilled pages kept alive for those copies
+    long retiredCount;
+    long retiredCapacity;
+    struct History *source; // For a frozen copy: the live history it pins
+} History;
+
+// History Function declarations
+void HistoryInit(History *history);                                   // Create an empty history (no spill file yet)
+void HistoryFree(History *history);                                   // Release pages and the spill file
+void HistoryClear(History *history);                                  // Drop all samples
+void HistoryAppend(History *history, double time, float value);       // Append a sample (times must not decrease)
+long HistoryCount(const History *history);                            // Number of raw samples
+bool HistoryTimeRange(History *history, double *first, double *last); // Time of first and last samples
+int HistoryQuery(History *history, double t0, double t1, int columns,
+                 HistoryColumn *out);                             // Min/max per column over [t0, t1] (returns level)
+long HistoryRecent(History *history, HistoryNode *out, long max); // Copy the newest raw samples, oldest first
+size_t HistoryBytes(const History *history);                      // RAM held by samples and resident pages
+bool HistoryFreeze(History *history, History *frozen);            // Read-only copy for saving on another thread
+void HistoryReleaseFrozen(History *frozen);                       // Free what HistoryFreeze copied
+size_t HistoryImageSize(const History *history);                  // Bytes written by HistorySaveImage
+bool HistorySaveImage(History *history, unsigned char *out);      // Copy samples and levels (false: spill unreadable)
+bool HistoryLoadImage(History *history, const unsigned char *data,
+                      size_t size); // Replace contents with a saved image, no rebuild (false if invalid: left empty)
+
+#endif
@@ -0,0 +1,179 @@
+/**********************************************************************************
+ * @file phase.c                                                                  *
+ * @brief Implementation of the velocity vs. displacement phase-portrait heatmap. *
+ * @author Gabe G.                                                                *
+ * @date 10-19-2026                                                               *
+ **********************************************************************************/
+
+#include "phase.h"
+#include "renderer/backend.h"
+#include "renderer/renderer.h"
+#include <math.h>
+#include <string.h>
+
+// Renormalize once hits are weighted this heavily (keeps bins well inside float range)
+#define PHASE_MAX_WEIGHT 1e18f
+
+// Panel placement in the main window (top-left, below the title)
+static const int PHASE_X = 10;
+static const int PHASE_Y = 60;
+static const int PHASE_SIZE = 180;
+
+static void MarkAllDirty(PhasePlot *plot); // Force a full upload on the next draw
+static void Renormalize(PhasePlot *plot);  // Fold the hit weight back into the bins
+
+void InitPhasePlot(PhasePlot *plot)
+{
+    memset(plot->bins, 0, sizeof(plot->bins));
+    memset(plot->dirtyRows, 0, sizeof(plot->dirtyRows));
+    plot->displacementRange = 1.0f;
+    plot->velocityRange = 1.0f;
+    plot->weight = 1.0f;
+    plot->peak = 0.0f;
+    plot->visible = true;
+    plot->uploadEvery = 1;
+    plot->uploadWait = 0;
+    SetPhasePlotHalfLife(plot, PHASE_DEFAULT_HALF_LIFE);
+
+    plot->image = renderBackend->createImage(PHASE_BINS, PHASE_BINS, plot->bins);
+}
+
+void SetPhasePlotRange(PhasePlot *plot, float displacementRange, float velocityRange)
+{
+    plot->displacementRange = displacementRange > 0.0f ? displacementRange : 1.0f;
+    plot->velocityRange = velocityRange > 0.0f ? velocityRange : 1.0f;
+    ClearPhasePlot(plot); // Old hits were binned against the old axes
+}
+
+void SetPhasePlotHalfLife(PhasePlot *plot, float seconds)
+{
+    Renormalize(plot);
+    plot->decayRate = seconds > 0.0f ? logf(2.0f) / seconds : 0.0f;
+}
+
+void SetPhasePlotUploadInterval(PhasePlot *plot, int frames)
+{
+    plot->uploadEvery = frames > 0 ? frames : 1;
+    if (plot->uploadWait >= plot->uploadEvery)
+        plot->uploadWait = plot->uploadEvery - 1;
+}
+
+void UpdatePhasePlot(PhasePlot *plot, float displacement, float velocity)
+{
+    PhasePlotAccumulate(plot, &displacement, &velocity, 1);
+}
+
+void PhasePlotAccumulate(PhasePlot *plot, const float *displacements, const float *velocities, int count)
+{
+    float columnScale = PHASE_BINS / (2.0f * plot->displacementRange);
+    float rowScale = PHASE_BINS / (2.0f * plot->velocityRange);
+    for (int i = 0; i < count; i++)
+    {
+        // Samples off the axes (e.g. a hard throw while dragging) are dropped
+        float column = (displacements[i] + plot->displacementRange) * columnScale;
+        float row = (plot->velocityRange - velocities[i]) * rowScale;
+        if (!(column >= 0.0f && column < PHASE_BINS && row >= 0.0f && row < PHASE_BINS))
+            continue;
+
+        int r = (int)row;
+        float *bin = &plot->bins[r * PHASE_BINS + (int)column];
+        *bin += plot->weight;
+        if (*bin > plot->peak)
+            plot->peak = *bin;
+        plot->dirtyRows[r] = true;
+    }
+}
+
+void PhasePlotDecay(PhasePlot *plot, float dt)
+{
+    if (plot->decayRate == 0.0f)
+        return;
+    plot->weight *= expf(plot->decayRate * dt);
+    if (plot->weight > PHASE_MAX_WEIGHT)
+        Renormalize(plot);
+}
+
+void ClearPhasePlot(PhasePlot *plot)
+{
+    memset(plot->bins, 0, sizeof(plot->bins));
+    plot->weight = 1.0f;
+    plot->peak = 0.0f;
+    MarkAllDirty(plot);
+}
+
+void DrawPhasePlot(PhasePlot *plot, SimRect bounds, SimColor *themeColor)
+{
+    if (!plot->visible || plot->image == NULL)
+        return; // Dirty rows keep accumulating and are uploaded once shown again
+
+    // Upload each run of dirty rows with one call; untouched rows stay on the GPU as they are. Under a tight
+    // frame budget the upload is spread out and the heatmap lags by a few frames.
+    bool upload = plot->uploadWait <= 0;
+    plot->uploadWait = upload ? plot->uploadEvery - 1 : plot->uploadWait - 1;
+    for (int r = 0; upload && r < PHASE_BINS;)
+    {
+        if (!plot->dirtyRows[r])
+        {
+            r++;
+            continue;
+        }
+        int first = r;
+        while (r < PHASE_BINS && plot->dirtyRows[r])
+            plot->dirtyRows[r++] = false;
+        renderBackend->updateImageRows(plot->image, first, r - first, &plot->bins[first * PHASE_BINS]);
+    }
+
+    // Panel, axes through the origin, then the heatmap tone-mapped by the backend
+    int x = bounds.x;
+    int y = bounds.y;
+    int width = bounds.width;
+    int height = bounds.height;
+    renderBackend->rect(x, y, width, height, (SimColor){ 20, 20, 20, 220 });
+    renderBackend->line((Vec2D){ x, y + height / 2 }, (Vec2D){ x + width, y + height / 2 }, 1.0f, SIM_DARKGRAY);
+    renderBackend->line((Vec2D){ x + width / 2, y }, (Vec2D){ x + width / 2, y + height }, 1.0f, SIM_DARKGRAY);
+
+    float invScale = 1.0f / plot->weight;
+    float displayedPeak = plot->peak * invScale;
+    float invLogPeak = displayedPeak > 0.0f ? 1.0f / logf(1.0f + displayedPeak) : 0.0f;
+    renderBackend->drawImage(plot->image, bounds, invScale, invLogPeak, *themeColor);
+
+    renderBackend->rectLines(x, y, width, height, SIM_GRAY);
+    Render_DrawText("Phase (x, v)  [P]", x + 4, y + 4, 10, SIM_LIGHTGRAY);
+}
+
+SimRect PhasePlotDefaultBounds(void)
+{
+    return (SimRect){ PHASE_X, PHASE_Y, PHASE_SIZE, PHASE_SIZE };
+}
+
+void ClosePhasePlot(PhasePlot *plot)
+{
+    renderBackend->destroyImage(plot->image);
+    plot->image = NULL;
+}
+
+/***************************************
+ *      Internal helper functions      *
+ ***************************************/
+
+static void MarkAllDirty(PhasePlot *plot)
+{
+    for (int r = 0; r < PHASE_BINS; r++)
+        plot->dirtyRows[r] = true;
+    plot->uploadWait = 0; // The whole texture is stale: don't let it show against the new weight
+}
+
+static void Renormalize(PhasePlot *plot)
+{
+    if (plot->weight == 1.0f)
+        return;
+
+    // A synchronous O(bins) pass plus a full re-upload, but rare: every ln(1e18) / decayRate seconds (about ten
+    // minutes at the default half-life)
+    float invWeight = 1.0f / plot->weight;
+    for (int i = 0; i < PHASE_BINS * PHASE_BINS; i++)
+        plot->bins[i] *= invWeight;
+    plot->peak *= invWeight;
+    plot->weight = 1.0f;
+    MarkAllDirty(plot);
+}
@@ -0,0 +1,51 @@
+/********************************************************************************
+ * @file phase.h                                                                *
+ * @brief Header file for the velocity vs. displacement phase-portrait heatmap. *
+ * @author Gabe G.                                                              *
+ * @date 10-19-2026                                                             *
+ ********************************************************************************/
+
+#ifndef PHASE_H
+#define PHASE_H
+
+#include "consts.h"
+#include "renderer/backend.h"
+
+#define PHASE_BINS 256                // Histogram resolution (bins per axis)
+#define PHASE_DEFAULT_HALF_LIFE 10.0f // Seconds for old hits to fade to half intensity (0 = never)
+
+// Histogram: row 0 is +velocityRange, column 0 is -displacementRange.
+// Decay is applied by growing the weight of new hits instead of scaling every bin each frame,
+// so the per-frame cost is the number of new samples; the backend divides by `weight` on display.
+typedef struct PhasePlot
+{
+    float bins[PHASE_BINS * PHASE_BINS];
+    bool dirtyRows[PHASE_BINS]; // Rows changed since the last upload
+    float displacementRange;    // Half-width of the displacement axis
+    float velocityRange;        // Half-height of the velocity axis
+    float weight;               // Weight of a hit added now
+    float peak;                 // Largest bin value (same units as `bins`)
+    float decayRate;            // ln(2) / half-life, per second
+    bool visible;               // Drawn (toggled with P in UpdateSim)
+    int uploadEvery;            // Frames between uploads of the dirty rows (1: every frame)
+    int uploadWait;             // Frames until the next upload
+    RenderImage *image;         // Backend copy of `bins`
+} PhasePlot;
+
+// Phase Plot Function declarations
+void InitPhasePlot(PhasePlot *plot); // Create the histogram and its backend image
+void SetPhasePlotRange(PhasePlot *plot, float displacementRange,
+                       float velocityRange);                   // Set axis half-ranges (clears the histogram)
+void SetPhasePlotHalfLife(PhasePlot *plot, float seconds);     // Set the decay half-life (0 disables decay)
+void SetPhasePlotUploadInterval(PhasePlot *plot, int frames);  // Upload dirty rows every `frames` draws
+void UpdatePhasePlot(PhasePlot *plot, float displacement, float velocity); // Add one sample
+void PhasePlotAccumulate(PhasePlot *plot, const float *displacements, const float *velocities,
+                         int count);                           // Add a batch of samples (e.g. an ensemble)
+void PhasePlotDecay(PhasePlot *plot, float dt);                // Advance the decay clock
+void ClearPhasePlot(PhasePlot *plot);                          // Drop all hits
+void DrawPhasePlot(PhasePlot *plot, SimRect bounds,
+                   SimColor *themeColor);                      // Upload dirty rows and draw the heatmap
+SimRect PhasePlotDefaultBounds(void);                          // Panel in the top-left of the main window
+void ClosePhasePlot(PhasePlot *plot);                          // Release the backend image
+
+#endif
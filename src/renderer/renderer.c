@@ -7,15 +7,63 @@
 
 #include "renderer/renderer.h"
 #include "math.h"
-#include "platform_internal.h"
-#include <raylib.h>
+#include "renderer/backend.h"
+
+const RenderBackend *renderBackend = NULL; // Set by SetRenderBackend() before the window is opened
+
+/**********************************
+ *      Forward Declarations      *
+ **********************************/
+
+static void DrawFloorTiled(SpringMassRenderState *state, RenderTile tile);  // Draw the floor into a tile
+static void DrawMassTiled(SpringMassRenderState *state, RenderTile tile);   // Draw the mass into a tile
+static void DrawSpringTiled(SpringMassRenderState *state, RenderTile tile); // Draw the spring into a tile
+
+// Identity placement used by the single-scene functions
+static const RenderTile FULL_WINDOW = { 0.0f, 0.0f, 1.0f };
+
+// Vec2D math (platform_internal.h has the raylib Vec2D versions; this file stays raylib-free)
+static inline Vec2D vec2Add(Vec2D v, Vec2D u)
+{
+    return (Vec2D){ v.x + u.x, v.y + u.y };
+}
+
+static inline Vec2D vec2Sub(Vec2D v, Vec2D u)
+{
+    return (Vec2D){ v.x - u.x, v.y - u.y };
+}
+
+static inline Vec2D vec2Scale(Vec2D v, float a)
+{
+    return (Vec2D){ v.x * a, v.y * a };
+}
+
+static inline float vec2Length(Vec2D v)
+{
+    return sqrtf(v.x * v.x + v.y * v.y);
+}
+
+#ifndef PI
+#define PI 3.14159265358979323846f
+#endif
+
+/***********************************
+ *      External API Functions     *
+ ***********************************/
 
 void InitRender(SpringMassRenderState *state, int windowWidth, int windowHeight, const char *title, int FPS)
 {
-    InitWindow(windowWidth, windowHeight, title);
-    SetTargetFPS(FPS);
-    SetExitKey(KEY_NULL);
+    InitRenderWindow(windowWidth, windowHeight, title, FPS);
+    InitRenderState(state);
+}
+
+void InitRenderWindow(int windowWidth, int windowHeight, const char *title, int FPS)
+{
+    renderBackend->openWindow(windowWidth, windowHeight, title, FPS);
+}
 
+void InitRenderState(SpringMassRenderState *state)
+{
     state->massRectangle = (SimRect){ 150, FLOOR_HEIGHT - RECT_SIZE - FLOOR_THICKNESS / 2, RECT_SIZE,
                                       RECT_SIZE }; // Initial position of the mass
     state->massColor = SIM_RED;                    // Color of the mass rectangle
@@ -38,27 +86,27 @@ void InitRender(SpringMassRenderState *state, int windowWidth, int windowHeight,
 
 void ShowStartupText(SpringMassRenderState *state)
 {
-    DrawText("Spring-Mass System", 10, 10, 30, SimColorToRayColor(state->themeColor)); // Title
+    renderBackend->text("Spring-Mass System", 10, 10, 30, state->themeColor); // Title
 
     const char *text1 = "Welcome to the Spring-Mass Simulation!";
     int fontSize1 = 20;
-    int textWidth1 = MeasureText(text1, fontSize1);
-    DrawText(text1, SCREEN_WIDTH / 2 - textWidth1 / 2, SCREEN_HEIGHT / 2 - 100, fontSize1, RAYWHITE);
+    int textWidth1 = renderBackend->measureText(text1, fontSize1);
+    renderBackend->text(text1, SCREEN_WIDTH / 2 - textWidth1 / 2, SCREEN_HEIGHT / 2 - 100, fontSize1, SIM_RAYWHITE);
 
     const char *text2 = "Click and drag to move the mass";
     int fontSize2 = 15;
-    int textWidth2 = MeasureText(text2, fontSize2);
-    DrawText(text2, SCREEN_WIDTH / 2 - textWidth2 / 2, SCREEN_HEIGHT / 2 - 80, fontSize2, RAYWHITE);
+    int textWidth2 = renderBackend->measureText(text2, fontSize2);
+    renderBackend->text(text2, SCREEN_WIDTH / 2 - textWidth2 / 2, SCREEN_HEIGHT / 2 - 80, fontSize2, SIM_RAYWHITE);
 
     const char *text3 = "Edit parameters with sliders in top right (or in settings)";
     int fontSize3 = 15;
-    int textWidth3 = MeasureText(text3, fontSize3);
-    DrawText(text3, SCREEN_WIDTH / 2 - textWidth3 / 2, SCREEN_HEIGHT / 2 - 60, fontSize3, RAYWHITE);
+    int textWidth3 = renderBackend->measureText(text3, fontSize3);
+    renderBackend->text(text3, SCREEN_WIDTH / 2 - textWidth3 / 2, SCREEN_HEIGHT / 2 - 60, fontSize3, SIM_RAYWHITE);
 
     const char *text4 = "ESC to pause";
     int fontSize4 = 15;
-    int textWidth4 = MeasureText(text4, fontSize4);
-    DrawText(text4, SCREEN_WIDTH / 2 - textWidth4 / 2, SCREEN_HEIGHT / 2 - 40, fontSize4, RAYWHITE);
+    int textWidth4 = renderBackend->measureText(text4, fontSize4);
+    renderBackend->text(text4, SCREEN_WIDTH / 2 - textWidth4 / 2, SCREEN_HEIGHT / 2 - 40, fontSize4, SIM_RAYWHITE);
 }
 
 void ShowStartupTextFadeOut(SpringMassRenderState *state, float dt, float fadeTime)
@@ -70,57 +118,167 @@ void ShowStartupTextFadeOut(SpringMassRenderState *state, float dt, float fadeTi
         cosValue = 0.0f;                  // Clamp to 0
     int alpha = (int)(cosValue * 255.0f); // Map 0-1 to 0-255
 
-    Color color = SimColorToRayColor(state->themeColor);
+    SimColor color = state->themeColor;
     color.a = alpha;
-    DrawText("Spring-Mass System", 10, 10, 30, color); // Title
+    renderBackend->text("Spring-Mass System", 10, 10, 30, color); // Title
 
     const char *text1 = "Welcome to the Spring-Mass Simulation!";
     int fontSize1 = 20;
-    int textWidth1 = MeasureText(text1, fontSize1);
-    DrawText(text1, SCREEN_WIDTH / 2 - textWidth1 / 2, SCREEN_HEIGHT / 2 - 100, fontSize1,
-             (Color){ 245, 245, 245, alpha });
+    int textWidth1 = renderBackend->measureText(text1, fontSize1);
+    renderBackend->text(text1, SCREEN_WIDTH / 2 - textWidth1 / 2, SCREEN_HEIGHT / 2 - 100, fontSize1,
+                        (SimColor){ 245, 245, 245, alpha });
 
     const char *text2 = "Click and drag to move the mass";
     int fontSize2 = 15;
-    int textWidth2 = MeasureText(text2, fontSize2);
-    DrawText(text2, SCREEN_WIDTH / 2 - textWidth2 / 2, SCREEN_HEIGHT / 2 - 80, fontSize2,
-             (Color){ 245, 245, 245, alpha });
+    int textWidth2 = renderBackend->measureText(text2, fontSize2);
+    renderBackend->text(text2, SCREEN_WIDTH / 2 - textWidth2 / 2, SCREEN_HEIGHT / 2 - 80, fontSize2,
+                        (SimColor){ 245, 245, 245, alpha });
 
     const char *text3 = "Edit parameters with sliders in top right (or in settings)";
     int fontSize3 = 15;
-    int textWidth3 = MeasureText(text3, fontSize3);
-    DrawText(text3, SCREEN_WIDTH / 2 - textWidth3 / 2, SCREEN_HEIGHT / 2 - 60, fontSize3,
-             (Color){ 245, 245, 245, alpha });
+    int textWidth3 = renderBackend->measureText(text3, fontSize3);
+    renderBackend->text(text3, SCREEN_WIDTH / 2 - textWidth3 / 2, SCREEN_HEIGHT / 2 - 60, fontSize3,
+                        (SimColor){ 245, 245, 245, alpha });
 
     const char *text4 = "ESC to pause";
     int fontSize4 = 15;
-    int textWidth4 = MeasureText(text4, fontSize4);
-    DrawText(text4, SCREEN_WIDTH / 2 - textWidth4 / 2, SCREEN_HEIGHT / 2 - 40, fontSize4,
-             (Color){ 245, 245, 245, alpha });
+    int textWidth4 = renderBackend->measureText(text4, fontSize4);
+    renderBackend->text(text4, SCREEN_WIDTH / 2 - textWidth4 / 2, SCREEN_HEIGHT / 2 - 40, fontSize4,
+                        (SimColor){ 245, 245, 245, alpha });
 }
 
 void DrawFloor(SpringMassRenderState *state)
 {
-    DrawLineEx(SimVectoRayVec(state->floorStart), SimVectoRayVec(state->floorEnd), state->floorThickness,
-               GRAY); // Draw the floor line
+    DrawFloorTiled(state, FULL_WINDOW);
 }
 
 void DrawMass(SpringMassRenderState *state)
 {
-    DrawRectangleRec(SimRectToRayRect(state->massRectangle),
-                     SimColorToRayColor(state->massColor)); // Draw the mass rectangle
+    DrawMassTiled(state, FULL_WINDOW);
 }
 
 void DrawSpring(SpringMassRenderState *state)
 {
-    Vector2 anchor = SimVectoRayVec(state->springAnchorPoint);
-    Vector2 attach = SimVectoRayVec(state->springAttachPoint);
+    DrawSpringTiled(state, FULL_WINDOW);
+}
+
+void SetSpringDetail(SpringMassRenderState *state, int segments)
+{
+    if (segments < 1)
+        segments = 1;
+    state->numSpringSegments = segments;
+    // Longer segments for fewer of them, so the coils still flatten at the same stretch
+    state->segmentLength = SPRING_SEGMENT_LENGTH * SPRING_SEGMENTS / (float)segments;
+}
+
+void DrawRender(SpringMassRenderState *state)
+{
+    DrawFloor(state);
+    DrawMass(state);
+    DrawSpring(state);
+}
+
+void UpdateRender(SpringMassRenderState *state)
+{
+    DrawFloor(state);
+    state->springAttachPoint.x = state->massRectangle.x;
+    DrawMass(state);
+    DrawSpring(state);
+}
+
+void UpdateRenderTiled(SpringMassRenderState **states, const RenderTile *tiles, int count)
+{
+    // Grouped by primitive rather than by scene, so rlgl can merge each group into one draw call
+    // (and the CPU rasterizer replays long runs of the same primitive)
+    for (int i = 0; i < count; i++)
+        DrawFloorTiled(states[i], tiles[i]);
+    for (int i = 0; i < count; i++)
+    {
+        states[i]->springAttachPoint.x = states[i]->massRectangle.x;
+        DrawSpringTiled(states[i], tiles[i]);
+    }
+    for (int i = 0; i < count; i++)
+        DrawMassTiled(states[i], tiles[i]);
+}
+
+void SetRenderBackend(const RenderBackend *backend)
+{
+    renderBackend = backend;
+}
+
+void Render_BeginDrawing(void)
+{
+    renderBackend->beginFrame();
+}
+
+void Render_EndDrawing(void)
+{
+    renderBackend->endFrame();
+}
+
+void Render_ClearBackground(SimColor color)
+{
+    renderBackend->clear(color);
+}
+
+float Render_GetFrameTime(void)
+{
+    return renderBackend->frameTime();
+}
+
+bool Render_LatchMousePosition(Vec2D *position)
+{
+    return renderBackend->latchMousePosition(position);
+}
+
+int Render_GetRefreshRate(void)
+{
+    return renderBackend->refreshRate();
+}
+
+void Render_DrawText(const char *text, int x, int y, int fontSize, SimColor color)
+{
+    renderBackend->text(text, x, y, fontSize, color);
+}
+
+void Render_DrawTileFrame(RenderTile tile, int sceneWidth, int sceneHeight, SimColor color, const char *label)
+{
+    renderBackend->rectLines(tile.x, tile.y, sceneWidth * tile.scale, sceneHeight * tile.scale, color);
+    renderBackend->text(label, tile.x + 5, tile.y + 5, 10, SIM_LIGHTGRAY);
+}
+
+/***************************************
+ *      Internal helper functions      *
+ ***************************************/
+
+static inline Vec2D TileVec(RenderTile tile, Vec2D v) // Map a scene point into a tile
+{
+    return (Vec2D){ tile.x + tile.scale * v.x, tile.y + tile.scale * v.y };
+}
+
+static void DrawFloorTiled(SpringMassRenderState *state, RenderTile tile)
+{
+    renderBackend->line(TileVec(tile, state->floorStart), TileVec(tile, state->floorEnd),
+                        state->floorThickness * tile.scale, SIM_GRAY); // Draw the floor line
+}
+
+static void DrawMassTiled(SpringMassRenderState *state, RenderTile tile)
+{
+    const SimRect *rect = &state->massRectangle;
+    renderBackend->rect(tile.x + tile.scale * rect->x, tile.y + tile.scale * rect->y, tile.scale * rect->width,
+                        tile.scale * rect->height, state->massColor); // Draw the mass rectangle
+}
+
+static void DrawSpringTiled(SpringMassRenderState *state, RenderTile tile)
+{
+    Vec2D anchor = state->springAnchorPoint;
+    Vec2D attach = state->springAttachPoint;
 
     int numSegments = state->numSpringSegments;
     float segmentLength = state->segmentLength;
     if (numSegments < 1)
         return;                                    // No segments to draw
-    Vector2 deltaSpring = vec2Sub(attach, anchor); // Vector from anchor to attach point
+    Vec2D deltaSpring = vec2Sub(attach, anchor);   // Vector from anchor to attach point
     float totalLength = vec2Length(deltaSpring);   // Total length from anchor to attach point
 
     // If start==end, nothing meaningful to do (all segments collapse)
@@ -128,10 +286,10 @@ void DrawSpring(SpringMassRenderState *state)
         return;
 
     // Unit tangent
-    Vector2 unitTangent = vec2Scale(deltaSpring, 1.0f / totalLength);
+    Vec2D unitTangent = vec2Scale(deltaSpring, 1.0f / totalLength);
 
     // Unit normal (perpendicular)
-    Vector2 unitNormal = (Vector2){ -unitTangent.y, unitTangent.x };
+    Vec2D unitNormal = (Vec2D){ -unitTangent.y, unitTangent.x };
 
     // Centerline step per segment
     float stepLength = totalLength / (float)numSegments;
@@ -151,8 +309,8 @@ void DrawSpring(SpringMassRenderState *state)
     for (int i = 0; i < numSegments; i++)
     {
         // Current vertex: centerline point + alternating normal offset.
-        Vector2 centerPoint = vec2Add(anchor, vec2Scale(unitTangent, (float)i * stepLength));
-        Vector2 vertex;
+        Vec2D centerPoint = vec2Add(anchor, vec2Scale(unitTangent, (float)i * stepLength));
+        Vec2D vertex;
         if (i == 0)
             vertex = anchor;
         else
@@ -160,49 +318,14 @@ void DrawSpring(SpringMassRenderState *state)
 
         int nextIndex = i + 1;
         // Next vertex (the other end of this segment).
-        Vector2 nextCenterPoint = vec2Add(anchor, vec2Scale(unitTangent, (float)nextIndex * stepLength));
-        Vector2 nextVertex;
+        Vec2D nextCenterPoint = vec2Add(anchor, vec2Scale(unitTangent, (float)nextIndex * stepLength));
+        Vec2D nextVertex;
         if (nextIndex == numSegments)
             nextVertex = attach;
         else
             nextVertex = vec2Add(nextCenterPoint, vec2Scale(unitNormal, ((nextIndex % 2) ? +amplitude : -amplitude)));
 
         // Draw this segment of the polyline.
-        DrawLineEx(vertex, nextVertex, 2, WHITE);
+        renderBackend->line(TileVec(tile, vertex), TileVec(tile, nextVertex), fmaxf(1.0f, 2 * tile.scale), SIM_WHITE);
     }
 }
-
-void DrawRender(SpringMassRenderState *state)
-{
-    DrawFloor(state);
-    DrawMass(state);
-    DrawSpring(state);
-}
-
-void UpdateRender(SpringMassRenderState *state)
-{
-    DrawFloor(state);
-    state->springAttachPoint.x = state->massRectangle.x;
-    DrawMass(state);
-    DrawSpring(state);
-}
-
-void Render_BeginDrawing(void)
-{
-    BeginDrawing();
-}
-
-void Render_EndDrawing(void)
-{
-    EndDrawing();
-}
-
-void Render_ClearBackground(SimColor color)
-{
-    ClearBackground(SimColorToRayColor(color));
-}
-
-float Render_GetFrameTime(void)
-{
-    return GetFrameTime();
-}
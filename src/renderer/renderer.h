@@ -10,6 +10,7 @@
 
 #include "consts.h"
 #include <math.h>
+#include <stdbool.h>
 #include <stdio.h>
 
 // Rendering state for the spring-mass system
@@ -32,20 +33,38 @@ typedef struct SpringMassRenderState
     float elapsedTime; // Elapsed time for animations/timing
 } SpringMassRenderState;
 
+// Placement of one simulation's scene in a shared window: screen = (x, y) + scale * scene
+typedef struct RenderTile
+{
+    float x;     // Screen position of the scene origin
+    float y;     //
+    float scale; // Scene-to-screen scale (1 for a full window)
+} RenderTile;
+
 // Renderer Function Declarations
 void InitRender(SpringMassRenderState *state, int windowWidth, int windowHeight, const char *title,
                 int FPS);                           // Initialize rendering state
+void InitRenderWindow(int windowWidth, int windowHeight, const char *title, int FPS); // Open the window
+void InitRenderState(SpringMassRenderState *state); // Initialize rendering state (window already open)
 void ShowStartupText(SpringMassRenderState *state); // Show startup text
 void ShowStartupTextFadeOut(SpringMassRenderState *state, float dt,
                             float fadeTime);     // Show startup text with fade-out effect
 void DrawFloor(SpringMassRenderState *state);    // Draw the floor
 void DrawMass(SpringMassRenderState *state);     // Draw the mass
 void DrawSpring(SpringMassRenderState *state);   // Draw the spring
+void SetSpringDetail(SpringMassRenderState *state, int segments); // Zig-zag segments (same fully-stretched length)
 void DrawRender(SpringMassRenderState *state);   // Draw entire spring-mass system
 void UpdateRender(SpringMassRenderState *state); // Update rendering state
+void UpdateRenderTiled(SpringMassRenderState **states, const RenderTile *tiles,
+                       int count); // Update and draw several scenes, one batch per primitive type
 void Render_BeginDrawing(void);                  // Begin drawing phase
 void Render_EndDrawing(void);                    // End drawing phase
 void Render_ClearBackground(SimColor color);     // Clear background with specified color
 float Render_GetFrameTime(void);                 // Get time elapsed since last frame
+bool Render_LatchMousePosition(Vec2D *position); // Query the cursor now (false: last polled position only)
+int Render_GetRefreshRate(void);                 // Display refresh rate in Hz (0 if unknown)
+void Render_DrawText(const char *text, int x, int y, int fontSize, SimColor color); // Draw a line of text
+void Render_DrawTileFrame(RenderTile tile, int sceneWidth, int sceneHeight, SimColor color,
+                          const char *label); // Outline a tile and label its top-left corner
 
 #endif
@@ -0,0 +1,502 @@
+/**************************************************************
+ * @file series.c                                             *
+ * @brief Implementation of the compressed time-series store. *
+ * @author Gabe G.                                            *
+ * @date 10-19-2026                                           *
+ **************************************************************/
+
+#include "renderer/series.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Worst case per sample: 5 + 64 time bits and 2 + 5 + 5 + 32 value bits
+#define SERIES_MAX_SAMPLE_BITS 113
+#define SERIES_TICK 1e-9 // Seconds per time offset unit
+#define SERIES_OPEN_WORDS ((SERIES_BLOCK_SAMPLES * SERIES_MAX_SAMPLE_BITS + 63) / 64 + 1)
+
+// Saved image: SeriesImage, `blockCount` SeriesBlockImage headers, then each block's words (BlockWords of it)
+typedef struct SeriesImage
+{
+    int64_t blockCount;
+    int64_t count;
+    uint64_t prevTime;
+    int64_t prevDelta;
+    uint32_t prevValue;
+    int32_t prevLeading;
+    int32_t prevTrailing;
+    uint32_t reserved; // Zero; keeps the headers 8-byte aligned
+} SeriesImage;
+
+typedef struct SeriesBlockImage
+{
+    uint32_t bitCount;
+    uint32_t count;
+    double firstTime;
+    double lastTime;
+} SeriesBlockImage;
+
+// Sequential reader over a block's bit stream
+typedef struct BitReader
+{
+    const uint64_t *bits;
+    uint32_t position;
+} BitReader;
+
+/**********************************
+ *      Forward Declarations      *
+ **********************************/
+
+static void WriteBits(SeriesBlock *block, uint32_t value, int count); // Append the low `count` bits of value
+static uint64_t TimeTicks(const SeriesBlock *block, double time);      // Offset from the block's first time
+static double TicksTime(const SeriesBlock *block, uint64_t ticks);     // Time of an offset, as decoded
+static uint64_t PeekBits(const BitReader *reader);                     // Next 64 bits, without consuming them
+static void OpenBlock(Series *series, double time, float value);       // Start a block with a raw first sample
+static void SealBlock(Series *series);                                 // Shrink the open block to its size
+static uint32_t FloatBits(float value);                                // IEEE bit pattern of a float
+static float BitsFloat(uint32_t bits);                                 // Float with the given bit pattern
+static size_t BlockWords(uint32_t bitCount);                           // Words a sealed block keeps
+
+/***********************************
+ *      External API Functions     *
+ ***********************************/
+
+void SeriesInit(Series *series)
+{
+    memset(series, 0, sizeof(*series));
+    series->prevLeading = -1;
+}
+
+void SeriesFree(Series *series)
+{
+    SeriesClear(series);
+    free(series->blocks);
+    memset(series, 0, sizeof(*series));
+    series->prevLeading = -1;
+}
+
+void SeriesClear(Series *series)
+{
+    for (long b = 0; b < series->blockCount; b++)
+        free(series->blocks[b].bits);
+    series->blockCount = 0;
+    series->count = 0;
+    series->bytes = 0;
+    series->prevLeading = -1;
+}
+
+void SeriesAppend(Series *series, double time, float value)
+{
+    SeriesBlock *block = series->blockCount ? &series->blocks[series->blockCount - 1] : NULL;
+    if (block == NULL || block->count == SERIES_BLOCK_SAMPLES)
+    {
+        if (block != NULL)
+            SealBlock(series);
+        OpenBlock(series, time, value);
+        return;
+    }
+
+    // Time: delta-of-delta of the offset in 1, 9, 12, 16, 37 or 69 bits (wrapping arithmetic keeps it lossless)
+    uint64_t ticks = TimeTicks(block, time);
+    int64_t delta = (int64_t)(ticks - series->prevTime);
+    int64_t dod = (int64_t)((uint64_t)delta - (uint64_t)series->prevDelta);
+    if (dod == 0)
+    {
+        WriteBits(block, 0, 1);
+    }
+    else if (dod >= -63 && dod <= 64)
+    {
+        WriteBits(block, 0x2, 2);
+        WriteBits(block, (uint32_t)(dod + 63), 7);
+    }
+    else if (dod >= -255 && dod <= 256)
+    {
+        WriteBits(block, 0x6, 3);
+        WriteBits(block, (uint32_t)(dod + 255), 9);
+    }
+    else if (dod >= -2047 && dod <= 2048)
+    {
+        WriteBits(block, 0xe, 4);
+        WriteBits(block, (uint32_t)(dod + 2047), 12);
+    }
+    else if (dod >= INT32_MIN && dod <= INT32_MAX)
+    {
+        WriteBits(block, 0x1e, 5);
+        WriteBits(block, (uint32_t)dod, 32);
+    }
+    else
+    {
+        WriteBits(block, 0x1f, 5);
+        WriteBits(block, (uint32_t)((uint64_t)dod >> 32), 32);
+        WriteBits(block, (uint32_t)dod, 32);
+    }
+    series->prevTime = ticks;
+    series->prevDelta = delta;
+
+    // Value: XOR with the previous value; reuse the previous window of meaningful bits when it still fits
+    uint32_t valueBits = FloatBits(value);
+    uint32_t x = valueBits ^ series->prevValue;
+    if (x == 0)
+    {
+        WriteBits(block, 0, 1);
+    }
+    else
+    {
+        int leading = __builtin_clz(x);
+        int trailing = __builtin_ctz(x);
+        if (series->prevLeading >= 0 && leading >= series->prevLeading && trailing >= series->prevTrailing)
+        {
+            WriteBits(block, 0x2, 2);
+            WriteBits(block, x >> series->prevTrailing, 32 - series->prevLeading - series->prevTrailing);
+        }
+        else
+        {
+            int length = 32 - leading - trailing;
+            WriteBits(block, 0x3, 2);
+            WriteBits(block, (uint32_t)leading, 5);
+            WriteBits(block, (uint32_t)(length - 1), 5);
+            WriteBits(block, x >> trailing, length);
+            series->prevLeading = leading;
+            series->prevTrailing = trailing;
+        }
+    }
+    series->prevValue = valueBits;
+
+    block->count++;
+    block->lastTime = TicksTime(block, ticks); // What decoding gives back, so searches agree with decoded times
+    series->count++;
+}
+
+int SeriesDecodeBlock(const Series *series, long b, SeriesSample *out)
+{
+    // Time codes by count of leading ones: '0', '10' + 7, '110' + 9, '1110' + 12, '11110' + 32 and '11111' + 64
+    // bits (the last one read separately)
+    static const int payloadBits[5] = { 0, 7, 9, 12, 32 };
+    static const int32_t payloadBias[5] = { 0, 63, 255, 2047, 0 };
+
+    const SeriesBlock *block = &series->blocks[b];
+    BitReader reader = { block->bits, 0 };
+    uint64_t window = PeekBits(&reader);
+    uint64_t ticks = 0; // The first sample is at offset 0
+    uint32_t valueBits = (uint32_t)(window >> 32);
+    reader.position += 32;
+    int64_t delta = 0;
+    int leading = 0, trailing = 0;
+    out[0] = (SeriesSample){ block->firstTime, BitsFloat(valueBits) };
+
+    for (uint32_t i = 1; i < block->count; i++)
+    {
+        window = PeekBits(&reader);
+        int used = 1; // Bits of `window` taken by the time code
+        if ((window >> 63) != 0)
+        {
+            int ones = __builtin_clzll(~window);
+            if (ones < 5)
+            {
+                int width = payloadBits[ones];
+                int64_t dod = (int32_t)(uint32_t)((window << (ones + 1)) >> (64 - width)) - payloadBias[ones];
+                delta = (int64_t)((uint64_t)delta + (uint64_t)dod);
+                used = ones + 1 + width;
+            }
+            else
+            {
+                reader.position += 5;
+                delta = (int64_t)((uint64_t)delta + PeekBits(&reader));
+                used = 64;
+            }
+        }
+        ticks += (uint64_t)delta;
+
+        // A value code is at most 44 bits; only a long time code forces a second load
+        reader.position += used;
+        window = (used <= 64 - 44) ? window << used : PeekBits(&reader);
+        if ((window >> 63) == 0)
+        {
+            reader.position += 1;
+        }
+        else
+        {
+            int header = 2;
+            if ((window >> 62) == 3)
+            {
+                leading = (int)((window >> 57) & 31);
+                trailing = 32 - leading - (int)((window >> 52) & 31) - 1;
+                header = 12;
+            }
+            int length = 32 - leading - trailing;
+            valueBits ^= (uint32_t)((window << header) >> (64 - length)) << trailing;
+            reader.position += header + length;
+        }
+        out[i] = (SeriesSample){ TicksTime(block, ticks), BitsFloat(valueBits) };
+    }
+    return (int)block->count;
+}
+
+long SeriesFindBlock(const Series *series, double time)
+{
+    long lo = 0, hi = series->blockCount;
+    while (lo < hi)
+    {
+        long mid = (lo + hi) / 2;
+        if (series->blocks[mid].lastTime < time)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+long SeriesRead(const Series *series, long first, long count, SeriesSample *out)
+{
+    if (first < 0)
+        first = 0;
+    if (first + count > series->count)
+        count = series->count - first;
+    SeriesSample decoded[SERIES_BLOCK_SAMPLES];
+    long written = 0;
+    while (written < count)
+    {
+        long index = first + written;
+        int n = SeriesDecodeBlock(series, index / SERIES_BLOCK_SAMPLES, decoded);
+        int offset = (int)(index % SERIES_BLOCK_SAMPLES);
+        long take = n - offset < count - written ? n - offset : count - written;
+        memcpy(out + written, decoded + offset, take * sizeof(SeriesSample));
+        written += take;
+    }
+    return count > 0 ? count : 0;
+}
+
+bool SeriesLast(const Series *series, SeriesSample *out)
+{
+    if (series->count == 0)
+        return false;
+    *out = (SeriesSample){ series->blocks[series->blockCount - 1].lastTime, BitsFloat(series->prevValue) };
+    return true;
+}
+
+bool SeriesFreeze(const Series *series, Series *frozen)
+{
+    // Sealed blocks never change again, so only the block table and the open block (still being written, and
+    // reallocated when sealed) are copied
+    *frozen = *series;
+    frozen->blocks = NULL;
+    frozen->blockCapacity = 0;
+    if (series->blockCount == 0)
+        return true;
+    frozen->blocks = malloc(series->blockCount * sizeof(SeriesBlock));
+    const SeriesBlock *open = &series->blocks[series->blockCount - 1];
+    uint64_t *bits = malloc(BlockWords(open->bitCount) * sizeof(uint64_t));
+    if (frozen->blocks == NULL || bits == NULL)
+    {
+        free(frozen->blocks);
+        free(bits);
+        frozen->blocks = NULL;
+        frozen->blockCount = 0;
+        return false;
+    }
+    memcpy(frozen->blocks, series->blocks, series->blockCount * sizeof(SeriesBlock));
+    memcpy(bits, open->bits, BlockWords(open->bitCount) * sizeof(uint64_t));
+    frozen->blocks[series->blockCount - 1].bits = bits;
+    frozen->blockCapacity = series->blockCount;
+    return true;
+}
+
+void SeriesReleaseFrozen(Series *frozen)
+{
+    if (frozen->blockCount > 0)
+        free(frozen->blocks[frozen->blockCount - 1].bits);
+    free(frozen->blocks);
+    memset(frozen, 0, sizeof(*frozen));
+    frozen->prevLeading = -1;
+}
+
+size_t SeriesImageSize(const Series *series)
+{
+    size_t size = sizeof(SeriesImage) + series->blockCount * sizeof(SeriesBlockImage);
+    for (long b = 0; b < series->blockCount; b++)
+        size += BlockWords(series->blocks[b].bitCount) * sizeof(uint64_t);
+    return size;
+}
+
+size_t SeriesSaveImage(const Series *series, unsigned char *out)
+{
+    SeriesImage image = { series->blockCount, series->count,       series->prevTime,     series->prevDelta,
+                          series->prevValue,  series->prevLeading, series->prevTrailing, 0 };
+    size_t size = 0;
+    memcpy(out, &image, sizeof(image));
+    size += sizeof(image);
+    for (long b = 0; b < series->blockCount; b++)
+    {
+        const SeriesBlock *block = &series->blocks[b];
+        SeriesBlockImage header = { block->bitCount, block->count, block->firstTime, block->lastTime };
+        memcpy(out + size, &header, sizeof(header));
+        size += sizeof(header);
+    }
+    // The open block only needs its written words; the rest of its worst-case allocation is still zero
+    for (long b = 0; b < series->blockCount; b++)
+    {
+        size_t bytes = BlockWords(series->blocks[b].bitCount) * sizeof(uint64_t);
+        memcpy(out + size, series->blocks[b].bits, bytes);
+        size += bytes;
+    }
+    return size;
+}
+
+size_t SeriesLoadImage(Series *series, const unsigned char *data, size_t size)
+{
+    SeriesClear(series);
+    SeriesImage image;
+    if (size < sizeof(image))
+        return 0;
+    memcpy(&image, data, sizeof(image));
+    if (image.blockCount < 0 || image.count < 0 ||
+        (size_t)image.blockCount > (size - sizeof(image)) / sizeof(SeriesBlockImage))
+        return 0;
+
+    // Validate every header before allocating, so a bad image leaves the series empty
+    const unsigned char *headers = data + sizeof(image);
+    size_t used = sizeof(image) + image.blockCount * sizeof(SeriesBlockImage);
+    int64_t samples = 0;
+    for (long b = 0; b < image.blockCount; b++)
+    {
+        SeriesBlockImage header;
+        memcpy(&header, headers + b * sizeof(header), sizeof(header));
+        bool full = header.count == SERIES_BLOCK_SAMPLES;
+        if (header.count == 0 || header.count > SERIES_BLOCK_SAMPLES || (!full && b != image.blockCount - 1) ||
+            header.bitCount < 32 || BlockWords(header.bitCount) > SERIES_OPEN_WORDS)
+            return 0;
+        samples += header.count;
+        used += BlockWords(header.bitCount) * sizeof(uint64_t);
+    }
+    if (samples != image.count || used > size)
+        return 0;
+
+    if (image.blockCount > series->blockCapacity)
+    {
+        SeriesBlock *blocks = realloc(series->blocks, image.blockCount * sizeof(SeriesBlock));
+        if (blocks == NULL)
+            return 0;
+        series->blocks = blocks;
+        series->blockCapacity = image.blockCount;
+    }
+    const unsigned char *words = headers + image.blockCount * sizeof(SeriesBlockImage);
+    for (long b = 0; b < image.blockCount; b++)
+    {
+        SeriesBlockImage header;
+        memcpy(&header, headers + b * sizeof(header), sizeof(header));
+        size_t count = BlockWords(header.bitCount);
+        bool open = b == image.blockCount - 1;
+        size_t allocated = open ? SERIES_OPEN_WORDS : count; // The open block keeps room for its worst case
+        uint64_t *bits = calloc(allocated, sizeof(uint64_t));
+        if (bits == NULL)
+        {
+            SeriesClear(series);
+            return 0;
+        }
+        memcpy(bits, words, count * sizeof(uint64_t));
+        words += count * sizeof(uint64_t);
+        series->blocks[b] = (SeriesBlock){ bits, header.bitCount, header.count, header.firstTime, header.lastTime };
+        series->blockCount = b + 1;
+        series->bytes += allocated * sizeof(uint64_t);
+    }
+    series->count = image.count;
+    series->prevTime = image.prevTime;
+    series->prevDelta = image.prevDelta;
+    series->prevValue = image.prevValue;
+    series->prevLeading = image.prevLeading;
+    series->prevTrailing = image.prevTrailing;
+    return used;
+}
+
+/***************************************
+ *      Internal helper functions      *
+ ***************************************/
+
+static void WriteBits(SeriesBlock *block, uint32_t value, int count)
+{
+    uint64_t bits = (count == 32) ? value : (value & ((1u << count) - 1));
+    uint32_t word = block->bitCount >> 6;
+    int space = 64 - (int)(block->bitCount & 63);
+    if (count <= space)
+    {
+        block->bits[word] |= bits << (space - count);
+    }
+    else
+    {
+        block->bits[word] |= bits >> (count - space);
+        block->bits[word + 1] |= bits << (64 - (count - space));
+    }
+    block->bitCount += count;
+}
+
+static uint64_t TimeTicks(const SeriesBlock *block, double time)
+{
+    return (uint64_t)llround((time - block->firstTime) / SERIES_TICK);
+}
+
+static double TicksTime(const SeriesBlock *block, uint64_t ticks)
+{
+    return block->firstTime + (double)ticks * SERIES_TICK;
+}
+
+static uint64_t PeekBits(const BitReader *reader)
+{
+    uint32_t word = reader->position >> 6;
+    int offset = (int)(reader->position & 63);
+    // Two shifts so an offset of 0 doesn't shift by 64; blocks keep a spare word for the lookahead
+    return (reader->bits[word] << offset) | ((reader->bits[word + 1] >> 1) >> (63 - offset));
+}
+
+static void OpenBlock(Series *series, double time, float value)
+{
+    if (series->blockCount == series->blockCapacity)
+    {
+        long capacity = series->blockCapacity ? series->blockCapacity * 2 : 64;
+        series->blocks = realloc(series->blocks, capacity * sizeof(SeriesBlock));
+        series->blockCapacity = capacity;
+    }
+    SeriesBlock *block = &series->blocks[series->blockCount++];
+    memset(block, 0, sizeof(*block));
+    block->bits = calloc(SERIES_OPEN_WORDS, sizeof(uint64_t)); // Worst case until sealed
+    series->bytes += SERIES_OPEN_WORDS * sizeof(uint64_t);
+
+    // The first sample is stored raw so the block decodes without its predecessors; its time is the block's base
+    series->prevTime = 0;
+    series->prevDelta = 0;
+    series->prevValue = FloatBits(value);
+    series->prevLeading = -1;
+    WriteBits(block, series->prevValue, 32);
+    block->count = 1;
+    block->firstTime = time;
+    block->lastTime = time;
+    series->count++;
+}
+
+static void SealBlock(Series *series)
+{
+    SeriesBlock *block = &series->blocks[series->blockCount - 1];
+    size_t words = BlockWords(block->bitCount);
+    uint64_t *bits = realloc(block->bits, words * sizeof(uint64_t));
+    if (bits != NULL)
+        block->bits = bits;
+    series->bytes -= (SERIES_OPEN_WORDS - words) * sizeof(uint64_t);
+}
+
+static uint32_t FloatBits(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static float BitsFloat(uint32_t bits)
+{
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static size_t BlockWords(uint32_t bitCount)
+{
+    return ((size_t)bitCount + 63) / 64 + 1; // One spare word so reads never run past the end
+}
@@ -0,0 +1,70 @@
+/****************************************************************************************************
+ * @file series.h                                                                                   *
+ * @brief Gorilla-style compressed time-series store in independently decodable blocks (no raylib). *
+ * @author Gabe G.                                                                                  *
+ * @date 10-19-2026                                                                                 *
+ ****************************************************************************************************/
+
+#ifndef SERIES_H
+#define SERIES_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define SERIES_BLOCK_SAMPLES 1024 // Samples per block; every block decodes on its own
+
+// A closed or open block. Times are stored as whole nanoseconds from the block's double first time, so they keep
+// their resolution however long the session runs and a fixed step codes to a zero delta-of-delta; values are
+// stored as the XOR with the previous value, keeping only the bits between the leading and trailing zeros.
+typedef struct SeriesBlock
+{
+    uint64_t *bits;    // Bit stream, most significant bit first
+    uint32_t bitCount; // Bits written
+    uint32_t count;    // Samples in the block
+    double firstTime;  // Time of the first sample (offset 0)
+    double lastTime;   // Time of the last sample, as decoded
+} SeriesBlock;
+
+// Append-only store; only the newest block is open for writing
+typedef struct Series
+{
+    SeriesBlock *blocks; // All blocks, oldest first
+    long blockCount;     // Blocks in use (the last one is open)
+    long blockCapacity;  // Allocated entries in `blocks`
+    long count;          // Samples stored
+    size_t bytes;        // Memory held by the bit streams
+
+    // Encoder state of the open block
+    uint64_t prevTime;  // Previous time offset (ns from the block's first time)
+    int64_t prevDelta;  // Previous time delta (ns)
+    uint32_t prevValue; // Bit pattern of the previous value
+    int prevLeading;    // Leading zeros of the previous XOR window (-1: none yet)
+    int prevTrailing;   // Trailing zeros of the previous XOR window
+} Series;
+
+// A decoded sample
+typedef struct SeriesSample
+{
+    double time;
+    float value;
+} SeriesSample;
+
+// Series Function declarations
+void SeriesInit(Series *series);                                            // Create an empty store
+void SeriesFree(Series *series);                                            // Release every block
+void SeriesClear(Series *series);                                           // Drop all samples
+void SeriesAppend(Series *series, double time, float value);                // Append (times must not decrease)
+int SeriesDecodeBlock(const Series *series, long block, SeriesSample *out); // Decode one block (returns samples)
+long SeriesFindBlock(const Series *series, double time);                    // First block whose last time is >= time
+long SeriesRead(const Series *series, long first, long count,
+                SeriesSample *out);                                         // Decode samples [first, first + count)
+bool SeriesLast(const Series *series, SeriesSample *out);                   // Newest sample (false if empty)
+bool SeriesFreeze(const Series *series, Series *frozen);                    // Read-only copy sharing sealed blocks
+void SeriesReleaseFrozen(Series *frozen);                                   // Free what SeriesFreeze copied
+size_t SeriesImageSize(const Series *series);                               // Bytes written by SeriesSaveImage
+size_t SeriesSaveImage(const Series *series, unsigned char *out);           // Copy blocks and encoder state out
+size_t SeriesLoadImage(Series *series, const unsigned char *data,
+                       size_t size); // Replace contents with a saved image (returns bytes used, 0 if invalid)
+
+#endif
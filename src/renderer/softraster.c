@@ -0,0 +1,866 @@
+/*******************************************************************************************************
+ * @file softraster.c                                                                                  *
+ * @brief CPU rasterizer backend: recorded draw calls replayed over horizontal bands by a thread pool. *
+ * @author Gabe G.                                                                                     *
+ * @date 10-19-2026                                                                                    *
+ *******************************************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "renderer/softraster.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define GLYPH_WIDTH 5   // Font cell width in font pixels
+#define GLYPH_HEIGHT 7  // Font cell height in font pixels
+#define GLYPH_ADVANCE 6 // Horizontal advance per character
+#define GLYPH_LINE 9    // Vertical advance per line
+
+typedef enum SoftCommandType
+{
+    SOFT_CLEAR,
+    SOFT_RECT,
+    SOFT_QUAD,
+    SOFT_CIRCLE,
+    SOFT_TEXT,
+    SOFT_IMAGE
+} SoftCommandType;
+
+// A density image: the rasterizer keeps its own copy, updated row by row like a texture
+struct RenderImage
+{
+    int width;
+    int height;
+    float *pixels;
+};
+
+// One recorded draw call, already clipped vertically to the framebuffer
+typedef struct SoftCommand
+{
+    SoftCommandType type;
+    uint32_t color; // Packed RGBA8
+    int top;        // First covered row
+    int bottom;     // One past the last covered row
+    float v[8];     // Rect: x, y, w, h. Quad: four (x, y) corners. Circle: cx, cy, r. Text: x, y, scale.
+                    // Image: x, y, w, h, scale, invLogPeak
+    int textStart;  // Text: offset into the text arena
+    int textLength; // Text: characters
+    const RenderImage *image; // Image: source
+} SoftCommand;
+
+typedef struct SoftRaster
+{
+    uint32_t *pixels;
+    int width;
+    int height;
+    float frameTime;
+
+    SoftCommand *commands;
+    int commandCount;
+    int commandCapacity;
+    char *text; // Characters of every text command this frame
+    int textLength;
+    int textCapacity;
+
+    // Thread pool: workers wake on a new frame serial and pull bands from `nextBand`
+    pthread_t workers[SOFT_RASTER_MAX_THREADS];
+    int workerCount;
+    pthread_mutex_t lock;
+    pthread_cond_t frameReady;
+    pthread_cond_t frameDone;
+    unsigned long frameSerial;
+    int workersBusy;
+    bool stopping;
+    atomic_int nextBand;
+} SoftRaster;
+
+static SoftRaster raster = { .frameTime = 1.0f / 60.0f };
+
+// 5x7 font for ASCII 32..126, one byte per row with the leftmost pixel in bit 4.
+// Lowercase letters share the uppercase glyphs and are skipped in the table.
+static const uint8_t FONT[][GLYPH_HEIGHT] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // ' '
+    { 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04 }, // '!'
+    { 0x0a, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '"'
+    { 0x0a, 0x0a, 0x1f, 0x0a, 0x1f, 0x0a, 0x0a }, // '#'
+    { 0x04, 0x0f, 0x14, 0x0e, 0x05, 0x1e, 0x04 }, // '$'
+    { 0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03 }, // '%'
+    { 0x0c, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0d }, // '&'
+    { 0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '\''
+    { 0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02 }, // '('
+    { 0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08 }, // ')'
+    { 0x00, 0x04, 0x15, 0x0e, 0x15, 0x04, 0x00 }, // '*'
+    { 0x00, 0x04, 0x04, 0x1f, 0x04, 0x04, 0x00 }, // '+'
+    { 0x00, 0x00, 0x00, 0x00, 0x0c, 0x04, 0x08 }, // ','
+    { 0x00, 0x00, 0x00, 0x1f, 0x00, 0x00, 0x00 }, // '-'
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x0c }, // '.'
+    { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00 }, // '/'
+    { 0x0e, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0e }, // '0'
+    { 0x04, 0x0c, 0x04, 0x04, 0x04, 0x04, 0x0e }, // '1'
+    { 0x0e, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1f }, // '2'
+    { 0x1f, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0e }, // '3'
+    { 0x02, 0x06, 0x0a, 0x12, 0x1f, 0x02, 0x02 }, // '4'
+    { 0x1f, 0x10, 0x1e, 0x01, 0x01, 0x11, 0x0e }, // '5'
+    { 0x06, 0x08, 0x10, 0x1e, 0x11, 0x11, 0x0e }, // '6'
+    { 0x1f, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 }, // '7'
+    { 0x0e, 0x11, 0x11, 0x0e, 0x11, 0x11, 0x0e }, // '8'
+    { 0x0e, 0x11, 0x11, 0x0f, 0x01, 0x02, 0x0c }, // '9'
+    { 0x00, 0x0c, 0x0c, 0x00, 0x0c, 0x0c, 0x00 }, // ':'
+    { 0x00, 0x0c, 0x0c, 0x00, 0x0c, 0x04, 0x08 }, // ';'
+    { 0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02 }, // '<'
+    { 0x00, 0x00, 0x1f, 0x00, 0x1f, 0x00, 0x00 }, // '='
+    { 0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08 }, // '>'
+    { 0x0e, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04 }, // '?'
+    { 0x0e, 0x11, 0x01, 0x0d, 0x15, 0x15, 0x0e }, // '@'
+    { 0x0e, 0x11, 0x11, 0x1f, 0x11, 0x11, 0x11 }, // 'A'
+    { 0x1e, 0x11, 0x11, 0x1e, 0x11, 0x11, 0x1e }, // 'B'
+    { 0x0e, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0e }, // 'C'
+    { 0x1c, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1c }, // 'D'
+    { 0x1f, 0x10, 0x10, 0x1e, 0x10, 0x10, 0x1f }, // 'E'
+    { 0x1f, 0x10, 0x10, 0x1e, 0x10, 0x10, 0x10 }, // 'F'
+    { 0x0e, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0f }, // 'G'
+    { 0x11, 0x11, 0x11, 0x1f, 0x11, 0x11, 0x11 }, // 'H'
+    { 0x0e, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0e }, // 'I'
+    { 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0c }, // 'J'
+    { 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11 }, // 'K'
+    { 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1f }, // 'L'
+    { 0x11, 0x1b, 0x15, 0x15, 0x11, 0x11, 0x11 }, // 'M'
+    { 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 }, // 'N'
+    { 0x0e, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e }, // 'O'
+    { 0x1e, 0x11, 0x11, 0x1e, 0x10, 0x10, 0x10 }, // 'P'
+    { 0x0e, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0d }, // 'Q'
+    { 0x1e, 0x11, 0x11, 0x1e, 0x14, 0x12, 0x11 }, // 'R'
+    { 0x0f, 0x10, 0x10, 0x0e, 0x01, 0x01, 0x1e }, // 'S'
+    { 0x1f, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 }, // 'T'
+    { 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e }, // 'U'
+    { 0x11, 0x11, 0x11, 0x11, 0x11, 0x0a, 0x04 }, // 'V'
+    { 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0a }, // 'W'
+    { 0x11, 0x11, 0x0a, 0x04, 0x0a, 0x11, 0x11 }, // 'X'
+    { 0x11, 0x11, 0x0a, 0x04, 0x04, 0x04, 0x04 }, // 'Y'
+    { 0x1f, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1f }, // 'Z'
+    { 0x0e, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0e }, // '['
+    { 0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00 }, // '\\'
+    { 0x0e, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0e }, // ']'
+    { 0x04, 0x0a, 0x11, 0x00, 0x00, 0x00, 0x00 }, // '^'
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f }, // '_'
+    { 0x08, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '`'
+    { 0x02, 0x04, 0x04, 0x08, 0x04, 0x04, 0x02 }, // '{'
+    { 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 }, // '|'
+    { 0x08, 0x04, 0x04, 0x02, 0x04, 0x04, 0x08 }, // '}'
+    { 0x00, 0x00, 0x08, 0x15, 0x02, 0x00, 0x00 }, // '~'
+};
+
+/**********************************
+ *      Forward Declarations      *
+ **********************************/
+
+static SoftCommand *PushCommand(SoftCommandType type, SimColor color, float top,
+                                float bottom);        // Record a command covering rows [top, bottom)
+static void RasterBands(void);                        // Pull and draw bands until none are left
+static void *WorkerThread(void *arg);                 // Pool worker
+static void StopWorkers(void);                        // Join the pool
+static const uint8_t *Glyph(unsigned char c);         // Font rows for a character
+static int TextScale(int fontSize);                   // Font pixel size for a font size
+
+/***********************************
+ *      External API Functions     *
+ ***********************************/
+
+bool SoftRasterInit(int width, int height, int threads)
+{
+    SoftRasterShutdown();
+    raster.pixels = calloc((size_t)width * height, sizeof(uint32_t));
+    if (raster.pixels == NULL)
+        return false;
+    raster.width = width;
+    raster.height = height;
+
+    if (threads <= 0)
+        threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads < 1)
+        threads = 1;
+    if (threads > SOFT_RASTER_MAX_THREADS)
+        threads = SOFT_RASTER_MAX_THREADS;
+
+    // The calling thread rasterizes too, so the pool holds one fewer
+    pthread_mutex_init(&raster.lock, NULL);
+    pthread_cond_init(&raster.frameReady, NULL);
+    pthread_cond_init(&raster.frameDone, NULL);
+    raster.stopping = false;
+    raster.frameSerial = 0;
+    raster.workerCount = 0;
+    for (int i = 0; i < threads - 1; i++)
+    {
+        if (pthread_create(&raster.workers[raster.workerCount], NULL, WorkerThread, NULL) != 0)
+            break;
+        raster.workerCount++;
+    }
+    return true;
+}
+
+void SoftRasterShutdown(void)
+{
+    if (raster.pixels == NULL)
+        return;
+    StopWorkers();
+    free(raster.pixels);
+    free(raster.commands);
+    free(raster.text);
+    raster.pixels = NULL;
+    raster.commands = NULL;
+    raster.text = NULL;
+    raster.commandCount = raster.commandCapacity = 0;
+    raster.textLength = raster.textCapacity = 0;
+}
+
+void SoftRasterSetFrameTime(float seconds)
+{
+    raster.frameTime = seconds;
+}
+
+const uint32_t *SoftRasterPixels(void)
+{
+    return raster.pixels;
+}
+
+int SoftRasterWidth(void)
+{
+    return raster.width;
+}
+
+int SoftRasterHeight(void)
+{
+    return raster.height;
+}
+
+uint64_t SoftRasterChecksum(void)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    const unsigned char *bytes = (const unsigned char *)raster.pixels;
+    size_t size = (size_t)raster.width * raster.height * sizeof(uint32_t);
+    for (size_t i = 0; i < size; i++)
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    return hash;
+}
+
+bool SoftRasterWritePPM(const char *path)
+{
+    FILE *file = fopen(path, "wb");
+    if (file == NULL)
+        return false;
+
+    fprintf(file, "P6\n%d %d\n255\n", raster.width, raster.height);
+    unsigned char *row = malloc((size_t)raster.width * 3);
+    bool ok = row != NULL;
+    for (int y = 0; ok && y < raster.height; y++)
+    {
+        const uint32_t *pixels = raster.pixels + (size_t)y * raster.width;
+        for (int x = 0; x < raster.width; x++)
+        {
+            row[3 * x + 0] = pixels[x] & 0xff;
+            row[3 * x + 1] = (pixels[x] >> 8) & 0xff;
+            row[3 * x + 2] = (pixels[x] >> 16) & 0xff;
+        }
+        ok = fwrite(row, 3, raster.width, file) == (size_t)raster.width;
+    }
+    free(row);
+    return fclose(file) == 0 && ok;
+}
+
+/************************************
+ *      Backend Implementation      *
+ ************************************/
+
+static void SoftOpenWindow(int width, int height, const char *title, int fps)
+{
+    (void)title;
+    (void)fps;
+    if (raster.pixels == NULL) // The caller may already have picked a size and thread count
+        SoftRasterInit(width, height, 0);
+}
+
+static bool SoftWindowShouldClose(void)
+{
+    return false;
+}
+
+static void SoftBeginFrame(void)
+{
+    raster.commandCount = 0;
+    raster.textLength = 0;
+}
+
+static void SoftEndFrame(void)
+{
+    if (raster.pixels == NULL)
+        return;
+
+    atomic_store(&raster.nextBand, 0);
+    pthread_mutex_lock(&raster.lock);
+    raster.workersBusy = raster.workerCount;
+    raster.frameSerial++;
+    pthread_cond_broadcast(&raster.frameReady);
+    pthread_mutex_unlock(&raster.lock);
+
+    RasterBands();
+
+    pthread_mutex_lock(&raster.lock);
+    while (raster.workersBusy > 0)
+        pthread_cond_wait(&raster.frameDone, &raster.lock);
+    pthread_mutex_unlock(&raster.lock);
+}
+
+static float SoftFrameTime(void)
+{
+    return raster.frameTime;
+}
+
+static void SoftSetWindowPosition(int x, int y)
+{
+    (void)x;
+    (void)y;
+}
+
+static void SoftClear(SimColor color)
+{
+    // Everything recorded so far is covered, so drop it
+    raster.commandCount = 0;
+    raster.textLength = 0;
+    PushCommand(SOFT_CLEAR, color, 0.0f, raster.height);
+}
+
+static void SoftLine(Vec2D from, Vec2D to, float thickness, SimColor color)
+{
+    float dx = to.x - from.x;
+    float dy = to.y - from.y;
+    float length = sqrtf(dx * dx + dy * dy);
+    if (length == 0.0f)
+        return;
+
+    // A line is the quad swept by its width; thin lines are one pixel wide
+    float half = (thickness > 1.0f ? thickness : 1.0f) * 0.5f / length;
+    float nx = -dy * half;
+    float ny = dx * half;
+    float top = fminf(fminf(from.y + ny, from.y - ny), fminf(to.y + ny, to.y - ny));
+    float bottom = fmaxf(fmaxf(from.y + ny, from.y - ny), fmaxf(to.y + ny, to.y - ny));
+    SoftCommand *command = PushCommand(SOFT_QUAD, color, top, bottom);
+    if (command == NULL)
+        return;
+    float corners[8] = { from.x + nx, from.y + ny, to.x + nx, to.y + ny,
+                         to.x - nx,   to.y - ny,   from.x - nx, from.y - ny };
+    memcpy(command->v, corners, sizeof(corners));
+}
+
+static void SoftRect(float x, float y, float width, float height, SimColor color)
+{
+    if (width <= 0.0f || height <= 0.0f)
+        return;
+    SoftCommand *command = PushCommand(SOFT_RECT, color, y, y + height);
+    if (command == NULL)
+        return;
+    command->v[0] = x;
+    command->v[1] = y;
+    command->v[2] = width;
+    command->v[3] = height;
+}
+
+static void SoftRectLines(float x, float y, float width, float height, SimColor color)
+{
+    // One-pixel border inside the rectangle, as raylib draws it
+    SoftRect(x, y, width, 1.0f, color);
+    SoftRect(x, y + height - 1.0f, width, 1.0f, color);
+    SoftRect(x, y + 1.0f, 1.0f, height - 2.0f, color);
+    SoftRect(x + width - 1.0f, y + 1.0f, 1.0f, height - 2.0f, color);
+}
+
+static void SoftCircle(Vec2D center, float radius, SimColor color)
+{
+    if (radius <= 0.0f)
+        return;
+    SoftCommand *command = PushCommand(SOFT_CIRCLE, color, center.y - radius, center.y + radius);
+    if (command == NULL)
+        return;
+    command->v[0] = center.x;
+    command->v[1] = center.y;
+    command->v[2] = radius;
+}
+
+static int SoftMeasureText(const char *text, int fontSize)
+{
+    int scale = TextScale(fontSize);
+    int widest = 0;
+    int current = 0;
+    for (const char *c = text; *c != '\0'; c++)
+    {
+        if (*c == '\n')
+        {
+            current = 0;
+            continue;
+        }
+        current++;
+        if (current > widest)
+            widest = current;
+    }
+    return widest > 0 ? (widest * GLYPH_ADVANCE - (GLYPH_ADVANCE - GLYPH_WIDTH)) * scale : 0;
+}
+
+static void SoftText(const char *text, int x, int y, int fontSize, SimColor color)
+{
+    int length = (int)strlen(text);
+    if (length == 0)
+        return;
+
+    int lines = 1;
+    for (int i = 0; i < length; i++)
+        lines += text[i] == '\n';
+    int scale = TextScale(fontSize);
+
+    if (raster.textLength + length > raster.textCapacity)
+    {
+        int capacity = raster.textCapacity > 0 ? raster.textCapacity : 1024;
+        while (capacity < raster.textLength + length)
+            capacity *= 2;
+        char *grown = realloc(raster.text, capacity);
+        if (grown == NULL)
+            return;
+        raster.text = grown;
+        raster.textCapacity = capacity;
+    }
+
+    SoftCommand *command = PushCommand(SOFT_TEXT, color, y, y + lines * GLYPH_LINE * scale);
+    if (command == NULL)
+        return;
+    command->v[0] = x;
+    command->v[1] = y;
+    command->v[2] = scale;
+    command->textStart = raster.textLength;
+    command->textLength = length;
+    memcpy(raster.text + raster.textLength, text, length);
+    raster.textLength += length;
+}
+
+static RenderImage *SoftCreateImage(int width, int height, const float *pixels)
+{
+    RenderImage *image = malloc(sizeof(RenderImage));
+    float *copy = malloc((size_t)width * height * sizeof(float));
+    if (image == NULL || copy == NULL)
+    {
+        free(image);
+        free(copy);
+        return NULL;
+    }
+    memcpy(copy, pixels, (size_t)width * height * sizeof(float));
+    *image = (RenderImage){ width, height, copy };
+    return image;
+}
+
+static void SoftUpdateImageRows(RenderImage *image, int firstRow, int rows, const float *pixels)
+{
+    memcpy(image->pixels + (size_t)firstRow * image->width, pixels, (size_t)rows * image->width * sizeof(float));
+}
+
+static void SoftDrawImage(RenderImage *image, SimRect bounds, float scale, float invLogPeak, SimColor tint)
+{
+    // Replayed when the frame ends, so the copy must not change before then (updates come before the draw)
+    SoftCommand *command = PushCommand(SOFT_IMAGE, tint, bounds.y, bounds.y + bounds.height);
+    if (command == NULL)
+        return;
+    command->v[0] = bounds.x;
+    command->v[1] = bounds.y;
+    command->v[2] = bounds.width;
+    command->v[3] = bounds.height;
+    command->v[4] = scale;
+    command->v[5] = invLogPeak;
+    command->image = image;
+}
+
+static void SoftDestroyImage(RenderImage *image)
+{
+    if (image == NULL)
+        return;
+    free(image->pixels);
+    free(image);
+}
+
+static Vec2D SoftMousePosition(void)
+{
+    return (Vec2D){ -1.0f, -1.0f }; // Off screen: hover-only drawing stays hidden
+}
+
+static float SoftMouseWheel(void)
+{
+    return 0.0f;
+}
+
+static bool SoftButton(RenderButton button)
+{
+    (void)button;
+    return false;
+}
+
+static bool SoftKeyPressed(RenderKey key)
+{
+    (void)key;
+    return false;
+}
+
+static bool SoftLatchMousePosition(Vec2D *position)
+{
+    *position = SoftMousePosition();
+    return false;
+}
+
+static int SoftRefreshRate(void)
+{
+    return (int)(1.0f / raster.frameTime + 0.5f); // Frames are "shown" once per fixed step
+}
+
+const RenderBackend SOFT_BACKEND = {
+    .name = "software",
+    .openWindow = SoftOpenWindow,
+    .closeWindow = SoftRasterShutdown,
+    .windowShouldClose = SoftWindowShouldClose,
+    .beginFrame = SoftBeginFrame,
+    .endFrame = SoftEndFrame,
+    .frameTime = SoftFrameTime,
+    .setWindowPosition = SoftSetWindowPosition,
+    .clear = SoftClear,
+    .line = SoftLine,
+    .rect = SoftRect,
+    .rectLines = SoftRectLines,
+    .circle = SoftCircle,
+    .text = SoftText,
+    .measureText = SoftMeasureText,
+    .createImage = SoftCreateImage,
+    .updateImageRows = SoftUpdateImageRows,
+    .drawImage = SoftDrawImage,
+    .destroyImage = SoftDestroyImage,
+    .mousePosition = SoftMousePosition,
+    .mouseWheel = SoftMouseWheel,
+    .buttonPressed = SoftButton,
+    .buttonDown = SoftButton,
+    .keyPressed = SoftKeyPressed,
+    .latchMousePosition = SoftLatchMousePosition,
+    .refreshRate = SoftRefreshRate,
+};
+
+/***************************************
+ *      Internal helper functions      *
+ ***************************************/
+
+// First pixel (row or column) whose center is at or past `edge`
+static inline int PixelStart(float edge)
+{
+    return (int)ceilf(edge - 0.5f);
+}
+
+static inline int Clamp(int value, int low, int high)
+{
+    return value < low ? low : (value > high ? high : value);
+}
+
+static inline uint32_t PackColor(SimColor color)
+{
+    return (uint32_t)color.r | (uint32_t)color.g << 8 | (uint32_t)color.b << 16 | (uint32_t)color.a << 24;
+}
+
+static SoftCommand *PushCommand(SoftCommandType type, SimColor color, float top, float bottom)
+{
+    if (raster.pixels == NULL || (color.a == 0 && type != SOFT_CLEAR))
+        return NULL;
+
+    int first = Clamp(PixelStart(top), 0, raster.height);
+    int last = Clamp(PixelStart(bottom), 0, raster.height);
+    if (type == SOFT_TEXT || type == SOFT_CLEAR) // Integer coordinates: the rows themselves
+    {
+        first = Clamp((int)top, 0, raster.height);
+        last = Clamp((int)bottom, 0, raster.height);
+    }
+    if (first >= last)
+        return NULL;
+
+    if (raster.commandCount == raster.commandCapacity)
+    {
+        int capacity = raster.commandCapacity > 0 ? raster.commandCapacity * 2 : 256;
+        SoftCommand *grown = realloc(raster.commands, capacity * sizeof(SoftCommand));
+        if (grown == NULL)
+            return NULL;
+        raster.commands = grown;
+        raster.commandCapacity = capacity;
+    }
+
+    SoftCommand *command = &raster.commands[raster.commandCount++];
+    command->type = type;
+    command->color = PackColor(color);
+    command->top = first;
+    command->bottom = last;
+    return command;
+}
+
+// Fill pixels [x0, x1) of one row. Opaque colors are stored directly; translucent ones are blended
+// as (src * a + dst * (255 - a)) / 255 with the same rounding in the SIMD and scalar paths.
+static void FillSpan(uint32_t *row, int x0, int x1, uint32_t color)
+{
+    unsigned alpha = color >> 24;
+    int x = x0;
+    if (alpha == 255)
+    {
+#if defined(__SSE2__)
+        __m128i fill = _mm_set1_epi32((int)color);
+        for (; x + 4 <= x1; x += 4)
+            _mm_storeu_si128((__m128i *)(row + x), fill);
+#endif
+        for (; x < x1; x++)
+            row[x] = color;
+        return;
+    }
+
+    uint32_t source = color | 0xff000000u; // Coverage comes from `alpha`; the framebuffer stays opaque
+#if defined(__SSE2__)
+    __m128i zero = _mm_setzero_si128();
+    __m128i sourceTerm = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(_mm_set1_epi32((int)source), zero),
+                                                       _mm_set1_epi16((short)alpha)),
+                                       _mm_set1_epi16(128));
+    __m128i inverse = _mm_set1_epi16((short)(255 - alpha));
+    for (; x + 4 <= x1; x += 4)
+    {
+        __m128i dest = _mm_loadu_si128((const __m128i *)(row + x));
+        __m128i low = _mm_add_epi16(sourceTerm, _mm_mullo_epi16(_mm_unpacklo_epi8(dest, zero), inverse));
+        __m128i high = _mm_add_epi16(sourceTerm, _mm_mullo_epi16(_mm_unpackhi_epi8(dest, zero), inverse));
+        low = _mm_srli_epi16(_mm_add_epi16(low, _mm_srli_epi16(low, 8)), 8);
+        high = _mm_srli_epi16(_mm_add_epi16(high, _mm_srli_epi16(high, 8)), 8);
+        _mm_storeu_si128((__m128i *)(row + x), _mm_packus_epi16(low, high));
+    }
+#endif
+    for (; x < x1; x++)
+    {
+        uint32_t dest = row[x];
+        uint32_t blended = 0;
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            unsigned t = ((source >> shift) & 0xff) * alpha + ((dest >> shift) & 0xff) * (255 - alpha) + 128;
+            blended |= (uint32_t)((t + (t >> 8)) >> 8) << shift;
+        }
+        row[x] = blended;
+    }
+}
+
+static void FillRowClipped(int y, float left, float right, uint32_t color)
+{
+    int x0 = Clamp(PixelStart(left), 0, raster.width);
+    int x1 = Clamp(PixelStart(right), 0, raster.width);
+    if (x0 < x1)
+        FillSpan(raster.pixels + (size_t)y * raster.width, x0, x1, color);
+}
+
+static void DrawQuadRow(const SoftCommand *command, int y)
+{
+    // Convex polygon: the row's span runs between the leftmost and rightmost edge crossings
+    float center = y + 0.5f;
+    float left = INFINITY;
+    float right = -INFINITY;
+    for (int i = 0; i < 4; i++)
+    {
+        float ax = command->v[2 * i], ay = command->v[2 * i + 1];
+        float bx = command->v[(2 * i + 2) % 8], by = command->v[(2 * i + 3) % 8];
+        if ((ay <= center) == (by <= center))
+            continue;
+        float x = ax + (center - ay) * (bx - ax) / (by - ay);
+        left = fminf(left, x);
+        right = fmaxf(right, x);
+    }
+    if (left < right)
+        FillRowClipped(y, left, right, command->color);
+}
+
+static void DrawCircleRow(const SoftCommand *command, int y)
+{
+    float dy = y + 0.5f - command->v[1];
+    float squared = command->v[2] * command->v[2] - dy * dy;
+    if (squared <= 0.0f)
+        return;
+    float half = sqrtf(squared);
+    FillRowClipped(y, command->v[0] - half, command->v[0] + half, command->color);
+}
+
+static void DrawImageRow(const SoftCommand *command, int y)
+{
+    // Nearest source pixel, tone-mapped as the GPU shader does it
+    const RenderImage *image = command->image;
+    float left = command->v[0], top = command->v[1], width = command->v[2], height = command->v[3];
+    int sourceRow = Clamp((int)((y + 0.5f - top) * image->height / height), 0, image->height - 1);
+    const float *source = image->pixels + (size_t)sourceRow * image->width;
+    uint32_t *row = raster.pixels + (size_t)y * raster.width;
+    int x1 = Clamp(PixelStart(left + width), 0, raster.width);
+    for (int x = Clamp(PixelStart(left), 0, raster.width); x < x1; x++)
+    {
+        int column = Clamp((int)((x + 0.5f - left) * image->width / width), 0, image->width - 1);
+        float level = logf(1.0f + source[column] * command->v[4]) * command->v[5];
+        if (!(level > 0.0f))
+            continue; // Empty bins are fully transparent
+        level = level < 1.0f ? level : 1.0f;
+        uint32_t color = (uint32_t)(level * 255.0f + 0.5f) << 24;
+        for (int shift = 0; shift < 24; shift += 8)
+        {
+            float tint = (float)((command->color >> shift) & 0xff);
+            color |= (uint32_t)(tint + (255.0f - tint) * level * level + 0.5f) << shift;
+        }
+        FillSpan(row, x, x + 1, color);
+    }
+}
+
+static void DrawTextRows(const SoftCommand *command, int y0, int y1)
+{
+    int scale = (int)command->v[2];
+    int penX = (int)command->v[0];
+    int penY = (int)command->v[1];
+    const char *text = raster.text + command->textStart;
+    for (int i = 0; i < command->textLength; i++)
+    {
+        if (text[i] == '\n')
+        {
+            penX = (int)command->v[0];
+            penY += GLYPH_LINE * scale;
+            continue;
+        }
+
+        const uint8_t *glyph = Glyph((unsigned char)text[i]);
+        for (int gy = 0; gy < GLYPH_HEIGHT; gy++)
+        {
+            int top = penY + gy * scale;
+            if (glyph[gy] == 0 || top + scale <= y0 || top >= y1)
+                continue;
+            // Each run of set bits becomes one span per covered row
+            for (int gx = 0; gx < GLYPH_WIDTH;)
+            {
+                if (!(glyph[gy] & (0x10 >> gx)))
+                {
+                    gx++;
+                    continue;
+                }
+                int start = gx;
+                while (gx < GLYPH_WIDTH && (glyph[gy] & (0x10 >> gx)))
+                    gx++;
+                int x0 = Clamp(penX + start * scale, 0, raster.width);
+                int x1 = Clamp(penX + gx * scale, 0, raster.width);
+                for (int y = top > y0 ? top : y0; x0 < x1 && y < top + scale && y < y1; y++)
+                    FillSpan(raster.pixels + (size_t)y * raster.width, x0, x1, command->color);
+            }
+        }
+        penX += GLYPH_ADVANCE * scale;
+    }
+}
+
+static void DrawBand(int band)
+{
+    int y0 = band * SOFT_RASTER_BAND_ROWS;
+    int y1 = y0 + SOFT_RASTER_BAND_ROWS < raster.height ? y0 + SOFT_RASTER_BAND_ROWS : raster.height;
+
+    for (int i = 0; i < raster.commandCount; i++)
+    {
+        const SoftCommand *command = &raster.commands[i];
+        if (command->bottom <= y0 || command->top >= y1)
+            continue;
+        int first = command->top > y0 ? command->top : y0;
+        int last = command->bottom < y1 ? command->bottom : y1;
+
+        switch (command->type)
+        {
+        case SOFT_CLEAR:
+            for (int y = first; y < last; y++)
+                FillSpan(raster.pixels + (size_t)y * raster.width, 0, raster.width, command->color | 0xff000000u);
+            break;
+        case SOFT_RECT:
+            for (int y = first; y < last; y++)
+                FillRowClipped(y, command->v[0], command->v[0] + command->v[2], command->color);
+            break;
+        case SOFT_QUAD:
+            for (int y = first; y < last; y++)
+                DrawQuadRow(command, y);
+            break;
+        case SOFT_CIRCLE:
+            for (int y = first; y < last; y++)
+                DrawCircleRow(command, y);
+            break;
+        case SOFT_TEXT:
+            DrawTextRows(command, first, last);
+            break;
+        case SOFT_IMAGE:
+            for (int y = first; y < last; y++)
+                DrawImageRow(command, y);
+            break;
+        }
+    }
+}
+
+static void RasterBands(void)
+{
+    int bands = (raster.height + SOFT_RASTER_BAND_ROWS - 1) / SOFT_RASTER_BAND_ROWS;
+    for (int band = atomic_fetch_add(&raster.nextBand, 1); band < bands; band = atomic_fetch_add(&raster.nextBand, 1))
+        DrawBand(band);
+}
+
+static void *WorkerThread(void *arg)
+{
+    (void)arg;
+    unsigned long seen = 0;
+    for (;;)
+    {
+        pthread_mutex_lock(&raster.lock);
+        while (!raster.stopping && raster.frameSerial == seen)
+            pthread_cond_wait(&raster.frameReady, &raster.lock);
+        if (raster.stopping)
+        {
+            pthread_mutex_unlock(&raster.lock);
+            return NULL;
+        }
+        seen = raster.frameSerial;
+        pthread_mutex_unlock(&raster.lock);
+
+        RasterBands();
+
+        pthread_mutex_lock(&raster.lock);
+        if (--raster.workersBusy == 0)
+            pthread_cond_signal(&raster.frameDone);
+        pthread_mutex_unlock(&raster.lock);
+    }
+}
+
+static void StopWorkers(void)
+{
+    pthread_mutex_lock(&raster.lock);
+    raster.stopping = true;
+    pthread_cond_broadcast(&raster.frameReady);
+    pthread_mutex_unlock(&raster.lock);
+    for (int i = 0; i < raster.workerCount; i++)
+        pthread_join(raster.workers[i], NULL);
+    raster.workerCount = 0;
+    pthread_mutex_destroy(&raster.lock);
+    pthread_cond_destroy(&raster.frameReady);
+    pthread_cond_destroy(&raster.frameDone);
+}
+
+static const uint8_t *Glyph(unsigned char c)
+{
+    if (c >= 'a' && c <= 'z')
+        c -= 'a' - 'A';
+    if (c < ' ' || c > '~')
+        c = '?';
+    return FONT[c <= '`' ? c - ' ' : c - ' ' - 26];
+}
+
+static int TextScale(int fontSize)
+{
+    // raylib's default font is 10 pixels tall at size 10
+    int scale = (fontSize + 5) / 10;
+    return scale > 0 ? scale : 1;
+}
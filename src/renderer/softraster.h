@@ -0,0 +1,33 @@
+/*********************************************************************************************
+ * @file softraster.h                                                                        *
+ * @brief Multithreaded CPU rasterizer backend drawing into an RGBA framebuffer (no raylib). *
+ * @author Gabe G.                                                                           *
+ * @date 10-19-2026                                                                          *
+ *********************************************************************************************/
+
+#ifndef SOFTRASTER_H
+#define SOFTRASTER_H
+
+#include "renderer/backend.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SOFT_RASTER_BAND_ROWS 32   // Framebuffer rows per work item
+#define SOFT_RASTER_MAX_THREADS 64 // Upper bound on raster worker threads
+
+// Headless backend: draw calls are recorded during the frame and rasterized when the frame ends,
+// one horizontal band per work item. Every band is drawn in submission order by a single thread,
+// so the output is identical for any thread count. Input queries report no input.
+extern const RenderBackend SOFT_BACKEND;
+
+// Soft Raster Function declarations
+bool SoftRasterInit(int width, int height, int threads); // Allocate the framebuffer (threads <= 0: one per CPU)
+void SoftRasterShutdown(void);                           // Release the framebuffer and command list
+void SoftRasterSetFrameTime(float seconds);              // Value reported by frameTime (fixed step)
+const uint32_t *SoftRasterPixels(void);                  // Row-major RGBA8 (R in the lowest byte)
+int SoftRasterWidth(void);                               // Framebuffer width in pixels
+int SoftRasterHeight(void);                              // Framebuffer height in pixels
+uint64_t SoftRasterChecksum(void);                       // FNV-1a over the pixels (for golden-image checks)
+bool SoftRasterWritePPM(const char *path);               // Write the framebuffer as binary PPM (P6)
+
+#endif
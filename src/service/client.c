@@ -0,0 +1,184 @@
+/*******************************************************************
+ * @file client.c                                                  *
+ * @brief Benchmark client for the Spring-Mass simulation service. *
+ * @author Gabe G.                                                 *
+ * @date 10-19-2026                                                *
+ *******************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "service/protocol.h"
+#include "service/service.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#define CLIENT_MAX_PIPELINE 64
+
+// Per-thread benchmark settings and results
+typedef struct ClientThread
+{
+    pthread_t thread;
+    const char *socketPath;
+    int requests;    // Requests this thread sends
+    int pipeline;    // Requests in flight per round trip (exercises server-side batching)
+    double *latency; // Per-request latency (s)
+    unsigned long samples;
+    int failures;
+} ClientThread;
+
+static double NowSeconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static bool ReadAll(int fd, void *buffer, size_t size)
+{
+    unsigned char *out = buffer;
+    while (size > 0)
+    {
+        ssize_t n = read(fd, out, size);
+        if (n <= 0)
+            return false;
+        out += n;
+        size -= (size_t)n;
+    }
+    return true;
+}
+
+static int ConnectService(const char *path)
+{
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un address = { .sun_family = AF_UNIX };
+    strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+    if (fd < 0 || connect(fd, (struct sockaddr *)&address, sizeof(address)) != 0)
+    {
+        if (fd >= 0)
+            close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void *ClientThreadMain(void *arg)
+{
+    ClientThread *client = arg;
+    int fd = ConnectService(client->socketPath);
+    if (fd < 0)
+    {
+        client->failures = client->requests;
+        return NULL;
+    }
+
+    // 10 s at 1 kHz, sampled at 100 Hz: the size of a typical pipeline query
+    ServiceRequest request = { 0 };
+    request.magic = SERVICE_REQUEST_MAGIC;
+    request.springConst = 100.0;
+    request.mass = 5.0;
+    request.damping = 4.0;
+    request.restitution = 0.1;
+    request.equilibrium = 150.0;
+    request.xMin = 50.0;
+    request.xMax = 400.0;
+    request.v0 = 0.0;
+    request.horizon = 10.0;
+    request.dt = 1e-3;
+    request.sampleEvery = 10;
+
+    uint32_t maxSamples = ServiceSampleCount(&request);
+    ServiceSample *samples = malloc(maxSamples * sizeof(ServiceSample));
+    double sendTime[CLIENT_MAX_PIPELINE];
+    for (int sent = 0; sent < client->requests;)
+    {
+        int inFlight = client->requests - sent < client->pipeline ? client->requests - sent : client->pipeline;
+        for (int i = 0; i < inFlight; i++)
+        {
+            request.id = (uint32_t)(sent + i);
+            request.x0 = 150.0 + (sent + i) % 200; // Vary the initial condition
+            sendTime[i] = NowSeconds();
+            if (write(fd, &request, sizeof(request)) != (ssize_t)sizeof(request))
+                goto done;
+        }
+        for (int i = 0; i < inFlight; i++)
+        {
+            ServiceResponseHeader header;
+            if (!ReadAll(fd, &header, sizeof(header)) || header.magic != SERVICE_RESPONSE_MAGIC ||
+                header.sampleCount > maxSamples || header.id - (uint32_t)sent >= (uint32_t)inFlight ||
+                !ReadAll(fd, samples, header.sampleCount * sizeof(ServiceSample)))
+                goto done;
+            // Workers answer as each job finishes, so responses may arrive out of request order
+            client->latency[header.id] = NowSeconds() - sendTime[header.id - sent];
+            client->samples += header.sampleCount;
+            if (header.status != SERVICE_OK)
+                client->failures++;
+        }
+        sent += inFlight;
+    }
+done:
+    free(samples);
+    close(fd);
+    return NULL;
+}
+
+static int CompareDouble(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Usage: springmass_client [socket path] [requests] [connections] [pipeline depth]
+int main(int argc, char **argv)
+{
+    const char *path = (argc > 1) ? argv[1] : SERVICE_DEFAULT_SOCKET;
+    int requests = (argc > 2) ? atoi(argv[2]) : 10000;
+    int connections = (argc > 3) ? atoi(argv[3]) : 4;
+    int pipeline = (argc > 4) ? atoi(argv[4]) : 8;
+    if (requests < 1 || connections < 1 || pipeline < 1 || pipeline > CLIENT_MAX_PIPELINE)
+    {
+        fprintf(stderr, "usage: %s [socket] [requests] [connections] [pipeline 1-%d]\n", argv[0],
+                CLIENT_MAX_PIPELINE);
+        return 1;
+    }
+
+    double *latency = calloc(requests, sizeof(double));
+    ClientThread *clients = calloc(connections, sizeof(ClientThread));
+    int offset = 0;
+    double start = NowSeconds();
+    for (int i = 0; i < connections; i++)
+    {
+        clients[i].socketPath = path;
+        clients[i].requests = requests / connections + (i < requests % connections);
+        clients[i].pipeline = pipeline;
+        clients[i].latency = latency + offset;
+        offset += clients[i].requests;
+        pthread_create(&clients[i].thread, NULL, ClientThreadMain, &clients[i]);
+    }
+
+    unsigned long samples = 0;
+    int failures = 0;
+    for (int i = 0; i < connections; i++)
+    {
+        pthread_join(clients[i].thread, NULL);
+        samples += clients[i].samples;
+        failures += clients[i].failures;
+    }
+    double elapsed = NowSeconds() - start;
+
+    qsort(latency, requests, sizeof(double), CompareDouble);
+    printf("%d requests over %d connection(s), pipeline %d: %.0f req/s, %.2f Msamples/s\n", requests, connections,
+           pipeline, requests / elapsed, samples / elapsed * 1e-6);
+    printf("latency p50 %.1f us, p99 %.1f us, max %.1f us, failures %d\n", latency[requests / 2] * 1e6,
+           latency[(int)floor(requests * 0.99)] * 1e6, latency[requests - 1] * 1e6, failures);
+
+    free(clients);
+    free(latency);
+    return failures ? 1 : 0;
+}
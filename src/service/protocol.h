@@ -0,0 +1,62 @@
+/**********************************************************************
+ * @file protocol.h                                                   *
+ * @brief Wire format of the Spring-Mass simulation service (socket). *
+ * @author Gabe G.                                                    *
+ * @date 10-19-2026                                                   *
+ **********************************************************************/
+
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <stdint.h>
+
+// All fields are native-endian; the service only listens on a local Unix domain socket.
+#define SERVICE_REQUEST_MAGIC 0x51524d53u  // "SMRQ"
+#define SERVICE_RESPONSE_MAGIC 0x53524d53u // "SMRS"
+#define SERVICE_MAX_SAMPLES (1u << 22)     // Largest trajectory a single request may ask for
+
+// Response status codes
+#define SERVICE_OK 0
+#define SERVICE_BAD_REQUEST 1 // Malformed magic or parameters
+#define SERVICE_TOO_LARGE 2   // horizon / (dt * sampleEvery) exceeds SERVICE_MAX_SAMPLES
+
+// Request flags
+#define SERVICE_FLAG_FIXED 1u // Step with the Q32.32 kernel: the same samples, bit for bit, from any build or machine
+
+// Trajectory request (fixed size)
+typedef struct ServiceRequest
+{
+    uint32_t magic;       // SERVICE_REQUEST_MAGIC
+    uint32_t id;          // Echoed back in the response
+    double springConst;   // k
+    double mass;          // m
+    double damping;       // c
+    double restitution;   // e
+    double equilibrium;   // Rest position
+    double xMin;          // Left wall (-INFINITY for none)
+    double xMax;          // Right wall (+INFINITY for none)
+    double x0;            // Initial position
+    double v0;            // Initial velocity
+    double horizon;       // Simulated time to cover (s)
+    double dt;            // Integration step (s)
+    uint32_t sampleEvery; // Emit a sample every N steps (>= 1)
+    uint32_t flags;       // SERVICE_FLAG_* (other bits must be 0)
+} ServiceRequest;
+
+// Response header, followed by `sampleCount` ServiceSample records
+typedef struct ServiceResponseHeader
+{
+    uint32_t magic;       // SERVICE_RESPONSE_MAGIC
+    uint32_t id;          // Request id
+    uint32_t status;      // SERVICE_OK or an error code (no samples follow on error)
+    uint32_t sampleCount; // Number of samples that follow
+} ServiceResponseHeader;
+
+typedef struct ServiceSample
+{
+    double time;     // Simulation time of the sample
+    double x;        // Position
+    double velocity; // Velocity
+} ServiceSample;
+
+#endif
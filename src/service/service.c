@@ -0,0 +1,664 @@
+/****************************************************************
+ * @file service.c                                              *
+ * @brief Implementation of the Spring-Mass simulation service. *
+ * @author Gabe G.                                              *
+ * @date 10-19-2026                                             *
+ ****************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "service/service.h"
+#include "core/fixed.h"
+#include "core/physics.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_CONNECTIONS 256
+#define LATENCY_BUCKETS 32 // Power-of-two microsecond buckets
+
+// One client connection; shared by the accept loop and any workers holding its jobs
+typedef struct Connection
+{
+    int fd;
+    pthread_mutex_t writeLock; // Guards the outbox
+    struct Job *outHead;       // Finished jobs not yet fully written, oldest first (each holds a reference)
+    struct Job *outTail;
+    size_t outSent;          // Bytes of `outHead`'s response already written
+    atomic_bool backlogged;  // Socket buffer full: the accept loop writes the rest when it turns writable
+    atomic_int refs;         // Accept loop + in-flight jobs
+    bool hungUp;             // Client closed its end: no more reads (accept loop only)
+    size_t received;         // Bytes of `pending` filled so far
+    ServiceRequest pending;  // Request being read
+} Connection;
+
+// A queued request and, once run, its response
+typedef struct Job
+{
+    Connection *connection;
+    ServiceRequest request;
+    double enqueueTime;
+    ServiceResponseHeader header;
+    ServiceSample *samples;
+    struct Job *next;
+} Job;
+
+// Request queue feeding the worker pool
+static struct
+{
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    Job *head;
+    Job *tail;
+    int depth;
+    int workers; // Pool size, to split the queue between workers
+    bool stop;
+} queue = { .lock = PTHREAD_MUTEX_INITIALIZER, .wake = PTHREAD_COND_INITIALIZER };
+
+// Service metrics (updated by workers, reported by the accept loop)
+static struct
+{
+    atomic_ulong completed;
+    atomic_ulong samples;
+    atomic_ulong batches;
+    atomic_ulong latencyTotalUs;
+    atomic_ulong latencyBuckets[LATENCY_BUCKETS];
+    atomic_int maxDepth;
+} metrics;
+
+static volatile sig_atomic_t stopRequested = 0;
+static int wakePipe[2] = { -1, -1 }; // Workers wake the accept loop to watch a backlogged connection
+
+/**********************************
+ *      Forward Declarations      *
+ **********************************/
+
+static double NowSeconds(void);                                        // Monotonic clock
+static void ConnectionRelease(Connection *connection);                 // Drop a reference, closing on last
+static bool ConnectionRead(Connection *connection);                    // Read and enqueue requests (false on EOF)
+static void ConnectionFlush(Connection *connection);                   // Write what the outbox holds, never blocking
+static Job *OutboxWrite(Connection *connection, bool drop);            // Send queued responses, return written ones
+static void QueuePush(Job *job);                                       // Append a job and wake a worker
+static int QueuePopBatch(Job **batch, int max);                        // Take a share of the queue (0 when stopping)
+static void *WorkerThread(void *arg);                                  // Run batches of jobs
+static void StateFromRequest(const ServiceRequest *request, SpringMassSystemState *state); // Set up the system
+static void RunBatch(Job **batch, int count);                          // Simulate jobs, answering each when done
+static void RunLockstep(Job **group, int count);                       // Advance same-step jobs together
+static void Respond(Job *job, int status, uint32_t sampleCount);       // Queue a finished job's response
+static void FinishJobs(Job *done);                                     // Record and free written jobs
+static void RecordLatency(double seconds);                             // Add a completed job to the histogram
+static void ReportMetrics(double elapsed, unsigned long lastCompleted); // Print metrics line to stderr
+
+/***********************************
+ *      External API Functions     *
+ ***********************************/
+
+uint32_t ServiceSampleCount(const ServiceRequest *request)
+{
+    if (request->magic != SERVICE_REQUEST_MAGIC || (request->flags & ~SERVICE_FLAG_FIXED) != 0 ||
+        request->sampleEvery == 0 || !(request->dt > 0.0) || !(request->horizon >= 0.0) || !(request->mass > 0.0) ||
+        !isfinite(request->x0) || !isfinite(request->v0))
+        return 0;
+    double steps = floor(request->horizon / request->dt);
+    double samples = floor(steps / request->sampleEvery) + 1.0;
+    return samples > SERVICE_MAX_SAMPLES ? SERVICE_MAX_SAMPLES + 1 : (uint32_t)samples;
+}
+
+int ServiceSimulate(const ServiceRequest *request, ServiceSample *samples, uint32_t *sampleCount)
+{
+    uint32_t count = ServiceSampleCount(request);
+    *sampleCount = 0;
+    if (count == 0)
+        return SERVICE_BAD_REQUEST;
+    if (count > SERVICE_MAX_SAMPLES)
+        return SERVICE_TOO_LARGE;
+
+    SpringMassSystemState state;
+    StateFromRequest(request, &state);
+
+    int stride = (int)request->sampleEvery;
+    double sampleDt = request->dt * stride;
+    if (request->flags & SERVICE_FLAG_FIXED)
+    {
+        // Lockstep mode: samples are the exact fixed-point values, so runs on different machines compare equal
+        FixedSystem fixed;
+        if (!FixedFromState(&fixed, &state, (SimReal)request->dt))
+            return SERVICE_BAD_REQUEST;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (i > 0)
+                FixedAdvance(&fixed, stride);
+            samples[i] = (ServiceSample){ i * sampleDt, FixedToReal(fixed.x), FixedToReal(fixed.velocity) };
+        }
+        *sampleCount = count;
+        return SERVICE_OK;
+    }
+
+    // The selected kernel runs `sampleEvery` steps per call with coefficients held in registers
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (i > 0)
+            SpringmassAdvance(&state, (SimReal)request->dt, stride);
+        samples[i] = (ServiceSample){ i * sampleDt, state.x, state.velocity };
+    }
+    *sampleCount = count;
+    return SERVICE_OK;
+}
+
+void ServiceStop(void)
+{
+    stopRequested = 1;
+}
+
+int ServiceRun(const ServiceConfig *config)
+{
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0)
+    {
+        perror("socket");
+        return 1;
+    }
+
+    struct sockaddr_un address = { .sun_family = AF_UNIX };
+    if (strlen(config->socketPath) >= sizeof(address.sun_path))
+    {
+        fprintf(stderr, "service: socket path too long\n");
+        close(listenFd);
+        return 1;
+    }
+    strcpy(address.sun_path, config->socketPath);
+    unlink(config->socketPath);
+    if (bind(listenFd, (struct sockaddr *)&address, sizeof(address)) != 0 || listen(listenFd, 64) != 0)
+    {
+        perror("bind/listen");
+        close(listenFd);
+        return 1;
+    }
+
+    // Non-blocking on both ends: a full pipe already means the loop will wake
+    if (pipe(wakePipe) != 0 || fcntl(wakePipe[0], F_SETFL, O_NONBLOCK) != 0 ||
+        fcntl(wakePipe[1], F_SETFL, O_NONBLOCK) != 0)
+    {
+        perror("pipe");
+        close(listenFd);
+        return 1;
+    }
+
+    int threads = config->threads > 0 ? config->threads : 1;
+    queue.workers = threads;
+    pthread_t *workers = malloc(threads * sizeof(pthread_t));
+    for (int i = 0; i < threads; i++)
+        pthread_create(&workers[i], NULL, WorkerThread, NULL);
+
+    fprintf(stderr, "service: listening on %s with %d worker(s)\n", config->socketPath, threads);
+
+    // Slot 0 is the listening socket, slot 1 the wake pipe, the rest are client connections
+    struct pollfd fds[MAX_CONNECTIONS + 2];
+    Connection *connections[MAX_CONNECTIONS + 2];
+    int count = 2;
+    fds[0] = (struct pollfd){ .fd = listenFd, .events = POLLIN };
+    fds[1] = (struct pollfd){ .fd = wakePipe[0], .events = POLLIN };
+
+    double start = NowSeconds();
+    double lastReport = start;
+    unsigned long lastCompleted = 0;
+    while (!stopRequested)
+    {
+        fds[0].events = count < MAX_CONNECTIONS + 2 ? POLLIN : 0; // Stop accepting while full
+        int ready = poll(fds, count, 250);
+        if (ready < 0 && errno != EINTR)
+        {
+            perror("poll");
+            break;
+        }
+
+        if (ready > 0 && (fds[1].revents & POLLIN))
+        {
+            char drain[64];
+            while (read(wakePipe[0], drain, sizeof(drain)) > 0)
+                ;
+        }
+
+        if (ready > 0 && (fds[0].revents & POLLIN))
+        {
+            int clientFd = accept(listenFd, NULL, NULL);
+            if (clientFd >= 0)
+            {
+                Connection *connection = calloc(1, sizeof(Connection));
+                connection->fd = clientFd;
+                pthread_mutex_init(&connection->writeLock, NULL);
+                atomic_init(&connection->refs, 1);
+                connections[count] = connection;
+                fds[count++] = (struct pollfd){ .fd = clientFd, .events = POLLIN };
+            }
+        }
+
+        for (int i = 2; i < count; i++)
+        {
+            Connection *connection = connections[i];
+            short revents = ready > 0 ? fds[i].revents : 0;
+            if (revents & (POLLOUT | POLLERR | POLLHUP))
+                ConnectionFlush(connection);
+            if (!connection->hungUp && revents && !ConnectionRead(connection))
+            {
+                // Client hung up: stop reading, but keep writing while jobs are in flight or backed up
+                shutdown(connection->fd, SHUT_RD);
+                connection->hungUp = true;
+            }
+            if (connection->hungUp && atomic_load(&connection->refs) == 1)
+            {
+                // Nothing left to answer: only the accept loop holds it
+                ConnectionRelease(connection);
+                fds[i] = fds[count - 1];
+                connections[i] = connections[count - 1];
+                count--;
+                i--;
+                continue;
+            }
+            bool backlogged = atomic_load(&connection->backlogged);
+            fds[i].fd = connection->hungUp && !backlogged ? -1 : connection->fd; // Skipped while idle and hung up
+            fds[i].events = (connection->hungUp ? 0 : POLLIN) | (backlogged ? POLLOUT : 0);
+        }
+
+        double now = NowSeconds();
+        if (now - lastReport >= SERVICE_METRICS_INTERVAL)
+        {
+            ReportMetrics(now - lastReport, lastCompleted);
+            lastCompleted = atomic_load(&metrics.completed);
+            lastReport = now;
+        }
+    }
+
+    // Drain: workers finish what is queued, then exit
+    pthread_mutex_lock(&queue.lock);
+    queue.stop = true;
+    pthread_cond_broadcast(&queue.wake);
+    pthread_mutex_unlock(&queue.lock);
+    for (int i = 0; i < threads; i++)
+        pthread_join(workers[i], NULL);
+    free(workers);
+
+    ReportMetrics(NowSeconds() - lastReport, lastCompleted);
+    for (int i = 2; i < count; i++)
+    {
+        // Whatever a slow client has not taken by now is dropped
+        ConnectionFlush(connections[i]);
+        pthread_mutex_lock(&connections[i]->writeLock);
+        Job *dropped = OutboxWrite(connections[i], true);
+        pthread_mutex_unlock(&connections[i]->writeLock);
+        FinishJobs(dropped);
+        ConnectionRelease(connections[i]);
+    }
+    close(wakePipe[0]);
+    close(wakePipe[1]);
+    wakePipe[0] = wakePipe[1] = -1;
+    close(listenFd);
+    unlink(config->socketPath);
+    return 0;
+}
+
+/***************************************
+ *      Internal helper functions      *
+ ***************************************/
+
+static double NowSeconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void ConnectionRelease(Connection *connection)
+{
+    if (atomic_fetch_sub(&connection->refs, 1) == 1)
+    {
+        close(connection->fd);
+        pthread_mutex_destroy(&connection->writeLock);
+        free(connection);
+    }
+}
+
+static bool ConnectionRead(Connection *connection)
+{
+    for (;;)
+    {
+        unsigned char *into = (unsigned char *)&connection->pending + connection->received;
+        ssize_t n = recv(connection->fd, into, sizeof(ServiceRequest) - connection->received, MSG_DONTWAIT);
+        if (n == 0)
+            return false;
+        if (n < 0)
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+
+        connection->received += (size_t)n;
+        if (connection->received < sizeof(ServiceRequest))
+            continue;
+
+        Job *job = calloc(1, sizeof(Job));
+        job->connection = connection;
+        job->request = connection->pending;
+        job->enqueueTime = NowSeconds();
+        atomic_fetch_add(&connection->refs, 1);
+        connection->received = 0;
+        QueuePush(job);
+    }
+}
+
+static void ConnectionFlush(Connection *connection)
+{
+    // Called by the accept loop, which holds its own reference, once a backlogged socket turns writable
+    pthread_mutex_lock(&connection->writeLock);
+    Job *done = OutboxWrite(connection, false);
+    pthread_mutex_unlock(&connection->writeLock);
+    FinishJobs(done);
+}
+
+static void QueuePush(Job *job)
+{
+    pthread_mutex_lock(&queue.lock);
+    if (queue.tail)
+        queue.tail->next = job;
+    else
+        queue.head = job;
+    queue.tail = job;
+    queue.depth++;
+    if (queue.depth > atomic_load(&metrics.maxDepth))
+        atomic_store(&metrics.maxDepth, queue.depth);
+    pthread_cond_signal(&queue.wake);
+    pthread_mutex_unlock(&queue.lock);
+}
+
+static int QueuePopBatch(Job **batch, int max)
+{
+    pthread_mutex_lock(&queue.lock);
+    while (!queue.head && !queue.stop)
+        pthread_cond_wait(&queue.wake, &queue.lock);
+
+    // Coalesce, but only this worker's share of what is waiting, so a burst is spread over the pool instead of
+    // run serially by whichever worker woke first
+    int share = (queue.depth + queue.workers - 1) / queue.workers;
+    if (share < max)
+        max = share;
+    int count = 0;
+    while (queue.head && count < max)
+    {
+        batch[count++] = queue.head;
+        queue.head = queue.head->next;
+    }
+    if (!queue.head)
+        queue.tail = NULL;
+    queue.depth -= count;
+    if (queue.head)
+        pthread_cond_signal(&queue.wake); // More left: wake another worker
+    pthread_mutex_unlock(&queue.lock);
+    return count;
+}
+
+static void *WorkerThread(void *arg)
+{
+    (void)arg;
+    Job *batch[SERVICE_BATCH_MAX];
+    int count;
+    while ((count = QueuePopBatch(batch, SERVICE_BATCH_MAX)) > 0)
+    {
+        atomic_fetch_add(&metrics.batches, 1);
+        RunBatch(batch, count);
+    }
+    return NULL;
+}
+
+static void StateFromRequest(const ServiceRequest *request, SpringMassSystemState *state)
+{
+    InitSystem(state);
+    state->springConst = request->springConst;
+    state->mass = request->mass;
+    state->damping = request->damping;
+    state->restitution = request->restitution;
+    state->equilibrium = request->equilibrium;
+    state->xMin = request->xMin;
+    state->xMax = request->xMax;
+    state->x = request->x0;
+    state->velocity = request->v0;
+    SpringmassSelectKernel(state);
+}
+
+static void RunBatch(Job **batch, int count)
+{
+    // Floating-point jobs with the same step and stride run in lockstep through the batch kernel; the rest
+    // (fixed-point, invalid, or alone in their group) run one at a time. Each job is answered as it finishes.
+    Job *group[SERVICE_BATCH_MAX];
+    bool taken[SERVICE_BATCH_MAX] = { false };
+    for (int first = 0; first < count; first++)
+    {
+        if (taken[first])
+            continue;
+        Job *job = batch[first];
+        uint32_t samples = ServiceSampleCount(&job->request);
+        if (samples > 0 && samples <= SERVICE_MAX_SAMPLES)
+            job->samples = malloc(samples * sizeof(ServiceSample));
+        int grouped = 0;
+        if (job->samples && !(job->request.flags & SERVICE_FLAG_FIXED))
+        {
+            for (int i = first; i < count; i++)
+            {
+                const ServiceRequest *request = &batch[i]->request;
+                if (taken[i] || (request->flags & SERVICE_FLAG_FIXED) || request->dt != job->request.dt ||
+                    request->sampleEvery != job->request.sampleEvery)
+                    continue;
+                uint32_t n = ServiceSampleCount(request);
+                if (i != first && (n == 0 || n > SERVICE_MAX_SAMPLES ||
+                                   !(batch[i]->samples = malloc(n * sizeof(ServiceSample)))))
+                    continue; // Answered with an error on its own turn
+                taken[i] = true;
+                group[grouped++] = batch[i];
+            }
+        }
+        if (grouped > 1)
+        {
+            RunLockstep(group, grouped);
+            continue;
+        }
+
+        taken[first] = true;
+        uint32_t produced = 0;
+        int status = job->samples ? ServiceSimulate(&job->request, job->samples, &produced)
+                                  : (samples == 0 ? SERVICE_BAD_REQUEST : SERVICE_TOO_LARGE);
+        Respond(job, status, produced);
+    }
+}
+
+static void RunLockstep(Job **group, int count)
+{
+    SpringMassSystemState states[SERVICE_BATCH_MAX];
+    SpringMassSystemState *active[SERVICE_BATCH_MAX];
+    Job *jobs[SERVICE_BATCH_MAX];
+    int running = 0;
+    for (int i = 0; i < count; i++)
+    {
+        Job *job = group[i];
+        StateFromRequest(&job->request, &states[i]);
+        job->samples[0] = (ServiceSample){ 0.0, states[i].x, states[i].velocity };
+        if (ServiceSampleCount(&job->request) == 1)
+        {
+            Respond(job, SERVICE_OK, 1);
+            continue;
+        }
+        active[running] = &states[i];
+        jobs[running++] = job;
+    }
+
+    // Every call advances all running systems one stride; a job drops out (and is sent) at its last sample
+    SimReal dt = (SimReal)group[0]->request.dt;
+    int stride = (int)group[0]->request.sampleEvery;
+    double sampleDt = group[0]->request.dt * stride;
+    for (uint32_t sample = 1; running > 0; sample++)
+    {
+        SpringmassAdvanceBatch(active, running, dt, stride);
+        int kept = 0;
+        for (int i = 0; i < running; i++)
+        {
+            Job *job = jobs[i];
+            job->samples[sample] = (ServiceSample){ sample * sampleDt, active[i]->x, active[i]->velocity };
+            if (sample + 1 == ServiceSampleCount(&job->request))
+            {
+                Respond(job, SERVICE_OK, sample + 1);
+                continue;
+            }
+            active[kept] = active[i];
+            jobs[kept++] = job;
+        }
+        running = kept;
+    }
+}
+
+static void Respond(Job *job, int status, uint32_t sampleCount)
+{
+    job->header = (ServiceResponseHeader){ SERVICE_RESPONSE_MAGIC, job->request.id, (uint32_t)status, sampleCount };
+
+    // Queue behind earlier responses on the connection; write now unless the accept loop is already waiting for
+    // the socket to drain, so a slow client never holds up the worker
+    Connection *connection = job->connection;
+    pthread_mutex_lock(&connection->writeLock);
+    job->next = NULL;
+    if (connection->outTail)
+        connection->outTail->next = job;
+    else
+        connection->outHead = job;
+    connection->outTail = job;
+    Job *done = atomic_load(&connection->backlogged) ? NULL : OutboxWrite(connection, false);
+    pthread_mutex_unlock(&connection->writeLock);
+    FinishJobs(done);
+}
+
+static Job *OutboxWrite(Connection *connection, bool drop)
+{
+    // Header and sample buffers are referenced in place, never copied into a send buffer
+    Job *done = NULL;
+    Job **doneTail = &done;
+    while (connection->outHead)
+    {
+        struct iovec iov[2 * SERVICE_BATCH_MAX];
+        int iovCount = 0;
+        for (Job *job = connection->outHead; job && iovCount < 2 * SERVICE_BATCH_MAX; job = job->next)
+        {
+            iov[iovCount++] = (struct iovec){ &job->header, sizeof(job->header) };
+            iov[iovCount++] = (struct iovec){ job->samples, job->header.sampleCount * sizeof(ServiceSample) };
+        }
+
+        // Skip what an earlier partial write already sent
+        struct iovec *cursor = iov;
+        size_t skip = connection->outSent;
+        while (skip >= cursor->iov_len && skip > 0)
+        {
+            skip -= cursor->iov_len;
+            cursor++;
+            iovCount--;
+        }
+        cursor->iov_base = (char *)cursor->iov_base + skip;
+        cursor->iov_len -= skip;
+
+        ssize_t n = -1;
+        if (!drop)
+        {
+            struct msghdr message = { .msg_iov = cursor, .msg_iovlen = iovCount };
+            n = sendmsg(connection->fd, &message, MSG_DONTWAIT | MSG_NOSIGNAL);
+        }
+        if (n < 0 && errno == EINTR && !drop)
+            continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) && !drop)
+        {
+            // Socket buffer full: hand the rest to the accept loop (woken in case it is asleep in poll)
+            if (!atomic_exchange(&connection->backlogged, true))
+            {
+                ssize_t woken = write(wakePipe[1], "", 1); // Only fails when the pipe is full, which wakes it too
+                (void)woken;
+            }
+            *doneTail = NULL;
+            return done;
+        }
+
+        // Retire fully written responses; on error (client gone) or `drop`, retire everything unsent
+        size_t written = n > 0 ? (size_t)n : 0;
+        connection->outSent += written;
+        while (connection->outHead)
+        {
+            Job *job = connection->outHead;
+            size_t bytes = sizeof(job->header) + job->header.sampleCount * sizeof(ServiceSample);
+            if (n > 0 && connection->outSent < bytes)
+                break;
+            connection->outSent = n > 0 ? connection->outSent - bytes : 0;
+            connection->outHead = job->next;
+            *doneTail = job;
+            doneTail = &job->next;
+        }
+        if (!connection->outHead)
+            connection->outTail = NULL;
+    }
+    *doneTail = NULL;
+    atomic_store(&connection->backlogged, false);
+    return done;
+}
+
+static void FinishJobs(Job *done)
+{
+    double now = NowSeconds();
+    while (done)
+    {
+        Job *job = done;
+        done = job->next;
+        RecordLatency(now - job->enqueueTime);
+        atomic_fetch_add(&metrics.samples, job->header.sampleCount);
+        ConnectionRelease(job->connection);
+        free(job->samples);
+        free(job);
+    }
+}
+
+static void RecordLatency(double seconds)
+{
+    unsigned long us = (unsigned long)(seconds * 1e6);
+    int bucket = 0;
+    while (bucket < LATENCY_BUCKETS - 1 && (1ul << bucket) <= us)
+        bucket++;
+    atomic_fetch_add(&metrics.latencyBuckets[bucket], 1);
+    atomic_fetch_add(&metrics.latencyTotalUs, us);
+    atomic_fetch_add(&metrics.completed, 1);
+}
+
+static void ReportMetrics(double elapsed, unsigned long lastCompleted)
+{
+    unsigned long completed = atomic_load(&metrics.completed);
+    unsigned long batches = atomic_load(&metrics.batches);
+
+    // Percentiles from the histogram are upper bounds of their power-of-two bucket
+    unsigned long p50 = 0, p99 = 0, seen = 0;
+    for (int i = 0; i < LATENCY_BUCKETS && completed > 0; i++)
+    {
+        seen += atomic_load(&metrics.latencyBuckets[i]);
+        if (!p50 && seen * 2 >= completed)
+            p50 = 1ul << i;
+        if (!p99 && seen * 100 >= completed * 99)
+            p99 = 1ul << i;
+    }
+
+    pthread_mutex_lock(&queue.lock);
+    int depth = queue.depth;
+    pthread_mutex_unlock(&queue.lock);
+
+    fprintf(stderr,
+            "service: %lu req (%.0f req/s), %lu samples, mean latency %.1f us, p50 <%lu us, p99 <%lu us, "
+            "%.1f req/batch, queue %d (max %d)\n",
+            completed, elapsed > 0 ? (completed - lastCompleted) / elapsed : 0.0, atomic_load(&metrics.samples),
+            completed ? (double)atomic_load(&metrics.latencyTotalUs) / completed : 0.0, p50, p99,
+            batches ? (double)completed / batches : 0.0, depth, atomic_load(&metrics.maxDepth));
+}
@@ -0,0 +1,32 @@
+/**************************************************************
+ * @file service.h                                            *
+ * @brief Local simulation service over a Unix domain socket. *
+ * @author Gabe G.                                            *
+ * @date 10-19-2026                                           *
+ **************************************************************/
+
+#ifndef SERVICE_H
+#define SERVICE_H
+
+#include "service/protocol.h"
+#include <stdbool.h>
+
+#define SERVICE_DEFAULT_SOCKET "/tmp/springmass.sock" // Default socket path
+#define SERVICE_BATCH_MAX 64                          // Most requests a worker takes from the queue at once
+#define SERVICE_METRICS_INTERVAL 5.0                  // Seconds between metrics reports
+
+// Service configuration
+typedef struct ServiceConfig
+{
+    const char *socketPath; // Path of the listening socket (unlinked on start and exit)
+    int threads;            // Worker threads in the pool
+} ServiceConfig;
+
+// Service Function declarations
+int ServiceRun(const ServiceConfig *config); // Serve until ServiceStop() (returns 0 on clean shutdown)
+void ServiceStop(void);                      // Request shutdown (async-signal-safe)
+int ServiceSimulate(const ServiceRequest *request, ServiceSample *samples,
+                    uint32_t *sampleCount); // Run one request into `samples` (returns a SERVICE_* status)
+uint32_t ServiceSampleCount(const ServiceRequest *request); // Samples a valid request produces (0 if invalid)
+
+#endif
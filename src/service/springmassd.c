@@ -0,0 +1,36 @@
+/**************************************************************
+ * @file springmassd.c                                        *
+ * @brief Entry point for the Spring-Mass simulation service. *
+ * @author Gabe G.                                            *
+ * @date 10-19-2026                                           *
+ **************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "service/service.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+static void HandleSignal(int signal)
+{
+    (void)signal;
+    ServiceStop();
+}
+
+// Usage: springmassd [socket path] [worker threads]
+int main(int argc, char **argv)
+{
+    ServiceConfig config;
+    config.socketPath = (argc > 1) ? argv[1] : SERVICE_DEFAULT_SOCKET;
+    config.threads = (argc > 2) ? atoi(argv[2]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+    struct sigaction action = { 0 };
+    action.sa_handler = HandleSignal;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    signal(SIGPIPE, SIG_IGN); // Clients that disconnect early surface as write errors instead
+
+    return ServiceRun(&config);
+}
@@ -0,0 +1,1160 @@
+/******************************************************************
+ * @file bench.c                                                  *
+ * @brief Headless benchmark for the Spring-Mass physics kernels. *
+ * @author Gabe G.                                                *
+ * @date 10-19-2026                                               *
+ ******************************************************************/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "consts.h"
+#include "core/chain.h"
+#include "core/contact.h"
+#include "core/design.h"
+#include "core/ensemble.h"
+#include "core/fixed.h"
+#include "core/modal.h"
+#include "core/parareal.h"
+#include "core/physics.h"
+#include "lib/springmass.h"
+#include "renderer/history.h"
+#include "sim/governor.h"
+#include "sim/perfcount.h"
+#include "sim/preview.h"
+#include "sim/timeline.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_STEPS 20000000 // Steps per configuration
+#define BENCH_DT ((SimReal)1 / 1000)
+
+#define BENCH_SYSTEMS 64 // Systems per force-law batch
+
+#define HISTORY_SECONDS 3600 // Length of the recorded session used for graph history figures
+#define HISTORY_RATE 1000    // Samples per second recorded
+#define HISTORY_COLUMNS 900  // Graph width in pixels
+#define HISTORY_KICK 60      // Seconds between kicks that set the settled mass moving again
+
+#define SENS_STEPS 2000  // Steps of the sensitivity check (two seconds)
+#define SENS_REPEATS 200 // Runs timed per law
+
+#define NOISE_SIGMA 400.0f // White-noise force density of the ensemble check
+#define NOISE_TAU 0.05f    // Correlation time of the coloured-noise run
+
+#define PARAREAL_HOURS 3 // Simulated length of the Parareal check
+
+#define CHAIN_MASSES 512 // Masses in the multirate check
+#define CHAIN_STIFF 8    // Light masses on stiff links in the middle of the chain
+#define CHAIN_SECONDS 20 // Simulated length of the multirate check
+
+#define MODAL_MASSES 256  // Masses in the modal check
+#define MODAL_SECONDS 10  // Time the modal and stepped solutions are compared at
+#define MODAL_SAMPLES 1200 // Output times reconstructed for the per-sample cost
+#define MODAL_TRUNCATED 32 // Modes kept by the truncated solution
+
+#define CONTACT_CRADLE 5         // Balls in the Newton's cradle check
+#define CONTACT_LARGEST 100000   // Bodies in the largest contact scaling run
+#define CONTACT_STEPS 120        // Steps timed per scaling run (one second at 120 Hz)
+
+#define LIB_SYSTEMS 512  // Library systems in the multi-threaded check
+#define LIB_THREADS 8    // Threads the systems are spread over, each owning its share
+#define LIB_STEPS 10000  // Steps per system (ten seconds at 1 kHz)
+#define LIB_RECORD 10    // Steps between recorded samples
+
+#define PREVIEW_DRAG_FRAMES 600 // Frames of a continuous slider drag in the preview check (five seconds at 120 Hz)
+
+#define GOVERNOR_PHASE_SECONDS 60 // Simulated length of each load phase of the governor check
+
+#define TIMELINE_SECONDS 3600 // Length of the recorded session in the timeline check
+#define TIMELINE_SUBSTEPS 4   // Steps per frame of that session
+#define TIMELINE_CHECKS 256   // Instants of it saved live and rebuilt by seeking
+
+#define DRIFT_HOURS 8        // Length of the simulated overnight run used for drift figures
+#define DRIFT_FRAME_RATE 120 // Frame rate the interactive loop targets
+
+// A parameter regime to benchmark
+typedef struct BenchCase
+{
+    SimReal damping;
+    SimReal restitution;
+    int bounded;
+} BenchCase;
+
+static double NowSeconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void SetupCase(SpringMassSystemState *state, const BenchCase *bc)
+{
+    InitSystem(state);
+    state->x = state->equilibrium + 200.0f; // Start stretched so walls get hit
+    state->damping = bc->damping;
+    state->restitution = bc->restitution;
+    state->xMin = bc->bounded ? state->equilibrium - 100.0f : -INFINITY;
+    state->xMax = bc->bounded ? state->equilibrium + 100.0f : INFINITY;
+    SpringmassSelectKernel(state);
+}
+
+// Reference path: the general step (with divisions) followed by the bounds check, once per step
+static double RunGeneral(SpringMassSystemState *state, int steps)
+{
+    double start = NowSeconds();
+    for (int i = 0; i < steps; i++)
+    {
+        SimReal displacement = state->x - state->equilibrium;
+        SimReal a = SpringmassAccel(displacement, state->velocity, state->springConst, state->mass, state->damping);
+        state->velocity += a * BENCH_DT;
+        state->x += state->velocity * BENCH_DT;
+        SpringmassResolveBounds(state, state->xMin, state->xMax);
+    }
+    return NowSeconds() - start;
+}
+
+static double RunKernel(SpringMassSystemState *state, int steps)
+{
+    double start = NowSeconds();
+    SpringmassAdvance(state, BENCH_DT, steps);
+    return NowSeconds() - start;
+}
+
+// Elapsed-time error after an overnight run of frame-time sized increments: naive sum vs Kahan
+static void ReportTimeDrift(void)
+{
+    const long frames = (long)DRIFT_HOURS * 3600 * DRIFT_FRAME_RATE;
+    const float dt = 1.0f / DRIFT_FRAME_RATE; // Frame times arrive as float from the renderer
+
+    SimTime naive = 0;
+    SimClock clock;
+    SimClockReset(&clock);
+    for (long i = 0; i < frames; i++)
+    {
+        naive += dt;
+        SimClockAdvance(&clock, dt);
+    }
+    long double exact = (long double)frames * dt;
+
+    printf("time drift after %dh @ %d Hz: naive %.6Lg s, kahan %.6Lg s\n", DRIFT_HOURS, DRIFT_FRAME_RATE,
+           fabsl((long double)naive - exact), fabsl((long double)clock.time - exact));
+}
+
+// State rounding drift: the same semi-implicit Euler scheme in SimReal vs long double
+static void ReportStateDrift(int steps)
+{
+    SpringMassSystemState state;
+    InitSystem(&state);
+    state.damping = 0;
+    state.x = state.equilibrium + 100;
+    SpringmassSelectKernel(&state);
+
+    long double kOverM = (long double)state.springConst / state.mass;
+    long double dt = BENCH_DT;
+    long double x = state.x - state.equilibrium;
+    long double v = 0;
+
+    double start = NowSeconds();
+    SpringmassAdvance(&state, BENCH_DT, steps);
+    double elapsed = NowSeconds() - start;
+
+    for (int i = 0; i < steps; i++)
+    {
+        v += -kOverM * x * dt;
+        x += v * dt;
+    }
+
+    printf("state drift after %d steps: |x - x_ref| = %.6Lg, throughput %.1f Msteps/s\n", steps,
+           fabsl((long double)(state.x - state.equilibrium) - x), steps / elapsed * 1e-6);
+}
+
+// Each force law over a batch of systems: one scalar kernel call per system vs the grouped SIMD batch
+static void ReportForceLaws(int steps)
+{
+    static SpringMassSystemState scalar[BENCH_SYSTEMS], batch[BENCH_SYSTEMS];
+    SpringMassSystemState *batchStates[BENCH_SYSTEMS];
+    int perSystem = steps / BENCH_SYSTEMS > 0 ? steps / BENCH_SYSTEMS : 1;
+    long total = (long)perSystem * BENCH_SYSTEMS;
+
+    printf("force laws, %d systems, %d lanes per SIMD group\n", BENCH_SYSTEMS, SpringmassBatchLanes());
+    printf("%-22s %12s %12s %8s %14s\n", "law", "scalar ns", "batch ns", "speedup", "|x diff|");
+    for (int law = 0; law < FORCE_LAWS; law++)
+    {
+        for (int i = 0; i < BENCH_SYSTEMS; i++)
+        {
+            BenchCase bc = { 0.01f, 0.5f, 1 };
+            SetupCase(&scalar[i], &bc);
+            scalar[i].law = (ForceLaw)law;
+            scalar[i].x = scalar[i].equilibrium + (i % 16) * 12.0f - 90.0f; // Spread so lanes diverge
+            SpringmassSelectKernel(&scalar[i]);
+            batch[i] = scalar[i];
+            batchStates[i] = &batch[i];
+        }
+
+        double start = NowSeconds();
+        for (int i = 0; i < BENCH_SYSTEMS; i++)
+            SpringmassAdvance(&scalar[i], BENCH_DT, perSystem);
+        double tScalar = NowSeconds() - start;
+
+        start = NowSeconds();
+        SpringmassAdvanceBatch(batchStates, BENCH_SYSTEMS, BENCH_DT, perSystem);
+        double tBatch = NowSeconds() - start;
+
+        double diff = 0;
+        for (int i = 0; i < BENCH_SYSTEMS; i++)
+            diff = fmax(diff, fabs(scalar[i].x - batch[i].x));
+        printf("%-22s %12.3f %12.3f %7.2fx %14.6g\n", SpringmassForceLawName((ForceLaw)law), tScalar * 1e9 / total,
+               tBatch * 1e9 / total, tScalar / tBatch, diff);
+    }
+}
+
+// Sets one sensitivity parameter of a system (the initial position is taken relative to equilibrium)
+static void SetSensParam(SpringMassSystemState *state, SensParam param, SimReal value)
+{
+    SimReal *fields[SENS_PARAMS] = { &state->springConst, &state->damping, &state->mass, &state->x };
+    *fields[param] = value;
+    SpringmassSelectKernel(state);
+}
+
+// Tangent propagation against central finite differences of each parameter, with the walls off (bounces make
+// the sensitivities jump, which differencing cannot follow). Float state needs wide differences, which straddle
+// the stick events of dry friction; double precision gives the clean comparison.
+static void ReportSensitivities(void)
+{
+    const int steps = SENS_STEPS;
+    printf("sensitivities after %d steps, tangent vs central differences\n", steps);
+    printf("%-10s %12s %12s %12s %12s %12s %12s\n", "law", "dx/dk", "dx/dc", "dx/dm", "dx/dx0", "tangent ns",
+           "fd ns");
+    for (int law = 0; law < FORCE_LAWS; law++)
+    {
+        SpringMassSystemState base;
+        InitSystem(&base);
+        base.law = (ForceLaw)law;
+        base.x = base.equilibrium + 80.0f;
+        base.velocity = 150.0f;
+        SpringmassSelectKernel(&base);
+
+        SpringMassTangent tangent;
+        double start = NowSeconds();
+        for (int r = 0; r < SENS_REPEATS; r++)
+        {
+            SpringMassSystemState state = base;
+            SpringmassTangentInit(&tangent);
+            SpringmassAdvanceTangent(&state, &tangent, BENCH_DT, steps);
+        }
+        double tTangent = (NowSeconds() - start) / SENS_REPEATS;
+
+        // Largest error relative to the derivative's size, per parameter
+        const SimReal values[SENS_PARAMS] = { base.springConst, base.damping, base.mass, base.x };
+        double error[SENS_PARAMS];
+        start = NowSeconds();
+        for (int r = 0; r < SENS_REPEATS; r++)
+        {
+            for (int p = 0; p < SENS_PARAMS; p++)
+            {
+                double h = (p == SENS_X0 ? 1 : values[p]) * (sizeof(SimReal) == sizeof(double) ? 1e-5 : 1e-2);
+                SpringMassSystemState plus = base, minus = base;
+                SetSensParam(&plus, (SensParam)p, values[p] + (SimReal)h);
+                SetSensParam(&minus, (SensParam)p, values[p] - (SimReal)h);
+                SpringmassAdvance(&plus, BENCH_DT, steps);
+                SpringmassAdvance(&minus, BENCH_DT, steps);
+                double fd = (plus.x - minus.x) / (2 * h);
+                error[p] = fabs(fd - tangent.dx[p]) / fmax(fabs(fd), 1e-6);
+            }
+        }
+        double tDiff = (NowSeconds() - start) / SENS_REPEATS;
+        printf("%-10s %12.3g %12.3g %12.3g %12.3g %12.1f %12.1f\n", SpringmassForceLawName((ForceLaw)law), error[0],
+               error[1], error[2], error[3], tTangent * 1e9 / steps, tDiff * 1e9 / steps);
+    }
+}
+
+// Inverse design for a few typical specs against the interactive scene's walls: cold, then repeated from the cache
+static void ReportDesign(void)
+{
+    static const char *specs[] = { "overshoot=0.1,settle=2", "settle=1", "overshoot=0.3,impacts=0",
+                                   "impacts=2,settle=3" };
+    printf("design search (walls at -100/+175 around equilibrium)\n");
+    printf("%-26s %7s %7s %7s %5s %9s %6s %6s %5s %9s %9s\n", "spec", "k", "c", "m", "e", "overshoot", "settle",
+           "impact", "met", "cold ms", "warm ms");
+    DesignClearCache();
+    for (size_t i = 0; i < sizeof(specs) / sizeof(specs[0]); i++)
+    {
+        DesignTarget target;
+        DesignParseTarget(&target, specs[i]);
+        SpringMassSystemState state;
+        InitSystem(&state);
+        state.xMin = state.equilibrium - 100.0f;
+        state.xMax = state.equilibrium + 175.0f;
+        SpringmassSelectKernel(&state);
+        SpringMassSystemState again = state;
+
+        DesignResult cold, warm;
+        DesignSolve(&state, &target, &cold);
+        DesignSolve(&again, &target, &warm);
+        printf("%-26s %7.2f %7.2f %7.2f %5.2f %9.3f %6.2f %6d %5s %9.1f %9.3f  (%d run, %d pruned, %d cached)\n",
+               specs[i], cold.springConst, cold.damping, cold.mass, cold.restitution, cold.overshoot,
+               cold.settleTime, cold.impacts, cold.met ? "yes" : "no", cold.seconds * 1e3, warm.seconds * 1e3,
+               cold.evaluated, cold.pruned, cold.cached);
+    }
+}
+
+// Stochastic ensembles of the linear oscillator: the same statistics from 1, 2 and 4 threads (compared bit for bit),
+// and white-noise variance and autocorrelation against the continuous theory, var(x) = sigma^2 / (2 c k)
+static void ReportEnsemble(void)
+{
+    SpringMassSystemState proto;
+    InitSystem(&proto);
+    SpringmassSetNoise(&proto, NOISE_SIGMA, 0, 1, 0);
+    EnsembleConfig config;
+    EnsembleConfigInit(&config);
+
+    // The noisy SIMD kernel draws what the scalar kernel draws
+    static SpringMassSystemState scalar[BENCH_SYSTEMS], batch[BENCH_SYSTEMS];
+    SpringMassSystemState *batchStates[BENCH_SYSTEMS];
+    for (int i = 0; i < BENCH_SYSTEMS; i++)
+    {
+        scalar[i] = proto;
+        scalar[i].noiseStream = (uint64_t)i;
+        batch[i] = scalar[i];
+        batchStates[i] = &batch[i];
+        SpringmassAdvance(&scalar[i], BENCH_DT, SENS_STEPS);
+    }
+    SpringmassAdvanceBatch(batchStates, BENCH_SYSTEMS, BENCH_DT, SENS_STEPS);
+    double diff = 0;
+    for (int i = 0; i < BENCH_SYSTEMS; i++)
+        diff = fmax(diff, fabs(scalar[i].x - batch[i].x));
+
+    printf("noise ensembles, %d members x %d samples every %d steps (kernel %s, scalar vs batch |x diff| %g)\n",
+           config.members, config.samples, config.sampleEvery, SpringmassKernelName(&proto), diff);
+    printf("%-8s %7s %12s %12s %12s %12s %10s %12s\n", "noise", "threads", "mean x", "var x", "var v", "rho(0.1s)",
+           "ms", "ns/step");
+    EnsembleStats reference;
+    for (int run = 0; run < 4; run++)
+    {
+        bool coloured = run == 3;
+        config.threads = coloured ? 0 : 1 << run;
+        SpringmassSetNoise(&proto, NOISE_SIGMA, coloured ? NOISE_TAU : 0, 1, 0);
+        EnsembleStats stats;
+        if (!EnsembleRun(&proto, &config, &stats))
+        {
+            printf("ensemble run failed\n");
+            return;
+        }
+        const char *same = "";
+        if (run == 0)
+            reference = stats;
+        else if (!coloured)
+            same = (memcmp(&stats.position, &reference.position, sizeof(Welford)) == 0 &&
+                    memcmp(&stats.velocity, &reference.velocity, sizeof(Welford)) == 0 &&
+                    memcmp(stats.autocorrelation, reference.autocorrelation, sizeof(stats.autocorrelation)) == 0)
+                       ? "  (bit-identical to 1 thread)"
+                       : "  (DIFFERS from 1 thread)";
+        long memberSteps = (long)config.members * (config.burnIn + (long)config.samples * config.sampleEvery);
+        printf("%-8s %7d %12.4f %12.3f %12.1f %12.4f %10.1f %12.2f%s\n", coloured ? "coloured" : "white",
+               stats.threads, stats.position.mean, WelfordVariance(&stats.position), WelfordVariance(&stats.velocity),
+               stats.autocorrelation[10], stats.seconds * 1e3, stats.seconds * 1e9 / memberSteps, same);
+    }
+
+    // Underdamped linear response to white noise: rho(t) = exp(-zeta w t) (cos wd t + zeta w / wd sin wd t)
+    double k = proto.springConst, c = proto.damping, m = proto.mass, sigma = NOISE_SIGMA;
+    double decay = c / (2 * m), wd = sqrt(k / m - decay * decay);
+    double t = 10 * config.sampleEvery * BENCH_DT;
+    printf("white theory     %12.4f %12.3f %12.1f %12.4f\n", 0.0, sigma * sigma / (2 * c * k),
+           sigma * sigma / (2 * c * m), exp(-decay * t) * (cos(wd * t) + decay / wd * sin(wd * t)));
+}
+
+// Parareal: one long trajectory split into time slices. Reports wall time against the serial fine solve, the time
+// with a core per thread (the critical path, which this machine may not have cores for), and the end-state error
+static void ReportParareal(void)
+{
+    static const struct
+    {
+        const char *name;
+        SimReal damping;
+        SimReal noise;
+    } cases[] = {
+        { "noisy", 4.0f, NOISE_SIGMA },
+        { "light damping", 0.05f, 0 },
+        { "undamped", 0, 0 },
+    };
+    static const int threads[] = { 2, 4, 8, 16 };
+
+    PararealConfig config;
+    PararealConfigInit(&config);
+    config.steps = (long)PARAREAL_HOURS * 3600 * 1000;
+    config.dt = BENCH_DT;
+    printf("parareal, %d h at 1 kHz, coarse step up to %dx the fine step\n", PARAREAL_HOURS, config.coarseRatio);
+    printf("%-14s %7s %5s %10s %10s %10s %9s %9s %9s %12s\n", "case", "threads", "iters", "change", "serial ms",
+           "ms", "speedup", "critical", "ideal", "|x diff|");
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++)
+    {
+        SpringMassSystemState start, serial;
+        InitSystem(&start);
+        start.x += 200.0f;
+        start.damping = cases[c].damping;
+        SpringmassSetNoise(&start, cases[c].noise, 0, 1, 0);
+        serial = start;
+        double t0 = NowSeconds();
+        for (long left = config.steps; left > 0; left -= 1000000)
+            SpringmassAdvance(&serial, config.dt, left > 1000000 ? 1000000 : (int)left);
+        double serialSeconds = NowSeconds() - t0;
+
+        for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++)
+        {
+            config.threads = threads[t];
+            SpringMassSystemState end;
+            PararealStats stats;
+            if (!PararealRun(&start, &config, &end, &stats))
+            {
+                printf("parareal run failed\n");
+                return;
+            }
+            double diff = fmax(fabs((double)end.x - serial.x), fabs((double)end.velocity - serial.velocity) * 0.1);
+            printf("%-14s %7d %5d %10.3g %10.1f %10.1f %8.2fx %8.2fx %8.2fx %12.6g%s\n", cases[c].name, stats.threads,
+                   stats.iterations, stats.change, serialSeconds * 1e3, stats.seconds * 1e3,
+                   serialSeconds / stats.seconds, serialSeconds / stats.criticalSeconds,
+                   (double)stats.slices / stats.iterations, diff,
+                   end.x == serial.x && end.velocity == serial.velocity ? "  (bit-identical)" : "");
+        }
+    }
+}
+
+// Fixed-point kernel: drift from the float kernel, throughput, and a digest to compare between builds and machines
+static void ReportFixed(int steps)
+{
+    static const BenchCase fixedCase = { 0.01f, 0.5f, 1 };
+    SpringMassSystemState state;
+    SetupCase(&state, &fixedCase);
+    state.damping = 1.0f; // Settles over minutes instead of seconds, so drift has time to build
+    SpringmassSelectKernel(&state);
+
+    printf("fixed point (Q32.32), %s start, %d lanes\n", SpringmassKernelName(&state), FixedBatchLanes());
+    printf("%-16s %14s %14s %14s\n", "cross-check", "max |x diff|", "max |v diff|", "rms |x diff|");
+    static const int seconds[] = { 10, 600 };
+    for (size_t i = 0; i < sizeof(seconds) / sizeof(seconds[0]); i++)
+    {
+        FixedDrift drift;
+        FixedCrossCheck(&state, BENCH_DT, seconds[i] * 1000, 10, &drift);
+        printf("%13ds %14.6g %14.6g %14.6g\n", seconds[i], drift.maxPosition, drift.maxVelocity, drift.rmsPosition);
+    }
+
+    // The same systems one at a time and in integer lanes; the digests must match. The fixed systems are varied in
+    // integers, so the digest depends on nothing but the fixed-point kernel.
+    static SpringMassSystemState reals[BENCH_SYSTEMS];
+    static FixedSystem scalar[BENCH_SYSTEMS], batch[BENCH_SYSTEMS];
+    SpringMassSystemState *realStates[BENCH_SYSTEMS];
+    FixedSystem *scalarSystems[BENCH_SYSTEMS], *batchSystems[BENCH_SYSTEMS];
+    for (int i = 0; i < BENCH_SYSTEMS; i++)
+    {
+        reals[i] = state;
+        reals[i].x += i;
+        reals[i].springConst *= 1.0f + 0.01f * i;
+        SpringmassSelectKernel(&reals[i]);
+        FixedFromState(&scalar[i], &state, BENCH_DT);
+        scalar[i].x += i * FIXED_ONE;
+        scalar[i].kDt += scalar[i].kDt / 100 * i;
+        batch[i] = scalar[i];
+        realStates[i] = &reals[i];
+        scalarSystems[i] = &scalar[i];
+        batchSystems[i] = &batch[i];
+    }
+    int perSystem = steps / BENCH_SYSTEMS > 1000 ? steps / BENCH_SYSTEMS : 1000;
+    double start = NowSeconds();
+    SpringmassAdvanceBatch(realStates, BENCH_SYSTEMS, BENCH_DT, perSystem);
+    double tFloat = NowSeconds() - start;
+    start = NowSeconds();
+    for (int i = 0; i < BENCH_SYSTEMS; i++)
+        FixedAdvance(scalarSystems[i], perSystem);
+    double tScalar = NowSeconds() - start;
+    start = NowSeconds();
+    FixedAdvanceBatch(batchSystems, BENCH_SYSTEMS, perSystem);
+    double tBatch = NowSeconds() - start;
+    uint64_t digest = FixedDigest(scalarSystems, BENCH_SYSTEMS);
+    double total = (double)perSystem * BENCH_SYSTEMS;
+    printf("%d systems x %d steps: float batch %.3f ns/step, fixed scalar %.3f ns/step, fixed lanes %.3f ns/step\n",
+           BENCH_SYSTEMS, perSystem, tFloat * 1e9 / total, tScalar * 1e9 / total, tBatch * 1e9 / total);
+    printf("digest %016llx (%s)\n", (unsigned long long)digest,
+           digest == FixedDigest(batchSystems, BENCH_SYSTEMS) ? "scalar and lanes identical" : "LANES DIFFER");
+}
+
+// A soft chain with a short stiff section, stepped multirate and with every mass at the stiff section's rate
+static void ReportChain(void)
+{
+    const SimReal dt = (SimReal)1 / DRIFT_FRAME_RATE;
+    const int steps = CHAIN_SECONDS * DRIFT_FRAME_RATE;
+    const int stiffFirst = (CHAIN_MASSES - CHAIN_STIFF) / 2;
+    SpringChain chains[2];
+    for (int run = 0; run < 2; run++)
+    {
+        if (!ChainInit(&chains[run], CHAIN_MASSES))
+        {
+            printf("chain allocation failed\n");
+            return;
+        }
+        for (int i = 0; i < CHAIN_MASSES; i++)
+        {
+            bool stiff = i >= stiffFirst && i < stiffFirst + CHAIN_STIFF;
+            ChainSetMass(&chains[run], i, stiff ? 0.001f : 1.0f);
+            ChainSetLink(&chains[run], i, stiff ? 500.0f : 50.0f, 0, 10);
+            chains[run].x[i] = 10.0f * (i + 1);
+        }
+        chains[run].v[0] = 20.0f; // A pulse that runs down the chain and through the stiff section
+        chains[run].singleRate = run == 1;
+    }
+
+    printf("multirate chain, %d masses (%d stiff), %.2f ms step, %ds\n", CHAIN_MASSES, CHAIN_STIFF, dt * 1e3,
+           CHAIN_SECONDS);
+    printf("%-12s %8s %14s %12s %14s\n", "stepping", "classes", "updates/step", "us/step", "energy drift");
+    double energy = ChainEnergy(&chains[0]), seconds[2];
+    for (int run = 0; run < 2; run++)
+    {
+        double start = NowSeconds();
+        ChainAdvance(&chains[run], dt, steps);
+        seconds[run] = NowSeconds() - start;
+        const SpringChain *chain = &chains[run];
+        printf("%-12s %8d %14.1f %12.3f %14.3g\n", run ? "single rate" : "multirate", chain->classes,
+               (double)(chain->massUpdates + chain->linkUpdates) / steps, seconds[run] * 1e6 / steps,
+               ChainEnergy(chain) / energy - 1);
+    }
+    double diff = 0;
+    for (int i = 0; i < CHAIN_MASSES; i++)
+        diff = fmax(diff, fabs(chains[0].x[i] - chains[1].x[i]));
+    printf("speedup %.1fx, max |x diff| between the two %.3g px\n", seconds[1] / seconds[0], diff);
+
+    // Making the stiff section like the rest puts every mass back in one class on the next step
+    for (int i = stiffFirst; i < stiffFirst + CHAIN_STIFF; i++)
+    {
+        ChainSetMass(&chains[0], i, 1.0f);
+        ChainSetLink(&chains[0], i, 50.0f, 0, 10);
+    }
+    ChainAdvance(&chains[0], dt, 1);
+    printf("after making the stiff section soft: %d class(es)\n", chains[0].classes);
+    ChainFree(&chains[0]);
+    ChainFree(&chains[1]);
+}
+
+// Modal solution of a proportionally damped chain against stepping it, and the cost of a sample
+static void ReportModal(void)
+{
+    SpringChain chain, stepped;
+    if (!ChainInit(&chain, MODAL_MASSES) || !ChainInit(&stepped, MODAL_MASSES))
+    {
+        printf("chain allocation failed\n");
+        return;
+    }
+    for (int i = 0; i < MODAL_MASSES; i++)
+    {
+        ChainSetMass(&chain, i, 0.5f + 1.5f * (i % 7) / 6); // Uneven masses, so the modes are not plain sines
+        ChainSetLink(&chain, i, 50.0f, 0.1f, 10);
+        chain.x[i] = 10.0f * (i + 1) + 5.0f * sinf(3.14159265f * i / MODAL_MASSES);
+    }
+    chain.v[0] = 20.0f;
+
+    ModalChain full, truncated;
+    double start = NowSeconds();
+    bool ok = ModalInit(&full, &chain, 0);
+    double tDecompose = NowSeconds() - start;
+    ok = ModalInit(&truncated, &chain, MODAL_TRUNCATED) && ok;
+    if (!ok)
+    {
+        printf("modal decomposition failed\n");
+        return;
+    }
+    printf("modal chain, %d masses, c/k %.3g, decomposition %.1f ms, modes from %.4f to %.2f rad/s\n", MODAL_MASSES,
+           full.beta, tDecompose * 1e3, full.omega[0], full.omega[full.modes - 1]);
+
+    // Stepping converges to the modal solution as the step shrinks (in float builds only until the rounding of
+    // positions a few thousand px from the wall takes over)
+    static SimReal exact[MODAL_MASSES], reduced[MODAL_MASSES];
+    double at = MODAL_SECONDS;
+    ModalSample(&full, &at, 1, exact);
+    ModalSample(&truncated, &at, 1, reduced);
+    printf("%-22s %14s\n", "after 10 s", "max |x diff|");
+    static const int rates[] = { 120, 1200, 12000 };
+    for (size_t r = 0; r < sizeof(rates) / sizeof(rates[0]); r++)
+    {
+        for (int i = 0; i < MODAL_MASSES; i++)
+        {
+            ChainSetMass(&stepped, i, chain.mass[i]);
+            ChainSetLink(&stepped, i, chain.k[i], chain.c[i], chain.rest[i]);
+        }
+        memcpy(stepped.x, chain.x, sizeof(SimReal) * MODAL_MASSES);
+        memcpy(stepped.v, chain.v, sizeof(SimReal) * MODAL_MASSES);
+        ChainAdvance(&stepped, (SimReal)1 / rates[r], MODAL_SECONDS * rates[r]);
+        double diff = 0;
+        for (int i = 0; i < MODAL_MASSES; i++)
+            diff = fmax(diff, fabs(stepped.x[i] - exact[i]));
+        printf("stepped at %5d Hz     %14.4g\n", rates[r], diff);
+    }
+    double diff = 0;
+    for (int i = 0; i < MODAL_MASSES; i++)
+        diff = fmax(diff, fabs(reduced[i] - exact[i]));
+    printf("lowest %d modes        %14.4g\n", MODAL_TRUNCATED, diff);
+
+    // Per-sample cost against stepping one 120 Hz frame
+    static double times[MODAL_SAMPLES];
+    static SimReal positions[MODAL_SAMPLES * MODAL_MASSES];
+    for (int s = 0; s < MODAL_SAMPLES; s++)
+        times[s] = s / 120.0;
+    start = NowSeconds();
+    ModalSample(&full, times, MODAL_SAMPLES, positions);
+    double tFull = (NowSeconds() - start) / MODAL_SAMPLES;
+    start = NowSeconds();
+    ModalSample(&truncated, times, MODAL_SAMPLES, positions);
+    double tTruncated = (NowSeconds() - start) / MODAL_SAMPLES;
+    start = NowSeconds();
+    ChainAdvance(&stepped, (SimReal)1 / 120, MODAL_SAMPLES);
+    double tStep = (NowSeconds() - start) / MODAL_SAMPLES;
+    printf("per output time: all modes %.2f us, lowest %d %.2f us, one 120 Hz step %.2f us\n", tFull * 1e6,
+           MODAL_TRUNCATED, tTruncated * 1e6, tStep * 1e6);
+    ModalFree(&full);
+    ModalFree(&truncated);
+    ChainFree(&chain);
+    ChainFree(&stepped);
+}
+
+// Uniform draw in [0, 1) from a 64-bit LCG, for reproducible bench scenes
+static double Uniform(uint64_t *seed)
+{
+    *seed = *seed * 6364136223846793005ull + 1442695040888963407ull;
+    return (*seed >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Body-body contacts: a Newton's cradle, then throughput and broadphase work from 10^3 to 10^5 bodies
+static void ReportContact(void)
+{
+    const SimReal dt = (SimReal)1 / DRIFT_FRAME_RATE;
+    ContactLine line;
+    if (!ContactInit(&line, CONTACT_CRADLE))
+        return;
+    for (int i = 1; i < CONTACT_CRADLE; i++)
+        line.x[i] = (SimReal)i * RECT_SIZE; // Hanging balls touching, the striker one width away
+    line.x[0] = -RECT_SIZE;
+    line.v[0] = 200.0f;
+    double energy = ContactKineticEnergy(&line);
+    ContactAdvance(&line, dt, DRIFT_FRAME_RATE);
+    printf("newton's cradle after 1 s, velocities:");
+    for (int i = 0; i < CONTACT_CRADLE; i++)
+        printf(" %.2f", line.v[i]);
+    printf(" (kinetic energy kept %.4f)\n", ContactKineticEnergy(&line) / energy);
+    ContactFree(&line);
+
+    printf("%-10s %12s %12s %12s %12s %14s\n", "bodies", "ns/body", "pairs/step", "swaps/step", "impulses/step",
+           "momentum drift");
+    for (int count = 1000; count <= CONTACT_LARGEST; count *= 10)
+    {
+        if (!ContactInit(&line, count))
+        {
+            printf("contact allocation failed\n");
+            return;
+        }
+        // Bodies of mixed mass and width crowded onto soft springs, half of them free, all moving
+        uint64_t seed = 42;
+        SimReal anchor = 0;
+        for (int i = 0; i < count; i++)
+        {
+            SimReal width = (SimReal)(60 + 80 * Uniform(&seed));
+            anchor += width / 2 + 2;
+            ContactSetBody(&line, i, (SimReal)(0.5 + 1.5 * Uniform(&seed)), i & 1 ? 20.0f : 0.0f, 0, anchor, width);
+            line.x[i] = anchor;
+            line.v[i] = (SimReal)(400 * Uniform(&seed) - 200);
+            anchor += width / 2 + 2;
+        }
+        line.restitution = 0.9f;
+        ContactAdvance(&line, dt, DRIFT_FRAME_RATE); // Settle into a typical state first
+        line.swaps = line.contacts = line.impulses = 0;
+
+        // Free bodies only exchange momentum, so measure it with every spring off
+        double momentum = 0;
+        if (count == 1000)
+        {
+            for (int i = 0; i < count; i++)
+                line.kOverM[i] = 0;
+            momentum = ContactMomentum(&line);
+        }
+        double start = NowSeconds();
+        ContactAdvance(&line, dt, CONTACT_STEPS);
+        double elapsed = NowSeconds() - start;
+        char drift[32] = "-";
+        if (count == 1000)
+            snprintf(drift, sizeof(drift), "%.3g", fabs(ContactMomentum(&line) / momentum - 1));
+        printf("%-10d %12.1f %12.1f %12.1f %12.1f %14s\n", count, elapsed * 1e9 / ((double)count * CONTACT_STEPS),
+               (double)line.contacts / CONTACT_STEPS, (double)line.swaps / CONTACT_STEPS,
+               (double)line.impulses / CONTACT_STEPS, drift);
+        ContactFree(&line);
+    }
+}
+
+// One thread's share of the library check: it creates, runs and destroys its own systems
+typedef struct LibraryJob
+{
+    int first;       // Index of the first system (picks its parameters)
+    int count;       // Systems owned
+    double *final;   // Final position of each
+    long samples;    // Samples recorded over all of them
+    bool ok;         // Every system was created
+} LibraryJob;
+
+static void *LibraryWorker(void *arg)
+{
+    LibraryJob *job = arg;
+    SmSystem *systems[LIB_SYSTEMS];
+    job->ok = true;
+    job->samples = 0;
+    for (int i = 0; i < job->count; i++)
+    {
+        // Every force law, a spread of stiffness and start positions, and noise on every fifth system
+        int n = job->first + i;
+        systems[i] = SmCreate();
+        if (systems[i] == NULL)
+        {
+            job->count = i;
+            job->ok = false;
+            break;
+        }
+        SmSetParam(systems[i], SM_PARAM_LAW, n % (SM_LAW_TABLE + 1));
+        SmSetParam(systems[i], SM_PARAM_SPRING, 50 + n);
+        SmSetParam(systems[i], SM_PARAM_WALL_MIN, 0);
+        SmSetParam(systems[i], SM_PARAM_WALL_MAX, 400);
+        if (n % 5 == 0)
+        {
+            SmSetParam(systems[i], SM_PARAM_NOISE, NOISE_SIGMA);
+            SmSetNoiseSeed(systems[i], 7, n);
+        }
+        SmSetState(systems[i], 250 + (n % 7) * 20, 0);
+        SmRecord(systems[i], LIB_RECORD);
+    }
+    for (int step = 0; step < LIB_STEPS; step += 100)
+        SmStepBatch(systems, job->count, 1.0 / 1000, 100);
+    for (int i = 0; i < job->count; i++)
+    {
+        SmState state;
+        SmGetState(systems[i], &state);
+        job->final[i] = state.position;
+        job->samples += SmHistoryCount(systems[i]);
+        SmDestroy(systems[i]);
+    }
+    return NULL;
+}
+
+// The library: the same systems run once on this thread and once spread over LIB_THREADS threads must agree bit
+// for bit, since no state outside a system is shared
+static void ReportLibrary(void)
+{
+    static double serial[LIB_SYSTEMS], threaded[LIB_SYSTEMS];
+    int share = LIB_SYSTEMS / LIB_THREADS;
+    LibraryJob jobs[LIB_THREADS];
+    double start = NowSeconds();
+    bool ok = true;
+    for (int t = 0; t < LIB_THREADS; t++)
+    {
+        jobs[t] = (LibraryJob){ t * share, share, serial + t * share, 0, false };
+        LibraryWorker(&jobs[t]);
+        ok &= jobs[t].ok;
+    }
+    double serialSeconds = NowSeconds() - start;
+
+    pthread_t workers[LIB_THREADS];
+    bool started[LIB_THREADS] = { false };
+    long samples = 0;
+    start = NowSeconds();
+    for (int t = 0; t < LIB_THREADS; t++)
+    {
+        jobs[t] = (LibraryJob){ t * share, share, threaded + t * share, 0, false };
+        started[t] = pthread_create(&workers[t], NULL, LibraryWorker, &jobs[t]) == 0;
+        if (!started[t])
+            LibraryWorker(&jobs[t]);
+    }
+    for (int t = 0; t < LIB_THREADS; t++)
+    {
+        if (started[t])
+            pthread_join(workers[t], NULL);
+        ok &= jobs[t].ok;
+        samples += jobs[t].samples;
+    }
+    double threadedSeconds = NowSeconds() - start;
+
+    int mismatched = 0;
+    for (int i = 0; i < LIB_SYSTEMS; i++)
+        mismatched += memcmp(&serial[i], &threaded[i], sizeof(double)) != 0;
+    double steps = (double)LIB_SYSTEMS * LIB_STEPS;
+    printf("libspringmass %d.%d: %d systems, %.1f M steps/s on 1 thread, %.1f M steps/s on %d, %ld samples "
+           "recorded, %s\n",
+           SmVersion() / 100, SmVersion() % 100, LIB_SYSTEMS, steps / serialSeconds * 1e-6,
+           steps / threadedSeconds * 1e-6, LIB_THREADS, samples,
+           !ok ? "allocation failed" : mismatched ? "threaded results differ" : "threaded results identical");
+}
+
+// Forecast preview: a slider dragged every frame. Requests must cost the frame loop next to nothing, stale jobs
+// must be dropped, and the last forecast must match stepping the frame loop's way
+static void ReportPreview(void)
+{
+    const SimReal step = (SimReal)1 / DRIFT_FRAME_RATE;
+    const struct timespec frame = { 0, 1000000000L / DRIFT_FRAME_RATE };
+    Preview preview;
+    PreviewInit(&preview);
+    SpringMassSystemState state;
+    InitSystem(&state);
+    state.x = 250;
+    SpringmassSelectKernel(&state);
+
+    double worst = 0, total = 0;
+    int shown = 0;
+    PreviewJob last = { 0 };
+    PreviewRequest(&preview, &state, 0, step, 1); // Starts the worker: a thread is created once, not per drag
+    for (int f = 0; f < PREVIEW_DRAG_FRAMES; f++)
+    {
+        state.springConst = (SimReal)(50 + f % 200); // The slider sweeps back and forth
+        SpringmassSelectKernel(&state);
+        double start = NowSeconds();
+        if (!PreviewRequest(&preview, &state, f * (double)step, step, 1))
+        {
+            printf("preview: no worker thread\n");
+            return;
+        }
+        double spent = NowSeconds() - start;
+        last = (PreviewJob){ state, f * (double)step, step, 1, (unsigned long)f + 2 };
+        total += spent;
+        worst = fmax(worst, spent);
+        shown += PreviewLatest(&preview) != NULL;
+        SpringmassAdvance(&state, step, 1);
+        nanosleep(&frame, NULL);
+    }
+    nanosleep(&frame, NULL);
+    nanosleep(&frame, NULL); // Let the last job finish
+    const PreviewForecast *forecast = PreviewLatest(&preview);
+    PreviewShutdown(&preview);
+
+    // The worker's answer to the last request, against the same job run here
+    static PreviewForecast reference;
+    PreviewRun(&last, &reference, NULL);
+    bool exact = forecast != NULL && forecast->generation == last.generation && forecast->count == reference.count &&
+                 memcmp(forecast->displacement, reference.displacement, reference.count * sizeof(float)) == 0;
+    unsigned long published = atomic_load(&preview.published), cancelled = atomic_load(&preview.cancelled);
+    printf("preview: %d requests, %.2f us mean / %.2f us worst in the frame loop, %lu forecasts, %lu dropped stale, "
+           "%lu skipped while one ran, forecast shown on %d frames, last forecast %s\n",
+           PREVIEW_DRAG_FRAMES, total / PREVIEW_DRAG_FRAMES * 1e6, worst * 1e6, published, cancelled,
+           PREVIEW_DRAG_FRAMES + 1 - published - cancelled, shown, exact ? "exact" : "wrong or missing");
+}
+
+// A counter per step for the table below, or "-" when the PMU didn't provide it
+static const char *CounterCell(char *cell, size_t size, PerfCounter counter, double value)
+{
+    if (PerfHasCounter(counter))
+        snprintf(cell, size, "%.3f", value);
+    else
+        snprintf(cell, size, "-");
+    return cell;
+}
+
+// Hardware counters for the same steps taken by the general path, the specialized kernel and the SIMD batch
+static void ReportCounters(int steps)
+{
+    if (!PerfInit())
+    {
+        printf("perf counters: unavailable (%s)\n", PerfError());
+        return;
+    }
+    static const BenchCase counterCase = { 0.01f, 0.5f, 1 };
+    static SpringMassSystemState states[BENCH_SYSTEMS];
+    SpringMassSystemState *batch[BENCH_SYSTEMS];
+    for (int i = 0; i < BENCH_SYSTEMS; i++)
+    {
+        SetupCase(&states[i], &counterCase);
+        batch[i] = &states[i];
+    }
+    int perSystem = steps / BENCH_SYSTEMS > 1000 ? steps / BENCH_SYSTEMS : 1000;
+    long total = (long)perSystem * BENCH_SYSTEMS;
+
+    printf("perf counters, %s steps (%s)\n", SpringmassKernelName(&states[0]), PerfError()[0] ? PerfError() : "all");
+    printf("%-12s %10s %8s %12s %14s %14s\n", "path", "instr/step", "IPC", "vector/step", "br miss/step",
+           "L1D miss/kstep");
+    static const char *const paths[] = { "general", "kernel", "batch" };
+    for (int path = 0; path < 3; path++)
+    {
+        PerfReset();
+        PerfBegin(PERF_PHYSICS);
+        if (path == 0)
+            for (int i = 0; i < BENCH_SYSTEMS; i++)
+                RunGeneral(&states[i], perSystem);
+        else if (path == 1)
+            for (int i = 0; i < BENCH_SYSTEMS; i++)
+                RunKernel(&states[i], perSystem);
+        else
+            SpringmassAdvanceBatch(batch, BENCH_SYSTEMS, BENCH_DT, perSystem);
+        PerfEnd(PERF_PHYSICS);
+
+        PerfTotals totals;
+        PerfRead(PERF_PHYSICS, &totals);
+        double cycles = (double)totals.count[PERF_CYCLES];
+        char cells[4][24];
+        printf("%-12s %10s %8.2f %12s %14s %14s\n", paths[path],
+               CounterCell(cells[0], sizeof(cells[0]), PERF_INSTRUCTIONS,
+                           (double)totals.count[PERF_INSTRUCTIONS] / total),
+               cycles > 0 && PerfHasCounter(PERF_INSTRUCTIONS) ? totals.count[PERF_INSTRUCTIONS] / cycles : 0.0,
+               CounterCell(cells[1], sizeof(cells[1]), PERF_VECTOR_OPS, (double)totals.count[PERF_VECTOR_OPS] / total),
+               CounterCell(cells[2], sizeof(cells[2]), PERF_BRANCH_MISSES,
+                           (double)totals.count[PERF_BRANCH_MISSES] / total),
+               CounterCell(cells[3], sizeof(cells[3]), PERF_L1D_MISSES, totals.count[PERF_L1D_MISSES] * 1e3 / total));
+    }
+    PerfShutdown();
+}
+
+// Frame-budget governor against a synthetic load: frame work per quality level, as a fraction of the budget
+static void ReportGovernor(void)
+{
+    static const struct
+    {
+        const char *name;
+        double cost[GOVERNOR_LEVELS]; // Work at each level (lowest first) over the frame budget
+    } phases[] = {
+        { "light", { 0.15, 0.20, 0.25, 0.40 } },
+        { "overload", { 0.70, 1.00, 1.40, 2.00 } },
+        { "borderline", { 0.30, 0.40, 0.50, 0.90 } }, // Full detail just over budget, the rest well under
+        { "light", { 0.15, 0.20, 0.25, 0.40 } },
+    };
+    FrameGovernor governor;
+    GovernorInit(&governor, DRIFT_FRAME_RATE, 0);
+    double now = 1.0;
+    float interval = (float)governor.budget;
+    uint32_t jitter = 1;
+    GovernorFrameBegin(&governor, now);
+
+    printf("frame governor, %.2f ms budget, %ds per load phase\n", governor.budget * 1e3, GOVERNOR_PHASE_SECONDS);
+    printf("%-11s %7s %8s %8s %8s %12s\n", "phase", "level", "changes", "ups", "missed", "settled (s)");
+    for (size_t p = 0; p < sizeof(phases) / sizeof(phases[0]); p++)
+    {
+        double phaseStart = now, lastChange = now;
+        int changes = 0, ups = 0;
+        long missed = 0;
+        while (now - phaseStart < GOVERNOR_PHASE_SECONDS)
+        {
+            jitter = jitter * 1664525u + 1013904223u; // +-5% frame-to-frame noise
+            double work = governor.budget * phases[p].cost[governor.level] * (0.95 + 0.1 * (jitter >> 8) / 16777216.0);
+            int level = governor.level;
+            if (GovernorFrameEnd(&governor, now + work, interval))
+            {
+                changes++;
+                ups += governor.level > level;
+                lastChange = now + work;
+            }
+            interval = (float)(work > governor.budget ? work : governor.budget); // Presents wait for the budget
+            missed += interval > GOVERNOR_MISSED * governor.budget;
+            now += interval;
+            GovernorFrameBegin(&governor, now);
+        }
+        printf("%-11s %7d %8d %8d %8ld %12.2f\n", phases[p].name, governor.level, changes, ups, missed,
+               lastChange - phaseStart);
+    }
+}
+
+// An hour of interactive session at 120 Hz: slider sweeps, drags, sensitivity and noise phases, jittery frame
+// times. Instants saved while it ran are rebuilt by seeking and must match bit for bit, within half a frame.
+static void ReportTimeline(void)
+{
+    static Timeline timeline;
+    TimelineInit(&timeline);
+    if (!TimelineOpen(&timeline, 1.0 / DRIFT_FRAME_RATE))
+    {
+        printf("timeline: no memory\n");
+        return;
+    }
+    static SpringMassSystemState saved[TIMELINE_CHECKS];
+    static double savedTime[TIMELINE_CHECKS];
+    const long frames = (long)TIMELINE_SECONDS * DRIFT_FRAME_RATE;
+    const long every = frames / TIMELINE_CHECKS;
+
+    SpringMassSystemState state;
+    InitSystem(&state);
+    state.x = 250;
+    SpringmassSelectKernel(&state);
+    SpringMassTangent tangent;
+    SpringmassTangentInit(&tangent);
+    double time = 0;
+    uint32_t jitter = 7;
+    int checks = 0;
+    for (long f = 0; f < frames; f++)
+    {
+        long second = f / DRIFT_FRAME_RATE, tick = f % DRIFT_FRAME_RATE;
+        if (second % 30 < 2) // A slider sweep every half minute
+        {
+            state.springConst = (SimReal)(50 + (second / 30 % 5) * 40 + tick % 60);
+            SpringmassSelectKernel(&state);
+        }
+        if (second % 300 == 100 && tick == 0) // Noise switched on and off for five minutes at a time
+        {
+            state.noiseIntensity = state.noiseIntensity > 0 ? 0 : NOISE_SIGMA;
+            SpringmassSelectKernel(&state);
+        }
+        if (f % every == every / 2 && checks < TIMELINE_CHECKS) // The last frame as shown, edits since included
+        {
+            saved[checks] = state;
+            savedTime[checks++] = time;
+        }
+        jitter = jitter * 1664525u + 1013904223u;
+        float dt = (float)(1.0 / DRIFT_FRAME_RATE * (0.9 + 0.2 * (jitter >> 8) / 16777216.0));
+        time += dt;
+
+        TimelineBeginFrame(&timeline, &state);
+        SimReal h = dt / TIMELINE_SUBSTEPS;
+        TimelineMode mode = TIMELINE_STEP;
+        if (second % 90 == 45) // A one-second drag every minute and a half
+        {
+            state.x = (SimReal)(200 + tick * 2);
+            state.velocity = 0;
+            SpringmassResolveBounds(&state, state.xMin, state.xMax);
+            SpringmassTangentInit(&tangent);
+            mode = TIMELINE_HELD;
+        }
+        else if (second % 600 < 20) // A sensitivity shown for twenty seconds every ten minutes
+        {
+            SpringmassAdvanceTangent(&state, &tangent, h, TIMELINE_SUBSTEPS);
+            mode = TIMELINE_TANGENT;
+        }
+        else
+        {
+            SpringMassSystemState *stepping = &state;
+            SpringmassAdvanceBatch(&stepping, 1, h, TIMELINE_SUBSTEPS);
+        }
+        TimelineEndFrame(&timeline, &state, dt, TIMELINE_SUBSTEPS, mode, time);
+    }
+
+    int exact = 0, over = 0;
+    double total = 0, worstWall = 0;
+    for (int i = 0; i < checks; i++)
+    {
+        TimelinePoint point;
+        double start = NowSeconds();
+        TimelineSeek(&timeline, savedTime[i] + 0.25 / DRIFT_FRAME_RATE, &point); // Between frames: the one before
+        worstWall = fmax(worstWall, NowSeconds() - start);
+        total += timeline.lastSeek;
+        over += timeline.lastSeek > timeline.budget / 2;
+        exact += point.exact && point.state.x == saved[i].x && point.state.velocity == saved[i].velocity &&
+                 point.state.noiseForce == saved[i].noiseForce && point.state.noiseStep == saved[i].noiseStep &&
+                 point.state.springConst == saved[i].springConst;
+    }
+    printf("timeline: %lds at %d Hz, %d keyframes, %llu edits, %llu parameter sets, %.1f MB; %d/%d seeks exact, "
+           "%.3f ms mean / %.3f ms worst CPU (%.3f ms worst wall), %d over half the %.2f ms frame budget\n",
+           (long)TIMELINE_SECONDS, DRIFT_FRAME_RATE, timeline.keyCount, timeline.eventCount, timeline.paramCount,
+           TimelineMemory(&timeline) / 1e6, exact, checks, total / checks * 1e3, timeline.worstSeek * 1e3,
+           worstWall * 1e3, over, timeline.budget * 1e3);
+    TimelineClose(&timeline);
+}
+
+// Graph history of an hour at 1 kHz: memory per sample, and the cost of drawing windows at several zoom levels
+static void ReportHistory(void)
+{
+    const long samples = (long)HISTORY_SECONDS * HISTORY_RATE;
+    const float dt = 1.0f / HISTORY_RATE;
+    float *raw = malloc(2 * samples * sizeof(float)); // Uncompressed (time, value) pairs for comparison
+    static History history;
+    HistoryInit(&history);
+
+    SpringMassSystemState state;
+    InitSystem(&state);
+    state.xMin = state.equilibrium - 100.0f;
+    state.xMax = state.equilibrium + 100.0f;
+    SpringmassSelectKernel(&state);
+    double time = 0.0;
+    for (long i = 0; i < samples; i++)
+    {
+        if (i % ((long)HISTORY_KICK * HISTORY_RATE) == 0)
+            state.velocity = 400.0f;
+        SpringmassAdvance(&state, dt, 1);
+        time = (double)(i + 1) * dt;
+        float displacement = state.x - state.equilibrium;
+        HistoryAppend(&history, time, displacement);
+        if (raw)
+        {
+            raw[2 * i] = (float)time;
+            raw[2 * i + 1] = displacement;
+        }
+    }
+    printf("graph history, %ds at %d Hz: %.2f MB in RAM (%.3f bytes/sample, raw pairs 8)\n", HISTORY_SECONDS,
+           HISTORY_RATE, HistoryBytes(&history) / 1e6, (double)HistoryBytes(&history) / samples);
+
+    // Full decode of every block vs a min/max scan over the raw pairs
+    static SeriesSample decoded[SERIES_BLOCK_SAMPLES];
+    double start = NowSeconds();
+    float sink = 0;
+    for (long b = 0; b < history.samples.blockCount; b++)
+        sink += decoded[SeriesDecodeBlock(&history.samples, b, decoded) - 1].value;
+    double tDecode = NowSeconds() - start;
+    float lo = INFINITY, hi = -INFINITY;
+    start = NowSeconds();
+    for (long i = 0; raw && i < samples; i++)
+    {
+        lo = raw[2 * i + 1] < lo ? raw[2 * i + 1] : lo;
+        hi = raw[2 * i + 1] > hi ? raw[2 * i + 1] : hi;
+    }
+    double tScan = NowSeconds() - start;
+    printf("decode %.2f ns/sample, raw scan %.2f ns/sample (%g)\n", tDecode * 1e9 / samples, tScan * 1e9 / samples,
+           sink + lo + hi);
+
+    // Times are nanosecond offsets from each block's double base, so the step stays resolvable hours in
+    SeriesSample newest;
+    SeriesLast(&history.samples, &newest);
+    printf("newest sample time error %.3g s (step %.3g s)\n", fabs(newest.time - time), (double)dt);
+
+    static HistoryColumn columns[HISTORY_COLUMNS];
+    static const float spans[] = { HISTORY_SECONDS, 600.0f, 60.0f, 1.0f };
+    for (size_t i = 0; i < sizeof(spans) / sizeof(spans[0]); i++)
+    {
+        double end = time * 0.75;
+        start = NowSeconds();
+        int level = HistoryQuery(&history, end - spans[i], end, HISTORY_COLUMNS, columns);
+        printf("  %6.0fs window: level %2d, %8.3f ms\n", spans[i], level, (NowSeconds() - start) * 1e3);
+    }
+    HistoryFree(&history);
+    free(raw);
+}
+
+int main(int argc, char **argv)
+{
+    int steps = (argc > 1) ? atoi(argv[1]) : BENCH_STEPS;
+    if (steps <= 0)
+        steps = BENCH_STEPS;
+
+    static const BenchCase cases[] = {
+        { 0.0f, 0.1f, 0 }, { 0.01f, 0.1f, 0 }, { 0.0f, 0.0f, 1 }, { 0.01f, 0.0f, 1 },
+        { 0.0f, 1.0f, 1 }, { 0.01f, 1.0f, 1 }, { 0.0f, 0.5f, 1 }, { 0.01f, 0.5f, 1 },
+    };
+
+    printf("precision: %s (state %zu bytes, time %zu bytes)\n", SIM_PRECISION_NAME, sizeof(SimReal),
+           sizeof(SimTime));
+    ReportTimeDrift();
+    ReportStateDrift(steps);
+
+    printf("%-22s %12s %12s %8s %14s\n", "kernel", "general ns", "kernel ns", "speedup", "|x diff|");
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        SpringMassSystemState general, specialized;
+        SetupCase(&general, &cases[i]);
+        SetupCase(&specialized, &cases[i]);
+
+        double tGeneral = RunGeneral(&general, steps);
+        double tKernel = RunKernel(&specialized, steps);
+
+        printf("%-22s %12.3f %12.3f %7.2fx %14.6g\n", SpringmassKernelName(&specialized), tGeneral * 1e9 / steps,
+               tKernel * 1e9 / steps, tGeneral / tKernel, fabs(general.x - specialized.x));
+    }
+    ReportForceLaws(steps);
+    ReportCounters(steps);
+    ReportSensitivities();
+    ReportDesign();
+    ReportEnsemble();
+    ReportParareal();
+    ReportFixed(steps);
+    ReportChain();
+    ReportModal();
+    ReportContact();
+    ReportLibrary();
+    ReportPreview();
+    ReportGovernor();
+    ReportTimeline();
+    ReportHistory();
+    return 0;
+}
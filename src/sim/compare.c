@@ -0,0 +1,205 @@
+/**************************************************************
+ * @file compare.c                                            *
+ * @brief Implementation of the side-by-side comparison mode. *
+ * @author Gabe G.                                            *
+ * @date 10-19-2026                                           *
+ **************************************************************/
+
+#include "compare.h"
+#include "UI/ui.h"
+#include "consts.h"
+#include <math.h>
+#include <stdio.h>
+
+// All comparison state; large (one phase histogram per simulation), so kept out of the stack
+typedef struct CompareState
+{
+    SimState sims[SIM_MAX_INSTANCES];
+    int count;              // Simulations in use
+    int focus;              // Simulation whose sliders, graph and phase plot are shown in the panel
+    int columns;            // Tile grid size
+    int rows;               //
+    bool paused;            // ESC toggles
+    FrameGovernor governor; // One detail level for every tile
+} CompareState;
+
+static CompareState compare;
+
+/**********************************
+ *      Forward Declarations      *
+ **********************************/
+
+static void CompareLayout(void);                   // Size the tile grid and place every simulation
+static void CompareHandleFocus(void);              // Focus the tile that was clicked
+static void CompareDrawTiles(void);                // Draw every scene (batched) plus tile frames and labels
+static void CompareDrawPanel(SimTime time);        // Draw the focused simulation's controls, graph and phase plot
+static SimRect CompareTileBounds(const SimState *sim); // Screen rectangle of a simulation's tile
+
+/***********************************
+ *      External API Functions     *
+ ***********************************/
+
+int RunCompare(int count)
+{
+    compare.count = (count < 1) ? 1 : (count > SIM_MAX_INSTANCES) ? SIM_MAX_INSTANCES : count;
+    compare.focus = 0;
+    compare.paused = false;
+
+    // One window, one GL context and one raygui state shared by every simulation
+    InitRenderWindow(SCREEN_WIDTH + COMPARE_PANEL_WIDTH, SCREEN_HEIGHT, "Spring-Mass System - Compare", 120);
+    for (int i = 0; i < compare.count; i++)
+    {
+        SimState *sim = &compare.sims[i];
+        InitSimInstance(sim);
+
+        // Start from the same release point with stiffer springs left to right, so the tiles differ at a glance
+        sim->systemState.springConst *= 1.0f + 0.5f * i;
+        sim->systemState.x = sim->systemState.equilibrium + 0.5f * (sim->systemState.xMax - sim->systemState.equilibrium);
+        SpringmassSelectKernel(&sim->systemState);
+    }
+    CompareLayout();
+    GovernorInit(&compare.governor, 120, Render_GetRefreshRate());
+    GovernorFrameBegin(&compare.governor, LatencyNow());
+
+    SimClock elapsedTime;
+    SimClockReset(&elapsedTime);
+    while (ExitButtonClicked())
+    {
+        float dt = CurrentFrameTime();
+        if (EscKeyPressed())
+            compare.paused = !compare.paused;
+        if (SensitivityKeyPressed())
+        {
+            for (int i = 0; i < compare.count; i++)
+                SimCycleSensitivity(&compare.sims[i]);
+        }
+        if (PhaseKeyPressed())
+        {
+            for (int i = 0; i < compare.count; i++)
+                compare.sims[i].phase.visible = !compare.sims[i].phase.visible;
+        }
+        CompareHandleFocus();
+        if (!compare.paused)
+        {
+            SimClockAdvance(&elapsedTime, dt);
+            UpdateSimBatch(compare.sims, compare.count, dt, elapsedTime.time);
+        }
+
+        Render_BeginDrawing();
+        Render_ClearBackground(SIM_BLACK);
+        CompareDrawTiles();
+        CompareDrawPanel(elapsedTime.time);
+        SimGovernFrame(&compare.governor, compare.sims, compare.count, dt, elapsedTime.time);
+        PerfBegin(PERF_PRESENT);
+        Render_EndDrawing();
+        PerfEnd(PERF_PRESENT);
+        PerfFrame();
+        for (int i = 0; i < compare.count; i++)
+            LatencyFramePresented(&compare.sims[i].latency);
+        GovernorFrameBegin(&compare.governor, LatencyNow());
+    }
+
+    if (PerfEnabled())
+        PerfReport(stderr);
+    PerfShutdown();
+    for (int i = 0; i < compare.count; i++)
+        CloseSimInstance(&compare.sims[i]);
+    DestroyRenderer();
+    return 0;
+}
+
+/***************************************
+ *      Internal helper functions      *
+ ***************************************/
+
+static void CompareLayout(void)
+{
+    compare.columns = (int)ceilf(sqrtf((float)compare.count));
+    compare.rows = (compare.count + compare.columns - 1) / compare.columns;
+    float scale = 1.0f / (compare.columns > compare.rows ? compare.columns : compare.rows);
+
+    for (int i = 0; i < compare.count; i++)
+    {
+        int column = i % compare.columns;
+        int row = i / compare.columns;
+        compare.sims[i].tile = (RenderTile){ column * SCREEN_WIDTH * scale, row * SCREEN_HEIGHT * scale, scale };
+    }
+}
+
+static void CompareHandleFocus(void)
+{
+    if (!LeftMouseButtonPressed())
+        return;
+    for (int i = 0; i < compare.count; i++)
+    {
+        SimRect bounds = CompareTileBounds(&compare.sims[i]);
+        if (ClickInBoundingBox(&bounds))
+            compare.focus = i;
+    }
+}
+
+static void CompareDrawTiles(void)
+{
+    PerfBegin(PERF_SPRING_DRAW);
+    SpringMassRenderState *states[SIM_MAX_INSTANCES];
+    RenderTile tiles[SIM_MAX_INSTANCES];
+    for (int i = 0; i < compare.count; i++)
+    {
+        if (!compare.paused)
+            SimLateLatch(&compare.sims[i]);
+        states[i] = &compare.sims[i].renderState;
+        tiles[i] = compare.sims[i].tile;
+    }
+    UpdateRenderTiled(states, tiles, compare.count);
+    PerfEnd(PERF_SPRING_DRAW);
+
+    PerfBegin(PERF_UI);
+
+    for (int i = 0; i < compare.count; i++)
+    {
+        const SimState *sim = &compare.sims[i];
+        const SpringMassSystemState *state = &sim->systemState;
+        SimColor frame = (i == compare.focus) ? sim->renderState.themeColor : SIM_DARKGRAY;
+        char label[96];
+        snprintf(label, sizeof(label), "#%d  k=%.0f m=%.1f c=%.1f e=%.1f", i + 1, (float)state->springConst,
+                 (float)state->mass, (float)state->damping, (float)state->restitution);
+        Render_DrawTileFrame(sim->tile, SCREEN_WIDTH, SCREEN_HEIGHT, frame, label);
+    }
+    PerfEnd(PERF_UI);
+}
+
+static void CompareDrawPanel(SimTime time)
+{
+    SimState *sim = &compare.sims[compare.focus];
+    SpringMassSystemState *state = &sim->systemState;
+    float panelX = SCREEN_WIDTH;
+    float sliderX = panelX + (COMPARE_PANEL_WIDTH - UI_SLIDER_WIDTH) / 2;
+
+    PerfBegin(PERF_UI);
+    SetThemeColor(&sim->renderState.themeColor);
+    if (MakeVariableSlidersAt(state, sliderX, UI_SLIDER_Y + 10))
+    {
+        SpringmassSelectKernel(state);
+        SimRequestForecast(sim, time);
+    }
+    ShowDampingAt(state->damping, state->springConst, state->mass, &sim->renderState.themeColor, sliderX,
+                  UI_SLIDER_Y + 10);
+    PerfEnd(PERF_UI);
+
+    PerfBegin(PERF_GRAPH_DRAW);
+    SimRect graphBounds = { panelX, 205, COMPARE_PANEL_WIDTH, 210 };
+    SimShowForecast(sim);
+    DrawGraph(&sim->graph, graphBounds, state->x - state->equilibrium, time, &sim->renderState.themeColor);
+
+    SimRect phaseBounds = { panelX + (COMPARE_PANEL_WIDTH - 180) / 2, 417, 180, 180 };
+    DrawPhasePlot(&sim->phase, phaseBounds, &sim->renderState.themeColor);
+    PerfEnd(PERF_GRAPH_DRAW);
+
+    if (compare.paused)
+        Render_DrawText("Paused (ESC)", 10, SCREEN_HEIGHT - 20, 15, SIM_LIGHTGRAY);
+}
+
+static SimRect CompareTileBounds(const SimState *sim)
+{
+    return (SimRect){ sim->tile.x, sim->tile.y, SCREEN_WIDTH * sim->tile.scale, SCREEN_HEIGHT * sim->tile.scale };
+}
@@ -0,0 +1,18 @@
+/************************************************************************
+ * @file compare.h                                                      *
+ * @brief Side-by-side comparison of several simulations in one window. *
+ * @author Gabe G.                                                      *
+ * @date 10-19-2026                                                     *
+ ************************************************************************/
+
+#ifndef COMPARE_H
+#define COMPARE_H
+
+#include "sim.h"
+
+#define COMPARE_PANEL_WIDTH 300 // Width of the control panel to the right of the tiles
+
+// Compare Function declarations
+int RunCompare(int count); // Run `count` simulations (1..SIM_MAX_INSTANCES) tiled in one window until closed
+
+#endif
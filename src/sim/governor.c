@@ -0,0 +1,114 @@
+/*******************************************************
+ * @file governor.c                                    *
+ * @brief Implementation of the frame-budget governor. *
+ * @author Gabe G.                                     *
+ * @date 10-19-2026                                    *
+ *******************************************************/
+
+#include "governor.h"
+#include "consts.h"
+#include <math.h>
+#include <string.h>
+
+// Detail per level, lowest first; the last row is the full detail every view was drawn with before
+static const QualitySettings levels[GOVERNOR_LEVELS] = {
+    { 4, 8, 8, 30, 1 },
+    { 3, 12, 4, 15, 2 },
+    { 2, 16, 2, 6, 4 },
+    { 1, SPRING_SEGMENTS, 1, 1, 8 },
+};
+
+void GovernorInit(FrameGovernor *governor, int targetFps, int refreshRate)
+{
+    memset(governor, 0, sizeof(*governor));
+    double frame = 1.0 / (targetFps > 0 ? targetFps : 60);
+    double refresh = refreshRate > 0 ? 1.0 / refreshRate : 0.0;
+    governor->budget = frame > refresh ? frame : refresh; // A 60 Hz display can't show 120 FPS anyway
+    governor->level = GOVERNOR_LEVELS - 1;
+    governor->settleFrames = GOVERNOR_SETTLE_FRAMES; // Start-up frames (window creation, first uploads) are atypical
+    governor->backoff = 1;
+    governor->blockedLevel = -1;
+}
+
+void GovernorFrameBegin(FrameGovernor *governor, double now)
+{
+    governor->workStart = now;
+}
+
+bool GovernorFrameEnd(FrameGovernor *governor, double now, float interval)
+{
+    if (governor->workStart == 0.0)
+        return false;
+    double work = now - governor->workStart;
+    governor->smoothedWork = (governor->smoothedWork == 0.0)
+                                 ? work
+                                 : governor->smoothedWork + GOVERNOR_SMOOTHING * (work - governor->smoothedWork);
+    if (governor->raisedAt > 0.0 && now - governor->raisedAt >= GOVERNOR_RETRY_SECONDS)
+    {
+        governor->raisedAt = 0.0; // The last step up held
+        governor->backoff = 1;
+    }
+    if (governor->settleFrames > 0)
+    {
+        governor->settleFrames--;
+        return false;
+    }
+
+    // Step down quickly on sustained overload; step up only after a stretch of clear headroom. The gap between
+    // the two marks keeps a level that is merely busy from flapping.
+    bool missed = interval > GOVERNOR_MISSED * governor->budget;
+    bool over = missed || governor->smoothedWork > GOVERNOR_HIGH_WATER * governor->budget;
+    bool roomy = !missed && governor->smoothedWork < GOVERNOR_LOW_WATER * governor->budget;
+    governor->overFrames = over ? governor->overFrames + 1 : 0;
+    governor->headroom = roomy ? governor->headroom + interval : 0.0;
+
+    // A level that could not hold stays blocked while the load that defeated it lasts: a borderline load would
+    // otherwise have every retry fail the same way. A clear drop in work below it means the load changed.
+    if (governor->blockedLevel == governor->level + 1 &&
+        (now >= governor->blockedUntil || governor->smoothedWork < GOVERNOR_LOAD_DROP * governor->blockedWork))
+        governor->blockedLevel = -1;
+    bool blocked = governor->blockedLevel == governor->level + 1;
+
+    int previous = governor->level;
+    if (governor->overFrames >= GOVERNOR_DOWN_FRAMES && governor->level > 0)
+    {
+        governor->level--;
+        // A step up that had to be undone right away is retried later and later
+        if (governor->raisedAt > 0.0)
+        {
+            governor->blockedLevel = previous;
+            governor->blockedWork = governor->raisedFrom;
+            governor->blockedUntil = now + GOVERNOR_BLOCK_SECONDS * governor->backoff;
+            if (governor->backoff < GOVERNOR_MAX_BACKOFF)
+                governor->backoff *= 2;
+        }
+        governor->raisedAt = 0.0;
+    }
+    else if (governor->headroom >= GOVERNOR_UP_SECONDS * governor->backoff && governor->level < GOVERNOR_LEVELS - 1 &&
+             !blocked)
+    {
+        governor->level++;
+        governor->raisedAt = now;
+        governor->raisedFrom = governor->smoothedWork;
+    }
+    if (governor->level == previous)
+        return false;
+
+    governor->overFrames = 0;
+    governor->headroom = 0.0;
+    governor->settleFrames = GOVERNOR_SETTLE_FRAMES;
+    return true;
+}
+
+void GovernorSettings(const FrameGovernor *governor, QualitySettings *settings)
+{
+    *settings = levels[governor->level];
+}
+
+int GovernorSubsteps(const QualitySettings *settings, float dt)
+{
+    int steps = (int)ceil(dt / GOVERNOR_SUBSTEP - 0.25); // Up to 25% over the step still takes one
+    if (steps < 1)
+        return 1;
+    return steps > settings->maxSubsteps ? settings->maxSubsteps : steps;
+}
@@ -0,0 +1,66 @@
+/*************************************************************************************************
+ * @file governor.h                                                                              *
+ * @brief Frame-budget governor: trades drawing and physics detail for frame pacing (no raylib). *
+ * @author Gabe G.                                                                               *
+ * @date 10-19-2026                                                                              *
+ *************************************************************************************************/
+
+#ifndef GOVERNOR_H
+#define GOVERNOR_H
+
+#include <stdbool.h>
+
+#define GOVERNOR_LEVELS 4            // Quality levels (0: lowest, GOVERNOR_LEVELS - 1: full detail)
+#define GOVERNOR_SMOOTHING 0.1       // Weight of the newest frame in the smoothed work time
+#define GOVERNOR_HIGH_WATER 0.85     // Over budget: smoothed work above this fraction of the frame budget
+#define GOVERNOR_LOW_WATER 0.55      // Headroom: smoothed work below this fraction
+#define GOVERNOR_MISSED 1.5          // A frame interval this many budgets long is a missed frame
+#define GOVERNOR_DOWN_FRAMES 12      // Consecutive over-budget frames before stepping down
+#define GOVERNOR_UP_SECONDS 2.0      // Headroom needed before stepping up (times the backoff)
+#define GOVERNOR_SETTLE_FRAMES 30    // Frames ignored after a change while the smoothing catches up
+#define GOVERNOR_RETRY_SECONDS 5.0   // A step up undone sooner than this doubles the backoff
+#define GOVERNOR_MAX_BACKOFF 16      // Largest backoff multiplier
+#define GOVERNOR_BLOCK_SECONDS 120.0 // A level whose step up failed is not retried for this long (times the backoff)
+#define GOVERNOR_LOAD_DROP 0.8       // ...unless the work at the level below falls under this share of what it was
+#define GOVERNOR_SUBSTEP (1.0 / 120) // Physics step the substep count aims for (seconds)
+
+// Detail of one quality level; full detail draws and steps exactly as without a governor
+typedef struct QualitySettings
+{
+    int graphColumnStride; // Pixels per graph column (1: one min/max column per pixel)
+    int springSegments;    // Zig-zag segments of the spring
+    int phaseUploadEvery;  // Frames between phase heatmap uploads
+    int overlayEvery;      // Frames between overlay text refreshes
+    int maxSubsteps;       // Most physics steps per frame when a frame runs long
+} QualitySettings;
+
+// Times are CLOCK_MONOTONIC seconds. A frame's work runs from the return of the previous present to the start of
+// this one, so the wait for the target frame rate (and vsync) is not counted against the budget.
+typedef struct FrameGovernor
+{
+    double budget;       // Frame budget: the longer of the target frame time and the display refresh period
+    int level;           // Current quality level
+    double workStart;    // When the current frame's work began (0: not yet)
+    double smoothedWork; // Smoothed work time
+    int overFrames;      // Consecutive frames over budget
+    double headroom;     // Seconds spent with headroom since the last change
+    int settleFrames;    // Frames left before decisions resume
+    int backoff;         // Multiplier on GOVERNOR_UP_SECONDS, doubled by failed step ups
+    double raisedAt;     // When the level last went up (0: never)
+    double raisedFrom;   // Smoothed work at the level below when it last went up
+    int blockedLevel;    // Level whose step up failed (-1: none)
+    double blockedWork;  // Smoothed work at the level below it when that step up was tried
+    double blockedUntil; // When the block lapses regardless of load
+} FrameGovernor;
+
+// Governor Function declarations
+void GovernorInit(FrameGovernor *governor, int targetFps,
+                  int refreshRate);                          // Start at full detail (refreshRate <= 0: unknown)
+void GovernorFrameBegin(FrameGovernor *governor, double now); // The previous frame was presented
+bool GovernorFrameEnd(FrameGovernor *governor, double now,
+                      float interval);                       // About to present: true if the level changed
+void GovernorSettings(const FrameGovernor *governor,
+                      QualitySettings *settings);            // Detail of the current level
+int GovernorSubsteps(const QualitySettings *settings, float dt); // Physics steps for a frame of length dt
+
+#endif
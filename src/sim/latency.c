@@ -0,0 +1,120 @@
+/*****************************************************************************
+ * @file latency.c                                                           *
+ * @brief Implementation of the drag latency histogram and cursor predictor. *
+ * @author Gabe G.                                                           *
+ * @date 10-19-2026                                                          *
+ *****************************************************************************/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "latency.h"
+#include <string.h>
+#include <time.h>
+
+#define CURSOR_SMOOTHING 0.5f // Weight of the newest velocity estimate
+#define CURSOR_STALE 0.1      // Samples further apart than this restart the velocity estimate
+
+void LatencyInit(LatencyTracker *tracker, int refreshRate)
+{
+    memset(tracker, 0, sizeof(*tracker));
+    tracker->refreshPeriod = 1.0 / (refreshRate > 0 ? refreshRate : 60);
+    tracker->pollTime = LatencyNow();
+    tracker->lastReport = tracker->pollTime;
+}
+
+double LatencyNow(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+void LatencyMarkSample(LatencyTracker *tracker, bool latched)
+{
+    tracker->latched = latched;
+    tracker->sampleTime = latched ? LatencyNow() : tracker->pollTime;
+}
+
+float LatencyPredictX(LatencyTracker *tracker, float x)
+{
+    double now = tracker->sampleTime;
+    if (tracker->hasCursor && now - tracker->cursorTime > 0.0 && now - tracker->cursorTime < CURSOR_STALE)
+    {
+        float velocity = (x - tracker->cursorX) / (float)(now - tracker->cursorTime);
+        tracker->cursorVelocity += CURSOR_SMOOTHING * (velocity - tracker->cursorVelocity);
+    }
+    else
+    {
+        tracker->cursorVelocity = 0.0f;
+    }
+    tracker->hasCursor = true;
+    tracker->cursorX = x;
+    tracker->cursorTime = now;
+
+    // The image reaches the screen about one refresh after the swap that follows the latch
+    double horizon = tracker->latchToPresent + tracker->refreshPeriod;
+    if (horizon > LATENCY_MAX_HORIZON)
+        horizon = LATENCY_MAX_HORIZON;
+    return x + tracker->cursorVelocity * (float)horizon;
+}
+
+void LatencyResetCursor(LatencyTracker *tracker)
+{
+    tracker->hasCursor = false;
+    tracker->cursorVelocity = 0.0f;
+}
+
+void LatencyFramePresented(LatencyTracker *tracker)
+{
+    double now = LatencyNow();
+    if (tracker->sampleTime > 0.0)
+    {
+        double latency = now - tracker->sampleTime;
+        int bin = (int)(latency / LATENCY_BIN_SECONDS);
+        tracker->histogram[bin < LATENCY_BINS ? bin : LATENCY_BINS - 1]++;
+        tracker->count++;
+        tracker->sum += latency;
+        tracker->last = latency;
+        if (latency > tracker->max)
+            tracker->max = latency;
+        if (tracker->latched)
+            tracker->latchToPresent += 0.1 * (latency - tracker->latchToPresent);
+    }
+    tracker->sampleTime = 0.0;
+    tracker->pollTime = now; // raylib polls input at the end of EndDrawing, so the next frame's input is this recent
+
+    if (tracker->count > 0 && now - tracker->lastReport >= LATENCY_REPORT_SECONDS)
+        LatencyReport(tracker, stderr);
+}
+
+double LatencyPercentile(const LatencyTracker *tracker, double fraction)
+{
+    if (tracker->count == 0)
+        return 0.0;
+    unsigned long target = (unsigned long)(fraction * tracker->count);
+    unsigned long seen = 0;
+    for (int i = 0; i < LATENCY_BINS; i++)
+    {
+        seen += tracker->histogram[i];
+        if (seen > target)
+            return (i + 1) * LATENCY_BIN_SECONDS;
+    }
+    return LATENCY_BINS * LATENCY_BIN_SECONDS;
+}
+
+void LatencyReport(LatencyTracker *tracker, FILE *out)
+{
+    if (tracker->count > 0)
+    {
+        fprintf(out,
+                "drag latency (cursor sample to swap): %lu frames, mean %.2f ms, p50 %.2f, p90 %.2f, p99 %.2f, "
+                "max %.2f ms\n",
+                tracker->count, tracker->sum / tracker->count * 1e3, LatencyPercentile(tracker, 0.50) * 1e3,
+                LatencyPercentile(tracker, 0.90) * 1e3, LatencyPercentile(tracker, 0.99) * 1e3, tracker->max * 1e3);
+    }
+    memset(tracker->histogram, 0, sizeof(tracker->histogram));
+    tracker->count = 0;
+    tracker->sum = 0.0;
+    tracker->max = 0.0;
+    tracker->lastReport = LatencyNow();
+}
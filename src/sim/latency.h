@@ -0,0 +1,63 @@
+/***************************************************************************************************
+ * @file latency.h                                                                                 *
+ * @brief Input-to-present latency histogram and cursor motion predictor for dragging (no raylib). *
+ * @author Gabe G.                                                                                 *
+ * @date 10-19-2026                                                                                *
+ ***************************************************************************************************/
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#define LATENCY_BINS 400            // Histogram bins
+#define LATENCY_BIN_SECONDS 0.00025 // Bin width (100 ms range; slower frames land in the last bin)
+#define LATENCY_REPORT_SECONDS 5.0  // Interval between reports while samples arrive
+#define LATENCY_MAX_HORIZON 0.05    // Prediction never extrapolates further than this (seconds)
+
+// How the dragged mass follows the cursor
+typedef enum LatchMode
+{
+    LATCH_OFF,     // Use the position polled at the end of the previous frame
+    LATCH_CURSOR,  // Re-sample the cursor just before drawing the mass
+    LATCH_PREDICT, // Re-sample, then extrapolate to the expected presentation time
+    LATCH_MODES
+} LatchMode;
+
+// Times are CLOCK_MONOTONIC seconds. A frame's latency runs from when the drawn cursor position was
+// sampled to when the frame was handed to the display (the buffer swap returning).
+typedef struct LatencyTracker
+{
+    double pollTime;       // When the input used this frame was polled (end of the previous frame)
+    double sampleTime;     // When this frame's drawn cursor position was sampled (0: none drawn)
+    bool latched;          // `sampleTime` came from a late latch rather than the poll
+    double refreshPeriod;  // Display refresh interval
+    double latchToPresent; // Smoothed sample-to-swap time of latched frames
+
+    unsigned long histogram[LATENCY_BINS];
+    unsigned long count; // Samples since the last report
+    double sum;          // Sum of those samples
+    double max;          // Largest of those samples
+    double last;         // Most recent sample
+    double lastReport;   // Time of the last report
+
+    // Cursor predictor: smoothed velocity of successive latched samples
+    bool hasCursor;
+    float cursorX;
+    double cursorTime;
+    float cursorVelocity; // Pixels per second
+} LatencyTracker;
+
+// Latency Function declarations
+void LatencyInit(LatencyTracker *tracker, int refreshRate);    // Reset (refreshRate <= 0 assumes 60 Hz)
+double LatencyNow(void);                                       // Monotonic clock in seconds
+void LatencyMarkSample(LatencyTracker *tracker, bool latched); // The drawn cursor was sampled now (or at the poll)
+float LatencyPredictX(LatencyTracker *tracker, float x);       // Extrapolate a latched x to presentation
+void LatencyResetCursor(LatencyTracker *tracker);              // Forget cursor motion (drag ended)
+void LatencyFramePresented(LatencyTracker *tracker);           // Frame swapped: record, report periodically
+double LatencyPercentile(const LatencyTracker *tracker,
+                         double fraction);                     // Upper edge of the bin holding `fraction`
+void LatencyReport(LatencyTracker *tracker, FILE *out);        // Print and clear the current distribution
+
+#endif
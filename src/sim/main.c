@@ -5,18 +5,166 @@
  * @date 1-9-2026                                            *
  *************************************************************/
 
+#include "compare.h"
 #include "consts.h"
+#include "core/parareal.h"
+#include "renderer/backend.h"
 #include "sim.h"
+#include "snapshot.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-int main(void)
+int main(int argc, char **argv)
 {
+    SetRenderBackend(&RAYLIB_BACKEND); // Interactive builds draw through raylib
+
+    // `--perf` attributes hardware counters to the parts of each frame and reports them on exit (either mode)
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--perf") == 0 && !PerfInit())
+            fprintf(stderr, "springmass: performance counters unavailable: %s\n", PerfError());
+    }
+
+    // `--compare K` runs K simulations side by side in one window (no snapshots or telemetry)
+    if (argc > 2 && strcmp(argv[1], "--compare") == 0)
+    {
+        return RunCompare(atoi(argv[2]));
+    }
+
+    // `--fresh` skips the saved session; `--spring-table FILE.csv` loads a measured force curve;
+    // `--design SPEC` picks k, c, m and e for targets such as "overshoot=0.1,settle=2,impacts=0";
+    // `--noise SIGMA[,TAU]` drives the mass with white (or coloured) noise; `--ensemble N` reports the statistics
+    // of N noise realisations of the starting system; `--parareal SECONDS` solves the starting system that far ahead
+    // in parallel time slices and reports the speedup over the serial solve
+    bool fresh = false;
+    bool design = false;
+    float noiseSigma = -1.0f, noiseTau = 0.0f;
+    int ensembleMembers = 0;
+    double pararealSeconds = 0;
+    DesignTarget designTarget;
+    static ForceTable springTable;
+    const ForceTable *table = NULL;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--fresh") == 0)
+        {
+            fresh = true;
+        }
+        else if (strcmp(argv[i], "--spring-table") == 0 && i + 1 < argc)
+        {
+            if (!ForceTableLoad(&springTable, argv[++i]))
+            {
+                fprintf(stderr, "springmass: cannot read a force curve from %s\n", argv[i]);
+                return 1;
+            }
+            table = &springTable;
+        }
+        else if (strcmp(argv[i], "--design") == 0 && i + 1 < argc)
+        {
+            if (!DesignParseTarget(&designTarget, argv[++i]))
+            {
+                fprintf(stderr, "springmass: bad design targets '%s' (overshoot=F,settle=S,impacts=N,release=X)\n",
+                        argv[i]);
+                return 1;
+            }
+            design = true;
+        }
+        else if (strcmp(argv[i], "--noise") == 0 && i + 1 < argc)
+        {
+            if (sscanf(argv[++i], "%f,%f", &noiseSigma, &noiseTau) < 1 || noiseSigma < 0 || noiseTau < 0)
+            {
+                fprintf(stderr, "springmass: bad noise '%s' (SIGMA or SIGMA,TAU)\n", argv[i]);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--ensemble") == 0 && i + 1 < argc)
+        {
+            ensembleMembers = atoi(argv[++i]);
+            if (ensembleMembers <= 0)
+            {
+                fprintf(stderr, "springmass: bad ensemble size '%s'\n", argv[i]);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--parareal") == 0 && i + 1 < argc)
+        {
+            pararealSeconds = atof(argv[++i]);
+            if (!(pararealSeconds > 0))
+            {
+                fprintf(stderr, "springmass: bad parareal length '%s'\n", argv[i]);
+                return 1;
+            }
+        }
+    }
+
     // Initialization
-    SimState sim;
+    static SimState sim; // Static: the phase plot histogram is too large for the stack
     InitSim(&sim, SCREEN_WIDTH, SCREEN_HEIGHT, "Spring-Mass System", 120);
+    if (table != NULL)
+    {
+        sim.systemState.table = table;
+        sim.systemState.law = FORCE_TABLE;
+        SpringmassSelectKernel(&sim.systemState);
+    }
+
+    SimClock elapsedTime; // Track total simulation time
+    SimClockReset(&elapsedTime);
+    // Kahan-compensated so summing frame times doesn't drift on long runs; build with
+    // PRECISION=MIXED or PRECISION=DOUBLE to also widen the time type (see `make bench-precision`).
 
-    float elapsedTime = 0.0f; // Track total simulation time
-    // float becomes imprecise after ~4.5 hours, so this is safe.
-    // Double becomes imprecise after like 34,000 years, but lets be honest, no ones using this for more that 4 hours.
+    // Resume the last session (or last checkpoint after a crash) unless started with --fresh
+    SnapshotInit(SNAPSHOT_PATH);
+    if (!fresh)
+    {
+        SnapshotRestore(&sim, &elapsedTime);
+    }
+    if (design)
+    {
+        DesignSolve(&sim.systemState, &designTarget, &sim.design);
+        sim.designSolved = true;
+        const DesignResult *r = &sim.design;
+        printf("design: %s k=%.2f c=%.2f m=%.2f e=%.2f (overshoot %.3f, settles in %.2f s, %d impacts) in %.0f ms\n",
+               r->met ? "met" : "closest, not met", (float)r->springConst, (float)r->damping, (float)r->mass,
+               (float)r->restitution, r->overshoot, r->settleTime, r->impacts, r->seconds * 1e3);
+    }
+    if (noiseSigma >= 0)
+    {
+        SpringmassSetNoise(&sim.systemState, noiseSigma, noiseTau, sim.systemState.noiseSeed, 0);
+    }
+    if (ensembleMembers > 0)
+    {
+        EnsembleConfig config;
+        EnsembleConfigInit(&config);
+        config.members = ensembleMembers;
+        EnsembleStats stats;
+        if (EnsembleRun(&sim.systemState, &config, &stats))
+            printf("ensemble: %d members, x mean %.2f std %.2f, v std %.2f, autocorrelation %.3f at 0.1 s and %.3f at "
+                   "0.5 s (%d threads, %.0f ms)\n",
+                   config.members, stats.position.mean, sqrt(WelfordVariance(&stats.position)),
+                   sqrt(WelfordVariance(&stats.velocity)), stats.autocorrelation[10], stats.autocorrelation[50],
+                   stats.threads, stats.seconds * 1e3);
+    }
+    if (pararealSeconds > 0)
+    {
+        // One slice is the serial solve (the coarse pass it adds costs a fraction of a percent)
+        PararealConfig config;
+        PararealConfigInit(&config);
+        config.steps = (long)(pararealSeconds / config.dt);
+        SpringMassSystemState end, serialEnd;
+        PararealStats stats, serial;
+        PararealConfig serialConfig = config;
+        serialConfig.slices = 1;
+        if (PararealRun(&sim.systemState, &config, &end, &stats) &&
+            PararealRun(&sim.systemState, &serialConfig, &serialEnd, &serial))
+            printf("parareal: %.0f s in %d slices on %d threads, %s after %d iterations, %.0f ms vs %.0f ms serial "
+                   "(%.2fx, %.2fx with a core per thread), end differs by %g px\n",
+                   pararealSeconds, stats.slices, stats.threads, stats.converged ? "converged" : "stopped",
+                   stats.iterations, stats.seconds * 1e3, serial.seconds * 1e3, serial.seconds / stats.seconds,
+                   serial.seconds / stats.criticalSeconds, fabs((double)end.x - serialEnd.x));
+    }
 
     // Simulation loop
     while (SimRunning(&sim))
@@ -24,12 +172,15 @@ int main(void)
         float dt = CurrentFrameTime(); // Time step: delta time between frames
         if (sim.dialog == NONE)
         {
-            elapsedTime += dt; // Only update total elapsed time if not in dialog
+            SimClockAdvance(&elapsedTime, dt); // Only update total elapsed time if not in dialog
         }
-        UpdateSim(&sim, dt, elapsedTime);
-        DrawSim(&sim, dt, elapsedTime);
+        UpdateSim(&sim, dt, elapsedTime.time);
+        DrawSim(&sim, dt, elapsedTime.time);
+        SnapshotTick(&sim, &elapsedTime, dt); // Periodic checkpoint, written in the background
     }
     // Cleanup
-    StopSim();
+    SnapshotRequest(&sim, &elapsedTime); // Final snapshot so the next launch resumes here
+    SnapshotShutdown();
+    StopSim(&sim);
     return 0;
 }
\ No newline at end of file
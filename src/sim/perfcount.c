@@ -0,0 +1,296 @@
+/*************************************************************
+ * @file perfcount.c                                         *
+ * @brief Implementation of the region performance counters. *
+ * @author Gabe G.                                           *
+ * @date 10-19-2026                                          *
+ *************************************************************/
+
+#define _DEFAULT_SOURCE // syscall()
+
+#include "perfcount.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define PERF_SUPPORTED 1
+#else
+#define PERF_SUPPORTED 0
+#endif
+
+#define PERF_INTEL_VECTOR 0x3cc7 // FP_ARITH_INST_RETIRED, umask 0x3c: 128- and 256-bit packed single and double
+#define PERF_AMD_VECTOR 0xff03   // Retired SSE/AVX operations (Zen), every type
+#define PERF_SNAPSHOT (PERF_COUNTERS + 2) // Counter values, then time enabled and time running
+
+static struct
+{
+    bool enabled;                               // Counters are open
+    int fd[PERF_COUNTERS];                      // File descriptor of each counter (-1: not opened)
+    int slot[PERF_COUNTERS];                    // Position of each counter in a group read (-1: missing)
+    int opened;                                 // Counters in the group
+    uint64_t begin[PERF_REGIONS][PERF_SNAPSHOT]; // Snapshot taken when each region was entered
+    PerfTotals totals[PERF_REGIONS];            // Counts so far
+    unsigned long frames;                       // Frames finished
+    char error[192];                            // Why the counters are unavailable, or which are missing
+} perf;
+
+static const char *const regionNames[PERF_REGIONS] = { "physics",     "graph update", "graph draw",
+                                                       "spring draw", "ui",           "present" };
+static const char *const counterNames[PERF_COUNTERS] = { "cycles",        "instructions",  "L1D misses",
+                                                         "LLC misses",    "branch misses", "vector ops" };
+
+/**********************************
+ *      Forward Declarations      *
+ **********************************/
+
+static bool Snapshot(uint64_t *snapshot); // Read the whole group at once
+static bool VectorEvent(uint64_t *config); // Raw event counting packed SIMD instructions on this CPU
+#if PERF_SUPPORTED
+static int OpenCounter(uint32_t type, uint64_t config, int group); // One counter of the calling thread
+#endif
+
+/***********************************
+ *      External API Functions     *
+ ***********************************/
+
+bool PerfInit(void)
+{
+    PerfShutdown();
+#if PERF_SUPPORTED
+    uint64_t vector = 0;
+    bool hasVector = VectorEvent(&vector);
+    static const uint64_t cache = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    const struct
+    {
+        uint32_t type;
+        uint64_t config;
+        bool wanted;
+    } events[PERF_COUNTERS] = {
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, true },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, true },
+        { PERF_TYPE_HW_CACHE, cache, true },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, true },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, true },
+        { PERF_TYPE_RAW, vector, hasVector },
+    };
+
+    // Cycles lead the group; any other counter the PMU or kernel refuses is left out and reported as missing
+    perf.fd[PERF_CYCLES] = OpenCounter(events[PERF_CYCLES].type, events[PERF_CYCLES].config, -1);
+    if (perf.fd[PERF_CYCLES] < 0)
+    {
+        snprintf(perf.error, sizeof(perf.error), "perf_event_open: %s%s", strerror(errno),
+                 errno == EACCES || errno == EPERM ? " (check /proc/sys/kernel/perf_event_paranoid)" : "");
+        return false;
+    }
+    perf.slot[PERF_CYCLES] = perf.opened++;
+    size_t length = 0;
+    for (int c = 1; c < PERF_COUNTERS; c++)
+    {
+        if (events[c].wanted)
+            perf.fd[c] = OpenCounter(events[c].type, events[c].config, perf.fd[PERF_CYCLES]);
+        if (perf.fd[c] >= 0)
+            perf.slot[c] = perf.opened++;
+        else if (length < sizeof(perf.error))
+            length += snprintf(perf.error + length, sizeof(perf.error) - length, "%s%s", length ? ", " : "missing: ",
+                               counterNames[c]);
+    }
+    ioctl(perf.fd[PERF_CYCLES], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(perf.fd[PERF_CYCLES], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    perf.enabled = true;
+    return true;
+#else
+    snprintf(perf.error, sizeof(perf.error), "hardware counters need Linux perf_event_open");
+    return false;
+#endif
+}
+
+void PerfShutdown(void)
+{
+#if PERF_SUPPORTED
+    for (int c = 0; c < PERF_COUNTERS; c++)
+        if (perf.enabled && perf.fd[c] >= 0)
+            close(perf.fd[c]);
+#endif
+    memset(&perf, 0, sizeof(perf));
+    for (int c = 0; c < PERF_COUNTERS; c++)
+    {
+        perf.fd[c] = -1;
+        perf.slot[c] = -1;
+    }
+}
+
+bool PerfEnabled(void)
+{
+    return perf.enabled;
+}
+
+const char *PerfError(void)
+{
+    return perf.error;
+}
+
+bool PerfHasCounter(PerfCounter counter)
+{
+    return perf.enabled && perf.slot[counter] >= 0;
+}
+
+void PerfBegin(PerfRegion region)
+{
+    if (perf.enabled && !Snapshot(perf.begin[region]))
+        perf.begin[region][PERF_COUNTERS] = 0;
+}
+
+void PerfEnd(PerfRegion region)
+{
+    uint64_t end[PERF_SNAPSHOT];
+    if (!perf.enabled || !Snapshot(end) || perf.begin[region][PERF_COUNTERS] == 0)
+        return;
+
+    // With more counters than the PMU has, the kernel time-slices the group; scale up by enabled over running
+    const uint64_t *begin = perf.begin[region];
+    uint64_t enabled = end[PERF_COUNTERS] - begin[PERF_COUNTERS];
+    uint64_t running = end[PERF_COUNTERS + 1] - begin[PERF_COUNTERS + 1];
+    double scale = (running > 0 && running < enabled) ? (double)enabled / running : 1.0;
+    PerfTotals *totals = &perf.totals[region];
+    for (int c = 0; c < PERF_COUNTERS; c++)
+        totals->count[c] += (uint64_t)((end[c] - begin[c]) * scale);
+    totals->entries++;
+}
+
+void PerfFrame(void)
+{
+    if (perf.enabled)
+        perf.frames++;
+}
+
+void PerfReset(void)
+{
+    memset(perf.totals, 0, sizeof(perf.totals));
+    perf.frames = 0;
+}
+
+void PerfRead(PerfRegion region, PerfTotals *totals)
+{
+    *totals = perf.totals[region];
+}
+
+const char *PerfRegionName(PerfRegion region)
+{
+    return regionNames[region];
+}
+
+void PerfReport(FILE *out)
+{
+    if (!perf.enabled)
+    {
+        fprintf(out, "perf: counters unavailable: %s\n", perf.error);
+        return;
+    }
+    double frames = perf.frames > 0 ? (double)perf.frames : 1.0;
+    uint64_t allCycles = 0;
+    for (int r = 0; r < PERF_REGIONS; r++)
+        allCycles += perf.totals[r].count[PERF_CYCLES];
+    fprintf(out, "perf: %lu frames, user space of the main thread%s%s\n", perf.frames, perf.error[0] ? "; " : "",
+            perf.error);
+    fprintf(out, "%-13s %6s %14s %6s %12s %12s %12s %12s\n", "region", "share", "cycles/frame", "IPC", "L1D miss/fr",
+            "LLC miss/fr", "br miss/fr", "vector/fr");
+    for (int r = 0; r < PERF_REGIONS; r++)
+    {
+        const PerfTotals *totals = &perf.totals[r];
+        if (totals->entries == 0)
+            continue;
+        char cells[PERF_COUNTERS][16];
+        for (int c = 0; c < PERF_COUNTERS; c++)
+        {
+            if (perf.slot[c] < 0)
+                snprintf(cells[c], sizeof(cells[c]), "-");
+            else
+                snprintf(cells[c], sizeof(cells[c]), "%.0f", totals->count[c] / frames);
+        }
+        double cycles = (double)totals->count[PERF_CYCLES];
+        fprintf(out, "%-13s %5.1f%% %14s %6.2f %12s %12s %12s %12s\n", regionNames[r],
+                allCycles ? 100.0 * cycles / allCycles : 0.0, cells[PERF_CYCLES],
+                cycles > 0 ? totals->count[PERF_INSTRUCTIONS] / cycles : 0.0, cells[PERF_L1D_MISSES],
+                cells[PERF_LLC_MISSES], cells[PERF_BRANCH_MISSES], cells[PERF_VECTOR_OPS]);
+    }
+}
+
+/***************************************
+ *      Internal helper functions      *
+ ***************************************/
+
+static bool Snapshot(uint64_t *snapshot)
+{
+#if PERF_SUPPORTED
+    // PERF_FORMAT_GROUP layout: count, time enabled, time running, then one value per counter in opening order
+    uint64_t buffer[3 + PERF_COUNTERS];
+    ssize_t size = read(perf.fd[PERF_CYCLES], buffer, sizeof(buffer));
+    if (size < (ssize_t)(3 * sizeof(uint64_t)) || buffer[0] != (uint64_t)perf.opened)
+        return false;
+    for (int c = 0; c < PERF_COUNTERS; c++)
+        snapshot[c] = perf.slot[c] >= 0 ? buffer[3 + perf.slot[c]] : 0;
+    snapshot[PERF_COUNTERS] = buffer[1];
+    snapshot[PERF_COUNTERS + 1] = buffer[2];
+    return true;
+#else
+    (void)snapshot;
+    return false;
+#endif
+}
+
+static bool VectorEvent(uint64_t *config)
+{
+    const char *override = getenv(PERF_VECTOR_ENV);
+    if (override != NULL && *override != '\0')
+    {
+        *config = strtoull(override, NULL, 0);
+        return *config != 0;
+    }
+
+    // There is no generic event for SIMD instructions; pick the vendor's packed-arithmetic event
+    FILE *cpuinfo = fopen("/proc/cpuinfo", "r");
+    if (cpuinfo == NULL)
+        return false;
+    char line[256];
+    bool found = false;
+    while (!found && fgets(line, sizeof(line), cpuinfo) != NULL)
+    {
+        if (strncmp(line, "vendor_id", 9) != 0)
+            continue;
+        if (strstr(line, "GenuineIntel") != NULL)
+        {
+            *config = PERF_INTEL_VECTOR;
+            found = true;
+        }
+        else if (strstr(line, "AuthenticAMD") != NULL)
+        {
+            *config = PERF_AMD_VECTOR;
+            found = true;
+        }
+        else
+            break;
+    }
+    fclose(cpuinfo);
+    return found;
+}
+
+#if PERF_SUPPORTED
+static int OpenCounter(uint32_t type, uint64_t config, int group)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = group < 0; // The leader holds the group off until every member is in
+    attr.exclude_kernel = 1;   // User space only: allowed at perf_event_paranoid 2, and it's where our code runs
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+}
+#endif
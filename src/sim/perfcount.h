@@ -0,0 +1,62 @@
+/********************************************************************************************************************
+ * @file perfcount.h                                                                                                *
+ * @brief Hardware performance counters (Linux perf_event_open) attributed to named regions of a frame (no raylib). *
+ * @author Gabe G.                                                                                                  *
+ * @date 10-19-2026                                                                                                 *
+ ********************************************************************************************************************/
+
+#ifndef PERFCOUNT_H
+#define PERFCOUNT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define PERF_VECTOR_ENV "SPRINGMASS_PERF_VECTOR" // Raw event config for vector instructions (overrides the default)
+
+// Parts of a frame the counters are attributed to
+typedef enum PerfRegion
+{
+    PERF_PHYSICS,      // Stepping the systems (kernels, tangents, dragging)
+    PERF_GRAPH_UPDATE, // Feeding the graph, phase plot, statistics and telemetry
+    PERF_GRAPH_DRAW,   // Drawing the graph and phase plot
+    PERF_SPRING_DRAW,  // Drawing the floor, spring and mass
+    PERF_UI,           // Sliders, overlays and dialogs
+    PERF_PRESENT,      // Ending the frame: rasterizing (CPU renderer) or handing it to the driver
+    PERF_REGIONS
+} PerfRegion;
+
+// Counters opened as one group, so they cover exactly the same instructions
+typedef enum PerfCounter
+{
+    PERF_CYCLES,        // Core cycles
+    PERF_INSTRUCTIONS,  // Instructions retired
+    PERF_L1D_MISSES,    // L1 data cache read misses
+    PERF_LLC_MISSES,    // Last-level cache misses
+    PERF_BRANCH_MISSES, // Mispredicted branches
+    PERF_VECTOR_OPS,    // Vector (packed SIMD) instructions, model-specific raw event
+    PERF_COUNTERS
+} PerfCounter;
+
+// Counts gathered for one region
+typedef struct PerfTotals
+{
+    uint64_t count[PERF_COUNTERS]; // Scaled for multiplexing when the PMU had to share counters
+    unsigned long entries;         // Times the region was entered
+} PerfTotals;
+
+// Perfcount Function declarations
+bool PerfInit(void);       // Open the counters for the calling thread (false: unavailable, see PerfError)
+void PerfShutdown(void);   // Close the counters
+bool PerfEnabled(void);    // Counters are open
+const char *PerfError(void);                       // Why PerfInit failed, or which counters are missing
+bool PerfHasCounter(PerfCounter counter);          // This counter opened on this machine
+void PerfBegin(PerfRegion region);                 // Enter a region (no-op when disabled)
+void PerfEnd(PerfRegion region);                   // Leave it, adding what was counted since PerfBegin
+void PerfFrame(void);                              // One frame finished (the per-sample denominator)
+void PerfReset(void);                              // Clear every region and the frame count
+void PerfRead(PerfRegion region, PerfTotals *totals); // Totals of a region so far
+const char *PerfRegionName(PerfRegion region);     // Short name such as "physics"
+void PerfReport(FILE *out);                        // Per-region IPC and misses per frame
+
+#endif
@@ -0,0 +1,196 @@
+/****************************************************************
+ * @file preview.c                                              *
+ * @brief Implementation of the background trajectory forecast. *
+ * @author Gabe G.                                              *
+ * @date 10-19-2026                                             *
+ ****************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "preview.h"
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+#define PREVIEW_FRESH 4          // Flag on a handed-over slot index: the receiving side hasn't taken it yet
+#define PREVIEW_POLL_NS 2000000L // Worker polls for requests this often while a slider is moving
+#define PREVIEW_POLLS 500        // Polls without a request before the worker sleeps on the semaphore (1 s)
+
+/**********************************
+ *      Forward Declarations      *
+ **********************************/
+
+static void *PreviewWorker(void *arg);      // Wait for requests and run the newest one
+static bool TakeJob(Preview *preview);      // Take a handed-over job (false: none waiting)
+static void WaitForWake(Preview *preview); // Block on the semaphore until a request wakes the worker
+
+/***********************************
+ *      External API Functions     *
+ ***********************************/
+
+void PreviewInit(Preview *preview)
+{
+    memset(preview, 0, sizeof(*preview));
+    atomic_init(&preview->stop, false);
+    atomic_init(&preview->sleeping, false);
+    atomic_init(&preview->generation, 0);
+    atomic_init(&preview->published, 0);
+    atomic_init(&preview->cancelled, 0);
+    preview->jobBack = 0;
+    atomic_init(&preview->jobMiddle, 1);
+    preview->jobFront = 2;
+    preview->forecastBack = 0;
+    atomic_init(&preview->forecastMiddle, 1);
+    preview->forecastFront = 2;
+}
+
+void PreviewShutdown(Preview *preview)
+{
+    if (!preview->started)
+        return;
+    atomic_store_explicit(&preview->stop, true, memory_order_seq_cst);
+    atomic_fetch_add_explicit(&preview->generation, 1, memory_order_relaxed); // Abandon a running job
+    sem_post(&preview->wake);                                                 // Or wake it from its sleep
+    pthread_join(preview->worker, NULL);
+    sem_destroy(&preview->wake);
+    preview->started = false;
+}
+
+bool PreviewRequest(Preview *preview, const SpringMassSystemState *state, double time, SimReal step, int substeps)
+{
+    if (!preview->started)
+    {
+        if (sem_init(&preview->wake, 0, 0) != 0)
+            return false;
+        if (pthread_create(&preview->worker, NULL, PreviewWorker, preview) != 0)
+        {
+            sem_destroy(&preview->wake);
+            return false;
+        }
+        preview->started = true;
+    }
+
+    // Bump the generation first, so a job still running stops at its next sample instead of finishing
+    unsigned long generation = atomic_fetch_add_explicit(&preview->generation, 1, memory_order_relaxed) + 1;
+    PreviewJob *job = &preview->jobs[preview->jobBack];
+    job->state = *state;
+    job->time = time;
+    job->step = step;
+    job->substeps = substeps > 0 ? substeps : 1;
+    job->generation = generation;
+    int handed = atomic_exchange_explicit(&preview->jobMiddle, preview->jobBack | PREVIEW_FRESH,
+                                          memory_order_seq_cst);
+    preview->jobBack = handed & ~PREVIEW_FRESH;
+
+    // While a slider moves the worker is polling and no syscall is made here; only the first request after a quiet
+    // second pays for a wake-up
+    if (atomic_exchange_explicit(&preview->sleeping, false, memory_order_seq_cst))
+        sem_post(&preview->wake);
+    return true;
+}
+
+void PreviewCancel(Preview *preview)
+{
+    preview->validFrom = atomic_fetch_add_explicit(&preview->generation, 1, memory_order_relaxed) + 1;
+}
+
+const PreviewForecast *PreviewLatest(Preview *preview)
+{
+    if (atomic_load_explicit(&preview->forecastMiddle, memory_order_relaxed) & PREVIEW_FRESH)
+    {
+        int taken = atomic_exchange_explicit(&preview->forecastMiddle, preview->forecastFront, memory_order_acq_rel);
+        preview->forecastFront = taken & ~PREVIEW_FRESH;
+        preview->haveForecast = true;
+    }
+    if (!preview->haveForecast)
+        return NULL;
+    const PreviewForecast *forecast = &preview->forecasts[preview->forecastFront];
+    return forecast->generation >= preview->validFrom ? forecast : NULL;
+}
+
+bool PreviewRun(const PreviewJob *job, PreviewForecast *out, const atomic_ulong *generation)
+{
+    // The same kernel and frame schedule as the frame loop, so the forecast is the path the mass will take (closed
+    // forms would drift from the integrator), and the specialized kernels make a 5 s horizon cost microseconds
+    SpringMassSystemState state = job->state;
+    SimReal frame = job->step * job->substeps;
+    int frames = frame > 0 ? (int)ceil(PREVIEW_SECONDS / frame) : 0;
+    int stride = (frames + PREVIEW_SAMPLES - 2) / (PREVIEW_SAMPLES - 1);
+    if (stride < 1)
+        stride = 1;
+    out->generation = job->generation;
+    out->t0 = job->time;
+    out->interval = (float)(frame * stride);
+    out->count = 1;
+    out->min = out->max = out->displacement[0] = (float)(state.x - state.equilibrium);
+    for (int done = 0; done < frames && out->count < PREVIEW_SAMPLES; done += stride)
+    {
+        if (generation != NULL && atomic_load_explicit(generation, memory_order_relaxed) != job->generation)
+            return false;
+        SpringmassAdvance(&state, job->step, stride * job->substeps);
+        float displacement = (float)(state.x - state.equilibrium);
+        out->displacement[out->count++] = displacement;
+        out->min = fminf(out->min, displacement);
+        out->max = fmaxf(out->max, displacement);
+    }
+    return true;
+}
+
+/***************************************
+ *      Internal helper functions      *
+ ***************************************/
+
+static void *PreviewWorker(void *arg)
+{
+    Preview *preview = arg;
+    const struct timespec poll = { 0, PREVIEW_POLL_NS };
+    int idle = 0;
+    while (!atomic_load_explicit(&preview->stop, memory_order_relaxed))
+    {
+        if (!TakeJob(preview))
+        {
+            if (++idle < PREVIEW_POLLS)
+                nanosleep(&poll, NULL);
+            else
+            {
+                WaitForWake(preview);
+                idle = 0;
+            }
+            continue;
+        }
+        idle = 0;
+        PreviewForecast *out = &preview->forecasts[preview->forecastBack];
+        if (!PreviewRun(&preview->jobs[preview->jobFront], out, &preview->generation))
+        {
+            atomic_fetch_add_explicit(&preview->cancelled, 1, memory_order_relaxed);
+            continue;
+        }
+        int handed = atomic_exchange_explicit(&preview->forecastMiddle, preview->forecastBack | PREVIEW_FRESH,
+                                              memory_order_acq_rel);
+        preview->forecastBack = handed & ~PREVIEW_FRESH;
+        atomic_fetch_add_explicit(&preview->published, 1, memory_order_relaxed);
+    }
+    return NULL;
+}
+
+static bool TakeJob(Preview *preview)
+{
+    if (!(atomic_load_explicit(&preview->jobMiddle, memory_order_seq_cst) & PREVIEW_FRESH))
+        return false;
+    int taken = atomic_exchange_explicit(&preview->jobMiddle, preview->jobFront, memory_order_acq_rel);
+    preview->jobFront = taken & ~PREVIEW_FRESH;
+    return true;
+}
+
+static void WaitForWake(Preview *preview)
+{
+    // Announce the sleep, then look once more: a request either sees the flag and posts, or is seen here
+    atomic_store_explicit(&preview->sleeping, true, memory_order_seq_cst);
+    bool pending = (atomic_load_explicit(&preview->jobMiddle, memory_order_seq_cst) & PREVIEW_FRESH) ||
+                   atomic_load_explicit(&preview->stop, memory_order_seq_cst);
+    if (pending && atomic_exchange_explicit(&preview->sleeping, false, memory_order_seq_cst))
+        return; // Caught before any request cleared the flag, so nobody posted
+    while (sem_wait(&preview->wake) != 0 && errno == EINTR)
+        ;
+}
@@ -0,0 +1,83 @@
+/*****************************************************************************************************************
+ * @file preview.h                                                                                               *
+ * @brief Background forecast of the trajectory after a parameter change, handed to the render thread lock-free. *
+ * @author Gabe G.                                                                                               *
+ * @date 10-19-2026                                                                                              *
+ *****************************************************************************************************************/
+
+#ifndef PREVIEW_H
+#define PREVIEW_H
+
+#include "core/physics.h"
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+
+#define PREVIEW_SECONDS 5.0f  // Forecast horizon
+#define PREVIEW_SAMPLES 1024 // Most samples per forecast (frames are skipped evenly past this)
+
+// What to forecast: the state right after the change, stepped on the frame loop's schedule
+typedef struct PreviewJob
+{
+    SpringMassSystemState state; // Starting state (noise counter included, so noisy forecasts are exact too)
+    double time;                 // Simulation time of `state`
+    SimReal step;                // Physics step of the frame loop
+    int substeps;                // Steps per frame
+    unsigned long generation;    // Request number; the job is dropped once a newer one exists
+} PreviewJob;
+
+// A finished forecast of the displacement from equilibrium
+typedef struct PreviewForecast
+{
+    unsigned long generation;             // Request it answers
+    double t0;                            // Time of sample 0
+    float interval;                       // Seconds between samples
+    int count;                            // Samples
+    float min;                            // Range of the samples
+    float max;
+    float displacement[PREVIEW_SAMPLES];  // Displacement at t0 + i * interval
+} PreviewForecast;
+
+// One worker per simulation. Requests and forecasts each pass through a triple buffer: the side handing a slot over
+// swaps its private slot with the shared one in a single atomic exchange, so neither side ever waits for the other.
+// A request only overwrites the pending job, so at most one job is in flight and one waits, however fast the
+// slider moves; a running job checks the generation counter and abandons itself as soon as it is stale. The worker
+// polls while requests keep coming and sleeps on a semaphore after a quiet second, so a continuous drag costs the
+// frame loop a state copy and two atomic exchanges per frame.
+typedef struct Preview
+{
+    bool started;            // Worker thread is running
+    pthread_t worker;        // The worker
+    sem_t wake;              // Posted to wake a sleeping worker
+    atomic_bool sleeping;    // Worker is (about to be) blocked on `wake` rather than polling
+    atomic_bool stop;        // Worker should exit
+    atomic_ulong generation; // Newest request (bumped before the job is handed over, to stop the running one)
+
+    PreviewJob jobs[3];       // Request triple buffer
+    int jobBack;              // Slot the frame loop fills next
+    atomic_int jobMiddle;     // Slot being handed over (PREVIEW_FRESH set: not taken yet)
+    int jobFront;             // Slot the worker runs
+
+    PreviewForecast forecasts[3]; // Forecast triple buffer
+    int forecastBack;             // Slot the worker fills next
+    atomic_int forecastMiddle;    // Slot being handed over
+    int forecastFront;            // Slot the render thread reads
+    bool haveForecast;            // `forecastFront` holds a forecast
+    unsigned long validFrom;      // Oldest generation still worth showing (raised by PreviewCancel)
+
+    atomic_ulong published; // Forecasts finished
+    atomic_ulong cancelled; // Jobs abandoned for a newer request
+} Preview;
+
+// Preview Function declarations
+void PreviewInit(Preview *preview);     // Empty preview; the worker starts with the first request
+void PreviewShutdown(Preview *preview); // Stop and join the worker
+bool PreviewRequest(Preview *preview, const SpringMassSystemState *state, double time, SimReal step,
+                    int substeps); // Forecast from `state` (false: no worker thread); never blocks
+void PreviewCancel(Preview *preview); // Drop the running job and hide every forecast made so far
+const PreviewForecast *PreviewLatest(Preview *preview); // Newest forecast (NULL: none); valid until the next call
+bool PreviewRun(const PreviewJob *job, PreviewForecast *out,
+                const atomic_ulong *generation); // Compute a forecast in place (false: stale, stopped early)
+
+#endif
@@ -0,0 +1,125 @@
+/******************************************************************************************************
+ * @file render_headless.c                                                                            *
+ * @brief Offline renderer: runs the simulation at a fixed step and draws it with the CPU rasterizer. *
+ * @author Gabe G.                                                                                    *
+ * @date 10-19-2026                                                                                   *
+ ******************************************************************************************************/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "consts.h"
+#include "core/physics.h"
+#include "renderer/graph.h"
+#include "renderer/renderer.h"
+#include "renderer/softraster.h"
+#include "sim/perfcount.h"
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define RENDER_FRAMES 600      // Frames to render by default
+#define RENDER_FPS 120         // Fixed step, matching the interactive frame rate
+#define RENDER_WRITE_EVERY 60  // With an output prefix, write one frame in this many (plus the last)
+#define RENDER_DISPLACEMENT 80 // Initial stretch so there is something to draw
+
+static double NowSeconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Usage: springmass_render [frames] [threads] [output prefix] [--perf]
+// Prints the time per frame and a checksum of the last frame; the checksum is the same for every thread count.
+// With --perf, hardware counters for each part of the frame are reported too (rasterizer threads not included).
+int main(int argc, char **argv)
+{
+    bool perf = argc > 1 && strcmp(argv[argc - 1], "--perf") == 0;
+    if (perf)
+    {
+        argc--;
+        if (!PerfInit())
+            fprintf(stderr, "render: performance counters unavailable: %s\n", PerfError());
+    }
+    int frames = (argc > 1) ? atoi(argv[1]) : RENDER_FRAMES;
+    int threads = (argc > 2) ? atoi(argv[2]) : 0;
+    const char *prefix = (argc > 3) ? argv[3] : NULL;
+    if (frames <= 0)
+        frames = RENDER_FRAMES;
+
+    // Scene on the left, graph on the right, as the two interactive windows are laid out
+    if (!SoftRasterInit(2 * SCREEN_WIDTH, SCREEN_HEIGHT, threads))
+    {
+        fprintf(stderr, "render: cannot allocate the framebuffer\n");
+        return 1;
+    }
+    SoftRasterSetFrameTime(1.0f / RENDER_FPS);
+    SetRenderBackend(&SOFT_BACKEND);
+
+    SpringMassRenderState renderState;
+    SpringMassSystemState state;
+    GraphState graph;
+    InitRenderState(&renderState);
+    InitSystem(&state);
+    InitGraph(&graph);
+    state.xMin = renderState.springAnchorPoint.x + SPRING_STOP_MARGIN;
+    state.xMax = renderState.springAnchorPoint.x + SPRING_SEGMENTS * SPRING_SEGMENT_LENGTH - SPRING_STOP_MARGIN;
+    state.x = state.equilibrium + RENDER_DISPLACEMENT;
+    SpringmassSelectKernel(&state);
+
+    SimRect graphBounds = { SCREEN_WIDTH, 0, SCREEN_WIDTH, SCREEN_HEIGHT };
+    SimClock clock;
+    SimClockReset(&clock);
+    double drawSeconds = 0.0;
+    for (int frame = 0; frame < frames; frame++)
+    {
+        float dt = Render_GetFrameTime();
+        SimClockAdvance(&clock, dt);
+        PerfBegin(PERF_PHYSICS);
+        SpringmassAdvance(&state, dt, 1);
+        PerfEnd(PERF_PHYSICS);
+        PerfBegin(PERF_GRAPH_UPDATE);
+        float displacement = state.x - state.equilibrium;
+        renderState.massRectangle.x = state.x;
+        UpdateGraph(&graph, displacement, clock.time);
+        PerfEnd(PERF_GRAPH_UPDATE);
+
+        double start = NowSeconds();
+        Render_BeginDrawing();
+        Render_ClearBackground(SIM_BLACK);
+        PerfBegin(PERF_GRAPH_DRAW);
+        DrawGraph(&graph, graphBounds, displacement, clock.time, &renderState.themeColor);
+        PerfEnd(PERF_GRAPH_DRAW);
+        PerfBegin(PERF_SPRING_DRAW);
+        UpdateRender(&renderState);
+        PerfEnd(PERF_SPRING_DRAW);
+        PerfBegin(PERF_UI);
+        if (clock.time <= 8.0f)
+            ShowStartupText(&renderState);
+        PerfEnd(PERF_UI);
+        PerfBegin(PERF_PRESENT);
+        Render_EndDrawing();
+        PerfEnd(PERF_PRESENT);
+        PerfFrame();
+        drawSeconds += NowSeconds() - start;
+
+        if (prefix != NULL && (frame % RENDER_WRITE_EVERY == 0 || frame == frames - 1))
+        {
+            char path[512];
+            snprintf(path, sizeof(path), "%s_%05d.ppm", prefix, frame);
+            if (!SoftRasterWritePPM(path))
+                fprintf(stderr, "render: cannot write %s\n", path);
+        }
+    }
+
+    printf("%d frames at %dx%d: %.3f ms/frame, checksum %016" PRIx64 "\n", frames, SoftRasterWidth(),
+           SoftRasterHeight(), drawSeconds * 1e3 / frames, SoftRasterChecksum());
+
+    if (PerfEnabled())
+        PerfReport(stderr);
+    PerfShutdown();
+    CloseGraph(&graph);
+    SoftRasterShutdown();
+    return 0;
+}
@@ -8,26 +8,59 @@
 #include "sim.h"
 #include "UI/ui.h"
 #include "consts.h"
-#include "renderer/graph.h"
 
 /**********************************
  *      Forward Declarations      *
  **********************************/
 
 static bool SimHandleDragging(SimState *sim); // Handle dragging logic; returns true if dragging is occurring
-static void SimResolveBounds(
-    SimState *sim); // Ensure the mass stays within bounds defined by the spring's anchor and max extension
-static void ShowUI(SimState *sim); // Draw the UI elements
+static Vec2D SimMousePosition(const SimState *sim); // Mouse position in this simulation's scene coordinates
+static bool SimMouseOverMass(const SimState *sim);  // Check if the mouse is over this simulation's mass
+static void SimSetBounds(
+    SimState *sim); // Set the walls from the spring's anchor and max extension and select the matching kernel
+static void ShowUI(SimState *sim, SimTime time);           // Draw the UI elements
+static void SimPublishParams(SimState *sim, SimTime time); // Publish current parameters to telemetry
+static void SimFitPhasePlot(SimState *sim);                // Refit the phase plot axes if the natural frequency changed
+static void SimShowLatency(SimState *sim);                 // Drag latency and latch mode overlay
+static void SimShowTimeline(SimState *sim);                // Timeline slider of the pause dialog; seeks when moved
+static void SimLeaveScrub(SimState *sim, SimTime time,
+                          bool resume); // Back to the live state, or continue from the instant shown
+static void SimStartDesign(SimState *sim, const DesignTarget *target,
+                           SimTime time);                // Solve on a worker thread (here if none can start)
+static void SimPollDesign(SimState *sim, SimTime time);  // Apply a solve that has finished
+static void SimApplyDesign(SimState *sim, SimTime time); // Copy the solved k, c, m and e into the live system
+static void *SimDesignWorker(void *arg);                 // Run one solve
 
 /***********************************
  *      External API Functions     *
  ***********************************/
 
 void InitSim(SimState *sim, int windowWidth, int windowHeight, const char *title, int FPS)
+{
+    InitRenderWindow(windowWidth, windowHeight, title, FPS);
+    InitSimInstance(sim);
+    GovernorInit(&sim->governor, FPS, Render_GetRefreshRate());
+    GovernorFrameBegin(&sim->governor, LatencyNow());
+    TimelineOpen(&sim->timeline, sim->governor.budget); // Optional: without memory for it there is no rewind
+    InitGraphWindow();
+    TelemetryOpenWriter(&sim->telemetry, TELEMETRY_SHM_NAME); // Optional: runs without it if shm is unavailable
+    SimPublishParams(sim, 0);
+}
+
+void InitSimInstance(SimState *sim)
 {
     InitSystem(&sim->systemState);
-    InitRender(&sim->renderState, windowWidth, windowHeight, title, FPS);
-    InitGraph();
+    InitRenderState(&sim->renderState);
+    InitGraph(&sim->graph);
+    InitPhasePlot(&sim->phase);
+    PreviewInit(&sim->preview);
+    sim->frameStep = 0;
+    sim->frameSubsteps = 0;
+    TimelineInit(&sim->timeline);
+    sim->scrubbing = false;
+    SimSetBounds(sim);
+    sim->phaseOmega = 0.0f;
+    sim->tile = (RenderTile){ 0.0f, 0.0f, 1.0f };
     sim->isRunning = true;
     // sim->isPaused = false;
     sim->pausedTime = 0.0f;
@@ -35,38 +68,152 @@ void InitSim(SimState *sim, int windowWidth, int windowHeight, const char *title
     // sim->showThemeChange = false;
     // sim->simShowPararms = false;
     sim->dialog = NONE;
+    InitThemeDialog(&sim->themeDialog);
+    InitDesignDialog(&sim->designDialog);
     sim->isDragging = false;
     sim->dragGrabOffsetX = 0.0f;
+    sim->latchMode = LATCH_CURSOR;
+    sim->sensitivity = SENS_PARAMS;
+    sim->designSolved = false;
+    sim->designWork.running = false;
+    atomic_init(&sim->designWork.done, false);
+    WelfordInit(&sim->noiseStats);
+    WelfordInit(&sim->noiseShown);
+    sim->frame = 0;
+    sim->latencyText[0] = '\0';
+    GovernorInit(&sim->governor, 0, Render_GetRefreshRate());
+    GovernorSettings(&sim->governor, &sim->quality);
+    SimApplyQuality(sim, &sim->quality); // Full detail until a governor says otherwise
+    SpringmassTangentInit(&sim->tangent);
+    LatencyInit(&sim->latency, Render_GetRefreshRate());
+    sim->telemetry.ring = NULL; // Only InitSim publishes; extra instances stay silent
 }
 
-void UpdateSim(SimState *sim, float dt, float time)
+void UpdateSim(SimState *sim, float dt, SimTime time)
 {
+    SimPollDesign(sim, time);
     if (EscKeyPressed())
     {
         // Toggle pause on ESC key
         // sim->isPaused = !sim->isPaused;
         sim->dialog = (sim->dialog == NONE) ? PAUSE : NONE;
+        if (sim->scrubbing)
+            SimLeaveScrub(sim, time, false); // Escape from a rewound view returns to the present
+    }
+    if (LatchKeyPressed())
+    {
+        sim->latchMode = (sim->latchMode + 1) % LATCH_MODES;
+        sim->latencyText[0] = '\0'; // Show the new mode right away
+    }
+    if (SensitivityKeyPressed())
+    {
+        SimCycleSensitivity(sim);
+    }
+    if (PhaseKeyPressed())
+    {
+        sim->phase.visible = !sim->phase.visible; // Dirty rows keep accumulating while hidden
     }
     if (sim->dialog == NONE)
     {
         // Only update physics when in a dialog
-        if (!SimHandleDragging(sim))
+        UpdateSimBatch(sim, 1, dt, time);
+    }
+}
+
+void UpdateSimBatch(SimState *sims, int count, float dt, SimTime time)
+{
+    // A long frame is stepped in pieces (as many as the detail level allows) instead of one large step
+    int substeps = count > 0 ? GovernorSubsteps(&sims[0].quality, dt) : 1;
+    SimReal h = dt / substeps;
+    for (int first = 0; first < count; first += SIM_MAX_INSTANCES)
+    {
+        int chunk = (count - first < SIM_MAX_INSTANCES) ? count - first : SIM_MAX_INSTANCES;
+        SimState *batch = sims + first;
+
+        // Dragged masses follow the mouse; masses with a sensitivity shown carry their tangent through the step;
+        // everything else is stepped together
+        PerfBegin(PERF_PHYSICS);
+        SpringMassSystemState *stepping[SIM_MAX_INSTANCES];
+        TimelineMode modes[SIM_MAX_INSTANCES];
+        int steppingCount = 0;
+        for (int i = 0; i < chunk; i++)
+        {
+            SimState *sim = &batch[i];
+            sim->frameStep = h;
+            sim->frameSubsteps = substeps;
+            TimelineBeginFrame(&sim->timeline, &sim->systemState);
+            if (SimHandleDragging(sim))
+            {
+                SpringmassResolveBounds(&sim->systemState, sim->systemState.xMin, sim->systemState.xMax);
+                SpringmassTangentInit(&sim->tangent); // Sensitivities restart from wherever the mass is let go
+                modes[i] = TIMELINE_HELD;
+            }
+            else if (sim->sensitivity != SENS_PARAMS)
+            {
+                SpringmassAdvanceTangent(&sim->systemState, &sim->tangent, h, substeps);
+                modes[i] = TIMELINE_TANGENT;
+            }
+            else
+            {
+                stepping[steppingCount++] = &sim->systemState;
+                modes[i] = TIMELINE_STEP;
+            }
+        }
+        SpringmassAdvanceBatch(stepping, steppingCount, h, substeps); // Step + bounds with each regime's kernel
+        for (int i = 0; i < chunk; i++)
+            TimelineEndFrame(&batch[i].timeline, &batch[i].systemState, dt, substeps, modes[i], time);
+        PerfEnd(PERF_PHYSICS);
+
+        PerfBegin(PERF_GRAPH_UPDATE);
+
+        for (int i = 0; i < chunk; i++)
         {
-            SpringmassStep(&sim->systemState, dt);
+            SimState *sim = &batch[i];
+            const SpringMassSystemState *state = &sim->systemState;
+            float displacement = state->x - state->equilibrium;
+            sim->renderState.massRectangle.x = state->x;
+            UpdateGraph(&sim->graph, displacement, time);
+            if (state->noiseIntensity > 0 && !sim->isDragging)
+                WelfordAdd(&sim->noiseStats, displacement);
+            if (sim->sensitivity != SENS_PARAMS)
+                UpdateGraphChannel(&sim->graph, sim->tangent.dx[sim->sensitivity], time);
+            SimFitPhasePlot(sim);
+            UpdatePhasePlot(&sim->phase, displacement, state->velocity);
+            PhasePlotDecay(&sim->phase, dt);
+
+            // Active force law, plus the coloured noise force (white noise has no finite value at an instant)
+            SimReal acceleration = SpringmassForceAccel(state, displacement, state->velocity);
+            if (state->noiseIntensity > 0 && state->noiseTau > 0)
+                acceleration += state->noiseForce * state->invMass;
+            TelemetryPublish(&sim->telemetry, TELEMETRY_SAMPLE, time, state->x, state->velocity, acceleration, 0.0);
         }
-        SimResolveBounds(sim);
-        sim->renderState.massRectangle.x = sim->systemState.x;
-        UpdateGraph(sim->systemState.x - sim->systemState.equilibrium, time);
+        PerfEnd(PERF_GRAPH_UPDATE);
     }
 }
 
-void DrawSim(SimState *sim, float dt, float time)
+void DrawSim(SimState *sim, float dt, SimTime time)
 {
     Render_BeginDrawing();
     Render_ClearBackground(SIM_BLACK); // Clear last frame
-    DrawGraph(sim->systemState.x - sim->systemState.equilibrium, time, &sim->renderState.themeColor);
-    ShowUI(sim);                     // Draw UI
+    PerfBegin(PERF_GRAPH_DRAW);
+    SimShowForecast(sim);
+    const SpringMassSystemState *shown = sim->scrubbing ? &sim->scrub.state : &sim->systemState;
+    DrawGraph(&sim->graph, GraphWindowBounds(), shown->x - shown->equilibrium,
+              sim->scrubbing ? (SimTime)sim->scrub.time : time, &sim->renderState.themeColor);
+    DrawPhasePlot(&sim->phase, PhasePlotDefaultBounds(), &sim->renderState.themeColor);
+    PerfEnd(PERF_GRAPH_DRAW);
+    PerfBegin(PERF_UI);
+    ShowUI(sim, time); // Draw UI
+    PerfEnd(PERF_UI);
+    SimLateLatch(sim); // Move a dragged mass to where the cursor is now
+    PerfBegin(PERF_SPRING_DRAW);
     UpdateRender(&sim->renderState); // Update render state based on system state
+    PerfEnd(PERF_SPRING_DRAW);
+    PerfBegin(PERF_UI);
+    if (sim->isDragging)
+    {
+        SimShowLatency(sim);
+    }
 
     float textPersistTime = 8.0f; // Time to show startup text before fading (seconds)
     float fadeTime = 2.0f;        // Duration of fade-out animation (seconds)
@@ -84,12 +231,17 @@ void DrawSim(SimState *sim, float dt, float time)
     switch (sim->dialog)
     {
         case PAUSE:
-            switch (ShowPauseDialog())
+            SimShowTimeline(sim);
+            switch (ShowPauseDialog(sim->scrubbing))
             {
                 case 1:
+                    if (sim->scrubbing)
+                        SimLeaveScrub(sim, time, true);
                     sim->dialog = NONE;
                     break;
                 case 2:
+                    if (sim->scrubbing)
+                        SimLeaveScrub(sim, time, false);
                     sim->dialog = SETTINGS;
                     break;
                 case 3:
@@ -106,18 +258,94 @@ void DrawSim(SimState *sim, float dt, float time)
                 case 2:
                     sim->dialog = CHANGE_THEME;
                     break;
+                case 3:
+                    sim->dialog = DESIGN;
+                    break;
             }
             break;
         case EDIT_PARAMS:
-            ShowParamEdit();
+            if (ShowParamEdit(&sim->systemState))
+            {
+                SpringmassSelectKernel(&sim->systemState);
+                SimPublishParams(sim, time);
+            }
             break;
         case CHANGE_THEME:
-            ShowThemeChange(&sim->renderState);
+            ShowThemeChange(&sim->renderState, &sim->themeDialog);
+            break;
+        case DESIGN:
+        {
+            DesignTarget target;
+            if (ShowDesignDialog(&sim->designDialog, &target, sim->designSolved ? &sim->design : NULL,
+                                 sim->designWork.running))
+                SimStartDesign(sim, &target, time); // 100+ ms: the frame loop keeps drawing meanwhile
             break;
+        }
     }
     // End of dialog handling logic
+    PerfEnd(PERF_UI);
 
+    SimGovernFrame(&sim->governor, sim, 1, dt, time);
+    PerfBegin(PERF_PRESENT);
     Render_EndDrawing();
+    PerfEnd(PERF_PRESENT);
+    PerfFrame();
+    LatencyFramePresented(&sim->latency);
+    GovernorFrameBegin(&sim->governor, LatencyNow());
+}
+
+void SimLateLatch(SimState *sim)
+{
+    if (!sim->isDragging || sim->dialog != NONE)
+        return;
+    if (sim->latchMode == LATCH_OFF)
+    {
+        LatencyMarkSample(&sim->latency, false); // Drawn where UpdateSim put it, from the last input poll
+        return;
+    }
+
+    // Everything drawn since UpdateSim (graph, phase plot, UI) no longer delays the mass
+    Vec2D cursor;
+    bool latched = Render_LatchMousePosition(&cursor);
+    LatencyMarkSample(&sim->latency, latched);
+    SpringMassSystemState *state = &sim->systemState;
+    state->x = (cursor.x - sim->tile.x) / sim->tile.scale - sim->dragGrabOffsetX;
+    SpringmassResolveBounds(state, state->xMin, state->xMax);
+
+    // The prediction is only drawn; the physics keeps the measured position
+    float shownX = state->x;
+    if (sim->latchMode == LATCH_PREDICT && latched)
+        shownX = fminf(fmaxf(LatencyPredictX(&sim->latency, shownX), state->xMin), state->xMax);
+    sim->renderState.massRectangle.x = shownX;
+}
+
+void SimCycleSensitivity(SimState *sim)
+{
+    sim->sensitivity = (sim->sensitivity + 1) % (SENS_PARAMS + 1);
+    SpringmassTangentInit(&sim->tangent); // Measured from now on, against the current state
+    GraphSetChannel(&sim->graph, sim->sensitivity == SENS_PARAMS ? NULL : SpringmassSensitivityName(sim->sensitivity));
+}
+
+void SimApplyQuality(SimState *sim, const QualitySettings *quality)
+{
+    sim->quality = *quality;
+    GraphSetColumnStride(&sim->graph, quality->graphColumnStride);
+    SetPhasePlotUploadInterval(&sim->phase, quality->phaseUploadEvery);
+    SetSpringDetail(&sim->renderState, quality->springSegments);
+}
+
+void SimGovernFrame(FrameGovernor *governor, SimState *sims, int count, float dt, SimTime time)
+{
+    double now = LatencyNow();
+    int previous = governor->level;
+    if (!GovernorFrameEnd(governor, now, dt))
+        return;
+    TelemetryPublish(&sims[0].telemetry, TELEMETRY_QUALITY, time, governor->level, previous,
+                     governor->smoothedWork * 1e3, governor->budget * 1e3);
+    QualitySettings quality;
+    GovernorSettings(governor, &quality);
+    for (int i = 0; i < count; i++)
+        SimApplyQuality(&sims[i], &quality);
 }
 
 float CurrentFrameTime(void)
@@ -130,11 +358,46 @@ bool SimRunning(const SimState *sim)
     return ExitButtonClicked() && sim->isRunning;
 }
 
-void StopSim(void)
+void StopSim(SimState *sim)
 {
+    LatencyReport(&sim->latency, stderr);
+    if (PerfEnabled())
+        PerfReport(stderr);
+    PerfShutdown();
+    TelemetryCloseWriter(&sim->telemetry);
+    CloseSimInstance(sim);
     DestroyRenderer();
 }
 
+void CloseSimInstance(SimState *sim)
+{
+    if (sim->designWork.running)
+        pthread_join(sim->designWork.worker, NULL); // A solve can't be interrupted; it ends within a second
+    PreviewShutdown(&sim->preview);
+    TimelineClose(&sim->timeline);
+    ClosePhasePlot(&sim->phase);
+    CloseGraph(&sim->graph);
+}
+
+void SimRequestForecast(SimState *sim, SimTime time)
+{
+    if (sim->frameSubsteps > 0 && !sim->isDragging)
+        PreviewRequest(&sim->preview, &sim->systemState, time, sim->frameStep, sim->frameSubsteps);
+}
+
+void SimShowForecast(SimState *sim)
+{
+    const PreviewForecast *forecast = PreviewLatest(&sim->preview);
+    if (forecast == NULL || sim->scrubbing)
+    {
+        GraphSetForecast(&sim->graph, NULL);
+        return;
+    }
+    GraphForecast ghost = { forecast->displacement, forecast->count, (float)forecast->t0, forecast->interval,
+                            forecast->min,          forecast->max };
+    GraphSetForecast(&sim->graph, &ghost);
+}
+
 /***************************************
  *      Internal helper functions      *
  ***************************************/
@@ -143,11 +406,13 @@ static bool SimHandleDragging(SimState *sim)
 {
     if (!sim->isDragging)
     {
-        if (LeftMouseButtonPressed() && ClickInBoundingBox(&sim->renderState.massRectangle))
+        if (LeftMouseButtonPressed() && SimMouseOverMass(sim))
         {
-            Vec2D mousePosition = GetMousePOS();
+            Vec2D mousePosition = SimMousePosition(sim);
             sim->isDragging = true;
+            PreviewCancel(&sim->preview); // The hand takes over: any forecast is wrong from here on
             sim->dragGrabOffsetX = mousePosition.x - sim->systemState.x;
+            LatencyResetCursor(&sim->latency);
         }
         else
         {
@@ -162,7 +427,7 @@ static bool SimHandleDragging(SimState *sim)
     }
     if (LeftMouseButtonDown())
     {
-        Vec2D mousePosition = GetMousePOS();
+        Vec2D mousePosition = SimMousePosition(sim);
         sim->systemState.x = mousePosition.x - sim->dragGrabOffsetX;
         sim->systemState.velocity = 0.0f;
         return true;
@@ -172,19 +437,161 @@ static bool SimHandleDragging(SimState *sim)
     return false;
 }
 
-static void SimResolveBounds(SimState *sim)
+static Vec2D SimMousePosition(const SimState *sim)
+{
+    Vec2D mousePosition = GetMousePOS();
+    return (Vec2D){ (mousePosition.x - sim->tile.x) / sim->tile.scale, (mousePosition.y - sim->tile.y) / sim->tile.scale };
+}
+
+static bool SimMouseOverMass(const SimState *sim)
+{
+    Vec2D mousePosition = SimMousePosition(sim);
+    const SimRect *mass = &sim->renderState.massRectangle;
+    return mousePosition.x >= mass->x && mousePosition.x <= mass->x + mass->width && mousePosition.y >= mass->y &&
+           mousePosition.y <= mass->y + mass->height;
+}
+
+static void SimSetBounds(SimState *sim)
 {
-    float x_min =
+    sim->systemState.xMin =
         sim->renderState.springAnchorPoint.x + SPRING_STOP_MARGIN; // Leftmost point of spring plus some margin
-    float x_max = sim->renderState.springAnchorPoint.x + (SPRING_SEGMENTS * SPRING_SEGMENT_LENGTH) -
-                  SPRING_STOP_MARGIN; // Point where spring is fully expanded minus some margin
-    SpringmassResolveBounds(&sim->systemState, x_min, x_max);
+    sim->systemState.xMax = sim->renderState.springAnchorPoint.x + (SPRING_SEGMENTS * SPRING_SEGMENT_LENGTH) -
+                            SPRING_STOP_MARGIN; // Point where spring is fully expanded minus some margin
+    SpringmassSelectKernel(&sim->systemState);
 }
 
-static void ShowUI(SimState *sim)
+static void ShowUI(SimState *sim, SimTime time)
 {
     SetThemeColor(&sim->renderState.themeColor);
-    MakeVariableSliders(&sim->systemState);
+    if (MakeVariableSliders(&sim->systemState))
+    {
+        SpringmassSelectKernel(&sim->systemState); // Only re-derive coefficients when a slider moved
+        SimPublishParams(sim, time);
+    }
     ShowDamping(sim->systemState.damping, sim->systemState.springConst, sim->systemState.mass,
                 &sim->renderState.themeColor);
-}
\ No newline at end of file
+    if (sim->frame++ % sim->quality.overlayEvery == 0 || sim->noiseStats.count < sim->noiseShown.count)
+        sim->noiseShown = sim->noiseStats; // Overlays refresh at the detail level's pace
+    if (sim->systemState.noiseIntensity > 0 && sim->noiseShown.count > 0)
+        ShowNoiseStats(sim->noiseShown.mean, sqrt(WelfordVariance(&sim->noiseShown)), (long)sim->noiseShown.count,
+                       &sim->renderState.themeColor);
+}
+
+static void SimPublishParams(SimState *sim, SimTime time)
+{
+    const SpringMassSystemState *state = &sim->systemState;
+    WelfordInit(&sim->noiseStats); // Statistics restart under the new parameters
+    SimRequestForecast(sim, time);
+    TelemetryPublish(&sim->telemetry, TELEMETRY_PARAMS, time, state->springConst, state->mass, state->damping,
+                     state->restitution);
+}
+
+static void SimFitPhasePlot(SimState *sim)
+{
+    const SpringMassSystemState *state = &sim->systemState;
+    SimReal omega = sqrt(state->kOverM);
+    if (omega == sim->phaseOmega)
+        return;
+    sim->phaseOmega = omega;
+
+    // Widest swing the walls allow, and the speed an undamped oscillation of that size reaches
+    float left = state->equilibrium - state->xMin;
+    float right = state->xMax - state->equilibrium;
+    float displacementRange = 1.1f * (left > right ? left : right);
+    SetPhasePlotRange(&sim->phase, displacementRange, omega * displacementRange);
+}
+
+static void SimShowLatency(SimState *sim)
+{
+    static const char *MODE_NAMES[LATCH_MODES] = { "off", "late latch", "late latch + prediction" };
+    if (sim->frame % sim->quality.overlayEvery == 0 || sim->latencyText[0] == '\0')
+        snprintf(sim->latencyText, sizeof(sim->latencyText), "Drag latency p50 %.1f ms  p99 %.1f ms   [L] %s",
+                 LatencyPercentile(&sim->latency, 0.50) * 1e3, LatencyPercentile(&sim->latency, 0.99) * 1e3,
+                 MODE_NAMES[sim->latchMode]);
+    Render_DrawText(sim->latencyText, 10, SCREEN_HEIGHT - 20, 10, SIM_LIGHTGRAY);
+}
+
+static void SimShowTimeline(SimState *sim)
+{
+    if (sim->timeline.keyCount == 0)
+        return;
+    float end = (float)TimelineEnd(&sim->timeline);
+    float shown = sim->scrubbing ? (float)sim->scrub.time : end;
+    if (!ShowTimelineSlider(&shown, (float)TimelineStart(&sim->timeline), end))
+        return;
+
+    // Rebuilt from the nearest keyframe within half a frame budget; the end of the slider is the live state
+    if (shown >= end)
+    {
+        sim->scrubbing = false;
+        sim->renderState.massRectangle.x = sim->systemState.x;
+    }
+    else if (TimelineSeek(&sim->timeline, shown, &sim->scrub))
+    {
+        sim->scrubbing = true;
+        sim->renderState.massRectangle.x = sim->scrub.state.x;
+    }
+}
+
+static void SimLeaveScrub(SimState *sim, SimTime time, bool resume)
+{
+    sim->scrubbing = false;
+    if (resume)
+    {
+        // The clock and graph keep running from now; the journal records the jump as an edit like any other
+        sim->systemState = sim->scrub.state;
+        SpringmassTangentInit(&sim->tangent);
+        SimPublishParams(sim, time);
+    }
+    sim->renderState.massRectangle.x = sim->systemState.x;
+}
+
+static void SimStartDesign(SimState *sim, const DesignTarget *target, SimTime time)
+{
+    // The solve works on a copy of the system as it was when Solve was pressed; the dialog holds the physics, so
+    // only k, c, m and e are copied back when it finishes
+    DesignWork *work = &sim->designWork;
+    if (work->running)
+        return;
+    work->state = sim->systemState;
+    work->target = *target;
+    atomic_store_explicit(&work->done, false, memory_order_relaxed);
+    if (pthread_create(&work->worker, NULL, SimDesignWorker, work) == 0)
+    {
+        work->running = true;
+        return;
+    }
+    DesignSolve(&work->state, &work->target, &work->result);
+    SimApplyDesign(sim, time);
+}
+
+static void SimPollDesign(SimState *sim, SimTime time)
+{
+    DesignWork *work = &sim->designWork;
+    if (!work->running || !atomic_load_explicit(&work->done, memory_order_acquire))
+        return;
+    pthread_join(work->worker, NULL);
+    work->running = false;
+    SimApplyDesign(sim, time);
+}
+
+static void SimApplyDesign(SimState *sim, SimTime time)
+{
+    const DesignResult *result = &sim->designWork.result;
+    sim->systemState.springConst = result->springConst;
+    sim->systemState.damping = result->damping;
+    sim->systemState.mass = result->mass;
+    sim->systemState.restitution = result->restitution;
+    SpringmassSelectKernel(&sim->systemState);
+    sim->design = *result;
+    sim->designSolved = true;
+    SimPublishParams(sim, time);
+}
+
+static void *SimDesignWorker(void *arg)
+{
+    DesignWork *work = arg;
+    DesignSolve(&work->state, &work->target, &work->result);
+    atomic_store_explicit(&work->done, true, memory_order_release);
+    return NULL;
+}
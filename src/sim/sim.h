@@ -8,19 +8,46 @@
 #ifndef SIM_H
 #define SIM_H
 
+#include "UI/ui.h"
+#include "core/design.h"
+#include "core/ensemble.h"
 #include "core/physics.h"
+#include "governor.h"
+#include "latency.h"
+#include "perfcount.h"
+#include "preview.h"
+#include "renderer/graph.h"
+#include "renderer/phase.h"
 #include "renderer/renderer.h"
+#include "telemetry/telemetry.h"
+#include "timeline.h"
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 
+#define SIM_MAX_INSTANCES 16 // Simulations stepped per batch (and shown at most in compare mode)
+
 typedef enum Dialog
 {
     NONE,
     PAUSE,
     SETTINGS,
     EDIT_PARAMS,
-    CHANGE_THEME
+    CHANGE_THEME,
+    DESIGN
 } Dialog;
 
+// An inverse design solve running off the frame thread; the frame loop applies its parameters once it finishes
+typedef struct DesignWork
+{
+    bool running;                // Worker started and not yet joined
+    pthread_t worker;            // The worker
+    SpringMassSystemState state; // Copy of the system being solved (k, c, m and e are written into it)
+    DesignTarget target;         // Targets of the solve
+    DesignResult result;         // Outcome, valid once `done` is set
+    atomic_bool done;            // The worker has finished
+} DesignWork;
+
 // Overall simulation state
 typedef struct SimState
 {
@@ -29,21 +56,66 @@ typedef struct SimState
 
     bool isRunning; // Simulation is currently running
 
-    float pausedTime; // Time when paused (used to freeze graph)
+    SimTime pausedTime; // Time when paused (used to freeze graph)
+
+    Dialog dialog;                  // Current active dialog
+    ThemeDialogState themeDialog;   // Preset list and custom picker of the theme dialog
+    DesignDialogState designDialog; // Targets of the design dialog
+
+    bool isDragging;        // Mass is currently being dragged
+    float dragGrabOffsetX;  // Horizontal offset from grab point during drag
+    LatchMode latchMode;    // How the dragged mass follows the cursor (cycled with L)
+    LatencyTracker latency; // Cursor-sample-to-swap latency of frames drawn while dragging
+
+    SpringMassTangent tangent; // Sensitivities of the trajectory to k, c, m and the start position
+    SensParam sensitivity;     // Sensitivity drawn on the graph (SENS_PARAMS: none, cycled with S)
+
+    DesignResult design;   // Last inverse design solve
+    bool designSolved;     // `design` holds a result
+    DesignWork designWork; // Solve in progress (the dialog shows it as running)
+
+    Welford noiseStats; // Displacement statistics since noise was switched on or a parameter changed
+    Welford noiseShown; // `noiseStats` as last drawn (refreshed every quality.overlayEvery frames)
+
+    FrameGovernor governor;  // Frame-budget governor of the windowed loop
+    QualitySettings quality; // Detail the graph, phase plot, spring, overlays and stepping run at
+    unsigned long frame;     // Frames drawn (paces the overlay refreshes)
+    char latencyText[128];   // Drag latency overlay as last formatted
+
+    Preview preview;   // Background forecast after a parameter change, drawn as a ghost on the graph
+    SimReal frameStep; // Physics step of the last frame (the forecast steps the same way)
+    int frameSubsteps; // Physics steps in the last frame (0: nothing stepped yet)
+
+    Timeline timeline;   // Keyframes and journal of the session, for rewinding (main window only)
+    bool scrubbing;      // Paused on a past instant picked on the timeline
+    TimelinePoint scrub; // That instant, rebuilt
 
-    Dialog dialog; // Current active dialog
+    GraphState graph;   // Displacement vs. time history and view
+    PhasePlot phase;    // Velocity vs. displacement heatmap
+    SimReal phaseOmega; // Natural frequency the phase plot axes were fitted to
+    RenderTile tile;    // Where this simulation's scene sits in the window
 
-    bool isDragging;       // Mass is currently being dragged
-    float dragGrabOffsetX; // Horizontal offset from grab point during drag
+    TelemetryWriter telemetry; // Shared-memory ring for external consumers (disabled if ring is NULL)
 } SimState;
 
 // Simulation Function declarations
 void InitSim(SimState *simulation, int windowWidth, int windowHeight, const char *title,
              int FPS);                               // Initialize simulation state
-void UpdateSim(SimState *sim, float dt, float time); // Update simulation state based on elapsed time
-void DrawSim(SimState *sim, float dt, float time);   // Draw current state of simulation
-float CurrentFrameTime(void);                        // Get time taken to render current frame
-bool SimRunning(const SimState *sim);                // Check if simulation is running
-void StopSim(void);                                  // Stop the simulation
+void InitSimInstance(SimState *sim);                   // Initialize one simulation in an already open window
+void UpdateSim(SimState *sim, float dt, SimTime time); // Update simulation state based on elapsed time
+void UpdateSimBatch(SimState *sims, int count, float dt,
+                    SimTime time);                     // Step several simulations in one batched pass
+void DrawSim(SimState *sim, float dt, SimTime time);   // Draw current state of simulation
+void SimLateLatch(SimState *sim);                      // Re-sample the cursor for a dragged mass just before drawing
+void SimCycleSensitivity(SimState *sim);               // Show the next sensitivity channel (or none)
+void SimApplyQuality(SimState *sim, const QualitySettings *quality); // Switch to another detail level
+void SimGovernFrame(FrameGovernor *governor, SimState *sims, int count, float dt,
+                    SimTime time);                     // Just before presenting: feed the governor, apply its level
+float CurrentFrameTime(void);                          // Get time taken to render current frame
+bool SimRunning(const SimState *sim);                  // Check if simulation is running
+void StopSim(SimState *sim);                           // Stop the simulation
+void CloseSimInstance(SimState *sim);                  // Release one simulation's graph and plot
+void SimRequestForecast(SimState *sim, SimTime time);  // Forecast from the current state in the background
+void SimShowForecast(SimState *sim);                   // Hand the newest finished forecast to the graph
 
 #endif
\ No newline at end of file
@@ -0,0 +1,565 @@
+/*****************************************************************************
+ * @file snapshot.c                                                          *
+ * @brief Implementation of full-state snapshot/restore for the Spring-Mass. *
+ * @author Gabe G.                                                           *
+ * @date 10-19-2026                                                          *
+ *****************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "snapshot.h"
+#include "UI/ui.h"
+#include "renderer/graph.h"
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// File layout: SnapshotHeader, then `sectionCount` sections of
+// { SnapshotSection, payload padded to 8 bytes }. Unknown section tags are
+// skipped on restore, so new sections can be added without a version bump.
+static const char SNAPSHOT_MAGIC[8] = "SMSNAP";
+
+typedef enum SnapshotTag
+{
+    SECTION_SIM = 1,      // SnapshotSim
+    SECTION_RENDER,       // SnapshotRender
+    SECTION_THEME_DIALOG, // ThemeDialogState
+    SECTION_GRAPH,        // SnapshotGraph followed by `count` Vec2D samples (0 once SECTION_HISTORY is written)
+    SECTION_FORCE_LAW,    // SnapshotForceLaw
+    SECTION_NOISE,        // SnapshotNoise
+    SECTION_HISTORY       // Graph history image: every compressed sample block and pyramid page (after SECTION_GRAPH)
+} SnapshotTag;
+
+typedef struct SnapshotHeader
+{
+    char magic[8];         // SNAPSHOT_MAGIC
+    uint32_t version;      // SNAPSHOT_VERSION
+    uint32_t sectionCount; // Number of sections that follow
+    uint32_t realSize;     // sizeof(SimReal) the snapshot was written with
+    uint32_t timeSize;     // sizeof(SimTime) the snapshot was written with
+    uint64_t payloadSize;  // Bytes after the header
+    uint64_t checksum;     // FNV-1a of the payload
+} SnapshotHeader;
+
+typedef struct SnapshotSection
+{
+    uint32_t tag;  // SnapshotTag
+    uint32_t size; // Payload size (excluding padding)
+} SnapshotSection;
+
+// Physical state and timing
+typedef struct SnapshotSim
+{
+    SimReal x;
+    SimReal velocity;
+    SimReal springConst;
+    SimReal mass;
+    SimReal damping;
+    SimReal equilibrium;
+    SimReal restitution;
+    SimReal xMin;
+    SimReal xMax;
+    SimClock clock;
+    SimTime pausedTime;
+    int32_t dialog;
+} SnapshotSim;
+
+// Force law and its parameters (a loaded measured table is not stored; it comes from the command line)
+typedef struct SnapshotForceLaw
+{
+    int32_t law;
+    SimReal cubicConst;
+    SimReal stopGap;
+    SimReal stopConst;
+    SimReal staticFriction;
+    SimReal kineticFriction;
+    SimReal dragCoeff;
+} SnapshotForceLaw;
+
+// Stochastic forcing, with the generator's position so a restored run continues the same noise
+typedef struct SnapshotNoise
+{
+    SimReal intensity;
+    SimReal tau;
+    SimReal force;
+    uint64_t seed;
+    uint64_t stream;
+    uint64_t step;
+} SnapshotNoise;
+
+// Render state worth keeping across sessions
+typedef struct SnapshotRender
+{
+    SimColor themeColor;
+    SimColor massColor;
+    float fadeElapsed; // Startup text fade-out progress
+} SnapshotRender;
+
+typedef struct SnapshotGraph
+{
+    float minDisplacement;
+    float maxDisplacement;
+    float maxTime;
+    int32_t count;
+} SnapshotGraph;
+
+// Growable byte buffer
+typedef struct SnapshotBuffer
+{
+    unsigned char *data;
+    size_t size;
+    size_t capacity;
+    uint32_t sections; // Sections appended since the header
+} SnapshotBuffer;
+
+// A capture handed from the frame thread to the writer: the small sections already serialized, and the graph
+// history frozen for the writer to serialize (with the checksum) off the frame thread
+typedef struct SnapshotCapture
+{
+    SnapshotBuffer buffer;
+    History history; // Frozen graph history (valid while `hasHistory`)
+    bool hasHistory;
+} SnapshotCapture;
+
+// Background writer shared between the frame thread and the writer thread
+static struct
+{
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    char *path;
+    SnapshotCapture pending; // Latest capture not yet written (guarded by lock)
+    bool hasPending;
+    bool stop;
+    bool running;
+} writer = { .lock = PTHREAD_MUTEX_INITIALIZER, .wake = PTHREAD_COND_INITIALIZER };
+
+static SnapshotCapture capture;      // Frame-thread scratch capture, swapped into `writer.pending`
+static float sinceCheckpoint = 0.0f; // Wall time since the last periodic checkpoint
+
+/**********************************
+ *      Forward Declarations      *
+ **********************************/
+
+static void BufferReserve(SnapshotBuffer *buffer, size_t size); // Grow buffer to at least `size` bytes
+static unsigned char *BufferBeginSection(SnapshotBuffer *buffer, SnapshotTag tag,
+                                         size_t size); // Append a zeroed section and return its payload
+static void BufferAppendSection(SnapshotBuffer *buffer, SnapshotTag tag, const void *first, size_t firstSize,
+                                const void *second, size_t secondSize); // Append a section (payload in two parts)
+static uint64_t Checksum(const unsigned char *data, size_t size);       // FNV-1a
+static void Capture(SimState *sim, const SimClock *clock);              // Copy full state into `capture`
+static void Finish(SnapshotCapture *capture);                           // Serialize the history, then the header
+static void ReleaseHistory(SnapshotCapture *capture);                   // Drop a frozen history not yet saved
+static bool WriteFile(const char *path, const SnapshotBuffer *buffer);  // Write atomically via temp file + rename
+static void *WriterThread(void *arg);                                   // Write pending captures off-thread
+
+/***********************************
+ *      External API Functions     *
+ ***********************************/
+
+void SnapshotInit(const char *path)
+{
+    writer.path = strdup(path);
+    writer.stop = false;
+    writer.hasPending = false;
+    writer.running = pthread_create(&writer.thread, NULL, WriterThread, NULL) == 0;
+    sinceCheckpoint = 0.0f;
+}
+
+bool SnapshotRestore(SimState *sim, SimClock *clock)
+{
+    int fd = open(writer.path, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(SnapshotHeader))
+    {
+        close(fd);
+        return false;
+    }
+
+    // Mapped so the checksum and the section copies read the file without an intermediate buffer
+    size_t fileSize = (size_t)st.st_size;
+    const unsigned char *file = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (file == MAP_FAILED)
+        return false;
+
+    const SnapshotHeader *header = (const SnapshotHeader *)file;
+    const unsigned char *payload = file + sizeof(SnapshotHeader);
+    size_t payloadSize = fileSize - sizeof(SnapshotHeader);
+    if (memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 || header->version != SNAPSHOT_VERSION ||
+        header->realSize != sizeof(SimReal) || header->timeSize != sizeof(SimTime) ||
+        header->payloadSize != payloadSize || header->checksum != Checksum(payload, payloadSize))
+    {
+        munmap((void *)file, fileSize);
+        return false;
+    }
+
+    bool restored = false;
+    size_t offset = 0;
+    for (uint32_t i = 0; i < header->sectionCount && offset + sizeof(SnapshotSection) <= payloadSize; i++)
+    {
+        const SnapshotSection *section = (const SnapshotSection *)(payload + offset);
+        const unsigned char *data = payload + offset + sizeof(SnapshotSection);
+        offset += sizeof(SnapshotSection) + (((size_t)section->size + 7u) & ~(size_t)7u);
+        if (offset > payloadSize)
+            break; // Truncated section
+
+        switch (section->tag)
+        {
+            case SECTION_SIM:
+                if (section->size == sizeof(SnapshotSim))
+                {
+                    const SnapshotSim *s = (const SnapshotSim *)data;
+                    SpringMassSystemState *state = &sim->systemState;
+                    state->x = s->x;
+                    state->velocity = s->velocity;
+                    state->springConst = s->springConst;
+                    state->mass = s->mass;
+                    state->damping = s->damping;
+                    state->equilibrium = s->equilibrium;
+                    state->restitution = s->restitution;
+                    state->xMin = s->xMin;
+                    state->xMax = s->xMax;
+                    SpringmassSelectKernel(state); // Kernel pointers aren't persisted
+                    sim->renderState.massRectangle.x = state->x;
+                    *clock = s->clock;
+                    sim->pausedTime = s->pausedTime;
+                    sim->dialog = (Dialog)s->dialog;
+                    restored = true;
+                }
+                break;
+            case SECTION_FORCE_LAW:
+                if (section->size == sizeof(SnapshotForceLaw))
+                {
+                    const SnapshotForceLaw *f = (const SnapshotForceLaw *)data;
+                    SpringMassSystemState *state = &sim->systemState;
+                    state->law = (ForceLaw)f->law;
+                    state->cubicConst = f->cubicConst;
+                    state->stopGap = f->stopGap;
+                    state->stopConst = f->stopConst;
+                    state->staticFriction = f->staticFriction;
+                    state->kineticFriction = f->kineticFriction;
+                    state->dragCoeff = f->dragCoeff;
+                    SpringmassSelectKernel(state); // Also rejects an out-of-range law
+                }
+                break;
+            case SECTION_NOISE:
+                if (section->size == sizeof(SnapshotNoise))
+                {
+                    const SnapshotNoise *n = (const SnapshotNoise *)data;
+                    SpringMassSystemState *state = &sim->systemState;
+                    SpringmassSetNoise(state, n->intensity, n->tau, n->seed, n->stream);
+                    state->noiseStep = n->step;
+                    state->noiseForce = n->force;
+                }
+                break;
+            case SECTION_RENDER:
+                if (section->size == sizeof(SnapshotRender))
+                {
+                    const SnapshotRender *r = (const SnapshotRender *)data;
+                    sim->renderState.themeColor = r->themeColor;
+                    sim->renderState.massColor = r->massColor;
+                    sim->renderState.elapsedTime = r->fadeElapsed;
+                }
+                break;
+            case SECTION_THEME_DIALOG:
+                if (section->size == sizeof(ThemeDialogState))
+                    memcpy(&sim->themeDialog, data, sizeof(ThemeDialogState));
+                break;
+            case SECTION_GRAPH:
+                if (section->size >= sizeof(SnapshotGraph))
+                {
+                    const SnapshotGraph *g = (const SnapshotGraph *)data;
+                    if (g->count >= 0 && section->size == sizeof(SnapshotGraph) + g->count * sizeof(Vec2D))
+                    {
+                        GraphHistory history = { (const Vec2D *)(g + 1), g->count, g->minDisplacement,
+                                                 g->maxDisplacement, g->maxTime };
+                        GraphRestoreHistory(&sim->graph, &history);
+                    }
+                }
+                break;
+            case SECTION_HISTORY:
+                // Copied as saved, without re-encoding samples or rebuilding the pyramid
+                if (!GraphLoadHistoryImage(&sim->graph, data, section->size))
+                    fprintf(stderr, "snapshot: graph history image is invalid; starting the graph empty\n");
+                break;
+            default:
+                break; // Section from a newer build; ignore
+        }
+    }
+
+    munmap((void *)file, fileSize);
+    return restored;
+}
+
+void SnapshotTick(SimState *sim, const SimClock *clock, float dt)
+{
+    sinceCheckpoint += dt;
+    if (sinceCheckpoint >= SNAPSHOT_INTERVAL)
+    {
+        sinceCheckpoint = 0.0f;
+        SnapshotRequest(sim, clock);
+    }
+}
+
+void SnapshotRequest(SimState *sim, const SimClock *clock)
+{
+    if (!writer.running)
+        return;
+
+    Capture(sim, clock); // Only small copies on the frame thread; the writer serializes the history
+
+    // Hand the capture to the writer; an older unwritten capture is simply replaced
+    pthread_mutex_lock(&writer.lock);
+    SnapshotCapture swap = writer.pending;
+    writer.pending = capture;
+    capture = swap;
+    writer.hasPending = true;
+    pthread_cond_signal(&writer.wake);
+    pthread_mutex_unlock(&writer.lock);
+}
+
+void SnapshotShutdown(void)
+{
+    if (writer.running)
+    {
+        pthread_mutex_lock(&writer.lock);
+        writer.stop = true;
+        pthread_cond_signal(&writer.wake);
+        pthread_mutex_unlock(&writer.lock);
+        pthread_join(writer.thread, NULL); // Writer drains the pending capture before exiting
+        writer.running = false;
+    }
+    ReleaseHistory(&writer.pending);
+    ReleaseHistory(&capture);
+    free(writer.pending.buffer.data);
+    free(capture.buffer.data);
+    free(writer.path);
+    writer.pending = (SnapshotCapture){ 0 };
+    capture = (SnapshotCapture){ 0 };
+    writer.path = NULL;
+}
+
+/***************************************
+ *      Internal helper functions      *
+ ***************************************/
+
+static void BufferReserve(SnapshotBuffer *buffer, size_t size)
+{
+    if (size <= buffer->capacity)
+        return;
+    size_t capacity = buffer->capacity ? buffer->capacity : 4096;
+    while (capacity < size)
+        capacity *= 2;
+    unsigned char *data = realloc(buffer->data, capacity);
+    if (!data)
+        abort();
+    buffer->data = data;
+    buffer->capacity = capacity;
+}
+
+static unsigned char *BufferBeginSection(SnapshotBuffer *buffer, SnapshotTag tag, size_t size)
+{
+    size_t padded = (size + 7u) & ~(size_t)7u;
+    BufferReserve(buffer, buffer->size + sizeof(SnapshotSection) + padded);
+
+    SnapshotSection section = { (uint32_t)tag, (uint32_t)size };
+    unsigned char *out = buffer->data + buffer->size;
+    memcpy(out, &section, sizeof(section));
+    out += sizeof(section);
+    memset(out, 0, padded);
+    buffer->size += sizeof(SnapshotSection) + padded;
+    buffer->sections++;
+    return out;
+}
+
+static void BufferAppendSection(SnapshotBuffer *buffer, SnapshotTag tag, const void *first, size_t firstSize,
+                                const void *second, size_t secondSize)
+{
+    unsigned char *out = BufferBeginSection(buffer, tag, firstSize + secondSize);
+    memcpy(out, first, firstSize);
+    if (secondSize)
+        memcpy(out + firstSize, second, secondSize);
+}
+
+static uint64_t Checksum(const unsigned char *data, size_t size)
+{
+    uint64_t hash = 1469598103934665603ull;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static void Capture(SimState *sim, const SimClock *clock)
+{
+    ReleaseHistory(&capture); // A replaced capture the writer never took
+    capture.buffer.size = sizeof(SnapshotHeader);
+    capture.buffer.sections = 0;
+    BufferReserve(&capture.buffer, capture.buffer.size);
+
+    const SpringMassSystemState *state = &sim->systemState;
+    SnapshotSim s;
+    memset(&s, 0, sizeof(s)); // Zero padding so identical states produce identical files
+    s.x = state->x;
+    s.velocity = state->velocity;
+    s.springConst = state->springConst;
+    s.mass = state->mass;
+    s.damping = state->damping;
+    s.equilibrium = state->equilibrium;
+    s.restitution = state->restitution;
+    s.xMin = state->xMin;
+    s.xMax = state->xMax;
+    s.clock = *clock;
+    s.pausedTime = sim->pausedTime;
+    s.dialog = sim->dialog;
+    BufferAppendSection(&capture.buffer, SECTION_SIM, &s, sizeof(s), NULL, 0);
+
+    SnapshotForceLaw f;
+    memset(&f, 0, sizeof(f));
+    f.law = state->law;
+    f.cubicConst = state->cubicConst;
+    f.stopGap = state->stopGap;
+    f.stopConst = state->stopConst;
+    f.staticFriction = state->staticFriction;
+    f.kineticFriction = state->kineticFriction;
+    f.dragCoeff = state->dragCoeff;
+    BufferAppendSection(&capture.buffer, SECTION_FORCE_LAW, &f, sizeof(f), NULL, 0);
+
+    SnapshotNoise n;
+    memset(&n, 0, sizeof(n));
+    n.intensity = state->noiseIntensity;
+    n.tau = state->noiseTau;
+    n.force = state->noiseForce;
+    n.seed = state->noiseSeed;
+    n.stream = state->noiseStream;
+    n.step = state->noiseStep;
+    BufferAppendSection(&capture.buffer, SECTION_NOISE, &n, sizeof(n), NULL, 0);
+
+    SnapshotRender r;
+    memset(&r, 0, sizeof(r));
+    r.themeColor = sim->renderState.themeColor;
+    r.massColor = sim->renderState.massColor;
+    r.fadeElapsed = sim->renderState.elapsedTime;
+    BufferAppendSection(&capture.buffer, SECTION_RENDER, &r, sizeof(r), NULL, 0);
+
+    BufferAppendSection(&capture.buffer, SECTION_THEME_DIALOG, &sim->themeDialog, sizeof(sim->themeDialog), NULL, 0);
+
+    GraphHistory history;
+    GraphGetHistory(&sim->graph, &history);
+    SnapshotGraph g = { history.minDisplacement, history.maxDisplacement, history.maxTime, history.count };
+    BufferAppendSection(&capture.buffer, SECTION_GRAPH, &g, sizeof(g), history.points, history.count * sizeof(Vec2D));
+
+    // The whole session's graph: only page tables and partial pages are copied here, Finish serializes it
+    capture.hasHistory = GraphFreezeHistory(&sim->graph, &capture.history);
+}
+
+static void Finish(SnapshotCapture *capture)
+{
+    // The whole session's graph, stored as it sits in memory; dropped if a spilled page can't be read back
+    SnapshotBuffer *buffer = &capture->buffer;
+    if (capture->hasHistory)
+    {
+        size_t before = buffer->size;
+        uint32_t sections = buffer->sections;
+        size_t imageSize = HistoryImageSize(&capture->history);
+        if (imageSize > UINT32_MAX ||
+            !HistorySaveImage(&capture->history, BufferBeginSection(buffer, SECTION_HISTORY, imageSize)))
+        {
+            buffer->size = before;
+            buffer->sections = sections;
+        }
+        ReleaseHistory(capture);
+    }
+
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.sectionCount = buffer->sections;
+    header.realSize = sizeof(SimReal);
+    header.timeSize = sizeof(SimTime);
+    header.payloadSize = buffer->size - sizeof(SnapshotHeader);
+    header.checksum = Checksum(buffer->data + sizeof(SnapshotHeader), header.payloadSize);
+    memcpy(buffer->data, &header, sizeof(header));
+}
+
+static void ReleaseHistory(SnapshotCapture *capture)
+{
+    if (capture->hasHistory)
+        HistoryReleaseFrozen(&capture->history);
+    capture->hasHistory = false;
+}
+
+static bool WriteFile(const char *path, const SnapshotBuffer *buffer)
+{
+    size_t pathLength = strlen(path);
+    char *tmpPath = malloc(pathLength + 5);
+    if (!tmpPath)
+        return false;
+    memcpy(tmpPath, path, pathLength);
+    memcpy(tmpPath + pathLength, ".tmp", 5);
+
+    bool ok = false;
+    int fd = open(tmpPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0)
+    {
+        size_t written = 0;
+        while (written < buffer->size)
+        {
+            ssize_t n = write(fd, buffer->data + written, buffer->size - written);
+            if (n <= 0)
+                break;
+            written += (size_t)n;
+        }
+        ok = written == buffer->size && fsync(fd) == 0;
+        close(fd);
+        // Rename is atomic, so a crash mid-write leaves the previous checkpoint intact
+        ok = ok && rename(tmpPath, path) == 0;
+        if (!ok)
+            unlink(tmpPath);
+    }
+    free(tmpPath);
+    return ok;
+}
+
+static void *WriterThread(void *arg)
+{
+    (void)arg;
+    SnapshotCapture writing = { 0 };
+
+    pthread_mutex_lock(&writer.lock);
+    for (;;)
+    {
+        while (!writer.hasPending && !writer.stop)
+            pthread_cond_wait(&writer.wake, &writer.lock);
+        if (!writer.hasPending)
+            break; // Stopping with nothing left to write
+
+        SnapshotCapture swap = writing;
+        writing = writer.pending;
+        writer.pending = swap;
+        writer.hasPending = false;
+
+        pthread_mutex_unlock(&writer.lock);
+        Finish(&writing);
+        if (!WriteFile(writer.path, &writing.buffer))
+            fprintf(stderr, "snapshot: failed to write %s\n", writer.path);
+        pthread_mutex_lock(&writer.lock);
+    }
+    pthread_mutex_unlock(&writer.lock);
+
+    ReleaseHistory(&writing);
+    free(writing.buffer.data);
+    return NULL;
+}
@@ -0,0 +1,28 @@
+/******************************************************************
+ * @file snapshot.h                                               *
+ * @brief Full-state snapshot/restore for the Spring-Mass System. *
+ * @author Gabe G.                                                *
+ * @date 10-19-2026                                               *
+ ******************************************************************/
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "core/precision.h"
+#include "sim.h"
+#include <stdbool.h>
+
+#define SNAPSHOT_PATH "springmass.snap" // Default snapshot file (written next to the executable's cwd)
+#define SNAPSHOT_INTERVAL 30.0f          // Seconds of wall time between periodic checkpoints
+#define SNAPSHOT_VERSION 2               // Bump when a section layout changes
+
+// Snapshot Function declarations
+void SnapshotInit(const char *path); // Start the background writer for `path`
+bool SnapshotRestore(SimState *sim,
+                     SimClock *clock); // Load `path` if present and valid (returns true if state was restored)
+void SnapshotTick(SimState *sim, const SimClock *clock,
+                  float dt);                                     // Request a checkpoint once SNAPSHOT_INTERVAL elapses
+void SnapshotRequest(SimState *sim, const SimClock *clock);      // Capture state now and write it in the background
+void SnapshotShutdown(void); // Flush any pending checkpoint and stop the writer
+
+#endif
@@ -0,0 +1,360 @@
+/**************************************************
+ * @file timeline.c                               *
+ * @brief Implementation of the session timeline. *
+ * @author Gabe G.                                *
+ * @date 10-19-2026                               *
+ **************************************************/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "timeline.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define TIMELINE_KEY_SHARE 0.25 // Estimated replay between keyframes, as a share of the frame budget (half of the
+                                // half a seek may take, leaving the rest for estimation error)
+#define TIMELINE_CALIBRATE 32   // Frames replayed to measure a stepping path's cost
+#define TIMELINE_HELD_COST 2e-8 // Seconds a frame without steps costs to replay
+
+/**********************************
+ *      Forward Declarations      *
+ **********************************/
+
+static void ParamsOf(const SpringMassSystemState *state, TimelineParams *params); // Copy out the edited fields
+static void ApplyParams(SpringMassSystemState *state, const TimelineParams *params); // Copy them back in
+static void AddEvent(Timeline *timeline, const SpringMassSystemState *state, bool paramsChanged); // Journal an edit
+static void AddKey(Timeline *timeline, unsigned long long frame, double time,
+                   const SpringMassSystemState *state); // Store a keyframe, thinning old ones when full
+static void StepFrame(SpringMassSystemState *state, float dt, int substeps, TimelineMode mode); // Replay one frame
+static double FrameCost(Timeline *timeline, const SpringMassSystemState *state, float dt, int substeps,
+                        TimelineMode mode);            // Estimated seconds to replay a frame
+static unsigned long long FirstEventAfter(const Timeline *timeline,
+                                          unsigned long long frame); // Journal index of the first later edit
+static double TimelineNow(void);                                      // CPU time of the calling thread in seconds
+
+/***********************************
+ *      External API Functions     *
+ ***********************************/
+
+void TimelineInit(Timeline *timeline)
+{
+    memset(timeline, 0, sizeof(*timeline));
+}
+
+bool TimelineOpen(Timeline *timeline, double budget)
+{
+    TimelineClose(timeline);
+    timeline->dt = malloc(TIMELINE_FRAMES * sizeof(float));
+    timeline->info = malloc(TIMELINE_FRAMES * sizeof(uint16_t));
+    timeline->events = malloc(TIMELINE_EVENTS * sizeof(TimelineEvent));
+    timeline->params = malloc(TIMELINE_PARAMS * sizeof(TimelineParamSet));
+    timeline->keys = malloc(TIMELINE_KEYS * sizeof(TimelineKey));
+    if (timeline->dt == NULL || timeline->info == NULL || timeline->events == NULL || timeline->params == NULL ||
+        timeline->keys == NULL)
+    {
+        TimelineClose(timeline);
+        return false;
+    }
+    timeline->budget = budget;
+    return true;
+}
+
+void TimelineClose(Timeline *timeline)
+{
+    free(timeline->dt);
+    free(timeline->info);
+    free(timeline->events);
+    free(timeline->params);
+    free(timeline->keys);
+    TimelineInit(timeline);
+}
+
+void TimelineBeginFrame(Timeline *timeline, const SpringMassSystemState *state)
+{
+    if (timeline->dt == NULL)
+        return;
+    TimelineParams params;
+    ParamsOf(state, &params);
+    if (!timeline->started)
+    {
+        timeline->started = true;
+        timeline->expected = *state;
+        timeline->expectedParams = params;
+        return;
+    }
+
+    // Anything that moved the mass or changed a parameter since the last frame (a drag, a slider, a dialog, a
+    // rewind) is journaled at the end of that frame, where the display showed it
+    const SpringMassSystemState *expected = &timeline->expected;
+    bool moved = state->x != expected->x || state->velocity != expected->velocity ||
+                 state->noiseForce != expected->noiseForce || state->noiseStep != expected->noiseStep;
+    bool changed = memcmp(&params, &timeline->expectedParams, sizeof(params)) != 0;
+    if (moved || changed)
+    {
+        AddEvent(timeline, state, changed);
+        timeline->expected = *state;
+        timeline->expectedParams = params;
+    }
+    if (timeline->keyCost >= timeline->budget * TIMELINE_KEY_SHARE)
+    {
+        AddKey(timeline, timeline->frames, timeline->lastTime, state);
+        timeline->keyCost = 0;
+    }
+}
+
+void TimelineEndFrame(Timeline *timeline, const SpringMassSystemState *state, float dt, int substeps,
+                      TimelineMode mode, double time)
+{
+    if (timeline->dt == NULL || !timeline->started)
+        return;
+    if (timeline->keyCount == 0)
+        AddKey(timeline, 0, time - dt, &timeline->expected); // The state the first frame started from
+
+    unsigned long long frame = ++timeline->frames;
+    if (frame > TIMELINE_FRAMES && timeline->oldest < frame - TIMELINE_FRAMES)
+        timeline->oldest = frame - TIMELINE_FRAMES; // Frames up to that one are overwritten
+    timeline->dt[frame % TIMELINE_FRAMES] = dt;
+    timeline->info[frame % TIMELINE_FRAMES] = (uint16_t)((substeps & 0xff) | (mode << 8));
+    timeline->lastTime = time;
+    timeline->keyCost += FrameCost(timeline, state, dt, substeps, mode);
+
+    // A held frame replays as no step at all; where the hand put the mass is an edit the next frame journals
+    if (mode != TIMELINE_HELD)
+        timeline->expected = *state;
+}
+
+bool TimelineSeek(Timeline *timeline, double time, TimelinePoint *point)
+{
+    if (timeline->keyCount == 0)
+        return false;
+    double start = TimelineNow();
+
+    // Latest keyframe at or before `time` (the first one if `time` is earlier)
+    int low = 0, high = timeline->keyCount - 1;
+    while (low < high)
+    {
+        int mid = (low + high + 1) / 2;
+        if (timeline->keys[mid].time <= time)
+            low = mid;
+        else
+            high = mid - 1;
+    }
+    const TimelineKey *key = &timeline->keys[low];
+    point->state = timeline->expected;
+    ApplyParams(&point->state, &key->params);
+    point->state.x = key->x;
+    point->state.velocity = key->velocity;
+    point->state.noiseForce = key->noiseForce;
+    point->state.noiseStep = key->noiseStep;
+    SpringmassSelectKernel(&point->state);
+    point->time = key->time;
+    point->frame = key->frame;
+    point->exact = key->frame >= timeline->oldest;
+
+    // Re-simulate the journaled frames and edits up to the last frame that ends by `time`
+    unsigned long long event = FirstEventAfter(timeline, key->frame);
+    for (unsigned long long frame = key->frame + 1; point->exact && frame <= timeline->frames; frame++)
+    {
+        float dt = timeline->dt[frame % TIMELINE_FRAMES];
+        if (point->time + dt > time)
+            break;
+        uint16_t info = timeline->info[frame % TIMELINE_FRAMES];
+        StepFrame(&point->state, dt, info & 0xff, (TimelineMode)(info >> 8));
+        point->time += dt;
+        point->frame = frame;
+        for (; event < timeline->eventCount && timeline->events[event % TIMELINE_EVENTS].frame == frame; event++)
+        {
+            const TimelineEvent *edit = &timeline->events[event % TIMELINE_EVENTS];
+            if (edit->params >= 0)
+            {
+                ApplyParams(&point->state, &timeline->params[edit->params % TIMELINE_PARAMS].params);
+                SpringmassSelectKernel(&point->state);
+            }
+            point->state.x = edit->x;
+            point->state.velocity = edit->velocity;
+            point->state.noiseForce = edit->noiseForce;
+            point->state.noiseStep = edit->noiseStep;
+        }
+    }
+    timeline->lastSeek = TimelineNow() - start;
+    if (timeline->lastSeek > timeline->worstSeek)
+        timeline->worstSeek = timeline->lastSeek;
+    return true;
+}
+
+double TimelineStart(const Timeline *timeline)
+{
+    return timeline->keyCount > 0 ? timeline->keys[0].time : timeline->lastTime;
+}
+
+double TimelineEnd(const Timeline *timeline)
+{
+    return timeline->lastTime;
+}
+
+size_t TimelineMemory(const Timeline *timeline)
+{
+    if (timeline->dt == NULL)
+        return 0;
+    return TIMELINE_FRAMES * (sizeof(float) + sizeof(uint16_t)) + TIMELINE_EVENTS * sizeof(TimelineEvent) +
+           TIMELINE_PARAMS * sizeof(TimelineParamSet) + TIMELINE_KEYS * sizeof(TimelineKey);
+}
+
+/***************************************
+ *      Internal helper functions      *
+ ***************************************/
+
+static void ParamsOf(const SpringMassSystemState *state, TimelineParams *params)
+{
+    memset(params, 0, sizeof(*params)); // Padding too, so parameter sets compare with memcmp
+    params->springConst = state->springConst;
+    params->mass = state->mass;
+    params->damping = state->damping;
+    params->equilibrium = state->equilibrium;
+    params->restitution = state->restitution;
+    params->xMin = state->xMin;
+    params->xMax = state->xMax;
+    params->law = state->law;
+    params->cubicConst = state->cubicConst;
+    params->stopGap = state->stopGap;
+    params->stopConst = state->stopConst;
+    params->staticFriction = state->staticFriction;
+    params->kineticFriction = state->kineticFriction;
+    params->dragCoeff = state->dragCoeff;
+    params->table = state->table;
+    params->noiseIntensity = state->noiseIntensity;
+    params->noiseTau = state->noiseTau;
+    params->noiseSeed = state->noiseSeed;
+    params->noiseStream = state->noiseStream;
+}
+
+static void ApplyParams(SpringMassSystemState *state, const TimelineParams *params)
+{
+    state->springConst = params->springConst;
+    state->mass = params->mass;
+    state->damping = params->damping;
+    state->equilibrium = params->equilibrium;
+    state->restitution = params->restitution;
+    state->xMin = params->xMin;
+    state->xMax = params->xMax;
+    state->law = params->law;
+    state->cubicConst = params->cubicConst;
+    state->stopGap = params->stopGap;
+    state->stopConst = params->stopConst;
+    state->staticFriction = params->staticFriction;
+    state->kineticFriction = params->kineticFriction;
+    state->dragCoeff = params->dragCoeff;
+    state->table = params->table;
+    state->noiseIntensity = params->noiseIntensity;
+    state->noiseTau = params->noiseTau;
+    state->noiseSeed = params->noiseSeed;
+    state->noiseStream = params->noiseStream;
+}
+
+static void AddEvent(Timeline *timeline, const SpringMassSystemState *state, bool paramsChanged)
+{
+    long long params = -1;
+    if (paramsChanged)
+    {
+        TimelineParamSet *set = &timeline->params[timeline->paramCount % TIMELINE_PARAMS];
+        if (timeline->paramCount >= TIMELINE_PARAMS && timeline->oldest < set->frame)
+            timeline->oldest = set->frame; // Replay from before this set would miss it
+        set->frame = timeline->frames;
+        ParamsOf(state, &set->params);
+        params = (long long)timeline->paramCount++;
+    }
+    TimelineEvent *event = &timeline->events[timeline->eventCount % TIMELINE_EVENTS];
+    if (timeline->eventCount >= TIMELINE_EVENTS && timeline->oldest < event->frame)
+        timeline->oldest = event->frame;
+    *event = (TimelineEvent){ timeline->frames, state->x, state->velocity,
+                              state->noiseForce, state->noiseStep, params };
+    timeline->eventCount++;
+}
+
+static void AddKey(Timeline *timeline, unsigned long long frame, double time, const SpringMassSystemState *state)
+{
+    // Full: drop every other keyframe the journal no longer reaches (they only snap), or else of the older half, so
+    // the whole session stays covered, ever more sparsely towards its start, in fixed memory
+    if (timeline->keyCount == TIMELINE_KEYS)
+    {
+        int stale = 0;
+        while (stale < timeline->keyCount && timeline->keys[stale].frame < timeline->oldest)
+            stale++;
+        int limit = stale > 2 ? stale : TIMELINE_KEYS / 2;
+        int kept = 1;
+        for (int k = 1; k < timeline->keyCount; k++)
+            if (k >= limit || k % 2 == 0)
+                timeline->keys[kept++] = timeline->keys[k];
+        timeline->keyCount = kept;
+    }
+    TimelineKey *key = &timeline->keys[timeline->keyCount++];
+    key->frame = frame;
+    key->time = time;
+    key->x = state->x;
+    key->velocity = state->velocity;
+    key->noiseForce = state->noiseForce;
+    key->noiseStep = state->noiseStep;
+    ParamsOf(state, &key->params);
+}
+
+static void StepFrame(SpringMassSystemState *state, float dt, int substeps, TimelineMode mode)
+{
+    // The frame loop's own calls with its own step, so the replay is bit-exact
+    SimReal h = dt / substeps;
+    if (mode == TIMELINE_STEP)
+        SpringmassAdvanceBatch(&state, 1, h, substeps);
+    else if (mode == TIMELINE_TANGENT)
+    {
+        SpringMassTangent tangent; // The state does not depend on the tangent it carries
+        SpringmassTangentInit(&tangent);
+        SpringmassAdvanceTangent(state, &tangent, h, substeps);
+    }
+}
+
+static double FrameCost(Timeline *timeline, const SpringMassSystemState *state, float dt, int substeps,
+                        TimelineMode mode)
+{
+    if (mode == TIMELINE_HELD || substeps <= 0)
+        return TIMELINE_HELD_COST;
+
+    // Kernels differ by more than an order of magnitude (noise draws, sensitivities), so each path is timed the
+    // first time it is seen, on a copy of the state
+    bool tangent = mode == TIMELINE_TANGENT;
+    for (int i = 0; i < timeline->costCount; i++)
+        if (timeline->costs[i].kernel == state->kernel && timeline->costs[i].tangent == tangent)
+            return timeline->costs[i].perStep * substeps + TIMELINE_HELD_COST;
+    SpringMassSystemState copy = *state;
+    double start = TimelineNow();
+    for (int i = 0; i < TIMELINE_CALIBRATE; i++)
+        StepFrame(&copy, dt, substeps, mode);
+    double perStep = (TimelineNow() - start) / (TIMELINE_CALIBRATE * substeps);
+    if (timeline->costCount < TIMELINE_KERNELS)
+        timeline->costs[timeline->costCount++] = (TimelineCost){ state->kernel, tangent, perStep };
+    return perStep * substeps + TIMELINE_HELD_COST;
+}
+
+static unsigned long long FirstEventAfter(const Timeline *timeline, unsigned long long frame)
+{
+    // Edits are journaled in frame order; search the ones still in the ring
+    unsigned long long low = timeline->eventCount > TIMELINE_EVENTS ? timeline->eventCount - TIMELINE_EVENTS : 0;
+    unsigned long long high = timeline->eventCount;
+    while (low < high)
+    {
+        unsigned long long mid = low + (high - low) / 2;
+        if (timeline->events[mid % TIMELINE_EVENTS].frame <= frame)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low;
+}
+
+static double TimelineNow(void)
+{
+    // CPU time rather than wall time: a seek preempted on a busy machine has not replayed any longer, and a
+    // calibration that was preempted would space keyframes too widely
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
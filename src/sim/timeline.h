@@ -0,0 +1,141 @@
+/*****************************************************************************************************************
+ * @file timeline.h                                                                                              *
+ * @brief Session timeline: keyframes and an input journal, so any past instant can be rebuilt by re-simulation. *
+ * @author Gabe G.                                                                                               *
+ * @date 10-19-2026                                                                                              *
+ *****************************************************************************************************************/
+
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include "core/physics.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define TIMELINE_FRAMES (1 << 21) // Frames journaled (4.8 h at 120 Hz); older frames keep only their keyframes
+#define TIMELINE_EVENTS (1 << 16) // Edits journaled (a dragged mass makes one per frame)
+#define TIMELINE_PARAMS (1 << 15) // Parameter sets journaled (a moving slider makes one per frame)
+#define TIMELINE_KEYS 8192        // Keyframes kept; the older half is thinned to every other one when full
+#define TIMELINE_KERNELS 32       // Step kernels whose replay cost is measured
+
+// How a frame moved the mass
+typedef enum TimelineMode
+{
+    TIMELINE_STEP,    // Stepped with the selected kernel
+    TIMELINE_TANGENT, // Stepped with the sensitivities alongside
+    TIMELINE_HELD     // Not stepped (the mass was being dragged)
+} TimelineMode;
+
+// Everything about a system that only changes when edited
+typedef struct TimelineParams
+{
+    SimReal springConst;
+    SimReal mass;
+    SimReal damping;
+    SimReal equilibrium;
+    SimReal restitution;
+    SimReal xMin;
+    SimReal xMax;
+    ForceLaw law;
+    SimReal cubicConst;
+    SimReal stopGap;
+    SimReal stopConst;
+    SimReal staticFriction;
+    SimReal kineticFriction;
+    SimReal dragCoeff;
+    const ForceTable *table;
+    SimReal noiseIntensity;
+    SimReal noiseTau;
+    uint64_t noiseSeed;
+    uint64_t noiseStream;
+} TimelineParams;
+
+// A parameter set and the frame it took effect at
+typedef struct TimelineParamSet
+{
+    unsigned long long frame;
+    TimelineParams params;
+} TimelineParamSet;
+
+// An edit between two frames: where the mass was put and, if they changed, the new parameters
+typedef struct TimelineEvent
+{
+    unsigned long long frame; // Frame whose end it happened at
+    SimReal x;
+    SimReal velocity;
+    SimReal noiseForce;
+    uint64_t noiseStep;
+    long long params; // Parameter set switched to (journal index, -1: unchanged)
+} TimelineEvent;
+
+// Compact full state at the end of a frame
+typedef struct TimelineKey
+{
+    unsigned long long frame; // Frame whose end state this is (0: before the first frame)
+    double time;              // Session time at that point
+    SimReal x;
+    SimReal velocity;
+    SimReal noiseForce;
+    uint64_t noiseStep;
+    TimelineParams params;
+} TimelineKey;
+
+// Measured replay cost of one stepping path
+typedef struct TimelineCost
+{
+    SpringMassKernel kernel;
+    bool tangent;
+    double perStep; // Seconds per step
+} TimelineCost;
+
+// A rebuilt instant
+typedef struct TimelinePoint
+{
+    SpringMassSystemState state;
+    double time;              // Session time of the frame shown (at or just before the one asked for)
+    unsigned long long frame; // Frame shown
+    bool exact;               // Re-simulated (false: older than the journal, snapped to the nearest keyframe)
+} TimelinePoint;
+
+// One simulation's timeline (disabled while `dt` is NULL). A keyframe is stored whenever the estimated cost of
+// replaying from the last one reaches a quarter of the frame budget, so a seek replays for at most half of it.
+typedef struct Timeline
+{
+    float *dt;                      // Frame time of each journaled frame (ring; frame f at f % TIMELINE_FRAMES)
+    uint16_t *info;                 // Substeps (low byte) and TimelineMode (high byte) of each frame
+    TimelineEvent *events;          // Edit ring
+    TimelineParamSet *params;       // Parameter set ring
+    TimelineKey *keys;              // Keyframes, oldest first
+    int keyCount;                   // Keyframes stored
+    unsigned long long frames;      // Frames journaled (numbered from 1)
+    unsigned long long eventCount;  // Edits journaled
+    unsigned long long paramCount;  // Parameter sets journaled
+    unsigned long long oldest;      // Earliest keyframe frame replay can start from (older: journal overwritten)
+    bool started;                   // A frame has begun
+    double lastTime;                // Session time at the end of the last frame
+    SpringMassSystemState expected; // What replay reaches at the end of the last frame
+    TimelineParams expectedParams;  // Parameters of `expected`
+    double keyCost;                 // Estimated seconds to replay from the last keyframe
+    double budget;                  // Frame budget; a seek replays at most half of it
+    TimelineCost costs[TIMELINE_KERNELS];
+    int costCount;
+    double lastSeek;  // CPU seconds the last seek took
+    double worstSeek; // CPU seconds the slowest seek took
+} Timeline;
+
+// Timeline Function declarations
+void TimelineInit(Timeline *timeline);                 // Disabled timeline (records nothing)
+bool TimelineOpen(Timeline *timeline, double budget);  // Allocate the journal (false: no memory, stays disabled)
+void TimelineClose(Timeline *timeline);                // Free the journal
+void TimelineBeginFrame(Timeline *timeline,
+                        const SpringMassSystemState *state); // Before a frame's physics: journal any edits
+void TimelineEndFrame(Timeline *timeline, const SpringMassSystemState *state, float dt, int substeps,
+                      TimelineMode mode, double time); // After a frame's physics: journal how it stepped
+bool TimelineSeek(Timeline *timeline, double time,
+                  TimelinePoint *point);               // Rebuild the state at `time` (false: nothing recorded)
+double TimelineStart(const Timeline *timeline);        // Earliest time a seek can show
+double TimelineEnd(const Timeline *timeline);          // Time at the end of the last frame
+size_t TimelineMemory(const Timeline *timeline);       // Bytes allocated (fixed once opened)
+
+#endif
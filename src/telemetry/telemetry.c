@@ -0,0 +1,146 @@
+/**************************************************************
+ * @file telemetry.c                                          *
+ * @brief Implementation of the shared-memory telemetry ring. *
+ * @author Gabe G.                                            *
+ * @date 10-19-2026                                           *
+ **************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "telemetry/telemetry.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/***********************************
+ *      External API Functions     *
+ ***********************************/
+
+bool TelemetryOpenWriter(TelemetryWriter *writer, const char *name)
+{
+    writer->ring = NULL;
+    snprintf(writer->name, sizeof(writer->name), "%s", name);
+
+    int fd = shm_open(name, O_CREAT | O_RDWR, 0644);
+    if (fd < 0)
+        return false;
+    if (ftruncate(fd, sizeof(TelemetryRing)) != 0)
+    {
+        close(fd);
+        return false;
+    }
+    void *memory = mmap(NULL, sizeof(TelemetryRing), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED)
+        return false;
+
+    // A fresh run restarts the stream; readers still attached see `head` go backwards and resync
+    TelemetryRing *ring = memory;
+    ring->magic = TELEMETRY_MAGIC;
+    ring->version = TELEMETRY_VERSION;
+    ring->capacity = TELEMETRY_CAPACITY;
+    ring->recordSize = sizeof(TelemetryRecord);
+    for (int i = 0; i < TELEMETRY_CAPACITY; i++)
+        atomic_store_explicit(&ring->slots[i].version, 0, memory_order_relaxed);
+    atomic_store_explicit(&ring->head, 0, memory_order_release);
+
+    writer->ring = ring;
+    return true;
+}
+
+void TelemetryPublish(TelemetryWriter *writer, TelemetryKind kind, double time, double a, double b, double c, double d)
+{
+    TelemetryRing *ring = writer->ring;
+    if (!ring)
+        return;
+
+    uint64_t sequence = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    TelemetrySlot *slot = &ring->slots[sequence & (TELEMETRY_CAPACITY - 1)];
+
+    // Mark the slot as being written, then fill it, then publish the even version
+    atomic_store_explicit(&slot->version, 2 * sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    slot->record = (TelemetryRecord){ sequence, (uint32_t)kind, 0, time, { a, b, c, d } };
+    atomic_store_explicit(&slot->version, 2 * sequence + 2, memory_order_release);
+    atomic_store_explicit(&ring->head, sequence + 1, memory_order_release);
+}
+
+void TelemetryCloseWriter(TelemetryWriter *writer)
+{
+    if (!writer->ring)
+        return;
+    // The object is left in place (not unlinked): the next run reopens the same one, so readers that stay attached
+    // across runs see `head` go back and resync instead of watching an orphaned ring that never moves again
+    munmap(writer->ring, sizeof(TelemetryRing));
+    writer->ring = NULL;
+}
+
+bool TelemetryOpenReader(TelemetryReader *reader, const char *name)
+{
+    reader->ring = NULL;
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0)
+        return false;
+    void *memory = mmap(NULL, sizeof(TelemetryRing), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED)
+        return false;
+
+    const TelemetryRing *ring = memory;
+    if (ring->magic != TELEMETRY_MAGIC || ring->version != TELEMETRY_VERSION || ring->capacity != TELEMETRY_CAPACITY ||
+        ring->recordSize != sizeof(TelemetryRecord))
+    {
+        munmap(memory, sizeof(TelemetryRing));
+        return false;
+    }
+    reader->ring = ring;
+    reader->next = atomic_load_explicit(&((TelemetryRing *)ring)->head, memory_order_acquire);
+    return true;
+}
+
+int TelemetryRead(TelemetryReader *reader, TelemetryRecord *records, int max, uint64_t *lost)
+{
+    TelemetryRing *ring = (TelemetryRing *)reader->ring; // Only loaded from; the cast is for the atomic API
+    *lost = 0;
+    if (!ring)
+        return 0;
+
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    if (head < reader->next)
+        reader->next = head; // Writer restarted
+    if (head - reader->next > TELEMETRY_CAPACITY)
+    {
+        // Fell more than a full ring behind: skip to the oldest record still present
+        *lost += head - reader->next - TELEMETRY_CAPACITY;
+        reader->next = head - TELEMETRY_CAPACITY;
+    }
+
+    int count = 0;
+    while (reader->next < head && count < max)
+    {
+        uint64_t sequence = reader->next++;
+        const TelemetrySlot *slot = &ring->slots[sequence & (TELEMETRY_CAPACITY - 1)];
+        uint64_t before = atomic_load_explicit(&((TelemetrySlot *)slot)->version, memory_order_acquire);
+        TelemetryRecord copy = slot->record;
+        atomic_thread_fence(memory_order_acquire);
+        uint64_t after = atomic_load_explicit(&((TelemetrySlot *)slot)->version, memory_order_relaxed);
+
+        // The writer lapped us while copying: the record is gone
+        if (before != 2 * sequence + 2 || after != before)
+        {
+            (*lost)++;
+            continue;
+        }
+        records[count++] = copy;
+    }
+    return count;
+}
+
+void TelemetryCloseReader(TelemetryReader *reader)
+{
+    if (reader->ring)
+        munmap((void *)reader->ring, sizeof(TelemetryRing));
+    reader->ring = NULL;
+}
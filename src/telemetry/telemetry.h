@@ -0,0 +1,80 @@
+/**********************************************************************
+ * @file telemetry.h                                                  *
+ * @brief Shared-memory telemetry ring (single writer, many readers). *
+ * @author Gabe G.                                                    *
+ * @date 10-19-2026                                                   *
+ **********************************************************************/
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TELEMETRY_SHM_NAME "/springmass-telemetry" // Default POSIX shared-memory object
+#define TELEMETRY_CAPACITY 4096                    // Records in the ring (power of two)
+#define TELEMETRY_MAGIC 0x544d4c54u                // "TLMT"
+#define TELEMETRY_VERSION 1
+
+typedef enum TelemetryKind
+{
+    TELEMETRY_SAMPLE = 0,  // values = { x, velocity, acceleration, 0 }
+    TELEMETRY_PARAMS = 1,  // values = { k, m, c, e }
+    TELEMETRY_QUALITY = 2, // values = { new level, previous level, smoothed frame work (ms), frame budget (ms) }
+} TelemetryKind;
+
+// One published record
+typedef struct TelemetryRecord
+{
+    uint64_t sequence; // Position in the stream (0, 1, 2, ...)
+    uint32_t kind;     // TelemetryKind
+    uint32_t reserved; // Padding (0)
+    double time;       // Simulation time
+    double values[4];  // Meaning depends on `kind`
+} TelemetryRecord;
+
+// Ring slot guarded by a per-slot sequence counter: odd while being written,
+// 2 * (sequence + 1) once record `sequence` is complete.
+typedef struct TelemetrySlot
+{
+    _Atomic uint64_t version;
+    TelemetryRecord record;
+} TelemetrySlot;
+
+// Layout of the shared-memory object
+typedef struct TelemetryRing
+{
+    uint32_t magic;        // TELEMETRY_MAGIC
+    uint32_t version;      // TELEMETRY_VERSION
+    uint32_t capacity;     // TELEMETRY_CAPACITY
+    uint32_t recordSize;   // sizeof(TelemetryRecord)
+    _Atomic uint64_t head; // Sequence number of the next record to be written
+    TelemetrySlot slots[TELEMETRY_CAPACITY];
+} TelemetryRing;
+
+// Writer side (owned by the simulation)
+typedef struct TelemetryWriter
+{
+    TelemetryRing *ring; // NULL when telemetry is unavailable
+    char name[64];
+} TelemetryWriter;
+
+// Reader side (external consumers)
+typedef struct TelemetryReader
+{
+    const TelemetryRing *ring;
+    uint64_t next; // Next sequence number to read
+} TelemetryReader;
+
+// Telemetry Function declarations
+bool TelemetryOpenWriter(TelemetryWriter *writer, const char *name); // Create/reset the ring (false if unavailable)
+void TelemetryPublish(TelemetryWriter *writer, TelemetryKind kind, double time, double a, double b, double c,
+                      double d);                                     // Append a record (no locks, no syscalls)
+void TelemetryCloseWriter(TelemetryWriter *writer);                  // Unmap the ring (kept for the next run)
+bool TelemetryOpenReader(TelemetryReader *reader, const char *name); // Attach read-only at the newest record
+int TelemetryRead(TelemetryReader *reader, TelemetryRecord *records, int max,
+                  uint64_t *lost);                  // Copy up to `max` new records; `lost` counts overrun records
+void TelemetryCloseReader(TelemetryReader *reader); // Detach from the ring
+
+#endif
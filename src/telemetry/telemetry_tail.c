@@ -0,0 +1,70 @@
+/**********************************************************************************
+ * @file telemetry_tail.c                                                         *
+ * @brief Follow the Spring-Mass telemetry ring and print records as they arrive. *
+ * @author Gabe G.                                                                *
+ * @date 10-19-2026                                                               *
+ **********************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "telemetry/telemetry.h"
+#include <inttypes.h>
+#include <signal.h>
+#include <stdio.h>
+#include <time.h>
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void HandleSignal(int signal)
+{
+    (void)signal;
+    stopRequested = 1;
+}
+
+// Usage: springmass_tail [shm name]
+int main(int argc, char **argv)
+{
+    const char *name = (argc > 1) ? argv[1] : TELEMETRY_SHM_NAME;
+    signal(SIGINT, HandleSignal);
+
+    TelemetryReader reader;
+    while (!TelemetryOpenReader(&reader, name))
+    {
+        if (stopRequested)
+            return 1;
+        fprintf(stderr, "waiting for %s...\n", name);
+        nanosleep(&(struct timespec){ 1, 0 }, NULL);
+    }
+
+    TelemetryRecord records[256];
+    uint64_t totalLost = 0;
+    while (!stopRequested)
+    {
+        uint64_t lost;
+        int count = TelemetryRead(&reader, records, 256, &lost);
+        if (lost)
+        {
+            totalLost += lost;
+            printf("# overrun: %" PRIu64 " record(s) lost (%" PRIu64 " total)\n", lost, totalLost);
+        }
+        for (int i = 0; i < count; i++)
+        {
+            const TelemetryRecord *r = &records[i];
+            if (r->kind == TELEMETRY_PARAMS)
+                printf("%10" PRIu64 " t=%.4f params k=%.3f m=%.3f c=%.3f e=%.3f\n", r->sequence, r->time,
+                       r->values[0], r->values[1], r->values[2], r->values[3]);
+            else if (r->kind == TELEMETRY_QUALITY)
+                printf("%10" PRIu64 " t=%.4f quality %.0f -> %.0f (frame work %.2f ms of a %.2f ms budget)\n",
+                       r->sequence, r->time, r->values[1], r->values[0], r->values[2], r->values[3]);
+            else
+                printf("%10" PRIu64 " t=%.4f x=%.4f v=%.4f a=%.4f\n", r->sequence, r->time, r->values[0],
+                       r->values[1], r->values[2]);
+        }
+        fflush(stdout);
+        if (count == 0)
+            nanosleep(&(struct timespec){ 0, 1000000 }, NULL); // Idle 1 ms; the writer is never waited on
+    }
+
+    TelemetryCloseReader(&reader);
+    return 0;
+}